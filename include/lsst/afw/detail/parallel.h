@@ -0,0 +1,97 @@
+// -*- lsst-c++ -*-
+#ifndef LSST_AFW_DETAIL_parallel_h_INCLUDED
+#define LSST_AFW_DETAIL_parallel_h_INCLUDED
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace lsst {
+namespace afw {
+namespace detail {
+
+/**
+ *  @internal Return the number of threads to use when nThreads are requested.
+ *
+ *  nThreads <= 0 means one thread per hardware thread.
+ */
+inline std::size_t getThreadCount(int nThreads) {
+    if (nThreads > 0) {
+        return nThreads;
+    }
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/**
+ *  @internal Call func(i) for each i in [0, nTasks), each on a thread of its own.
+ *
+ *  Task 0 is run on the calling thread, as is any task whose thread cannot be started.  All tasks are
+ *  run to completion before the first exception thrown by any of them (in task order) is rethrown.
+ */
+template <typename Func>
+void runParallel(std::size_t nTasks, Func const& func) {
+    if (nTasks <= 1) {
+        if (nTasks == 1) func(0);
+        return;
+    }
+    std::vector<std::exception_ptr> errors(nTasks);
+    auto runTask = [&func, &errors](std::size_t task) {
+        try {
+            func(task);
+        } catch (...) {
+            errors[task] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(nTasks - 1);
+    try {
+        for (std::size_t task = 1; task < nTasks; ++task) {
+            threads.emplace_back(runTask, task);
+        }
+    } catch (...) {
+        // Could not start a thread; the tasks without one are run below.
+    }
+    runTask(0);
+    for (std::size_t task = threads.size() + 1; task < nTasks; ++task) {
+        runTask(task);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (auto const& error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+}
+
+/**
+ *  @internal Call func(worker, i) for each i in [0, n), handing the items out one at a time to up to
+ *  nWorkers threads.
+ *
+ *  Use this rather than runParallel when the cost of the items varies widely.  worker (in
+ *  [0, nWorkers)) identifies the thread calling func, for per-thread state.  No item is started after
+ *  one has thrown; the first exception is rethrown once all threads have stopped.
+ */
+template <typename Func>
+void forEachParallel(std::size_t n, std::size_t nWorkers, Func const& func) {
+    std::atomic<std::size_t> next(0);
+    std::atomic<bool> failed(false);
+    runParallel(std::min(nWorkers, n), [&func, &next, &failed, n](std::size_t worker) {
+        try {
+            for (std::size_t i = next++; i < n && !failed; i = next++) {
+                func(worker, i);
+            }
+        } catch (...) {
+            failed = true;
+            throw;
+        }
+    });
+}
+
+}  // namespace detail
+}  // namespace afw
+}  // namespace lsst
+
+#endif  // !LSST_AFW_DETAIL_parallel_h_INCLUDED
@@ -62,10 +62,12 @@ public:
      * @param threshold threshold to find objects
      * @param npixMin minimum number of pixels in an object
      * @param setPeaks should I set the Peaks list?
+     * @param nThreads number of threads to use when setting the Peaks; if <= 0, use one per core.
+     *                 The Peaks are the same whatever the number of threads.
      */
     template <typename ImagePixelT>
     FootprintSet(image::Image<ImagePixelT> const& img, Threshold const& threshold, int const npixMin = 1,
-                 bool const setPeaks = true);
+                 bool const setPeaks = true, int const nThreads = 1);
 
     /**
      * Find a FootprintSet given a Mask and a threshold
@@ -94,10 +96,13 @@ public:
      * @param planeName mask plane to set (if != "")
      * @param npixMin minimum number of pixels in an object
      * @param setPeaks should I set the Peaks list?
+     * @param nThreads number of threads to use when setting the Peaks; if <= 0, use one per core.
+     *                 The Peaks are the same whatever the number of threads.
      */
     template <typename ImagePixelT, typename MaskPixelT>
     FootprintSet(image::MaskedImage<ImagePixelT, MaskPixelT> const& img, Threshold const& threshold,
-                 std::string const& planeName = "", int const npixMin = 1, bool const setPeaks = true);
+                 std::string const& planeName = "", int const npixMin = 1, bool const setPeaks = true,
+                 int const nThreads = 1);
 
     /**
      * Construct an empty FootprintSet given a region that its footprints would have lived in
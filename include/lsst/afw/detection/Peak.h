@@ -82,6 +82,8 @@ public:
 protected:
     explicit PeakRecord(std::shared_ptr<PeakTable> const& table);
 
+    PeakRecord(std::shared_ptr<PeakTable> const& table, afw::table::detail::RecordView const& view);
+
 private:
     friend class PeakTable;
 };
@@ -186,6 +188,9 @@ protected:
 
     std::shared_ptr<afw::table::BaseRecord> _makeRecord() override;
 
+    std::shared_ptr<afw::table::BaseRecord> _makeRecordView(
+            afw::table::detail::RecordView const& view) override;
+
 private:
     // Struct that holds the minimal schema and the special keys we've added to it.
     struct MinimalSchema {
@@ -14,8 +14,10 @@
  */
 
 #include <climits>
+#include <cstdint>
 #include <string>
 #include <set>
+#include <vector>
 
 #include <boost/format.hpp>
 
@@ -408,6 +410,20 @@ public:
      */
     void readMetadata(daf::base::PropertySet& metadata, bool strip = false);
 
+    /**
+     *  Read only the given keys of a FITS header into a PropertySet or PropertyList.
+     *
+     *  Cards for other keys are skipped without being parsed, which makes this much faster than
+     *  reading the whole header when only a few keys are needed from a long one.  Keys that are
+     *  not present are silently omitted.
+     *
+     *  @param[in,out] metadata  A PropertySet or PropertyList that FITS header items will be added to.
+     *  @param[in]     strip     If true, common FITS keys that usually have non-metadata intepretations
+     *                           (e.g. NAXIS, BITPIX) will be ignored even if requested.
+     *  @param[in]     keys      Names of the keys to read.
+     */
+    void readMetadata(daf::base::PropertySet& metadata, bool strip, std::vector<std::string> const& keys);
+
     /// Read a FITS header key into the given reference.
     template <typename T>
     void readKey(std::string const& key, T& value);
@@ -547,6 +563,30 @@ public:
         readImageImpl(N, array.getData(), begin.elems, end.elems, increment.elems);
     }
 
+    /**
+     *  Map a 2-d subimage of the current image HDU directly from the file, instead of reading it.
+     *
+     *  Only the pages of the file that hold the requested rows are mapped, and only those holding the
+     *  requested pixels are ever read.  The mapping is private, so pixels may be modified without
+     *  affecting the file.  Pixels that aren't already in native form on disk (i.e. on little-endian
+     *  machines, all but single-byte pixels, and unsigned integers stored with a BZERO offset) are
+     *  converted in place when the subimage is mapped, which touches every page of the subimage;
+     *  single-byte pixels on any machine, and all pixels on big-endian machines, are loaded lazily
+     *  by the operating system as they are accessed.
+     *
+     *  Mapping is only possible for uncompressed, unscaled images in a regular file opened read-only
+     *  whose on-disk type is exactly T; other images must be read with readImage.
+     *
+     *  @param[in]   shape    Shape (rows, columns) of the subimage.
+     *  @param[in]   offset   Indices of the first pixel of the subimage.
+     *
+     *  @returns  An array viewing the mapped pixels, whose rows are strided as they are in the image,
+     *            or an empty array if the image cannot be mapped.
+     */
+    template <typename T>
+    ndarray::Array<T, 2, 1> mapImage(ndarray::Vector<int, 2> const& shape,
+                                     ndarray::Vector<int, 2> const& offset);
+
     /// Create a new binary table extension.
     void createTable();
 
@@ -586,6 +626,31 @@ public:
     /// Write a string to a binary table.
     void writeTableScalar(std::size_t row, int col, std::string const& value);
 
+    /**
+     *  Write raw bytes to consecutive rows of a binary table.
+     *
+     *  The bytes are copied verbatim, so they must already be in the on-disk representation:
+     *  big-endian, with any TZERO offset applied and bit columns packed.  A single call may
+     *  span many rows, starting at the first byte of the given row.
+     *
+     *  @param[in] row     Zero-indexed row at which to start writing.
+     *  @param[in] nBytes  Number of bytes to write.
+     *  @param[in] data    Bytes to write.
+     */
+    void writeTableBytes(std::size_t row, std::size_t nBytes, std::uint8_t const* data);
+
+    /**
+     *  Read raw bytes from consecutive rows of a binary table.
+     *
+     *  The bytes are in the on-disk representation (see writeTableBytes); no scaling or byte
+     *  swapping is done.
+     *
+     *  @param[in]  row     Zero-indexed row at which to start reading.
+     *  @param[in]  nBytes  Number of bytes to read.
+     *  @param[out] data    Buffer of at least nBytes bytes.
+     */
+    void readTableBytes(std::size_t row, std::size_t nBytes, std::uint8_t* data);
+
     /// Read an array value from a binary table.
     template <typename T>
     void readTableArray(std::size_t row, int col, int nElements, T* value);
@@ -684,6 +749,19 @@ std::shared_ptr<daf::base::PropertyList> combineMetadata(
  */
 std::shared_ptr<daf::base::PropertyList> readMetadata(std::string const& fileName, int hdu = DEFAULT_HDU,
                                                       bool strip = false);
+/** Read the given keys of a FITS header
+ *
+ * As readMetadata(std::string const&, int, bool), but reading only the given keys; cards for other
+ * keys are skipped without being parsed.  Keys that are not present are silently omitted.
+ *
+ * @param fileName the file whose header will be read
+ * @param hdu the HDU to read (0-indexed; 0 is the Primary HDU).
+ * @param strip if `true`, common FITS keys that usually have non-metadata intepretations
+ *              (e.g. NAXIS, BITPIX) will be ignored.
+ * @param keys names of the keys to read
+ */
+std::shared_ptr<daf::base::PropertyList> readMetadata(std::string const& fileName, int hdu, bool strip,
+                                                      std::vector<std::string> const& keys);
 /** Read FITS header
  *
  * Includes support for the INHERIT convention: if 'INHERIT = T' is in the header, the
@@ -696,6 +774,19 @@ std::shared_ptr<daf::base::PropertyList> readMetadata(std::string const& fileNam
  */
 std::shared_ptr<daf::base::PropertyList> readMetadata(fits::MemFileManager& manager, int hdu = DEFAULT_HDU,
                                                       bool strip = false);
+/** Read the given keys of a FITS header
+ *
+ * As readMetadata(fits::MemFileManager&, int, bool), but reading only the given keys; cards for other
+ * keys are skipped without being parsed.  Keys that are not present are silently omitted.
+ *
+ * @param manager the in-memory file whose header will be read
+ * @param hdu the HDU to read (0-indexed; 0 is the Primary HDU).
+ * @param strip if `true`, common FITS keys that usually have non-metadata intepretations
+ *              (e.g. NAXIS, BITPIX) will be ignored.
+ * @param keys names of the keys to read
+ */
+std::shared_ptr<daf::base::PropertyList> readMetadata(fits::MemFileManager& manager, int hdu, bool strip,
+                                                      std::vector<std::string> const& keys);
 /** Read FITS header
  *
  * Includes support for the INHERIT convention: if 'INHERIT = T' is in the header, the
@@ -706,10 +797,44 @@ std::shared_ptr<daf::base::PropertyList> readMetadata(fits::MemFileManager& mana
  *              (e.g. NAXIS, BITPIX) will be ignored.
  */
 std::shared_ptr<daf::base::PropertyList> readMetadata(fits::Fits& fitsfile, bool strip = false);
+/** Read the given keys of a FITS header
+ *
+ * As readMetadata(fits::Fits&, bool), but reading only the given keys; cards for other
+ * keys are skipped without being parsed.  Keys that are not present are silently omitted.
+ *
+ * @param fitsfile the file and HDU to be read
+ * @param strip if `true`, common FITS keys that usually have non-metadata intepretations
+ *              (e.g. NAXIS, BITPIX) will be ignored.
+ * @param keys names of the keys to read
+ */
+std::shared_ptr<daf::base::PropertyList> readMetadata(fits::Fits& fitsfile, bool strip,
+                                                      std::vector<std::string> const& keys);
 
 void setAllowImageCompression(bool allow);
 bool getAllowImageCompression();
 
+/**
+ *  Set the number of threads used to compress and decompress image tiles.
+ *
+ *  Tiles of RICE-compressed 8-bit, 16-bit (signed or unsigned) and 32-bit signed integer images
+ *  (including floating-point images we quantize ourselves, when writing) are compressed and
+ *  decompressed by afw on this many threads, while cfitsio writes and reads the standard tiled-image
+ *  BINTABLE; all other compressed images are handled entirely by cfitsio.  Zero or a negative number
+ *  (the default) uses one thread per hardware thread, and one does all the work on the calling thread.
+ */
+void setCompressionThreads(int nThreads);
+int getCompressionThreads();
+
+/**
+ *  Limit the number of threads used to compress and decompress image tiles for the calling thread.
+ *
+ *  The limit applies only to the thread that sets it, and caps the number set by
+ *  setCompressionThreads(); zero or a negative number (the default) removes the limit.  This keeps
+ *  threads that each write or read their own files from all compressing on every hardware thread.
+ */
+void setCompressionThreadLimit(int nThreads);
+int getCompressionThreadLimit();
+
 
 
 /**
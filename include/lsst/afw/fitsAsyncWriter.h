@@ -0,0 +1,119 @@
+// -*- lsst-c++ -*-
+#ifndef LSST_AFW_fitsAsyncWriter_h_INCLUDED
+#define LSST_AFW_fitsAsyncWriter_h_INCLUDED
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace lsst {
+namespace afw {
+namespace fits {
+
+/**
+ *  A pool of background threads that write FITS files, so computation can continue while files are
+ *  formatted, compressed, and written.
+ *
+ *  Each write is queued as a task and returns a future that becomes ready when the write is complete;
+ *  any exception thrown by the write is rethrown by future::get().  At most maxPending writes may be
+ *  queued or in progress at once: further calls block until one finishes, which bounds the memory
+ *  held by objects waiting to be written.
+ *
+ *  The writer takes ownership of each object it writes, and deletes it once it has been written.  The
+ *  object must not share any data with objects the caller still uses: afw objects copied shallowly
+ *  share pixels and records, whose reference counts are not safe to update from several threads.
+ *  Pass a deep copy:
+ *  @code
+ *  fits::AsyncWriter writer;
+ *  auto done = writer.writeFits(std::make_unique<image::Exposure<float>>(exposure, true), filename);
+ *  ...  // modify exposure
+ *  done.get();  // rethrows any error from writing
+ *  @endcode
+ *
+ *  Each writer thread compresses image tiles on at most its share of the hardware threads (see
+ *  setCompressionThreadLimit()), so that the writers together do not oversubscribe the machine.
+ *
+ *  Writing on other threads requires cfitsio to have been built to be reentrant.  If it was not,
+ *  writes are performed immediately on the calling thread instead (still reporting errors through
+ *  the returned future).
+ *
+ *  The destructor waits for all queued writes to finish.
+ */
+class AsyncWriter {
+public:
+    /**
+     *  Start the background threads.
+     *
+     *  @param[in] nThreads    Number of writer threads; zero or negative uses one per hardware thread.
+     *  @param[in] maxPending  Maximum number of writes queued or in progress before new writes block;
+     *                         zero means twice the number of threads.
+     */
+    explicit AsyncWriter(int nThreads = 1, std::size_t maxPending = 0);
+
+    AsyncWriter(AsyncWriter const &) = delete;
+    AsyncWriter(AsyncWriter &&) = delete;
+    AsyncWriter &operator=(AsyncWriter const &) = delete;
+    AsyncWriter &operator=(AsyncWriter &&) = delete;
+
+    ~AsyncWriter() noexcept;
+
+    /**
+     *  Queue an arbitrary write, blocking first if maxPending writes are already pending.
+     *
+     *  @returns a future that is ready when the write is done, and rethrows any exception it threw.
+     */
+    std::future<void> submit(std::function<void()> write);
+
+    /**
+     *  Queue a call to object->writeFits(args...), taking ownership of object.
+     *
+     *  Any afw class with writeFits methods (images, masked images, exposures, catalogs, ...) may be
+     *  written, with any of the arguments of its writeFits methods that write to a file; arguments are
+     *  copied.  The object must be a deep copy, which no one else refers to.
+     */
+    template <typename T, typename... Args>
+    std::future<void> writeFits(std::unique_ptr<T> object, Args... args) {
+        // std::function needs a copyable target; only the queued task ever refers to the object.
+        std::shared_ptr<T> owned(std::move(object));
+        auto write = [](std::shared_ptr<T> const &obj, Args const &... a) { obj->writeFits(a...); };
+        return submit(std::bind(write, std::move(owned), std::move(args)...));
+    }
+
+    /// Block until all writes queued so far have finished.
+    void wait();
+
+    /// Return the number of writes queued or in progress.
+    std::size_t getPending() const;
+
+    /// Return the number of background threads, which is zero if writes are done synchronously.
+    std::size_t getThreadCount() const noexcept { return _threads.size(); }
+
+    /// Return the maximum number of writes queued or in progress before new writes block.
+    std::size_t getMaxPending() const noexcept { return _maxPending; }
+
+private:
+    void _run(int compressionThreadLimit);
+    void _stop() noexcept;  // finish the queued writes and join the threads
+
+    std::size_t _maxPending;
+    std::size_t _pending;  // queued or in progress
+    bool _stopping;
+    std::deque<std::packaged_task<void()>> _queue;
+    mutable std::mutex _mutex;
+    std::condition_variable _workAvailable;  // signalled when a task is queued, or on shutdown
+    std::condition_variable _taskDone;       // signalled when a task finishes
+    std::vector<std::thread> _threads;
+};
+
+}  // namespace fits
+}  // namespace afw
+}  // namespace lsst
+
+#endif  // !LSST_AFW_fitsAsyncWriter_h_INCLUDED
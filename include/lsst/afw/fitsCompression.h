@@ -371,13 +371,14 @@ public:
     float quantizePad;  ///< Number of stdev to allow on the low/high side (for STDEV_POSITIVE/NEGATIVE)
     double bscale;      ///< Manually specified BSCALE (for MANUAL scaling)
     double bzero;       ///< Manually specified BZERO (for MANUAL scaling)
+    std::size_t maxSamples;  ///< Maximum number of pixels sampled for STDEV_* statistics (0 for all)
 
     /// Default Ctor
     ///
     /// Scaling is disabled by default.
     explicit ImageScalingOptions()
             : ImageScalingOptions(NONE, 0, {}, 1, 4.0, 5.0, false, std::numeric_limits<double>::quiet_NaN(),
-                                  std::numeric_limits<double>::quiet_NaN()) {}
+                                  std::numeric_limits<double>::quiet_NaN(), 0) {}
 
     /// General purpose Ctor
     ///
@@ -390,10 +391,14 @@ public:
     /// @param[in] fuzz_  Fuzz the values when quantising floating-point values?
     /// @param[in] bscale_  Manually specified BSCALE (for MANUAL scaling)
     /// @param[in] bzero_  Manually specified BZERO (for MANUAL scaling)
+    /// @param[in] maxSamples_  Maximum number of pixels from which to estimate the median and standard
+    ///                         deviation for STDEV_* scaling, or 0 to use all unmasked pixels.  Sampling
+    ///                         is reproducible (the seed is used), and makes the relative error of the
+    ///                         standard deviation about 1.2/sqrt(maxSamples).
     ImageScalingOptions(ScalingAlgorithm algorithm_, int bitpix_,
                         std::vector<std::string> const& maskPlanes_ = {}, int seed_ = 1,
                         float quantizeLevel_ = 4.0, float quantizePad_ = 5.0, bool fuzz_ = true,
-                        double bscale_ = 1.0, double bzero_ = 0.0);
+                        double bscale_ = 1.0, double bzero_ = 0.0, std::size_t maxSamples_ = 0);
 
     /// Manual scaling Ctor
     ///
@@ -401,7 +406,7 @@ public:
     /// @param[in] bscale_  Manually specified BSCALE
     /// @param[in] bzero_  Manually specified BZERO
     ImageScalingOptions(int bitpix_, double bscale_ = 1.0, double bzero_ = 0.0)
-            : ImageScalingOptions(MANUAL, bitpix_, {}, 1, 4.0, 5.0, false, bscale_, bzero_) {}
+            : ImageScalingOptions(MANUAL, bitpix_, {}, 1, 4.0, 5.0, false, bscale_, bzero_, 0) {}
 
     //@{
     /// Determine the scaling for a particular image
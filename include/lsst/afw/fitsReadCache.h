@@ -0,0 +1,155 @@
+// -*- lsst-c++ -*-
+#ifndef LSST_AFW_fitsReadCache_h_INCLUDED
+#define LSST_AFW_fitsReadCache_h_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+
+namespace lsst {
+namespace daf {
+namespace base {
+class PropertySet;
+}  // namespace base
+}  // namespace daf
+namespace afw {
+namespace fits {
+
+/**
+ *  A process-wide cache of objects decoded from FITS files on disk.
+ *
+ *  The FITS readers (ImageFitsReader, MaskFitsReader, MaskedImageFitsReader and ExposureFitsReader)
+ *  consult this cache when they are constructed from a file name, so opening the same file again from
+ *  another reader finds the headers and the Exposure components in them (Wcs, VisitInfo, etc.) already
+ *  decoded.  The components saved in an Exposure's archive (Psf, Wcs, ApCorrMap, etc.) are cached as
+ *  decoded objects when first read, except CoaddInputs; the archive HDUs themselves are cached as raw
+ *  bytes, from which each reader lazily parses only the catalogs it needs.
+ *
+ *  Entries are keyed on the file's canonical path, modification time and size, an HDU, and the kind of
+ *  object stored; a file that is modified gets a new key, and its old entries are eventually evicted.
+ *  The total (estimated) size of the entries is bounded by the capacity, evicting the least recently
+ *  used first.  The capacity is zero by default, which disables caching.
+ *
+ *  Cached objects are shared by all readers, and must not be modified; readers return copies of
+ *  anything their callers could modify.  All methods are thread-safe.
+ */
+class ReadCache {
+public:
+    /// Identity of a file on disk, as used in cache keys.
+    struct FileId {
+        std::string path;        ///< Canonical absolute path, or empty if the file is not cached.
+        std::int64_t mtime = 0;  ///< Modification time (ns).
+        std::int64_t size = 0;   ///< Size (bytes).
+
+        /// Whether objects from this file may be cached.
+        explicit operator bool() const noexcept { return !path.empty(); }
+    };
+
+    ReadCache(ReadCache const &) = delete;
+    ReadCache(ReadCache &&) = delete;
+    ReadCache &operator=(ReadCache const &) = delete;
+    ReadCache &operator=(ReadCache &&) = delete;
+
+    /// Return the process-wide cache.
+    static ReadCache &getInstance();
+
+    /**
+     *  Return the identity of a file for use in cache keys.
+     *
+     *  The result is empty (and nothing will be cached for it) if caching is disabled or the file
+     *  cannot be examined.
+     */
+    FileId identify(std::string const &fileName) const;
+
+    /**
+     *  Return the cached object of the given kind for an HDU of a file, or null if there is none.
+     *
+     *  @throws pex::exceptions::TypeError if the cached object is not a T.
+     */
+    template <typename T>
+    std::shared_ptr<T const> find(FileId const &file, int hdu, std::string const &kind) {
+        return std::static_pointer_cast<T const>(_find(makeKey(file, hdu, kind), typeid(T)));
+    }
+
+    /**
+     *  Add an object to the cache, evicting others if necessary.
+     *
+     *  @param[in] file    File the object was read from; nothing is done if empty.
+     *  @param[in] hdu     HDU the object was read from.
+     *  @param[in] kind    Kind of object; together with file and hdu, identifies the object.
+     *  @param[in] value   Object to cache.  It must not be modified afterwards.
+     *  @param[in] nBytes  Estimate of the memory used by value; objects larger than the capacity are
+     *                     not cached.
+     */
+    template <typename T>
+    void insert(FileId const &file, int hdu, std::string const &kind, std::shared_ptr<T const> value,
+                std::size_t nBytes) {
+        if (file) {
+            _insert(makeKey(file, hdu, kind), typeid(T), std::move(value), nBytes);
+        }
+    }
+
+    /// Return an estimate of the memory used by a header, for use with insert.
+    static std::size_t estimateSize(daf::base::PropertySet const &metadata);
+
+    /// Set the maximum total size of cached objects (bytes), evicting if necessary; 0 disables caching.
+    void setCapacity(std::size_t nBytes);
+
+    /// Return the maximum total size of cached objects (bytes).
+    std::size_t getCapacity() const;
+
+    /// Return the estimated total size of cached objects (bytes).
+    std::size_t getSize() const;
+
+    /// Return the number of objects in the cache.
+    std::size_t getCount() const;
+
+    /// Return the number of calls to find that returned an object.
+    std::size_t getHitCount() const;
+
+    /// Return the number of calls to find that did not.
+    std::size_t getMissCount() const;
+
+    /// Remove all objects from the cache, and reset the hit and miss counts.
+    void clear();
+
+private:
+    struct Entry {
+        std::string key;
+        std::type_index type;
+        std::shared_ptr<void const> value;
+        std::size_t nBytes;
+    };
+
+    ReadCache() = default;
+
+    static std::string makeKey(FileId const &file, int hdu, std::string const &kind);
+
+    std::shared_ptr<void const> _find(std::string const &key, std::type_info const &type);
+
+    void _insert(std::string key, std::type_info const &type, std::shared_ptr<void const> value,
+                 std::size_t nBytes);
+
+    // Evict least recently used entries until the size is within the capacity; the mutex must be held.
+    void _evict();
+
+    mutable std::mutex _mutex;
+    std::size_t _capacity = 0;
+    std::size_t _size = 0;
+    std::size_t _hits = 0;
+    std::size_t _misses = 0;
+    std::list<Entry> _entries;  // most recently used first
+    std::unordered_map<std::string, std::list<Entry>::iterator> _index;
+};
+
+}  // namespace fits
+}  // namespace afw
+}  // namespace lsst
+
+#endif  // !LSST_AFW_fitsReadCache_h_INCLUDED
@@ -36,6 +36,7 @@
 #include "lsst/afw/geom/Box.h"
 #include "lsst/afw/geom/Span.h"
 #include "lsst/afw/geom/SpanSet.h"
+#include "lsst/afw/geom/CompactSpanSet.h"
 #include "lsst/afw/geom/SpherePoint.h"
 #include "lsst/afw/geom/polygon/Polygon.h"
 #include "lsst/afw/geom/Endpoint.h"
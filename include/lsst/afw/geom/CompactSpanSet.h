@@ -0,0 +1,224 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2018  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_AFW_GEOM_COMPACTSPANSET_H
+#define LSST_AFW_GEOM_COMPACTSPANSET_H
+
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <vector>
+#include "lsst/geom/Box.h"
+#include "lsst/afw/geom/Span.h"
+#include "lsst/afw/geom/SpanSet.h"
+#include "lsst/afw/geom/SpanSetFunctorGetters.h"
+
+namespace lsst {
+namespace afw {
+namespace geom {
+
+/**
+ * A memory-compact, immutable encoding of the Spans of a SpanSet
+ *
+ * Each Span is stored as three variable-length integers: the change in row and the change in
+ * starting column relative to the previous Span, and the width of the Span. For the regular
+ * shapes typical of Footprints this takes three bytes per Span, compared to twelve for a Span.
+ *
+ * The encoded data are immutable and shared between copies. shiftedBy never touches the encoded
+ * data, and clippedTo shares them whenever the box contains the whole CompactSpanSet, so derived
+ * objects cost only the size of the object itself.
+ *
+ * Spans are decoded on the fly while iterating, in the order of the SpanSet the object was created
+ * from; applyFunctor works as SpanSet::applyFunctor. Use toSpanSet to recover a full SpanSet for
+ * other operations.
+ *
+ * This is a standalone container: Footprints still hold (and persist) full SpanSets. Code that keeps
+ * many Footprints' pixel regions for a long time may store CompactSpanSets instead, converting back
+ * with toSpanSet when a Footprint is needed.
+ */
+class CompactSpanSet final {
+public:
+    /// Forward iterator which decodes Spans on the fly
+    class Iterator {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef Span value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Span const *pointer;
+        typedef Span const &reference;
+
+        Iterator() : _next(nullptr), _remaining(0), _span() {}
+
+        Span const &operator*() const { return _span; }
+        Span const *operator->() const { return &_span; }
+
+        Iterator &operator++() {
+            _decode();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator tmp(*this);
+            _decode();
+            return tmp;
+        }
+
+        bool operator==(Iterator const &other) const {
+            return _next == other._next && _remaining == other._remaining && _span == other._span;
+        }
+        bool operator!=(Iterator const &other) const { return !(*this == other); }
+
+    private:
+        friend class CompactSpanSet;
+
+        // Construct an iterator positioned on the first of nSpans encoded Spans
+        Iterator(std::uint8_t const *data, std::size_t nSpans, lsst::geom::Point2I const &origin);
+
+        void _decode();
+
+        std::uint8_t const *_next;
+        // Number of Spans, including the current one, not yet passed
+        std::size_t _remaining;
+        // Current Span, from which the next one is decoded
+        Span _span;
+    };
+
+    typedef Iterator const_iterator;
+    typedef std::size_t size_type;
+
+    /// Construct an empty CompactSpanSet
+    CompactSpanSet();
+
+    /** Encode the Spans of a SpanSet
+     *
+     * @param spanSet SpanSet to encode
+     */
+    explicit CompactSpanSet(SpanSet const &spanSet);
+
+    CompactSpanSet(CompactSpanSet const &) = default;
+    CompactSpanSet(CompactSpanSet &&) = default;
+    CompactSpanSet &operator=(CompactSpanSet const &) = default;
+    CompactSpanSet &operator=(CompactSpanSet &&) = default;
+    ~CompactSpanSet() = default;
+
+    const_iterator begin() const;
+    const_iterator end() const { return Iterator(); }
+
+    /// Return the number of Spans
+    size_type size() const;
+
+    /// Return true if there are no Spans
+    bool empty() const { return size() == 0; }
+
+    /// Return the number of pixels
+    std::size_t getArea() const { return _area; }
+
+    /// Return the smallest integer box containing all pixels
+    lsst::geom::Box2I getBBox() const { return _bbox; }
+
+    /// Return the number of bytes used by the (possibly shared) encoded Spans
+    std::size_t getEncodedSize() const;
+
+    /// Return true if this and other share the same encoded data
+    bool sharesStorageWith(CompactSpanSet const &other) const { return _data && _data == other._data; }
+
+    /// Decode into a new SpanSet
+    std::shared_ptr<SpanSet> toSpanSet() const;
+
+    /** Return a CompactSpanSet shifted by the specified amount, sharing the encoded data
+     *
+     * @param x number of pixels to shift in x dimension
+     * @param y number of pixels to shift in y dimension
+     */
+    CompactSpanSet shiftedBy(int x, int y) const;
+
+    /** Return a CompactSpanSet shifted by the specified amount, sharing the encoded data
+     *
+     * @param offset integer extent which specifies amount to offset in x and y
+     */
+    CompactSpanSet shiftedBy(lsst::geom::Extent2I const &offset) const;
+
+    /** Return a CompactSpanSet which has all pixels inside the specified box
+     *
+     * The encoded data are shared if the box already contains all the pixels.
+     *
+     * @param box Integer box specifying the bounds for which all pixels must be within
+     */
+    CompactSpanSet clippedTo(lsst::geom::Box2I const &box) const;
+
+    /// Return true if both objects contain the same Spans in the same order
+    bool operator==(CompactSpanSet const &other) const;
+    bool operator!=(CompactSpanSet const &other) const { return !(*this == other); }
+
+    /** Apply functor on individual elements from the supplied parameters
+     *
+     * See SpanSet::applyFunctor for the types of arguments supported.
+     *
+     * @param func Functor that is to be applied on each of the values taken from ...args.
+     * @param ...args Variadic arguments, may be of type Image, MaskedImage, ndarrays, numeric values
+     *                and iterators.
+     */
+    template <typename Functor, typename... Args>
+    void applyFunctor(Functor &&func, Args &&... args) const {
+        applyFunctorImpl(func, details::makeGetter(args)...);
+    }
+
+private:
+    // Encoded spans, with coordinates relative to origin
+    struct Data {
+        std::vector<std::uint8_t> bytes;
+        std::size_t nSpans;
+        lsst::geom::Point2I origin;
+    };
+
+    CompactSpanSet(std::shared_ptr<Data const> data, lsst::geom::Extent2I const &offset,
+                   lsst::geom::Box2I const &bbox, std::size_t area);
+
+    template <typename Container>
+    static CompactSpanSet _encode(Container const &spans);
+
+    template <typename F, typename... T>
+    void applyFunctorImpl(F &&f, T... args) const {
+        details::variadicBoundChecker(_bbox, _area, args...);
+        for (auto const &spn : *this) {
+            details::variadicSpanSetter(spn, args...);
+            for (int x = spn.getX0(); x <= spn.getX1(); ++x) {
+                lsst::geom::Point2I point(x, spn.getY());
+                f(point, args.get()...);
+                details::variadicIncrementPosition(args...);
+            }
+        }
+    }
+
+    std::shared_ptr<Data const> _data;
+    // Shift applied to the encoded coordinates on top of the origin
+    lsst::geom::Extent2I _offset;
+    lsst::geom::Box2I _bbox;
+    std::size_t _area;
+};
+}  // namespace geom
+}  // namespace afw
+}  // namespace lsst
+
+#endif  // LSST_AFW_GEOM_COMPACTSPANSET_H
@@ -27,10 +27,12 @@
 
 #include <vector>
 #include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <utility>
 #include "lsst/pex/exceptions.h"
+#include "lsst/afw/detail/parallel.h"
 #include "lsst/afw/geom/Span.h"
 #include "lsst/geom/Box.h"
 #include "lsst/afw/image/Mask.h"
@@ -55,6 +57,67 @@ public:
     bool operator()(T pixelValue) { return pixelValue != 0; }
 };
 
+inline int countTrailingZeros(std::uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#else
+    int n = 0;
+    while (!(x & 1u)) {
+        x >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+/* Append to spans the runs of pixels in row[0, width) which have any of the bits in bitmask set
+ * (or none of them, if invert is true), as Spans on row y with the first pixel at column x0.
+ *
+ * The row is processed in blocks of 64 pixels. For each block the comparisons are first packed into
+ * the bits of a single word, in a loop simple enough for the compiler to vectorize, and run boundaries
+ * are then found by counting trailing zeros, so blocks without any boundary cost a single test.
+ */
+template <bool invert, typename T>
+void appendMaskRuns(T const *row, int width, T bitmask, int y, int x0, std::vector<Span> &spans) {
+    bool inSpan = false;
+    int start = 0;
+    for (int block = 0; block < width; block += 64) {
+        int const n = std::min(64, width - block);
+        T const *pixels = row + block;
+        std::uint64_t bits = 0;
+        for (int k = 0; k < n; ++k) {
+            bits |= static_cast<std::uint64_t>(((pixels[k] & bitmask) != 0) != invert) << k;
+        }
+        std::uint64_t const valid = (n == 64) ? ~std::uint64_t(0) : ((std::uint64_t(1) << n) - 1);
+        int pos = 0;
+        while (pos < n) {
+            std::uint64_t const ahead = valid & (~std::uint64_t(0) << pos);
+            if (inSpan) {
+                // Look for the first pixel which ends the current span
+                std::uint64_t const ends = ~bits & ahead;
+                if (!ends) {
+                    break;
+                }
+                pos = countTrailingZeros(ends);
+                spans.push_back(Span(y, x0 + start, x0 + block + pos - 1));
+                inSpan = false;
+            } else {
+                // Look for the first pixel which starts a new span
+                std::uint64_t const starts = bits & ahead;
+                if (!starts) {
+                    break;
+                }
+                pos = countTrailingZeros(starts);
+                start = block + pos;
+                inSpan = true;
+            }
+        }
+    }
+    if (inSpan) {
+        spans.push_back(Span(y, x0 + start, x0 + width - 1));
+    }
+}
+
 }  // namespace details
 
 /** An enumeration class which describes the shapes
@@ -298,18 +361,19 @@ public:
      *
      * @param input The ndarray from which the values will be taken
      * @param xy0 A point object with is used as the origin point for the SpanSet coordinate system
+     * @param nThreads Number of threads to use, see applyFunctorParallel. Defaults to 1 (serial)
      */
     template <typename Pixel, int inN, int inC>
     ndarray::Array<typename std::remove_const<Pixel>::type, inN - 1, inN - 1> flatten(
             ndarray::Array<Pixel, inN, inC> const &input,
-            lsst::geom::Point2I const &xy0 = lsst::geom::Point2I()) const {
+            lsst::geom::Point2I const &xy0 = lsst::geom::Point2I(), int nThreads = 1) const {
         // Populate a lower dimensional array with the values from input taken at the points of SpanSet
         auto outputShape = ndarray::concatenate(ndarray::makeVector(getArea()),
                                                 input.getShape().template last<inN - 2>());
         ndarray::Array<typename std::remove_const<Pixel>::type, inN - 1, inN - 1> outputArray =
                 ndarray::allocate(outputShape);
         outputArray.deep() = 0;
-        flatten(outputArray, input, xy0);
+        flatten(outputArray, input, xy0, nThreads);
         return outputArray;
     }
 
@@ -331,16 +395,17 @@ public:
      * @param[out] output The 1d ndarray which will be populated with output parameters, will happen in place
      * @param[in] input The ndarray from which the values will be taken
      * @param[in] xy0 A point object which is used as the origin point for the SpanSet coordinate system
+     * @param[in] nThreads Number of threads to use, see applyFunctorParallel. Defaults to 1 (serial)
      */
     template <typename PixelIn, typename PixelOut, int inA, int outC, int inC>
     void flatten(ndarray::Array<PixelOut, inA - 1, outC> const &output,
                  ndarray::Array<PixelIn, inA, inC> const &input,
-                 lsst::geom::Point2I const &xy0 = lsst::geom::Point2I()) const {
+                 lsst::geom::Point2I const &xy0 = lsst::geom::Point2I(), int nThreads = 1) const {
         auto ndAssigner = [](lsst::geom::Point2I const &point,
                              typename details::FlatNdGetter<PixelOut, inA - 1, outC>::Reference out,
                              typename details::ImageNdGetter<PixelIn, inA, inC>::Reference in) { out = in; };
         // Populate array output with values from input at positions given by SpanSet
-        applyFunctor(ndAssigner, ndarray::ndFlat(output), ndarray::ndImage(input, xy0));
+        applyFunctorParallel(nThreads, ndAssigner, ndarray::ndFlat(output), ndarray::ndImage(input, xy0));
     }
 
     /** Expand an array by one spatial dimension at points given by SpanSet
@@ -355,10 +420,11 @@ public:
      * @tparam inC Number of guaranteed row-major contiguous dimensions, starting from the end
      *
      * @param input The ndarray from which the values will be taken
+     * @param nThreads Number of threads to use, see applyFunctorParallel. Defaults to 1 (serial)
      */
     template <typename Pixel, int inA, int inC>
     ndarray::Array<typename std::remove_const<Pixel>::type, inA + 1, inA + 1> unflatten(
-            ndarray::Array<Pixel, inA, inC> const &input) const {
+            ndarray::Array<Pixel, inA, inC> const &input, int nThreads = 1) const {
         // Create a higher dimensional array the size of the bounding box and extra dimensions of input.
         // Populate values from input, placed at locations corresponding to SpanSet, offset by the
         // lower corner of the bounding box
@@ -370,7 +436,7 @@ public:
         ndarray::Array<typename std::remove_const<Pixel>::type, inA + 1, inA + 1> outputArray =
                 ndarray::allocate(outputShape);
         outputArray.deep() = 0;
-        unflatten(outputArray, input, lsst::geom::Point2I(_bbox.getMinX(), _bbox.getMinY()));
+        unflatten(outputArray, input, lsst::geom::Point2I(_bbox.getMinX(), _bbox.getMinY()), nThreads);
         return outputArray;
     }
 
@@ -392,17 +458,18 @@ public:
     * @param[out] output The 1d ndarray which will be populated with output parameters, will happen in place
     * @param[in] input The ndarray from which the values will be taken
     * @param[in] xy0 A point object with is used as the origin point for the SpanSet coordinate system
+    * @param[in] nThreads Number of threads to use, see applyFunctorParallel. Defaults to 1 (serial)
     */
     template <typename PixelIn, typename PixelOut, int inA, int outC, int inC>
     void unflatten(ndarray::Array<PixelOut, inA + 1, outC> const &output,
                    ndarray::Array<PixelIn, inA, inC> const &input,
-                   lsst::geom::Point2I const &xy0 = lsst::geom::Point2I()) const {
+                   lsst::geom::Point2I const &xy0 = lsst::geom::Point2I(), int nThreads = 1) const {
         // Populate 2D ndarray output with values from input, at locations defined by SpanSet, optionally
         // offset by xy0
         auto ndAssigner = [](lsst::geom::Point2I const &point,
                              typename details::ImageNdGetter<PixelOut, inA + 1, outC>::Reference out,
                              typename details::FlatNdGetter<PixelIn, inA, inC>::Reference in) { out = in; };
-        applyFunctor(ndAssigner, ndarray::ndImage(output, xy0), ndarray::ndFlat(input));
+        applyFunctorParallel(nThreads, ndAssigner, ndarray::ndImage(output, xy0), ndarray::ndFlat(input));
     }
 
     /** Copy contents of source Image into destination image at the positions defined in the SpanSet
@@ -521,6 +588,38 @@ public:
         applyFunctorImpl(func, details::makeGetter(args)...);
     }
 
+    /** Apply functor on individual elements from the supplied parameters, using several threads
+     *
+     * This behaves like applyFunctor, but the Spans are partitioned into contiguous ranges of rows of
+     * roughly equal area, and each range is handed to its own thread. Rows are never split between
+     * threads, and one dimensional arguments (ndarray::ndFlat, iterators) are advanced to the
+     * correct flat position for the first pixel of each range, so the result is identical to that of
+     * applyFunctor.
+     *
+     * Because the functor is invoked concurrently it must be safe to do so, i.e. it may only write to
+     * the values passed to it (or otherwise synchronize its side effects), and its result must not
+     * depend on the order in which rows are visited. Execution falls back to a single thread when
+     * fewer than parallelMinArea pixels would be given to each thread, when any of the arguments is an
+     * iterator that is not random access (which could only be advanced to each thread's first pixel
+     * one element at a time), or when any is an ndarray with more than two dimensions (whose elements
+     * are array views that cannot be created concurrently). If the functor throws, all threads are
+     * joined and the first exception is rethrown.
+     *
+     * @tparam ...Args Variadic type specification
+     *
+     * @param nThreads Maximum number of threads to use; values less than one use the number of
+     *                 hardware threads available.
+     * @param func Functor that is to be applied on each of the values taken from ...args.
+     * @param ...args Variadic arguments, as for applyFunctor.
+     */
+    template <typename Functor, typename... Args>
+    void applyFunctorParallel(int nThreads, Functor &&func, Args &&... args) const {
+        applyFunctorParallelImpl(nThreads, func, details::makeGetter(args)...);
+    }
+
+    /// Minimum number of pixels each thread must be given before applyFunctorParallel uses it
+    static constexpr std::size_t parallelMinArea = 1 << 14;
+
     /** Set a Mask at pixels defined by the SpanSet
      *
      * @tparam T data-type of a pixel in the Mask plane
@@ -548,6 +647,15 @@ public:
      */
     std::shared_ptr<SpanSet> intersect(SpanSet const &other) const;
 
+    /** Determine the common points between a SpanSet and each of several other SpanSets
+     *
+     * @param others The SpanSets with which to intersect
+     *
+     * @returns a vector with the intersection with each of others, in the same order
+     */
+    std::vector<std::shared_ptr<SpanSet>> intersect(
+            std::vector<std::shared_ptr<SpanSet>> const &others) const;
+
     /** Determine the common points between a SpanSet and a Mask with a given bit pattern
      *
      * @tparam T Pixel type of the Mask
@@ -565,6 +673,15 @@ public:
      */
     std::shared_ptr<SpanSet> intersectNot(SpanSet const &other) const;
 
+    /** Determine, for each of several SpanSets, the points of this SpanSet not contained in it
+     *
+     * @param others The SpanSets which will be logically inverted when computing the intersections
+     *
+     * @returns a vector with the intersection with the inverse of each of others, in the same order
+     */
+    std::vector<std::shared_ptr<SpanSet>> intersectNot(
+            std::vector<std::shared_ptr<SpanSet>> const &others) const;
+
     /** @brief Determine the common points between a SpanSet and the logical inverse of a Mask for a
      *  given bit pattern
      *
@@ -582,6 +699,15 @@ public:
      */
     std::shared_ptr<SpanSet> union_(SpanSet const &other) const;
 
+    /** Create, for each of several SpanSets, a new SpanSet containing all points of it and of this
+     *
+     * @param others The SpanSets from which the unions will be calculated
+     *
+     * @returns a vector with the union with each of others, in the same order
+     */
+    std::vector<std::shared_ptr<SpanSet>> union_(
+            std::vector<std::shared_ptr<SpanSet>> const &others) const;
+
     /** Determine the union between a SpanSet and a Mask for a given bit pattern
      *
      * @tparam T Pixel type of the Mask
@@ -699,7 +825,44 @@ public:
      */
     template <typename T>
     static std::shared_ptr<geom::SpanSet> fromMask(image::Mask<T> const &mask, T bitmask) {
-        return fromMask(mask, [bitmask](T const &bitPattern) { return bitPattern & bitmask; });
+        return std::move(fromMaskPlanes(mask, std::vector<T>(1, bitmask)).front());
+    }
+
+    /** Create one SpanSet per bit pattern from a mask, in a single pass over the mask
+     *
+     * This is equivalent to calling fromMask(mask, bitmask) for each element of bitmasks, but each row
+     * of the mask is only read from memory once.
+     *
+     * @tparam T Pixel type of the Mask
+     *
+     * @param mask mask to convert to SpanSets
+     * @param bitmasks bit patterns used to specify which pixels to include in each SpanSet
+     *
+     * @returns a vector of SpanSets, in the same order as bitmasks
+     */
+    template <typename T>
+    static std::vector<std::shared_ptr<geom::SpanSet>> fromMaskPlanes(image::Mask<T> const &mask,
+                                                                      std::vector<T> const &bitmasks) {
+        std::vector<std::vector<Span>> tempVecs(bitmasks.size());
+        auto const maskArray = mask.getArray();
+        auto const minPoint = mask.getBBox().getMin();
+        int const width = mask.getWidth();
+        int const height = mask.getHeight();
+        T const *rowData = maskArray.getData();
+        auto const rowStride = maskArray.template getStride<0>();
+        for (int y = 0; y < height; ++y, rowData += rowStride) {
+            for (std::size_t i = 0; i < bitmasks.size(); ++i) {
+                details::appendMaskRuns<false>(rowData, width, bitmasks[i], y + minPoint.getY(),
+                                               minPoint.getX(), tempVecs[i]);
+            }
+        }
+        std::vector<std::shared_ptr<geom::SpanSet>> result;
+        result.reserve(bitmasks.size());
+        for (auto &tempVec : tempVecs) {
+            // Runs are produced in sorted order and never touch, so there is nothing to normalize
+            result.push_back(std::make_shared<SpanSet>(std::move(tempVec), false));
+        }
+        return result;
     }
 
     /** Split a discontinuous SpanSet into multiple SpanSets which are contiguous
@@ -748,6 +911,12 @@ private:
 
     std::shared_ptr<SpanSet> makeShift(int x, int y) const;
 
+    /* Partition the Spans into at most maxChunks ranges of whole rows with roughly equal area.
+     * Returns the index of the first Span of each range followed by size(), and fills offsets
+     * with the number of pixels preceding each range.
+     */
+    std::vector<size_type> _partitionRows(std::size_t maxChunks, std::vector<std::size_t> &offsets) const;
+
     template <typename F, typename... T>
     void applyFunctorImpl(F &&f, T... args) const {
         /* Implementation for applying functors, loop over each of the spans, and then
@@ -756,17 +925,55 @@ private:
          */
         // make sure that the SpanSet is within the bounds of functor arguments
         details::variadicBoundChecker(_bbox, _area, args...);
-        for (auto const &spn : _spanVector) {
+        applyFunctorRange(f, _spanVector.cbegin(), _spanVector.cend(), args...);
+    }
+
+    template <typename F, typename... T>
+    void applyFunctorRange(F &&f, const_iterator first, const_iterator last, T &... args) const {
+        for (auto spn = first; spn != last; ++spn) {
             // Set the current span in the getter, useful for optimizing value lookups
-            details::variadicSpanSetter(spn, args...);
-            for (int x = spn.getX0(); x <= spn.getX1(); ++x) {
-                lsst::geom::Point2I point(x, spn.getY());
+            details::variadicSpanSetter(*spn, args...);
+            for (int x = spn->getX0(); x <= spn->getX1(); ++x) {
+                lsst::geom::Point2I point(x, spn->getY());
                 f(point, args.get()...);
                 details::variadicIncrementPosition(args...);
             }
         }
     }
 
+    template <typename F, typename... T>
+    void applyFunctorParallelImpl(int nThreads, F &&f, T... args) const {
+        details::variadicBoundChecker(_bbox, _area, args...);
+        std::size_t maxChunks = lsst::afw::detail::getThreadCount(nThreads);
+        maxChunks = std::min(maxChunks, _area / parallelMinArea);
+        std::vector<std::size_t> offsets;
+        auto bounds = details::AllThreadSafe<T...>::value && maxChunks > 1
+                              ? _partitionRows(maxChunks, offsets)
+                              : std::vector<size_type>();
+        if (bounds.size() <= 2) {
+            applyFunctorRange(f, _spanVector.cbegin(), _spanVector.cend(), args...);
+            return;
+        }
+        // Each worker gets its own copy of the getters. The copies are made, and destroyed, on
+        // this thread so that no reference counts are touched concurrently.
+        auto makeWorker = [this, &f](const_iterator first, const_iterator last, std::size_t offset,
+                                     T... getters) {
+            return [this, &f, first, last, offset, getters...]() mutable {
+                details::variadicAdvancePosition(offset, getters...);
+                applyFunctorRange(f, first, last, getters...);
+            };
+        };
+        using Worker = decltype(makeWorker(_spanVector.cbegin(), _spanVector.cend(), 0, args...));
+        std::size_t const nChunks = bounds.size() - 1;
+        std::vector<Worker> workers;
+        workers.reserve(nChunks);
+        for (std::size_t i = 0; i < nChunks; ++i) {
+            workers.push_back(makeWorker(_spanVector.cbegin() + bounds[i], _spanVector.cbegin() + bounds[i + 1],
+                                         offsets[i], args...));
+        }
+        lsst::afw::detail::runParallel(nChunks, [&workers](std::size_t i) { workers[i](); });
+    }
+
     // Vector to hold the Spans contained in the SpanSet
     std::vector<Span> _spanVector;
 
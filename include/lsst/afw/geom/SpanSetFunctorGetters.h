@@ -27,6 +27,8 @@
 #ifndef LSST_AFW_GEOM_SPANSETFUNCTORGETTERS_H
 #define LSST_AFW_GEOM_SPANSETFUNCTORGETTERS_H
 
+#include <cstddef>
+#include <iterator>
 #include <type_traits>
 #include "lsst/afw/geom/Span.h"
 #include "lsst/geom/Point.h"
@@ -79,6 +81,32 @@ void variadicIncrementPosition(T& first, Args&... x) {
     variadicIncrementPosition(x...);
 }
 
+template <typename T>
+void variadicAdvancePosition(std::size_t n, T& x) {
+    x.advance(n);
+}
+
+template <typename T, typename... Args>
+void variadicAdvancePosition(std::size_t n, T& first, Args&... x) {
+    variadicAdvancePosition(n, first);
+    variadicAdvancePosition(n, x...);
+}
+
+/* Compile time check that every getter in a parameter pack may be driven from
+ * several threads at once (after being copied on the calling thread). Getters
+ * whose references are ndarray views are not, because creating those views
+ * touches the (non-atomic) reference count shared by all copies of the array.
+ */
+template <typename... Args>
+struct AllThreadSafe;
+
+template <>
+struct AllThreadSafe<> : std::true_type {};
+
+template <typename T, typename... Args>
+struct AllThreadSafe<T, Args...>
+        : std::integral_constant<bool, T::isThreadSafe && AllThreadSafe<Args...>::value> {};
+
 /* Getter classes exist to provide a common API (duck-type) for accessing data from
  * different data-types. This common API is used by the SpanSets applyFunctor method
  * for passing the correct references into the supplied functor.
@@ -109,6 +137,13 @@ public:
     IterGetter& operator=(IterGetter&&) = default;
     ~IterGetter() = default;
 
+    // Each thread jumps to its first element with advance(), which is only cheap (and only safe to do
+    // on a copy of the iterator) for random-access iterators; other iterators are driven serially.
+    // Beyond that, thread safety of a generic iterator is the responsibility of the caller.
+    static constexpr bool isThreadSafe =
+            std::is_base_of<std::random_access_iterator_tag,
+                            typename std::iterator_traits<T>::iterator_category>::value;
+
     // There is no good way to check the extents of a generic iterator, so make
     // a no-op function to satisfy api
     void checkExtents(lsst::geom::Box2I const& bbox, int area) const {}
@@ -117,6 +152,8 @@ public:
 
     void increment() { ++_iter; }
 
+    void advance(std::size_t n) { std::advance(_iter, static_cast<std::ptrdiff_t>(n)); }
+
     typename std::iterator_traits<T>::reference get() const { return *_iter; }
 
 private:
@@ -136,6 +173,8 @@ public:
     ConstantGetter& operator=(ConstantGetter&&) = default;
     ~ConstantGetter() = default;
 
+    static constexpr bool isThreadSafe = true;
+
     // Constants are simply repeated, so no need to check extents, make no-op
     // function
     void checkExtents(lsst::geom::Box2I const& bbox, int area) const {}
@@ -145,6 +184,8 @@ public:
     // No need to increment, make a no-op function
     void increment() {}
 
+    void advance(std::size_t n) {}
+
     T get() const { return _const; }
 
 private:
@@ -166,6 +207,9 @@ public:
     ImageNdGetter& operator=(ImageNdGetter&&) = default;
     ~ImageNdGetter() = default;
 
+    // Each element is itself an ndarray view, which shares the parent's reference count
+    static constexpr bool isThreadSafe = false;
+
     void checkExtents(lsst::geom::Box2I const& bbox, int area) const {
         // If the bounding box lays outside the are of the image, throw an error
         lsst::geom::Box2I arrayBBox(
@@ -183,6 +227,9 @@ public:
 
     void increment() { ++_iterX; }
 
+    // Image getters are positioned by setSpan, so there is nothing to advance
+    void advance(std::size_t n) {}
+
     Reference get() { return *_iterX; }
 
 private:
@@ -191,6 +238,54 @@ private:
     typename ndarray::Array<T, N, C>::Reference::Iterator _iterX;
 };
 
+template <typename T, int C>
+class ImageNdGetter<T, 2, C> final {
+    // Getter class to manage iterating though a 2D ndarray (including the arrays of Images and Masks).
+    // Pixels are addressed directly through the data pointer and strides, so positioning the getter
+    // on a new span never creates temporary array views.
+public:
+    using Reference = T&;
+
+    ImageNdGetter(ndarray::Array<T, 2, C> const& array, lsst::geom::Point2I const& xy0)
+            : _array(array), _xy0(xy0), _stride(array.template getStride<1>()), _pixel(nullptr) {}
+
+    ImageNdGetter(ImageNdGetter const&) = default;
+    ImageNdGetter(ImageNdGetter&&) = default;
+    ImageNdGetter& operator=(ImageNdGetter const&) = default;
+    ImageNdGetter& operator=(ImageNdGetter&&) = default;
+    ~ImageNdGetter() = default;
+
+    static constexpr bool isThreadSafe = true;
+
+    void checkExtents(lsst::geom::Box2I const& bbox, int area) const {
+        // If the bounding box lays outside the are of the image, throw an error
+        lsst::geom::Box2I arrayBBox(
+                _xy0, lsst::geom::Extent2I(_array.template getSize<1>(), _array.template getSize<0>()));
+        if (!arrayBBox.contains(bbox)) {
+            throw LSST_EXCEPT(lsst::pex::exceptions::OutOfRangeError,
+                              "SpanSet bounding box lands outside array");
+        }
+    }
+
+    void setSpan(Span const& span) {
+        _pixel = _array.getData() + (span.getY() - _xy0.getY()) * _array.template getStride<0>() +
+                 (span.getMinX() - _xy0.getX()) * _stride;
+    }
+
+    void increment() { _pixel += _stride; }
+
+    // Image getters are positioned by setSpan, so there is nothing to advance
+    void advance(std::size_t n) {}
+
+    Reference get() { return *_pixel; }
+
+private:
+    ndarray::Array<T, 2, C> _array;
+    lsst::geom::Point2I _xy0;
+    std::ptrdiff_t _stride;
+    T* _pixel;
+};
+
 template <typename T, int inA, int inC>
 class FlatNdGetter final {
     // Getter class to manage iterating though an ndarray which is interpreted as a 1D image
@@ -215,10 +310,15 @@ public:
         }
     }
 
+    // Only one dimensional arrays yield plain references to their elements
+    static constexpr bool isThreadSafe = (inA == 1);
+
     void setSpan(Span const& span) {}
 
     void increment() { ++_iter; }
 
+    void advance(std::size_t n) { _iter += static_cast<std::ptrdiff_t>(n); }
+
     Reference get() const { return *_iter; }
 
 private:
@@ -424,6 +424,26 @@ public:
         return Exposure<ImageT, MaskT, VarianceT>(manager);
     }
 
+    /**
+     *  Write an Exposure to a scratch file.
+     *
+     *  @param[in] fileName      Name of the file to write.
+     *  @param[in] options       Options controlling how pixels are stored.
+     *
+     *  @see ScratchWriteOptions
+     */
+    void writeScratch(std::string const& fileName, ScratchWriteOptions const& options) const;
+
+    /// Write an Exposure to an uncompressed scratch file.
+    void writeScratch(std::string const& fileName) const;
+
+    /**
+     *  Read an Exposure from a scratch file written by writeScratch.
+     *
+     *  @param[in] fileName    Name of the file to read.
+     */
+    static Exposure readScratch(std::string const& fileName);
+
     /**
      * Return an Exposure that is a small cutout of the original.
      *
@@ -0,0 +1,143 @@
+/*
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSST_AFW_IMAGE_EXPOSURECUTOUTREADER_H
+#define LSST_AFW_IMAGE_EXPOSURECUTOUTREADER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "lsst/geom/Box.h"
+#include "lsst/afw/image/ExposureFitsReader.h"
+
+namespace lsst {
+namespace afw {
+namespace image {
+
+/**
+ * A reader for many small subimages ("cutouts") of many Exposure FITS files.
+ *
+ * Each batch of requests is grouped by file (names that resolve to the same
+ * path, such as relative and absolute names or symbolic links, are the same
+ * file), so each file's headers and Exposure components are read only once
+ * per batch, and its cutouts are read in row order, so that reads from
+ * tile-compressed images proceed through the file in order.  Decompressed
+ * tiles are not cached: RICE-compressed integer planes are decompressed by
+ * afw rather than through cfitsio's tile cache, so a tile is decompressed
+ * again for each cutout that overlaps it.  Files are spread over a number of
+ * threads, and each thread decompresses tiles on its share of the cores (see
+ * fits::setCompressionThreadLimit).  Each thread
+ * keeps a pool of open files (as ExposureFitsReaders), closing the least
+ * recently used when it is full, so later batches from the same files need
+ * not open them again.
+ *
+ * An ExposureCutoutReader may only be used by one thread at a time.
+ */
+class ExposureCutoutReader {
+public:
+    /// A cutout to read.
+    struct Request {
+        std::string fileName;     ///< Name of the file to read from.
+        lsst::geom::Box2I bbox;   ///< Bounding box of the cutout.
+    };
+
+    /**
+     * Construct a cutout reader.
+     *
+     * @param  nThreads      Number of threads to read with; zero or negative
+     *                       uses one per hardware thread.  Reading on other
+     *                       threads requires cfitsio to have been built to be
+     *                       reentrant; if it was not, one thread is used.
+     * @param  maxOpenFiles  Maximum number of files each thread keeps open.
+     */
+    explicit ExposureCutoutReader(int nThreads = 1, std::size_t maxOpenFiles = 16);
+
+    // Cutout readers are not copyable, movable, or assignable.
+    ExposureCutoutReader(ExposureCutoutReader const &) = delete;
+    ExposureCutoutReader(ExposureCutoutReader &&) = delete;
+    ExposureCutoutReader &operator=(ExposureCutoutReader const &) = delete;
+    ExposureCutoutReader &operator=(ExposureCutoutReader &&) = delete;
+
+    ~ExposureCutoutReader() noexcept;
+
+    /**
+     * Read cutouts as MaskedImages.
+     *
+     * @param  requests     The cutouts to read.
+     * @param  origin       Coordinate system convention for the requested boxes.
+     * @param  allowUnsafe  Permit reading into the requested pixel type even
+     *                      when on-disk values may overflow or truncate.
+     *
+     * @return The cutouts, in the order requested.
+     *
+     * @throws If any cutout cannot be read, the first exception encountered
+     *         is rethrown after all threads have stopped.
+     *
+     * In Python, this templated method is wrapped with an additional `dtype`
+     * argument to provide the type to read (for the image plane).
+     */
+    template <typename ImagePixelT>
+    std::vector<MaskedImage<ImagePixelT>> readMaskedImages(std::vector<Request> const &requests,
+                                                           ImageOrigin origin = PARENT,
+                                                           bool allowUnsafe = false);
+
+    /**
+     * Read cutouts as Exposures, with all the components of the files' Exposures.
+     *
+     * Cutouts from the same file share their components (other than their
+     * metadata), just as repeated reads with an ExposureFitsReader do.
+     *
+     * Arguments, return value and exceptions are as for readMaskedImages.
+     */
+    template <typename ImagePixelT>
+    std::vector<Exposure<ImagePixelT>> readExposures(std::vector<Request> const &requests,
+                                                     ImageOrigin origin = PARENT, bool allowUnsafe = false);
+
+    /// Return the number of threads used to read.
+    std::size_t getThreadCount() const noexcept { return _pools.size(); }
+
+    /// Return the maximum number of files each thread keeps open.
+    std::size_t getMaxOpenFiles() const noexcept { return _maxOpenFiles; }
+
+    /**
+     * Close all the files kept open.
+     *
+     * Open files are not checked for modification, so call this before
+     * reading again from files that may have been rewritten.
+     */
+    void closeFiles();
+
+private:
+    class ReaderPool;
+
+    template <typename T, typename ReadFunc>
+    std::vector<T> _readAll(std::vector<Request> const &requests, ReadFunc const &readOne);
+
+    std::size_t _maxOpenFiles;
+    std::vector<std::unique_ptr<ReaderPool>> _pools;  // one per thread
+};
+
+}  // namespace image
+}  // namespace afw
+}  // namespace lsst
+
+#endif  // !LSST_AFW_IMAGE_EXPOSURECUTOUTREADER_H
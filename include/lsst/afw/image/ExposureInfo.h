@@ -212,6 +212,19 @@ public:
     /// Set the exposure's transmission curve.
     void setTransmissionCurve(std::shared_ptr<TransmissionCurve const> tc) { _transmissionCurve = tc; }
 
+    /**
+     *  Set whether equal but separately allocated components (e.g. the Psfs and Wcss of CoaddInputs
+     *  records) are saved only once when this exposure is written to FITS.
+     *
+     *  Components saved this way are shared when the exposure is read back.  Disabled by default.
+     *
+     *  @see table::io::OutputArchive::setContentDeduplication
+     */
+    void setArchiveContentDeduplication(bool deduplicate) { _deduplicateArchive = deduplicate; }
+
+    /// Return whether equal components are saved only once; see setArchiveContentDeduplication().
+    bool getArchiveContentDeduplication() const { return _deduplicateArchive; }
+
     /// Get the version of FITS serialization that this ExposureInfo understands.
     static int getFitsSerializationVersion();
 
@@ -320,6 +333,7 @@ private:
     std::shared_ptr<ApCorrMap> _apCorrMap;
     std::shared_ptr<image::VisitInfo const> _visitInfo;
     std::shared_ptr<TransmissionCurve const> _transmissionCurve;
+    bool _deduplicateArchive = false;
 };
 }  // namespace image
 }  // namespace afw
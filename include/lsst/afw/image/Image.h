@@ -332,6 +332,26 @@ public:
         return Image<PixelT>(manager, hdu);
     }
 
+    /**
+     *  Write an image to a scratch file.
+     *
+     *  @param[in] fileName      Name of the file to write.
+     *  @param[in] options       Options controlling how pixels are stored.
+     *
+     *  @see ScratchWriteOptions
+     */
+    void writeScratch(std::string const& fileName, ScratchWriteOptions const& options) const;
+
+    /// Write an image to an uncompressed scratch file.
+    void writeScratch(std::string const& fileName) const;
+
+    /**
+     *  Read an Image from a scratch file written by writeScratch.
+     *
+     *  @param[in] fileName    Name of the file to read.
+     */
+    static Image readScratch(std::string const& fileName);
+
     void swap(Image& rhs);
     //
     // Operators etc.
@@ -54,6 +54,8 @@ struct ImageWriteOptions;
 }  // namespace fits
 
 namespace image {
+struct ScratchWriteOptions;
+
 namespace detail {
 //
 // Traits for image types
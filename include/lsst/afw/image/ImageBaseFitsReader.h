@@ -28,6 +28,7 @@
 #include "lsst/geom/Box.h"
 #include "lsst/daf/base/PropertyList.h"
 #include "lsst/afw/fits.h"
+#include "lsst/afw/fitsReadCache.h"
 
 namespace lsst { namespace afw { namespace image {
 
@@ -130,6 +131,22 @@ public:
         bool allowUnsafe=false
     );
 
+    /**
+     * Set whether `read` maps pixels directly from the file instead of copying them.
+     *
+     * When mapping is enabled and the HDU allows it (an uncompressed, unscaled image in a regular
+     * file, whose on-disk type matches the requested pixel type exactly; see `fits::Fits::mapImage`),
+     * the returned image is a view into a private memory mapping of just the rows it covers, so reading
+     * small subimages of a large file touches only the pages they occupy.  Images that can't be mapped
+     * are read as usual.  `readArray` always copies.
+     */
+    void setMapping(bool mapping) noexcept { _mapping = mapping; }
+
+    /**
+     * Return whether `read` maps pixels directly from the file when it can.
+     */
+    bool getMapping() const noexcept { return _mapping; }
+
     /**
      * Return the HDU this reader targets.
      */
@@ -146,13 +163,24 @@ protected:
     // be deleted through a base-class pointer.
     ~ImageBaseFitsReader() noexcept;
 
+    /**
+     * Read the image's data array, mapping it from the file if mapping is enabled and possible.
+     *
+     * Arguments are as for `readArray`.
+     */
+    template <typename T>
+    ndarray::Array<T, 2, 1> _readMappableArray(lsst::geom::Box2I const & bbox, ImageOrigin origin,
+                                               bool allowUnsafe);
+
 private:
 
     friend class MaskedImageFitsReader;
 
     bool _ownsFitsFile;
+    bool _mapping = false;
     int _hdu;
     fits::Fits * _fitsFile;
+    fits::ReadCache::FileId _cacheFile;  // empty unless headers may be shared through the read cache
     lsst::geom::Box2I _bbox;
     std::shared_ptr<daf::base::PropertyList> _metadata;
 };
@@ -437,6 +437,26 @@ public:
         return Mask<MaskPixelT>(manager, hdu);
     }
 
+    /**
+     *  Write a mask to a scratch file.
+     *
+     *  @param[in] fileName      Name of the file to write.
+     *  @param[in] options       Options controlling how pixels are stored.
+     *
+     *  @see ScratchWriteOptions
+     */
+    void writeScratch(std::string const& fileName, ScratchWriteOptions const& options) const;
+
+    /// Write a mask to an uncompressed scratch file.
+    void writeScratch(std::string const& fileName) const;
+
+    /**
+     *  Read a Mask from a scratch file written by writeScratch.
+     *
+     *  @param[in] fileName    Name of the file to read.
+     */
+    static Mask readScratch(std::string const& fileName);
+
     /// Interpret a mask value as a comma-separated list of mask plane names
     static std::string interpret(MaskPixelT value);
     std::string getAsString(int x, int y) { return interpret((*this)(x, y)); }
@@ -523,6 +543,7 @@ public:
 private:
 
     friend class MaskFitsReader;
+    friend class ScratchFileReader;
 
     std::shared_ptr<detail::MaskDict> _maskDict;  // our bitplane dictionary
 
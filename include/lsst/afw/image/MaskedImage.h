@@ -1052,6 +1052,26 @@ public:
         return MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>(manager);
     }
 
+    /**
+     *  Write a MaskedImage to a scratch file.
+     *
+     *  @param[in] fileName      Name of the file to write.
+     *  @param[in] options       Options controlling how pixels are stored.
+     *
+     *  @see ScratchWriteOptions
+     */
+    void writeScratch(std::string const& fileName, ScratchWriteOptions const& options) const;
+
+    /// Write a MaskedImage to an uncompressed scratch file.
+    void writeScratch(std::string const& fileName) const;
+
+    /**
+     *  Read a MaskedImage from a scratch file written by writeScratch.
+     *
+     *  @param[in] fileName    Name of the file to read.
+     */
+    static MaskedImage readScratch(std::string const& fileName);
+
     // Getters
 
     /// Return a (shared_ptr to) the MaskedImage's %image
@@ -224,6 +224,23 @@ public:
         bool conformMasks=false, bool needAllHdus=false, bool allowUnsafe=false
     );
 
+    /**
+     * Set whether the image, mask, and variance are mapped directly from the file instead of copied,
+     * where possible.
+     *
+     * @see ImageBaseFitsReader::setMapping
+     */
+    void setMapping(bool mapping) noexcept {
+        _imageReader.setMapping(mapping);
+        _maskReader.setMapping(mapping);
+        _varianceReader.setMapping(mapping);
+    }
+
+    /**
+     * Return whether pixels are mapped directly from the file when possible.
+     */
+    bool getMapping() const noexcept { return _imageReader.getMapping(); }
+
     /**
      * Return the name of the file this reader targets.
      */
@@ -235,6 +252,8 @@ private:
 
     fits::Fits * _getFitsFile() { return _imageReader._fitsFile; }
 
+    fits::ReadCache::FileId const & _getCacheFile() const { return _imageReader._cacheFile; }
+
     std::shared_ptr<daf::base::PropertyList> _imageMetadata;
     std::shared_ptr<daf::base::PropertyList> _maskMetadata;
     std::shared_ptr<daf::base::PropertyList> _varianceMetadata;
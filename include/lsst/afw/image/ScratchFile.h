@@ -0,0 +1,270 @@
+/*
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSST_AFW_IMAGE_SCRATCHFILE_H
+#define LSST_AFW_IMAGE_SCRATCHFILE_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "lsst/geom/Box.h"
+#include "lsst/afw/image/Exposure.h"
+
+namespace lsst {
+namespace afw {
+namespace image {
+
+/**
+ * Options for writing scratch files.
+ *
+ * Scratch files are an afw-specific binary format for intermediate data that
+ * is written and read back by the same software, where the cost of FITS
+ * (2880-byte blocking, big-endian pixels, header formatting and parsing)
+ * isn't worth paying.  Pixels are stored little-endian and aligned, so
+ * uncompressed planes can be mapped directly into memory; compressed planes
+ * are split into tiles of rows, so subimages need only decompress the tiles
+ * they overlap.  All compression is lossless: everything read from a scratch
+ * file is exactly what was written.
+ *
+ * Scratch files are not an archival or interchange format, and files written
+ * by one version of afw are not guaranteed to be readable by another.
+ */
+struct ScratchWriteOptions {
+    /// Compression applied to each tile of pixels.
+    enum Compression {
+        NONE = 0,  ///< Uncompressed; planes may be read by mapping the file.
+        GZIP = 1,  ///< Byte-shuffled and deflate-compressed (with zlib).
+    };
+
+    Compression compression;  ///< Compression of pixel planes.
+    int tileRows;             ///< Number of rows in each compressed tile; <= 0 for one tile per plane.
+
+    explicit ScratchWriteOptions(Compression compression_ = NONE, int tileRows_ = 64)
+            : compression(compression_), tileRows(tileRows_) {}
+};
+
+/**
+ * Write an Image to a scratch file.
+ *
+ * @param[in] fileName  Name of the file to write; it is replaced if it exists.
+ * @param[in] image     Image to write.
+ * @param[in] options   Options controlling how pixels are stored.
+ */
+template <typename PixelT>
+void writeScratch(std::string const& fileName, Image<PixelT> const& image,
+                  ScratchWriteOptions const& options = ScratchWriteOptions());
+
+/**
+ * Write a Mask, including its mask plane definitions, to a scratch file.
+ *
+ * Arguments are as for the Image overload.
+ */
+template <typename MaskPixelT>
+void writeScratch(std::string const& fileName, Mask<MaskPixelT> const& mask,
+                  ScratchWriteOptions const& options = ScratchWriteOptions());
+
+/**
+ * Write a MaskedImage to a scratch file.
+ *
+ * Arguments are as for the Image overload.
+ */
+template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
+void writeScratch(std::string const& fileName,
+                  MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT> const& maskedImage,
+                  ScratchWriteOptions const& options = ScratchWriteOptions());
+
+/**
+ * Write an Exposure to a scratch file.
+ *
+ * The Exposure's components are saved with the same table::io archive
+ * (stored as a small embedded FITS file) as Exposure::writeFits, so they
+ * are read back just as they would be from a FITS file.
+ *
+ * Arguments are as for the Image overload.
+ */
+template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
+void writeScratch(std::string const& fileName,
+                  Exposure<ImagePixelT, MaskPixelT, VariancePixelT> const& exposure,
+                  ScratchWriteOptions const& options = ScratchWriteOptions());
+
+/**
+ * A reader for scratch files written by writeScratch.
+ *
+ * Pixels must be read with exactly the type they were written with.  Mapping
+ * is disabled by default; when enabled, uncompressed planes are returned as
+ * private mappings of the file (so they may be modified without affecting
+ * it), which must not be truncated or rewritten while they are in use.
+ *
+ * @see ScratchWriteOptions
+ */
+class ScratchFileReader final {
+public:
+    /**
+     * Open a scratch file and read its table of contents.
+     *
+     * @throws pex::exceptions::IoError if the file cannot be opened or is not a scratch file.
+     */
+    explicit ScratchFileReader(std::string const& fileName);
+
+    // Scratch file readers are not copyable, movable, or assignable.
+    ScratchFileReader(ScratchFileReader const&) = delete;
+    ScratchFileReader(ScratchFileReader&&) = delete;
+    ScratchFileReader& operator=(ScratchFileReader const&) = delete;
+    ScratchFileReader& operator=(ScratchFileReader&&) = delete;
+
+    ~ScratchFileReader() noexcept;
+
+    /// Return the name of the file this reader is reading.
+    std::string getFileName() const { return _fileName; }
+
+    /// Read the bounding box of the image(s) in the file.
+    lsst::geom::Box2I readBBox(ImageOrigin origin = PARENT) const;
+
+    /**
+     * Return a numpy-like description of the type of the image plane (or
+     * the mask, for a file holding only a Mask), e.g. "float32".
+     */
+    std::string readImageDType() const;
+
+    /// Return whether the file has a mask plane.
+    bool hasMask() const;
+
+    /// Return whether the file has a variance plane.
+    bool hasVariance() const;
+
+    /// Return whether the file has Exposure components.
+    bool hasExposureInfo() const;
+
+    /// Set whether uncompressed planes are read by mapping the file.
+    void setMapping(bool mapping) { _mapping = mapping; }
+
+    /// Return whether uncompressed planes are read by mapping the file.
+    bool getMapping() const { return _mapping; }
+
+    /**
+     * Read the image plane.
+     *
+     * @param  bbox    A bounding box used to defined a subimage, or an empty
+     *                 box (default) to read the whole image.
+     * @param  origin  Coordinate system convention for the given box.
+     *
+     * In Python, this templated method is wrapped with an additional `dtype`
+     * argument to provide the type to read.  This defaults to the type of the
+     * stored image, which is the only type that can be read.
+     */
+    template <typename ImagePixelT>
+    Image<ImagePixelT> readImage(lsst::geom::Box2I const& bbox = lsst::geom::Box2I(),
+                                 ImageOrigin origin = PARENT);
+
+    /**
+     * Read the mask plane.
+     *
+     * @param  bbox          A bounding box used to defined a subimage, or an
+     *                       empty box (default) to read the whole image.
+     * @param  origin        Coordinate system convention for the given box.
+     * @param  conformMasks  If True, conform the global mask dict to match
+     *                       this file.
+     */
+    template <typename MaskPixelT>
+    Mask<MaskPixelT> readMask(lsst::geom::Box2I const& bbox = lsst::geom::Box2I(),
+                              ImageOrigin origin = PARENT, bool conformMasks = false);
+
+    /**
+     * Read the variance plane.
+     *
+     * Arguments are as for readImage.
+     */
+    template <typename VariancePixelT>
+    Image<VariancePixelT> readVariance(lsst::geom::Box2I const& bbox = lsst::geom::Box2I(),
+                                       ImageOrigin origin = PARENT);
+
+    /**
+     * Read a MaskedImage.
+     *
+     * Arguments are as for readMask.  A file holding only an Image yields a
+     * MaskedImage with an empty mask and variance.
+     */
+    template <typename ImagePixelT, typename MaskPixelT = MaskPixel, typename VariancePixelT = VariancePixel>
+    MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT> readMaskedImage(
+            lsst::geom::Box2I const& bbox = lsst::geom::Box2I(), ImageOrigin origin = PARENT,
+            bool conformMasks = false);
+
+    /**
+     * Read the Exposure components.
+     *
+     * @returns the components, or an empty ExposureInfo if the file has none.
+     */
+    std::shared_ptr<ExposureInfo> readExposureInfo();
+
+    /**
+     * Read an Exposure.
+     *
+     * Arguments are as for readMask.
+     */
+    template <typename ImagePixelT, typename MaskPixelT = MaskPixel, typename VariancePixelT = VariancePixel>
+    Exposure<ImagePixelT, MaskPixelT, VariancePixelT> readExposure(
+            lsst::geom::Box2I const& bbox = lsst::geom::Box2I(), ImageOrigin origin = PARENT,
+            bool conformMasks = false);
+
+private:
+    // Description of a plane or blob in the file.
+    struct Section {
+        std::uint32_t kind;
+        std::uint32_t pixelType;
+        lsst::geom::Box2I bbox;
+        std::uint32_t compression;
+        std::uint32_t tileRows;
+        std::uint64_t offset;
+        std::uint64_t size;
+    };
+
+    Section const* _findSection(std::uint32_t kind) const;
+
+    Section const& _getSection(std::uint32_t kind) const;
+
+    // Return the image plane, or the mask plane if there is no image plane.
+    Section const& _getImageOrMaskSection() const;
+
+    // Return the subimage of a plane to read, in PARENT coordinates, checking that it is in the plane.
+    lsst::geom::Box2I _getSubBBox(Section const& section, lsst::geom::Box2I const& bbox,
+                                  ImageOrigin origin) const;
+
+    // Read the given pixels (in PARENT coordinates) of a plane, checking their type.
+    template <typename T>
+    ndarray::Array<T, 2, 1> _readArray(Section const& section, lsst::geom::Box2I const& subBBox);
+
+    detail::MaskPlaneDict _readMaskPlanes() const;
+
+    void _readBytes(void* buffer, std::size_t nBytes, std::uint64_t offset) const;
+
+    std::string _fileName;
+    int _fd;
+    bool _mapping;
+    std::vector<Section> _sections;
+};
+
+}  // namespace image
+}  // namespace afw
+}  // namespace lsst
+
+#endif  // !LSST_AFW_IMAGE_SCRATCHFILE_H
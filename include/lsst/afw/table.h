@@ -8,6 +8,9 @@
 #include "lsst/afw/table/Exposure.h"
 #include "lsst/afw/table/Match.h"
 #include "lsst/afw/table/BaseColumnView.h"
+#include "lsst/afw/table/CompactCatalog.h"
+#include "lsst/afw/table/CatalogIndex.h"
+#include "lsst/afw/table/Predicate.h"
 #include "lsst/afw/table/FunctorKey.h"
 #include "lsst/afw/table/aggregates.h"
 #include "lsst/afw/table/arrays.h"
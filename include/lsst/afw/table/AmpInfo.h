@@ -165,6 +165,8 @@ protected:
     friend class AmpInfoTable;
 
     explicit AmpInfoRecord(std::shared_ptr<AmpInfoTable> const &table);
+
+    AmpInfoRecord(std::shared_ptr<AmpInfoTable> const &table, detail::RecordView const &view);
 };
 
 /**
@@ -282,6 +284,8 @@ protected:
 
     std::shared_ptr<BaseRecord> _makeRecord() override;
 
+    std::shared_ptr<BaseRecord> _makeRecordView(detail::RecordView const &view) override;
+
 private:
     // Struct that holds the minimal schema and the special keys we've added to it.
     struct MinimalSchema {
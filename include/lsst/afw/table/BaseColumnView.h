@@ -71,6 +71,9 @@ private:
  *  no deletions).  It also requires that those records be allocated in the same block,
  *  which can be guaranteed with BaseTable::preallocate().
  *
+ *  Columns of a table in columnar mode (see BaseTable::setColumnar()) have unit stride for scalar
+ *  fields; otherwise consecutive elements of a column are separated by the size of a record.
+ *
  *  Geometric (point and shape) fields cannot be accessed through a BaseColumnView, but their
  *  scalar components can be.
  *
@@ -88,6 +91,9 @@ public:
     /// Return the schema that defines the fields.
     Schema getSchema() const { return getTable()->getSchema(); }
 
+    /// Return the number of records in the view.
+    std::size_t size() const;
+
     /// Return a 1-d array corresponding to a scalar field (or subfield).
     template <typename T>
     ndarray::ArrayRef<T, 1> const operator[](Key<T> const& key) const;
@@ -156,10 +162,12 @@ public:
 
 protected:
     BaseColumnView(std::shared_ptr<BaseTable> const& table, int recordCount, void* buf,
-                   ndarray::Manager::Ptr const& manager);
+                   ndarray::Manager::Ptr const& manager, detail::ColumnLayout const* columns = nullptr,
+                   std::size_t firstRow = 0, std::size_t capacity = 0);
 
 private:
     friend class BaseTable;
+    friend class detail::Access;
 
     struct Impl;
 
@@ -204,14 +212,20 @@ BaseColumnView BaseColumnView::make(std::shared_ptr<BaseTable> const& table, Inp
     std::size_t recordCount = 1;
     void* buf = first->_data;
     ndarray::Manager::Ptr manager = first->_manager;
+    detail::ColumnLayout const* columns = first->_columns;
+    std::size_t firstRow = first->_row;
+    std::size_t capacity = first->_capacity;
     char* expected = reinterpret_cast<char*>(buf) + recordSize;
     for (++first; first != last; ++first, ++recordCount, expected += recordSize) {
-        if (first->_data != expected || first->_manager != manager) {
+        // Columnar records in the same block share _data, and are contiguous if their rows are.
+        bool const follows = columns ? (first->_data == buf && first->_row == firstRow + recordCount)
+                                     : first->_data == expected;
+        if (!follows || first->_manager != manager || first->_columns != columns) {
             throw LSST_EXCEPT(lsst::pex::exceptions::RuntimeError,
                               "Record data is not contiguous in memory.");
         }
     }
-    return BaseColumnView(table, recordCount, buf, manager);
+    return BaseColumnView(table, recordCount, buf, manager, columns, firstRow, capacity);
 }
 
 template <typename InputIterator>
@@ -223,9 +237,13 @@ bool BaseColumnView::isRangeContiguous(std::shared_ptr<BaseTable> const& table,
     std::size_t recordCount = 1;
     void* buf = first->_data;
     ndarray::Manager::Ptr manager = first->_manager;
+    detail::ColumnLayout const* columns = first->_columns;
+    std::size_t firstRow = first->_row;
     char* expected = reinterpret_cast<char*>(buf) + recordSize;
     for (++first; first != last; ++first, ++recordCount, expected += recordSize) {
-        if (first->_data != expected || first->_manager != manager) {
+        bool const follows = columns ? (first->_data == buf && first->_row == firstRow + recordCount)
+                                     : first->_data == expected;
+        if (!follows || first->_manager != manager || first->_columns != columns) {
             return false;
         }
     }
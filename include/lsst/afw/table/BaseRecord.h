@@ -3,17 +3,39 @@
 #define AFW_TABLE_BaseRecord_h_INCLUDED
 
 #include <iosfwd>
+#include <vector>
 
 #include "lsst/base.h"
 #include "lsst/afw/table/fwd.h"
 #include "lsst/afw/table/Schema.h"
 #include "lsst/afw/table/BaseTable.h"
 #include "lsst/afw/table/FunctorKey.h"
+#include "lsst/afw/table/detail/ColumnLayout.h"
 
 namespace lsst {
 namespace afw {
 namespace table {
 
+namespace detail {
+
+struct RecordCopyPlan;
+
+/**
+ *  Copy field values from each input record to the corresponding output record using a mapper,
+ *  as with BaseRecord::assign(other, mapper).
+ *
+ *  The schemas are checked once per table rather than once per record, and the records are divided
+ *  between nThreads threads (nThreads <= 0 uses one per hardware thread).  Every output record must
+ *  be distinct.
+ *
+ *  @throws lsst::pex::exceptions::LengthError if the vectors have different sizes.
+ *  @throws lsst::pex::exceptions::LogicError if a record's schema does not contain the mapper's.
+ */
+void assignRecords(std::vector<BaseRecord const*> const& inputs, std::vector<BaseRecord*> const& outputs,
+                   SchemaMapper const& mapper, int nThreads = 1);
+
+}  // namespace detail
+
 /**
  *  Base class for all records.
  *
@@ -70,8 +92,7 @@ public:
                     pex::exceptions::LogicError,
                     "Key is not valid (if this is a SourceRecord, make sure slot aliases have been set up).");
         }
-        return reinterpret_cast<typename Field<T>::Element*>(reinterpret_cast<char*>(_data) +
-                                                             key.getOffset());
+        return reinterpret_cast<typename Field<T>::Element*>(_getElementData(key.getOffset()));
     }
 
     /**
@@ -88,8 +109,7 @@ public:
                     pex::exceptions::LogicError,
                     "Key is not valid (if this is a SourceRecord, make sure slot aliases have been set up).");
         }
-        return reinterpret_cast<typename Field<T>::Element const*>(reinterpret_cast<char const*>(_data) +
-                                                                   key.getOffset());
+        return reinterpret_cast<typename Field<T>::Element const*>(_getElementData(key.getOffset()));
     }
 
     /**
@@ -186,18 +206,60 @@ protected:
     /// additional fields on new lines, with the syntax "%(name)s: %(value)s".
     virtual void _stream(std::ostream& os) const;
 
+    /**
+     *  Called when a record view is moved to other field data (see CompactCatalogT), to allow
+     *  subclasses to reset data members that are not fields.
+     */
+    virtual void _resetView() {}
+
     /// Construct a record with uninitialized data.
     BaseRecord(std::shared_ptr<BaseTable> const& table) : daf::base::Citizen(typeid(this)), _table(table) {
         table->_initialize(*this);
     }
 
+    /// Construct a record that is a view of existing field data; see BaseTable::_makeRecordView.
+    BaseRecord(std::shared_ptr<BaseTable> const& table, detail::RecordView const& view)
+            : daf::base::Citizen(typeid(this)),
+              _data(view.data),
+              _columns(nullptr),
+              _row(0),
+              _capacity(0),
+              _view(true),
+              _table(table),
+              _manager(view.manager) {}
+
 private:
     friend class BaseTable;
     friend class BaseColumnView;
+    friend class detail::Access;
+    friend void detail::assignRecords(std::vector<BaseRecord const*> const&, std::vector<BaseRecord*> const&,
+                                      SchemaMapper const&, int);
+
+    // Point a record view at other field data.
+    void _setView(detail::RecordView const& view) {
+        _data = view.data;
+        _manager = view.manager;
+        _resetView();
+    }
+
+    // Copy the fields mapped by a compiled SchemaMapper, without checking schemas.
+    void _assignMapped(BaseRecord const& other, SchemaMapper const& mapper,
+                       detail::RecordCopyPlan const& plan);
+
+    // Return the address of the data at the given row-major offset.
+    char* _getElementData(int offset) const {
+        char* data = reinterpret_cast<char*>(_data);
+        if (_columns) return _columns->getElement(data, _capacity, _row, offset);
+        return data + offset;
+    }
 
     // All these are definitely private, not protected - we don't want derived classes mucking with them.
-    void* _data;                        // pointer to field data
-    std::shared_ptr<BaseTable> _table;  // the associated table
+    void* _data;                           // pointer to field data (the whole block, for columnar records)
+    detail::ColumnLayout const* _columns;  // layout of a columnar block; null for row-major records
+    std::size_t _row;                      // index of a columnar record in its block
+    std::size_t _capacity;                 // number of records a columnar record's block can hold
+    bool _view;                            // true if the field data is owned by something else
+    std::shared_ptr<BaseTable> _table;     // the associated table
     ndarray::Manager::Ptr _manager;  // shared manager for lifetime of _data (like shared_ptr with no pointer)
 };
 }  // namespace table
@@ -8,6 +8,7 @@
 #include "ndarray/Manager.h"
 #include "lsst/afw/table/fwd.h"
 #include "lsst/afw/table/Schema.h"
+#include "lsst/afw/table/detail/ColumnLayout.h"
 
 namespace lsst {
 namespace afw {
@@ -20,6 +21,22 @@ class Fits;
 
 namespace table {
 
+namespace detail {
+
+class BlockCache;
+
+/**
+ *  Existing row-major field data for a record that is a view, kept alive by the manager.
+ *
+ *  Passed by BaseTable::_makeRecordView to the record constructors that make views.
+ */
+struct RecordView {
+    char* data;
+    ndarray::Manager::Ptr manager;
+};
+
+}  // namespace detail
+
 /**
  *  Base class for all tables.
  *
@@ -140,6 +157,36 @@ public:
      */
     std::size_t getBufferSize() const;
 
+    /**
+     *  Set whether new records store their fields in columnar (structure-of-arrays) form.
+     *
+     *  In columnar mode, each memory block holds a separate array for every field, so column views
+     *  of records allocated contiguously (see preallocate()) have unit stride for scalar fields,
+     *  and operations that touch only a few columns of a wide schema read only those columns.
+     *  Access to individual records is unchanged, but is slightly more expensive.
+     *
+     *  Changing the mode does not affect existing records; the next record will be allocated in a
+     *  new block.
+     */
+    void setColumnar(bool columnar);
+
+    /// Return true if new records store their fields in columnar form; see setColumnar().
+    bool isColumnar() const { return static_cast<bool>(_columns); }
+
+    /**
+     *  Set whether the memory of released blocks is reused for new ones.
+     *
+     *  When enabled, the memory of the most recent block whose records have all been destroyed is
+     *  kept by the table and given to the next block that fits in it, instead of being freed and
+     *  allocated again.  This bounds the memory used by code that repeatedly fills a catalog and
+     *  lets it go, as with io::FitsChunkReader.  Blocks are released only when none of their records
+     *  remain, so this has no effect while records from the previous block are still in use.
+     */
+    void setBlockReuse(bool reuse);
+
+    /// Return true if the memory of released blocks is reused; see setBlockReuse().
+    bool getBlockReuse() const { return _reuseBlocks; }
+
     /**
      *  Construct a new table.
      *
@@ -181,12 +228,26 @@ protected:
     /// Default-construct an associated record (protected implementation).
     virtual std::shared_ptr<BaseRecord> _makeRecord();
 
+    /**
+     *  Construct an associated record that is a view of existing field data (protected implementation).
+     *
+     *  The record neither initializes nor destroys its fields; it is used by containers (see
+     *  CompactCatalogT) that own their field data and only materialize record objects on access.
+     *  Tables with their own record class should override this along with _makeRecord, constructing
+     *  the record with its view constructor and without setting any field values.
+     */
+    virtual std::shared_ptr<BaseRecord> _makeRecordView(detail::RecordView const& view);
+
     /// Construct from a schema.
     explicit BaseTable(Schema const& schema);
 
     /// Copy construct.
     BaseTable(BaseTable const& other)
-            : daf::base::Citizen(other), _schema(other._schema), _metadata(other._metadata) {
+            : daf::base::Citizen(other),
+              _schema(other._schema),
+              _metadata(other._metadata),
+              _columns(other._columns),
+              _reuseBlocks(other._reuseBlocks) {
         if (_metadata) _metadata = std::static_pointer_cast<daf::base::PropertyList>(_metadata->deepCopy());
     }
     // Delegate to copy-constructor for backwards compatibility
@@ -196,6 +257,7 @@ private:
     friend class BaseRecord;
     friend class io::FitsWriter;
     friend class AliasMap;
+    friend class detail::Access;
 
     // Called by BaseRecord ctor to fill in its _data, _table, and _manager members.
     void _initialize(BaseRecord& record);
@@ -212,13 +274,19 @@ private:
      */
     void _destroy(BaseRecord& record);
 
+    // Return the cache of released block memory, creating it if blocks are reused; null otherwise.
+    std::shared_ptr<detail::BlockCache> const& _getBlockCache();
+
     // Return a writer object that knows how to save in FITS format.  See also FitsWriter.
     virtual std::shared_ptr<io::FitsWriter> makeFitsWriter(fits::Fits* fitsfile, int flags) const;
 
     // All these are definitely private, not protected - we don't want derived classes mucking with them.
-    Schema _schema;                                      // schema that defines the table's fields
-    ndarray::Manager::Ptr _manager;                      // current memory block to use for new records
-    std::shared_ptr<daf::base::PropertyList> _metadata;  // flexible metadata; may be null
+    Schema _schema;                                        // schema that defines the table's fields
+    ndarray::Manager::Ptr _manager;                        // current memory block to use for new records
+    std::shared_ptr<daf::base::PropertyList> _metadata;    // flexible metadata; may be null
+    std::shared_ptr<detail::ColumnLayout const> _columns;  // layout of new records; null if row-major
+    bool _reuseBlocks = false;                             // whether to keep released block memory
+    std::shared_ptr<detail::BlockCache> _blockCache;       // released block memory; not shared by clones
 };
 }  // namespace table
 }  // namespace afw
@@ -2,6 +2,7 @@
 #ifndef AFW_TABLE_Catalog_h_INCLUDED
 #define AFW_TABLE_Catalog_h_INCLUDED
 
+#include <algorithm>
 #include <type_traits>
 #include <vector>
 
@@ -15,6 +16,8 @@
 #include "lsst/afw/table/io/FitsWriter.h"
 #include "lsst/afw/table/io/FitsReader.h"
 #include "lsst/afw/table/SchemaMapper.h"
+#include "lsst/afw/table/BaseRecord.h"
+#include "lsst/afw/table/detail/argsort.h"
 
 namespace lsst {
 namespace afw {
@@ -186,6 +189,7 @@ public:
                             .str());
         }
         CatalogT<RecordT> result(getTable());
+        result._internal.reserve(std::count(mask.begin(), mask.end(), true));
         ndarray::Array<bool const, 1>::Iterator maskIter = mask.begin();
         const_iterator catIter = begin();
         for (; maskIter != mask.end(); ++maskIter, ++catIter) {
@@ -516,20 +520,34 @@ public:
         }
     }
 
-    /// Insert a range of records into the catalog by copying them with a SchemaMapper.
+    /**
+     *  Insert a range of records into the catalog by copying them with a SchemaMapper.
+     *
+     *  The new records are all created before any fields are copied, so the copies can be divided
+     *  between nThreads threads (nThreads <= 0 uses one per hardware thread); see
+     *  detail::assignRecords.  If copying fails, no records are inserted.
+     */
     template <typename InputIterator>
-    void insert(SchemaMapper const& mapper, iterator pos, InputIterator first, InputIterator last) {
+    void insert(SchemaMapper const& mapper, iterator pos, InputIterator first, InputIterator last,
+                int nThreads = 1) {
         if (!_table->getSchema().contains(mapper.getOutputSchema())) {
             throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
                               "SchemaMapper's output schema does not match catalog's schema");
         }
         _maybeReserve(pos, first, last, true,
                       (typename std::iterator_traits<InputIterator>::iterator_category*)0);
-        while (first != last) {
-            pos = insert(pos, _table->copyRecord(*first, mapper));
-            ++pos;
-            ++first;
+        std::vector<std::shared_ptr<RecordT> > records;
+        std::vector<BaseRecord const*> inputs;
+        std::vector<BaseRecord*> outputs;
+        for (; first != last; ++first) {
+            BaseRecord const& input = *first;
+            inputs.push_back(&input);
+            auto record = _table->makeRecord();
+            outputs.push_back(record.get());
+            records.push_back(record);
         }
+        detail::assignRecords(inputs, outputs, mapper, nThreads);
+        _internal.insert(pos.base(), records.begin(), records.end());
     }
 
     /// Insert a copy of the given record at the given position.
@@ -572,9 +590,18 @@ public:
     template <typename Compare>
     bool isSorted(Compare cmp) const;
 
-    /// Sort the catalog in-place by the field with the given key.
+    /**
+     *  Sort the catalog in-place by the field with the given key.
+     *
+     *  The field values are first gathered into a contiguous array, which is sorted with a radix
+     *  sort for integer fields (such as IDs) or a merge sort otherwise, and the records are then
+     *  permuted once.  The sort is stable.
+     *
+     *  @param[in] key       Key for the field to sort by.
+     *  @param[in] nThreads  Number of threads to use; <= 0 uses one per hardware thread.
+     */
     template <typename T>
-    void sort(Key<T> const& key);
+    void sort(Key<T> const& key, int nThreads = 1);
 
     /**
      *  Sort the catalog in-place by the field with the given predicate.
@@ -727,15 +754,37 @@ void CatalogT<RecordT>::sort(Compare cmp) {
 template <typename RecordT>
 template <typename T>
 bool CatalogT<RecordT>::isSorted(Key<T> const& key) const {
-    detail::KeyComparisonFunctor<RecordT, T> f = {key};
-    return isSorted(f);
+    if (empty()) return true;
+    typename Field<T>::Value last = _internal.front()->get(key);
+    for (auto i = _internal.begin() + 1; i != _internal.end(); ++i) {
+        typename Field<T>::Value current = (**i).get(key);
+        if (current < last) return false;
+        last = std::move(current);
+    }
+    return true;
 }
 
 template <typename RecordT>
 template <typename T>
-void CatalogT<RecordT>::sort(Key<T> const& key) {
-    detail::KeyComparisonFunctor<RecordT, T> f = {key};
-    return sort(f);
+void CatalogT<RecordT>::sort(Key<T> const& key, int nThreads) {
+    // vector<bool> can't be written concurrently, so flags are gathered as bytes.
+    typedef typename Field<T>::Value Value;
+    typedef typename std::conditional<std::is_same<Value, bool>::value, unsigned char, Value>::type Element;
+    std::size_t const n = size();
+    std::vector<Element> values(n);
+    std::size_t const nChunks = detail::getChunkCount(n, nThreads);
+    afw::detail::runParallel(nChunks, [this, &values, &key, n, nChunks](std::size_t chunk) {
+        for (std::size_t i = chunk * n / nChunks; i < (chunk + 1) * n / nChunks; ++i) {
+            values[i] = _internal[i]->get(key);
+        }
+    });
+    std::vector<std::size_t> const order = detail::argsort(values, nThreads);
+    Internal sorted;
+    sorted.reserve(n);
+    for (std::size_t i : order) {
+        sorted.push_back(std::move(_internal[i]));
+    }
+    _internal.swap(sorted);
 }
 
 template <typename RecordT>
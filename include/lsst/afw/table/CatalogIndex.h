@@ -0,0 +1,384 @@
+// -*- lsst-c++ -*-
+#ifndef AFW_TABLE_CatalogIndex_h_INCLUDED
+#define AFW_TABLE_CatalogIndex_h_INCLUDED
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "lsst/base.h"
+#include "lsst/afw/table/fwd.h"
+#include "lsst/afw/table/Key.h"
+#include "lsst/afw/table/detail/argsort.h"
+
+namespace lsst {
+namespace afw {
+namespace table {
+
+namespace detail {
+
+// The value of one or more fields used as an index key: the field value itself for a single field,
+// or a tuple of values for a composite key.
+template <typename... T>
+struct IndexTraits {
+    typedef std::tuple<typename Field<T>::Value...> Value;
+
+    template <typename RecordT>
+    static Value getValue(RecordT const& record, std::tuple<Key<T>...> const& keys) {
+        return _getValue(record, keys, std::index_sequence_for<T...>());
+    }
+
+private:
+    template <typename RecordT, std::size_t... N>
+    static Value _getValue(RecordT const& record, std::tuple<Key<T>...> const& keys,
+                           std::index_sequence<N...>) {
+        return Value(record.get(std::get<N>(keys))...);
+    }
+};
+
+template <typename T>
+struct IndexTraits<T> {
+    typedef typename Field<T>::Value Value;
+
+    template <typename RecordT>
+    static Value getValue(RecordT const& record, std::tuple<Key<T>> const& keys) {
+        return record.get(std::get<0>(keys));
+    }
+};
+
+// Hash function for index values, including composite ones.
+struct IndexHash {
+    template <typename T>
+    std::size_t operator()(T const& value) const {
+        return std::hash<T>()(value);
+    }
+
+    template <typename... T>
+    std::size_t operator()(std::tuple<T...> const& value) const {
+        return _combine(value, std::index_sequence_for<T...>());
+    }
+
+private:
+    template <typename Tuple, std::size_t... N>
+    std::size_t _combine(Tuple const& value, std::index_sequence<N...>) const {
+        std::size_t seed = 0;
+        // same mixing as boost::hash_combine
+        for (std::size_t h : {(*this)(std::get<N>(value))...}) {
+            seed ^= h + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        }
+        return seed;
+    }
+};
+
+// State and operations shared by HashIndex and SortedIndex.
+template <typename RecordT, typename... T>
+class IndexBase {
+public:
+    typedef typename IndexTraits<T...>::Value Value;
+    typedef std::pair<Value, std::shared_ptr<RecordT>> Entry;
+
+    explicit IndexBase(Key<T> const&... keys) : _keys(keys...) {}
+
+    /// Return the indexed value of a record.
+    Value getValue(RecordT const& record) const { return IndexTraits<T...>::getValue(record, _keys); }
+
+protected:
+    // Pair each record of a catalog with the indexed records whose value matches its values of the
+    // given keys, which findAll(value) returns.
+    template <typename Container, typename FindAll>
+    std::vector<std::pair<std::shared_ptr<typename Container::Record>, std::shared_ptr<RecordT>>> _join(
+            Container const& catalog, std::tuple<Key<T>...> const& keys, FindAll findAll) const {
+        std::vector<std::pair<std::shared_ptr<typename Container::Record>, std::shared_ptr<RecordT>>> result;
+        for (std::size_t i = 0; i < catalog.size(); ++i) {
+            std::shared_ptr<typename Container::Record> record = catalog.get(i);
+            for (auto const& match : findAll(IndexTraits<T...>::getValue(*record, keys))) {
+                result.emplace_back(record, match);
+            }
+        }
+        return result;
+    }
+
+    // Extract the indexed values of all records in a catalog, in parallel.
+    template <typename Container>
+    std::vector<Entry> _makeEntries(Container const& catalog, int nThreads) const {
+        std::size_t const n = catalog.size();
+        std::vector<Entry> entries(n);
+        std::size_t const nChunks = getChunkCount(n, nThreads);
+        afw::detail::runParallel(nChunks, [this, &catalog, &entries, n, nChunks](std::size_t chunk) {
+            for (std::size_t i = chunk * n / nChunks; i < (chunk + 1) * n / nChunks; ++i) {
+                std::shared_ptr<RecordT> record = catalog.get(i);
+                entries[i].first = getValue(*record);
+                entries[i].second = std::move(record);
+            }
+        });
+        return entries;
+    }
+
+    std::tuple<Key<T>...> _keys;
+};
+
+}  // namespace detail
+
+/**
+ *  A hash index for looking up the records of a catalog by the value of one or more fields.
+ *
+ *  An index is not attached to a catalog, and is never invalidated or updated when a catalog
+ *  changes: it holds shared_ptrs to the records it was given, so it keeps returning them after they
+ *  are removed from their catalog, and it does not know about records added since it was built.
+ *  Such changes must be mirrored with insert() and erase() if the index should reflect them.
+ *  Changing an indexed field of a record that is in the index leaves that record under its old
+ *  value, so records should be erased before such changes and reinserted afterwards.
+ *
+ *  Composite indexes are created by passing multiple keys; their values are std::tuples of the
+ *  field values, in the order of the keys.
+ *
+ *  @code
+ *  HashIndex<SourceRecord, RecordId> byParent(SourceTable::getParentKey());
+ *  byParent.extend(catalog, 0);
+ *  auto children = byParent.findAll(parent.getId());
+ *  @endcode
+ *
+ *  join() replaces a nested loop over two catalogs with one lookup per record:
+ *
+ *  @code
+ *  HashIndex<SimpleRecord, RecordId> byId(SimpleTable::getIdKey());
+ *  byId.extend(refCat);
+ *  auto matches = byId.join(sources, objectIdKey);  // (source, reference) pairs
+ *  @endcode
+ */
+template <typename RecordT, typename... T>
+class HashIndex : public detail::IndexBase<RecordT, T...> {
+    typedef detail::IndexBase<RecordT, T...> Base;
+    typedef std::unordered_multimap<typename Base::Value, std::shared_ptr<RecordT>, detail::IndexHash>
+            Internal;
+
+public:
+    typedef typename Base::Value Value;
+
+    /// Construct an empty index on the given fields.
+    explicit HashIndex(Key<T> const&... keys) : Base(keys...) {}
+
+    /// Return the number of records in the index.
+    std::size_t size() const { return _internal.size(); }
+
+    /// Remove all records from the index.
+    void clear() { _internal.clear(); }
+
+    /// Add a record to the index.
+    void insert(std::shared_ptr<RecordT> const& record) {
+        _internal.emplace(this->getValue(*record), record);
+    }
+
+    /**
+     *  Add all records in a catalog to the index.
+     *
+     *  The indexed values are extracted by up to nThreads threads (<= 0 for one per core).
+     */
+    template <typename Container>
+    void extend(Container const& catalog, int nThreads = 1) {
+        std::vector<typename Base::Entry> entries = this->_makeEntries(catalog, nThreads);
+        _internal.reserve(_internal.size() + entries.size());
+        for (auto& entry : entries) {
+            _internal.insert(std::move(entry));
+        }
+    }
+
+    /// Remove a record from the index; return false if it was not found.
+    bool erase(RecordT const& record) {
+        auto range = _internal.equal_range(this->getValue(record));
+        for (auto i = range.first; i != range.second; ++i) {
+            if (i->second.get() == &record) {
+                _internal.erase(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Return a record with the given value, or a null pointer if there is none.
+    std::shared_ptr<RecordT> find(Value const& value) const {
+        auto i = _internal.find(value);
+        return i == _internal.end() ? std::shared_ptr<RecordT>() : i->second;
+    }
+
+    /// Return all records with the given value, in no particular order.
+    std::vector<std::shared_ptr<RecordT>> findAll(Value const& value) const {
+        auto range = _internal.equal_range(value);
+        std::vector<std::shared_ptr<RecordT>> result;
+        for (auto i = range.first; i != range.second; ++i) {
+            result.push_back(i->second);
+        }
+        return result;
+    }
+
+    /// Return the number of records with the given value.
+    std::size_t count(Value const& value) const { return _internal.count(value); }
+
+    /**
+     *  Join a catalog to the index.
+     *
+     *  Return a (catalog record, indexed record) pair for each record in the catalog and each indexed
+     *  record whose value equals the catalog record's values of the given keys, in catalog order.
+     */
+    template <typename Container>
+    std::vector<std::pair<std::shared_ptr<typename Container::Record>, std::shared_ptr<RecordT>>> join(
+            Container const& catalog, Key<T> const&... keys) const {
+        return this->_join(catalog, std::tuple<Key<T>...>(keys...),
+                           [this](Value const& value) { return findAll(value); });
+    }
+
+private:
+    Internal _internal;
+};
+
+/**
+ *  A sorted index for looking up the records of a catalog by value or by range of values.
+ *
+ *  Unlike CatalogT::sort and the search methods that rely on it, a SortedIndex doesn't change the
+ *  order of the catalog, and several can be used at once.  Records with equal values are kept in the
+ *  order they were inserted.  Adding and removing single records costs time linear in the size of the
+ *  index, so large changes are best made with extend() or by rebuilding it.
+ *
+ *  As with HashIndex, the index holds shared_ptrs to records and is never invalidated or updated
+ *  when a catalog changes, so such changes should be mirrored with insert() and erase(), and
+ *  composite indexes use std::tuple values.
+ */
+template <typename RecordT, typename... T>
+class SortedIndex : public detail::IndexBase<RecordT, T...> {
+    typedef detail::IndexBase<RecordT, T...> Base;
+    typedef std::vector<typename Base::Entry> Internal;
+
+public:
+    typedef typename Base::Value Value;
+    typedef typename Base::Entry Entry;
+
+    /// Iterators dereference to (value, record pointer) pairs.
+    typedef typename Internal::const_iterator const_iterator;
+
+    /// Construct an empty index on the given fields.
+    explicit SortedIndex(Key<T> const&... keys) : Base(keys...) {}
+
+    /// Return the number of records in the index.
+    std::size_t size() const { return _internal.size(); }
+
+    /// Remove all records from the index.
+    void clear() { _internal.clear(); }
+
+    /// Return an iterator to the entry with the smallest value.
+    const_iterator begin() const { return _internal.begin(); }
+
+    /// Return an iterator past the entry with the largest value.
+    const_iterator end() const { return _internal.end(); }
+
+    /// Add a record to the index, after any with the same value.
+    void insert(std::shared_ptr<RecordT> const& record) {
+        Entry entry(this->getValue(*record), record);
+        _internal.insert(std::upper_bound(_internal.begin(), _internal.end(), entry, _compare), entry);
+    }
+
+    /**
+     *  Add all records in a catalog to the index.
+     *
+     *  The indexed values are extracted and sorted by up to nThreads threads (<= 0 for one per core).
+     */
+    template <typename Container>
+    void extend(Container const& catalog, int nThreads = 1) {
+        Internal entries = this->_makeEntries(catalog, nThreads);
+        detail::parallelStableSort(entries, _compare, nThreads);
+        Internal merged;
+        merged.reserve(_internal.size() + entries.size());
+        std::merge(std::make_move_iterator(_internal.begin()), std::make_move_iterator(_internal.end()),
+                   std::make_move_iterator(entries.begin()), std::make_move_iterator(entries.end()),
+                   std::back_inserter(merged), _compare);
+        _internal.swap(merged);
+    }
+
+    /// Remove a record from the index; return false if it was not found.
+    bool erase(RecordT const& record) {
+        auto range = equal_range(this->getValue(record));
+        for (auto i = range.first; i != range.second; ++i) {
+            if (i->second.get() == &record) {
+                _internal.erase(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Return a record with the given value, or a null pointer if there is none.
+    std::shared_ptr<RecordT> find(Value const& value) const {
+        const_iterator i = lower_bound(value);
+        return (i == end() || value < i->first) ? std::shared_ptr<RecordT>() : i->second;
+    }
+
+    /// Return an iterator to the first entry with a value not less than the given one.
+    const_iterator lower_bound(Value const& value) const {
+        return std::lower_bound(begin(), end(), value,
+                                [](Entry const& entry, Value const& v) { return entry.first < v; });
+    }
+
+    /// Return an iterator to the first entry with a value greater than the given one.
+    const_iterator upper_bound(Value const& value) const {
+        return std::upper_bound(begin(), end(), value,
+                                [](Value const& v, Entry const& entry) { return v < entry.first; });
+    }
+
+    /// Return the range of entries with the given value.
+    std::pair<const_iterator, const_iterator> equal_range(Value const& value) const {
+        return std::make_pair(lower_bound(value), upper_bound(value));
+    }
+
+    /// Return the records with values in [lower, upper), in order.
+    std::vector<std::shared_ptr<RecordT>> findRange(Value const& lower, Value const& upper) const {
+        std::vector<std::shared_ptr<RecordT>> result;
+        for (const_iterator i = lower_bound(lower); i != end() && i->first < upper; ++i) {
+            result.push_back(i->second);
+        }
+        return result;
+    }
+
+    /// Return all records with the given value, in the order they were inserted.
+    std::vector<std::shared_ptr<RecordT>> findAll(Value const& value) const {
+        std::vector<std::shared_ptr<RecordT>> result;
+        auto range = equal_range(value);
+        for (const_iterator i = range.first; i != range.second; ++i) {
+            result.push_back(i->second);
+        }
+        return result;
+    }
+
+    /// Return the number of records with the given value.
+    std::size_t count(Value const& value) const {
+        auto range = equal_range(value);
+        return range.second - range.first;
+    }
+
+    /**
+     *  Join a catalog to the index.
+     *
+     *  Return a (catalog record, indexed record) pair for each record in the catalog and each indexed
+     *  record whose value equals the catalog record's values of the given keys, in catalog order and
+     *  then index order.
+     */
+    template <typename Container>
+    std::vector<std::pair<std::shared_ptr<typename Container::Record>, std::shared_ptr<RecordT>>> join(
+            Container const& catalog, Key<T> const&... keys) const {
+        return this->_join(catalog, std::tuple<Key<T>...>(keys...),
+                           [this](Value const& value) { return findAll(value); });
+    }
+
+private:
+    static bool _compare(Entry const& a, Entry const& b) { return a.first < b.first; }
+
+    Internal _internal;
+};
+
+}  // namespace table
+}  // namespace afw
+}  // namespace lsst
+
+#endif  // !AFW_TABLE_CatalogIndex_h_INCLUDED
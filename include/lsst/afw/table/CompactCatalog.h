@@ -0,0 +1,354 @@
+// -*- lsst-c++ -*-
+#ifndef AFW_TABLE_CompactCatalog_h_INCLUDED
+#define AFW_TABLE_CompactCatalog_h_INCLUDED
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include "boost/iterator/iterator_facade.hpp"
+
+#include "lsst/base.h"
+#include "lsst/pex/exceptions.h"
+#include "lsst/afw/table/fwd.h"
+#include "lsst/afw/table/BaseColumnView.h"
+#include "lsst/afw/table/BaseRecord.h"
+#include "lsst/afw/table/Catalog.h"
+#include "lsst/afw/table/detail/Access.h"
+#include "lsst/afw/table/detail/RecordStore.h"
+
+namespace lsst {
+namespace afw {
+namespace table {
+
+/**
+ *  A container for large numbers of records that does not hold a record object for each element.
+ *
+ *  CatalogT holds a shared_ptr to a separately-allocated record object for every element, which
+ *  costs roughly a hundred bytes and a heap allocation per record in addition to the field data.
+ *  CompactCatalogT instead holds only the field data, in arrays of row-major records it owns
+ *  (detail::RecordStore), and describes its elements as runs of consecutive records in those
+ *  arrays; a catalog whose records were added contiguously (see reserve()) needs no per-record
+ *  bookkeeping at all.
+ *
+ *  Record objects are materialized on access, as views of the field data (see
+ *  BaseTable::_makeRecordView): get(), addNew() and dereferencing an iterator return records of the
+ *  table's record type that read and write the catalog's field data directly and keep it alive, but
+ *  destroying them does not affect the catalog.  get() and addNew() allocate a new view each time,
+ *  while an iterator reuses a single view, moving it from record to record, so iterating does not
+ *  allocate.  Any state a record class holds outside its fields (such as a SourceRecord's Footprint)
+ *  is therefore not retained; CompactCatalogT is intended for records whose content is entirely in
+ *  their fields, such as reference catalogs.  Field values can also be read and written by index
+ *  without materializing a record at all.
+ *
+ *  Like CatalogT, copying a CompactCatalogT is shallow: the copies share field data.  Records are
+ *  always added by deep copy, regardless of the table that allocated them.
+ */
+template <typename RecordT>
+class CompactCatalogT {
+    // A run of consecutive records in a store.
+    struct Segment {
+        detail::RecordStore::Ptr store;
+        std::size_t first;  // index of the first record in the store
+        std::size_t count;  // number of records in the run
+    };
+
+public:
+    typedef RecordT Record;
+    typedef typename Record::Table Table;
+    typedef CatalogT<RecordT> Catalog;
+
+    typedef RecordT value_type;
+    typedef RecordT& reference;
+    typedef std::shared_ptr<RecordT> pointer;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    /**
+     *  Iterator class for CompactCatalogT.
+     *
+     *  Like CatalogIterator, iterators dereference to record references and are implicitly
+     *  convertible to record shared_ptrs.  The record is a view the iterator keeps and moves to the
+     *  current element on dereference, so a reference is valid only until the iterator is changed
+     *  or destroyed; convert the iterator to a shared_ptr to keep a record.
+     */
+    class iterator : public boost::iterator_facade<iterator, RecordT, boost::random_access_traversal_tag> {
+    public:
+        iterator() : _catalog(nullptr), _index(0), _current(false) {}
+
+        operator std::shared_ptr<RecordT>() const { return _catalog->get(_index); }
+
+    private:
+        friend class CompactCatalogT;
+        friend class boost::iterator_core_access;
+
+        iterator(CompactCatalogT const* catalog, size_type index)
+                : _catalog(catalog), _index(index), _current(false) {}
+
+        RecordT& dereference() const {
+            if (!_current) {
+                // Copies of this iterator share the view until they move it, so only move it to
+                // this element if no copy can still be referring to it
+                if (_record && _record.use_count() == 1) {
+                    _catalog->_moveView(*_record, _index);
+                } else {
+                    _record = _catalog->get(_index);
+                }
+                _current = true;
+            }
+            return *_record;
+        }
+
+        bool equal(iterator const& other) const { return _index == other._index; }
+
+        void increment() { advance(1); }
+
+        void decrement() { advance(-1); }
+
+        void advance(difference_type n) {
+            _index += n;
+            _current = false;
+        }
+
+        difference_type distance_to(iterator const& other) const {
+            return static_cast<difference_type>(other._index) - static_cast<difference_type>(_index);
+        }
+
+        CompactCatalogT const* _catalog;
+        size_type _index;
+        mutable std::shared_ptr<RecordT> _record;  // view reused for each element
+        mutable bool _current;                     // whether _record is a view of element _index
+    };
+
+    typedef iterator const_iterator;
+
+    /**
+     *  Construct a catalog from a table (or nothing).
+     *
+     *  A catalog with no table is considered invalid; a valid table must be assigned to it
+     *  before it can be used.
+     */
+    explicit CompactCatalogT(std::shared_ptr<Table> const& table = std::shared_ptr<Table>())
+            : _table(table) {}
+
+    /// Construct a catalog from a schema, creating a table with Table::make(schema).
+    explicit CompactCatalogT(Schema const& schema) : _table(Table::make(schema)) {}
+
+    /// Construct a catalog from a table and deep copies of a range of records; see extend().
+    template <typename InputIterator>
+    CompactCatalogT(std::shared_ptr<Table> const& table, InputIterator first, InputIterator last)
+            : _table(table) {
+        extend(first, last);
+    }
+
+    /// Shallow copy constructor; the new catalog shares field data with this one.
+    CompactCatalogT(CompactCatalogT const&) = default;
+    CompactCatalogT(CompactCatalogT&&) = default;
+
+    /// Shallow assignment; the catalog shares field data with the other one.
+    CompactCatalogT& operator=(CompactCatalogT const&) = default;
+    CompactCatalogT& operator=(CompactCatalogT&&) = default;
+
+    ~CompactCatalogT() = default;
+
+    /// Return the table associated with the catalog.
+    std::shared_ptr<Table> getTable() const { return _table; }
+
+    /// Return the schema associated with the catalog's table.
+    Schema getSchema() const { return _table->getSchema(); }
+
+    /// Return the number of elements in the catalog.
+    size_type size() const { return _ends.empty() ? 0 : _ends.back(); }
+
+    /// Return true if the catalog has no records.
+    bool empty() const { return _ends.empty(); }
+
+    /// Return true if all records are in a single contiguous run, so a column view can be created.
+    bool isContiguous() const { return _segments.size() <= 1; }
+
+    /**
+     *  Increase the capacity of the catalog to the given size.
+     *
+     *  As with CatalogT::reserve, records added up to that size will be contiguous in memory, but
+     *  they will only be contiguous with existing records if the catalog already had enough space.
+     */
+    void reserve(size_type n) {
+        if (n <= size()) return;
+        size_type const extra = n - size();
+        if (_store && _store->getCapacity() - _store->size() >= extra) return;
+        _store = detail::RecordStore::make(getSchema(), extra);
+    }
+
+    /// Return an iterator to the first record.
+    iterator begin() const { return iterator(this, 0); }
+
+    /// Return an iterator past the last record.
+    iterator end() const { return iterator(this, size()); }
+
+    /// Return a view of the record at index i.
+    std::shared_ptr<RecordT> get(size_type i) const {
+        Segment const& segment = _findSegment(i);
+        std::shared_ptr<RecordT> record = std::dynamic_pointer_cast<RecordT>(
+                detail::Access::makeRecordView(*_table, _getView(segment, i)));
+        if (!record) {
+            throw LSST_EXCEPT(pex::exceptions::LogicError,
+                              "Table does not make record views of the catalog's record type; it must "
+                              "override BaseTable::_makeRecordView.");
+        }
+        return record;
+    }
+
+    /// Return a view of the record at index i, throwing LengthError if it is out of range.
+    std::shared_ptr<RecordT> at(size_type i) const {
+        _checkIndex(i);
+        return get(i);
+    }
+
+    /// Return the value of a field of the record at index i, without materializing the record.
+    template <typename T>
+    typename Field<T>::Value get(size_type i, Key<T> const& key) const {
+        _checkKey(key);
+        Segment const& segment = _findSegment(i);
+        return detail::Access::getValue(key, segment.store->getRecord(segment.first + i), segment.store);
+    }
+
+    /// Set the value of a field of the record at index i, without materializing the record.
+    template <typename T, typename U>
+    void set(size_type i, Key<T> const& key, U const& value) const {
+        _checkKey(key);
+        Segment const& segment = _findSegment(i);
+        detail::Access::setValue(key, segment.store->getRecord(segment.first + i), segment.store, value);
+    }
+
+    /// Add a new record with default field values, and return a view of it.
+    std::shared_ptr<RecordT> addNew() {
+        if (!_store || _store->size() == _store->getCapacity()) {
+            // grow geometrically, as there's no need to keep stores small for contiguity
+            _store = detail::RecordStore::make(
+                    getSchema(), std::max(size(), static_cast<size_type>(BaseTable::nRecordsPerBlock)));
+        }
+        size_type const index = _store->append();
+        if (!_segments.empty() && _segments.back().store == _store &&
+            _segments.back().first + _segments.back().count == index) {
+            ++_segments.back().count;
+            ++_ends.back();
+        } else {
+            _segments.push_back(Segment{_store, index, 1});
+            _ends.push_back(size() + 1);
+        }
+        return get(size() - 1);
+    }
+
+    /// Add a deep copy of a record, which must have the same schema as the catalog.
+    std::shared_ptr<RecordT> append(BaseRecord const& record) {
+        std::shared_ptr<RecordT> result = addNew();
+        result->assign(record);
+        return result;
+    }
+
+    /**
+     *  Add deep copies of a range of records.
+     *
+     *  The iterators must dereference to record references, as CatalogT iterators do.
+     */
+    template <typename InputIterator>
+    void extend(InputIterator first, InputIterator last) {
+        _extend(first, last, typename std::iterator_traits<InputIterator>::iterator_category());
+    }
+
+    /// Remove all records, releasing the catalog's reference to their field data.
+    void clear() {
+        _segments.clear();
+        _ends.clear();
+        _store.reset();
+    }
+
+    /**
+     *  Return a column view of the catalog's fields.
+     *
+     *  @throws lsst::pex::exceptions::RuntimeError if the records are not contiguous.
+     */
+    BaseColumnView getColumnView() const {
+        if (!isContiguous()) {
+            throw LSST_EXCEPT(pex::exceptions::RuntimeError, "Record data is not contiguous in memory.");
+        }
+        if (empty()) {
+            return detail::Access::makeColumnView<BaseColumnView>(_table, 0, nullptr,
+                                                                  ndarray::Manager::Ptr());
+        }
+        Segment const& segment = _segments.front();
+        return detail::Access::makeColumnView<BaseColumnView>(_table, segment.count,
+                                                              segment.store->getRecord(segment.first),
+                                                              segment.store);
+    }
+
+    /// Return a CatalogT holding deep copies of the records, allocated by the catalog's table.
+    Catalog toCatalog() const {
+        Catalog result(_table);
+        result.reserve(size());
+        for (iterator i = begin(); i != end(); ++i) {
+            result.addNew()->assign(*i);
+        }
+        return result;
+    }
+
+private:
+    template <typename InputIterator>
+    void _extend(InputIterator first, InputIterator last, std::input_iterator_tag) {
+        for (; first != last; ++first) {
+            append(*first);
+        }
+    }
+
+    template <typename InputIterator>
+    void _extend(InputIterator first, InputIterator last, std::forward_iterator_tag) {
+        reserve(size() + std::distance(first, last));
+        _extend(first, last, std::input_iterator_tag());
+    }
+
+    // Point a view made by get() at the record at index i.
+    void _moveView(RecordT& record, size_type i) const {
+        Segment const& segment = _findSegment(i);
+        detail::Access::setRecordView(record, _getView(segment, i));
+    }
+
+    // Return the field data of the record at index i of a segment.
+    static detail::RecordView _getView(Segment const& segment, size_type i) {
+        return detail::RecordView{segment.store->getRecord(segment.first + i), segment.store};
+    }
+
+    // Return the segment holding record i, and set i to the record's index in that segment.
+    Segment const& _findSegment(size_type& i) const {
+        if (_segments.size() == 1) return _segments.front();
+        std::size_t const n = std::upper_bound(_ends.begin(), _ends.end(), i) - _ends.begin();
+        if (n > 0) i -= _ends[n - 1];
+        return _segments[n];
+    }
+
+    void _checkIndex(size_type i) const {
+        if (i >= size()) {
+            throw LSST_EXCEPT(
+                    pex::exceptions::LengthError,
+                    (boost::format("Index %d out of range for catalog with %d records") % i % size()).str());
+        }
+    }
+
+    template <typename T>
+    static void _checkKey(Key<T> const& key) {
+        if (!key.isValid()) {
+            throw LSST_EXCEPT(pex::exceptions::LogicError, "Key is not valid.");
+        }
+    }
+
+    std::shared_ptr<Table> _table;    // table used to materialize records
+    std::vector<Segment> _segments;   // runs of consecutive records, in catalog order
+    std::vector<size_type> _ends;     // cumulative number of records through each segment
+    detail::RecordStore::Ptr _store;  // store new records are added to
+};
+
+}  // namespace table
+}  // namespace afw
+}  // namespace lsst
+
+#endif  // !AFW_TABLE_CompactCatalog_h_INCLUDED
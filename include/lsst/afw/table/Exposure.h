@@ -60,6 +60,14 @@ class Detector;
 
 namespace table {
 
+/**
+ *  Bitflags to be passed to ExposureCatalog::writeFits
+ */
+enum ExposureFitsFlags {
+    /// Save equal but separately allocated Psfs, Wcss, etc. only once, sharing them when read back
+    EXPOSURE_IO_DEDUPLICATE_ARCHIVE = 0x1
+};
+
 class ExposureRecord;
 class ExposureTable;
 
@@ -170,8 +178,12 @@ public:
 protected:
     explicit ExposureRecord(std::shared_ptr<ExposureTable> const& table);
 
+    ExposureRecord(std::shared_ptr<ExposureTable> const& table, detail::RecordView const& view);
+
     void _assign(BaseRecord const& other) override;
 
+    void _resetView() override;
+
 private:
     friend class ExposureTable;
 
@@ -273,6 +285,8 @@ protected:
 
     std::shared_ptr<BaseRecord> _makeRecord() override;
 
+    std::shared_ptr<BaseRecord> _makeRecordView(detail::RecordView const& view) override;
+
 private:
     // Struct that holds the minimal schema and the special keys we've added to it.
     struct MinimalSchema {
@@ -83,6 +83,10 @@ public:
  *  Objects that inherit from ReferenceFunctorKey can be passed to BaseRecord::operator[], just as true Keys
  *  can, but the record will simply pass itself to ReferenceFunctorKey::getReference().
  *
+ *  A reference may span several fields, which are not adjacent in a columnar record (see
+ *  BaseTable::setColumnar); implementations should throw pex::exceptions::LogicError when they cannot
+ *  refer to the record's storage, rather than return a reference to a copy.
+ *
  *  @note We'd combine this with the ConstReferenceFunctorKey interface if it weren't for the fact that
  *  we can't pass multiple template arguments to a Swig macro if either contains commas, and we'd need that
  *  to wrap a combined interface base class.
@@ -0,0 +1,145 @@
+// -*- lsst-c++ -*-
+#ifndef AFW_TABLE_Predicate_h_INCLUDED
+#define AFW_TABLE_Predicate_h_INCLUDED
+
+#include <memory>
+#include <vector>
+
+#include "ndarray.h"
+#include "lsst/base.h"
+#include "lsst/afw/table/fwd.h"
+#include "lsst/afw/table/BaseColumnView.h"
+#include "lsst/afw/table/BaseRecord.h"
+#include "lsst/afw/table/Key.h"
+#include "lsst/afw/table/Flag.h"
+
+namespace lsst {
+namespace afw {
+namespace table {
+
+/**
+ *  A boolean expression over the fields of a record, used to select records from catalogs.
+ *
+ *  Predicates are built from comparisons between scalar fields and constants and from tests of Flag
+ *  fields, combined with the &&, || and ! operators:
+ *  @code
+ *  Predicate good = Predicate(fluxKey, Predicate::GREATER, 100.0) && !Predicate(saturatedKey);
+ *  auto selected = good.subset(catalog, true);
+ *  @endcode
+ *
+ *  When a catalog is contiguous, predicates are evaluated a column at a time, in blocks of rows, so
+ *  the inner loops are simple enough for the compiler to vectorize (fully so for the unit-stride
+ *  columns of columnar tables; see BaseTable::setColumnar).  Other catalogs are evaluated one
+ *  record at a time.  The right operand of && is not evaluated for blocks in which the left operand
+ *  is false for every record, and likewise for || when it is true.
+ */
+class Predicate final {
+public:
+    /// Comparison operators for field values; the field is always the left operand.
+    enum Comparison { EQUAL, NOT_EQUAL, LESS, LESS_EQUAL, GREATER, GREATER_EQUAL };
+
+    /// Construct a predicate that compares a scalar field to a constant.
+    template <typename T>
+    Predicate(Key<T> const& key, Comparison op, typename Field<T>::Value const& value);
+
+    /// Construct a predicate that tests whether a flag field has the given value.
+    explicit Predicate(Key<Flag> const& key, bool value = true);
+
+    Predicate(Predicate const&);
+    Predicate(Predicate&&);
+    Predicate& operator=(Predicate const&);
+    Predicate& operator=(Predicate&&);
+    ~Predicate();
+
+    /// Return a predicate that is true when both operands are.
+    Predicate operator&&(Predicate const& other) const;
+
+    /// Return a predicate that is true when either operand is.
+    Predicate operator||(Predicate const& other) const;
+
+    /// Return a predicate that is true when this one is false.
+    Predicate operator!() const;
+
+    /// Evaluate the predicate for a single record.
+    bool operator()(BaseRecord const& record) const;
+
+    /// Evaluate the predicate for all records in a column view.
+    ndarray::Array<bool, 1, 1> evaluate(BaseColumnView const& columns) const;
+
+    /// Evaluate the predicate for all records in a catalog.
+    template <typename Catalog>
+    ndarray::Array<bool, 1, 1> evaluate(Catalog const& catalog) const {
+        if (catalog.isContiguous()) {
+            return evaluate(catalog.getColumnView());
+        }
+        ndarray::Array<bool, 1, 1> result = ndarray::allocate(catalog.size());
+        auto out = result.begin();
+        for (auto const& record : catalog) {
+            *out++ = (*this)(record);
+        }
+        return result;
+    }
+
+    /// Return the indices of the records in a catalog for which the predicate is true.
+    template <typename Catalog>
+    std::vector<std::size_t> select(Catalog const& catalog) const {
+        ndarray::Array<bool, 1, 1> const mask = evaluate(catalog);
+        std::vector<std::size_t> result;
+        result.reserve(_count(mask));
+        for (std::size_t i = 0; i < mask.size(); ++i) {
+            if (mask[i]) result.push_back(i);
+        }
+        return result;
+    }
+
+    /**
+     *  Return the records of a catalog for which the predicate is true.
+     *
+     *  If deep is true, the records are copied by the catalog's table into new memory that is
+     *  allocated all at once, so the result is contiguous.  Otherwise the result shares records with
+     *  the input catalog.
+     */
+    template <typename Catalog>
+    Catalog subset(Catalog const& catalog, bool deep = false) const {
+        std::vector<std::size_t> const indices = select(catalog);
+        Catalog result(catalog.getTable());
+        result.reserve(indices.size());
+        for (std::size_t i : indices) {
+            if (deep) {
+                result.push_back(catalog.getTable()->copyRecord(catalog[i]));
+            } else {
+                result.push_back(catalog.get(i));
+            }
+        }
+        return result;
+    }
+
+private:
+    class Node;
+    template <typename T>
+    class ComparisonNode;
+    class FlagNode;
+    class AndNode;
+    class OrNode;
+    class NotNode;
+
+    explicit Predicate(std::shared_ptr<Node const> node);
+
+    template <typename T>
+    static std::shared_ptr<Node const> _makeComparison(Key<T> const& key, Comparison op,
+                                                       typename Field<T>::Value const& value);
+
+    static std::size_t _count(ndarray::Array<bool, 1, 1> const& mask);
+
+    std::shared_ptr<Node const> _node;
+};
+
+template <typename T>
+Predicate::Predicate(Key<T> const& key, Comparison op, typename Field<T>::Value const& value)
+        : _node(_makeComparison(key, op, value)) {}
+
+}  // namespace table
+}  // namespace afw
+}  // namespace lsst
+
+#endif  // !AFW_TABLE_Predicate_h_INCLUDED
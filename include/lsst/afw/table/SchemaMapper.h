@@ -214,6 +214,11 @@ public:
             std::vector<std::string> const& prefixes = std::vector<std::string>());
 
 private:
+    friend class detail::Access;
+
+    // Return the mapping compiled into a copy plan, compiling it if necessary.
+    std::shared_ptr<detail::RecordCopyPlan const> _getCopyPlan() const;
+
     template <typename Predicate>
     struct AddMappingsWhere {
         template <typename T>
@@ -81,6 +81,8 @@ protected:
     friend class SimpleTable;
 
     explicit SimpleRecord(std::shared_ptr<SimpleTable> const& table);
+
+    SimpleRecord(std::shared_ptr<SimpleTable> const& table, detail::RecordView const& view);
 };
 
 /**
@@ -193,6 +195,8 @@ protected:
 
     std::shared_ptr<BaseRecord> _makeRecord() override;
 
+    std::shared_ptr<BaseRecord> _makeRecordView(detail::RecordView const& view) override;
+
 private:
     // Struct that holds the minimal schema and the special keys we've added to it.
     struct MinimalSchema {
@@ -62,8 +62,8 @@ public:
     /// Return true if the vector is in ascending ID order.
     bool isSorted() const { return this->isSorted(Table::getIdKey()); }
 
-    /// Sort the vector in-place by ID.
-    void sort() { this->sort(Table::getIdKey()); }
+    /// Sort the vector in-place by ID, using the given number of threads (<= 0 for one per core).
+    void sort(int nThreads = 1) { this->sort(Table::getIdKey(), nThreads); }
 
     //@{
     /**
@@ -193,8 +193,12 @@ public:
 protected:
     explicit SourceRecord(std::shared_ptr<SourceTable> const &table);
 
+    SourceRecord(std::shared_ptr<SourceTable> const &table, detail::RecordView const &view);
+
     virtual void _assign(BaseRecord const &other);
 
+    void _resetView() override;
+
 private:
     friend class SourceTable;
 
@@ -470,6 +474,8 @@ protected:
 
     std::shared_ptr<BaseRecord> _makeRecord() override;
 
+    std::shared_ptr<BaseRecord> _makeRecordView(detail::RecordView const &view) override;
+
 private:
     // Struct that holds the minimal schema and the special keys we've added to it.
     struct MinimalSchema {
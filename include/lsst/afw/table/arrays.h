@@ -38,6 +38,10 @@ namespace table {
  *  ArrayKey operates on the convention that arrays are defined by a set of contiguous scalar fields
  *  (i.e. added to the Schema in order, with no interruption) of the same type, with a common field
  *  name prefix and "_0", "_1" etc. suffixes.
+ *
+ *  In a columnar record (see BaseTable::setColumnar) each of those scalar fields has a column of its
+ *  own, so the elements are not contiguous: get() and getConstReference() then return copies, and
+ *  getReference() throws.  ArrayKeys made from a true array field are contiguous in either layout.
  */
 template <typename T>
 class ArrayKey : public FunctorKey<ndarray::Array<T const, 1, 1> >,
@@ -107,16 +111,31 @@ public:
     /// Return the number of elements in the array.
     int getSize() const noexcept { return _size; }
 
-    /// Get an array from the given record
+    /**
+     *  Get an array from the given record
+     *
+     *  In a columnar record (see BaseTable::setColumnar) the scalar fields are not contiguous, so
+     *  this returns a copy of their values rather than a view into the record.
+     */
     ndarray::Array<T const, 1, 1> get(BaseRecord const& record) const override;
 
     /// Set an array in the given record
     void set(BaseRecord& record, ndarray::Array<T const, 1, 1> const& value) const override;
 
-    /// Get non-const reference array from the given record
+    /**
+     *  Get non-const reference array from the given record
+     *
+     *  @throws pex::exceptions::LogicError if the record is columnar and the array is made of separate
+     *          scalar fields, which are then not contiguous.
+     */
     ndarray::ArrayRef<T, 1, 1> getReference(BaseRecord& record) const override;
 
-    /// Get const reference array from the given record
+    /**
+     *  Get const reference array from the given record
+     *
+     *  As with get(), if the record is columnar and the array is made of separate scalar fields, this
+     *  refers to a copy of their values rather than to the record.
+     */
     ndarray::ArrayRef<T const, 1, 1> getConstReference(BaseRecord const& record) const override;
 
     //@{
@@ -7,6 +7,7 @@
 #include "ndarray/Manager.h"
 #include "lsst/afw/table/FieldBase.h"
 #include "lsst/afw/table/Schema.h"
+#include "lsst/afw/table/detail/ColumnLayout.h"
 #include "lsst/afw/table/detail/SchemaImpl.h"
 
 namespace lsst {
@@ -18,6 +19,8 @@ class BaseTable;
 
 namespace detail {
 
+struct RecordCopyPlan;
+
 /**
  *  @internal
  *
@@ -75,6 +78,87 @@ public:
     /// @internal Access to the private Key constructor.
     static Key<Flag> makeKey(int offset, int bit) { return Key<Flag>(offset, bit); }
 
+    /// @internal Return the address of the data at the given row-major offset in a record.
+    template <typename RecordT>
+    static char *getElementData(RecordT &record, int offset) {
+        return record._getElementData(offset);
+    }
+
+    /// @internal Return true if a record's fields are stored in columnar form.
+    template <typename RecordT>
+    static bool isColumnar(RecordT const &record) {
+        return record._columns != nullptr;
+    }
+
+    /**
+     *  @internal Return the raw field data of a row-major record, for bulk serialization.
+     *
+     *  The fields of a columnar record are not contiguous; use gatherData and scatterData instead.
+     */
+    template <typename RecordT>
+    static char *getData(RecordT &record) {
+        return reinterpret_cast<char *>(record._data);
+    }
+
+    /// @internal Return the raw field data of a row-major record, for bulk serialization.
+    template <typename RecordT>
+    static char const *getData(RecordT const &record) {
+        return reinterpret_cast<char const *>(record._data);
+    }
+
+    /// @internal Copy the fixed-size fields of a columnar record into a row-major buffer.
+    template <typename RecordT>
+    static void gatherData(RecordT const &record, char *out) {
+        record._columns->gather(reinterpret_cast<char const *>(record._data), record._capacity, record._row,
+                                out);
+    }
+
+    /// @internal Copy the fixed-size fields in a row-major buffer into a columnar record.
+    template <typename RecordT>
+    static void scatterData(char const *in, RecordT &record) {
+        record._columns->scatter(in, reinterpret_cast<char *>(record._data), record._capacity, record._row);
+    }
+
+    /// @internal Return the value of a field in row-major record data that isn't held by a record.
+    template <typename T>
+    static typename Field<T>::Value getValue(Key<T> const &key, char const *data,
+                                             ndarray::Manager::Ptr const &manager) {
+        return key.getValue(reinterpret_cast<typename Field<T>::Element const *>(data + key.getOffset()),
+                            manager);
+    }
+
+    /// @internal Set the value of a field in row-major record data that isn't held by a record.
+    template <typename T, typename U>
+    static void setValue(Key<T> const &key, char *data, ndarray::Manager::Ptr const &manager,
+                         U const &value) {
+        key.setValue(reinterpret_cast<typename Field<T>::Element *>(data + key.getOffset()), manager, value);
+    }
+
+    /// @internal Construct a record that refers to existing row-major field data; see RecordStore.
+    template <typename TableT, typename ViewT>
+    static std::shared_ptr<BaseRecord> makeRecordView(TableT &table, ViewT const &view) {
+        return static_cast<BaseTable &>(table)._makeRecordView(view);
+    }
+
+    /// @internal Point a record made by makeRecordView at other row-major field data.
+    template <typename RecordT, typename ViewT>
+    static void setRecordView(RecordT &record, ViewT const &view) {
+        static_cast<BaseRecord &>(record)._setView(view);
+    }
+
+    /// @internal Construct a column view of contiguous row-major field data; see RecordStore.
+    template <typename ColumnViewT, typename TableT>
+    static ColumnViewT makeColumnView(std::shared_ptr<TableT> const &table, int recordCount, char *data,
+                                      ndarray::Manager::Ptr const &manager) {
+        return ColumnViewT(table, recordCount, data, manager);
+    }
+
+    /// @internal Return the copy plan compiled from a SchemaMapper.
+    template <typename MapperT>
+    static std::shared_ptr<RecordCopyPlan const> getCopyPlan(MapperT const &mapper) {
+        return mapper._getCopyPlan();
+    }
+
     /// @internal Add some padding to a schema without adding a field.
     static void padSchema(Schema &schema, int bytes) {
         schema._edit();
@@ -0,0 +1,69 @@
+// -*- lsst-c++ -*-
+#ifndef AFW_TABLE_DETAIL_ColumnLayout_h_INCLUDED
+#define AFW_TABLE_DETAIL_ColumnLayout_h_INCLUDED
+
+#include <cstdint>
+#include <vector>
+
+namespace lsst {
+namespace afw {
+namespace table {
+
+class Schema;
+
+namespace detail {
+
+/**
+ *  @internal
+ *
+ *  The mapping between the row-major layout of a record (as described by Schema offsets) and the
+ *  columnar layout used by tables in columnar mode.
+ *
+ *  A block of memory that holds N records in columnar form stores each field in its own array of N
+ *  elements; the array for a field at row-major offset o starts at byte o*N of the block, which
+ *  keeps it aligned to the field's element type and ensures the arrays never overlap.  Within a
+ *  record, the elements of a field (array elements, flag bits, etc.) remain contiguous, so keys for
+ *  subfields still work, and the elements of consecutive records are separated by the size of the
+ *  field rather than the size of the record.
+ */
+class ColumnLayout final {
+public:
+    /// Construct the layout for a (padded) schema.
+    explicit ColumnLayout(Schema const& schema);
+
+    /// Return the address of the element at the given row-major offset for row 'row' of a block.
+    char* getElement(char* block, std::size_t capacity, std::size_t row, int offset) const {
+        Column const& column = _columns[offset];
+        return block + column.offset * capacity + row * column.size + (offset - column.offset);
+    }
+
+    /// Return the address of the element at the given row-major offset for row 'row' of a block.
+    char const* getElement(char const* block, std::size_t capacity, std::size_t row, int offset) const {
+        return getElement(const_cast<char*>(block), capacity, row, offset);
+    }
+
+    /// Return the number of bytes between consecutive elements of the field holding the given offset.
+    std::size_t getStride(int offset) const { return _columns[offset].size; }
+
+    /// Copy the fixed-size fields of a columnar record into a row-major record buffer.
+    void gather(char const* block, std::size_t capacity, std::size_t row, char* out) const;
+
+    /// Copy the fixed-size fields of a row-major record buffer into a columnar record.
+    void scatter(char const* in, char* block, std::size_t capacity, std::size_t row) const;
+
+private:
+    struct Column {
+        std::uint32_t offset;  // row-major offset of the first element of the field
+        std::uint32_t size;    // size of the field in a single record
+    };
+
+    std::vector<Column> _columns;  // indexed by row-major byte offset
+    std::vector<Column> _fixed;    // fields that hold plain data rather than objects, sorted by offset
+};
+
+}  // namespace detail
+}  // namespace table
+}  // namespace afw
+}  // namespace lsst
+
+#endif  // !AFW_TABLE_DETAIL_ColumnLayout_h_INCLUDED
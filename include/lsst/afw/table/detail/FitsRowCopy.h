@@ -0,0 +1,145 @@
+// -*- lsst-c++ -*-
+#ifndef AFW_TABLE_DETAIL_FitsRowCopy_h_INCLUDED
+#define AFW_TABLE_DETAIL_FitsRowCopy_h_INCLUDED
+
+#include <complex>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace lsst {
+namespace afw {
+namespace table {
+namespace detail {
+
+/**
+ *  @internal
+ *
+ *  The on-disk layout of a FITS binary table element type: the size of the units that must be
+ *  byte-swapped between native and big-endian order, and whether cfitsio stores the type with a
+ *  TZERO offset, which amounts to flipping its sign bit.
+ */
+template <typename T>
+struct FitsRawFormat {
+    static constexpr std::size_t swapSize = sizeof(T);
+    static constexpr bool flipSign = false;
+};
+
+template <typename T>
+struct FitsRawFormat<std::complex<T> > {
+    static constexpr std::size_t swapSize = sizeof(T);
+    static constexpr bool flipSign = false;
+};
+
+template <>
+struct FitsRawFormat<std::int8_t> {
+    static constexpr std::size_t swapSize = 1;
+    static constexpr bool flipSign = true;
+};
+
+template <>
+struct FitsRawFormat<std::uint16_t> {
+    static constexpr std::size_t swapSize = 2;
+    static constexpr bool flipSign = true;
+};
+
+template <>
+struct FitsRawFormat<std::uint32_t> {
+    static constexpr std::size_t swapSize = 4;
+    static constexpr bool flipSign = true;
+};
+
+/**
+ *  @internal
+ *
+ *  A contiguous run of elements copied between a record and a FITS binary table row.
+ *
+ *  A vector of these is a copy plan for all the fixed-size fields of a schema, letting whole rows be
+ *  converted without any per-field dispatch.
+ */
+struct FitsRowCopy {
+    std::size_t recordOffset;  // offset of the first element in the record
+    std::size_t rowOffset;     // offset of the first element in the FITS row
+    std::size_t nBytes;        // total size of the elements
+    std::size_t swapSize;      // size of the units to byte-swap
+    bool flipSign;             // whether to flip the sign bit of each unit
+
+    /// Return a run of nElements elements of type T.
+    template <typename T>
+    static FitsRowCopy make(std::size_t recordOffset, std::size_t rowOffset, std::size_t nElements) {
+        return FitsRowCopy{recordOffset, rowOffset, nElements * sizeof(T), FitsRawFormat<T>::swapSize,
+                           FitsRawFormat<T>::flipSign};
+    }
+};
+
+/// @internal Add a run to a copy plan, merging it with the last one when both sides are contiguous.
+inline void appendFitsRowCopy(std::vector<FitsRowCopy> &plan, FitsRowCopy const &op) {
+    if (!plan.empty()) {
+        FitsRowCopy &last = plan.back();
+        if (last.swapSize == op.swapSize && last.flipSign == op.flipSign &&
+            last.recordOffset + last.nBytes == op.recordOffset &&
+            last.rowOffset + last.nBytes == op.rowOffset) {
+            last.nBytes += op.nBytes;
+            return;
+        }
+    }
+    plan.push_back(op);
+}
+
+/// @internal Return true if native byte order differs from FITS (big-endian) order.
+inline bool fitsNeedsByteSwap() {
+    std::uint16_t const one = 1;
+    return *reinterpret_cast<std::uint8_t const *>(&one) == 1;
+}
+
+/// @internal Copy nBytes, reversing the byte order of each N-byte unit.
+template <std::size_t N>
+void copyByteSwapped(std::uint8_t const *in, std::uint8_t *out, std::size_t nBytes) {
+    for (std::size_t i = 0; i < nBytes; i += N) {
+        for (std::size_t j = 0; j < N; ++j) {
+            out[i + j] = in[i + N - 1 - j];
+        }
+    }
+}
+
+/// @internal Copy a run, byte-swapping if necessary, then flip the sign bit in byte msb of each unit.
+inline void copyFitsRun(FitsRowCopy const &op, std::uint8_t const *in, std::uint8_t *out, bool swap,
+                        std::size_t msb) {
+    switch (swap ? op.swapSize : 1) {
+        case 2:
+            copyByteSwapped<2>(in, out, op.nBytes);
+            break;
+        case 4:
+            copyByteSwapped<4>(in, out, op.nBytes);
+            break;
+        case 8:
+            copyByteSwapped<8>(in, out, op.nBytes);
+            break;
+        default:
+            std::memcpy(out, in, op.nBytes);
+    }
+    if (op.flipSign) {
+        for (std::size_t i = 0; i < op.nBytes; i += op.swapSize) {
+            out[i + msb] ^= 0x80;
+        }
+    }
+}
+
+/// @internal Copy a run from record data into a FITS row.
+inline void copyToFitsRow(FitsRowCopy const &op, char const *record, std::uint8_t *row, bool swap) {
+    copyFitsRun(op, reinterpret_cast<std::uint8_t const *>(record) + op.recordOffset, row + op.rowOffset,
+                swap, 0);
+}
+
+/// @internal Copy a run from a FITS row into record data.
+inline void copyFromFitsRow(FitsRowCopy const &op, std::uint8_t const *row, char *record, bool swap) {
+    copyFitsRun(op, row + op.rowOffset, reinterpret_cast<std::uint8_t *>(record) + op.recordOffset, swap,
+                swap ? op.swapSize - 1 : 0);
+}
+
+}  // namespace detail
+}  // namespace table
+}  // namespace afw
+}  // namespace lsst
+
+#endif  // !AFW_TABLE_DETAIL_FitsRowCopy_h_INCLUDED
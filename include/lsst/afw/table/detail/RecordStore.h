@@ -0,0 +1,65 @@
+// -*- lsst-c++ -*-
+#ifndef AFW_TABLE_DETAIL_RecordStore_h_INCLUDED
+#define AFW_TABLE_DETAIL_RecordStore_h_INCLUDED
+
+#include <memory>
+
+#include "ndarray/Manager.h"
+#include "lsst/afw/table/Schema.h"
+
+namespace lsst {
+namespace afw {
+namespace table {
+namespace detail {
+
+/**
+ *  @internal
+ *
+ *  A fixed-capacity array of row-major records that owns its field data, used as storage by
+ *  CompactCatalogT.
+ *
+ *  Like the blocks tables allocate records from, a RecordStore is an ndarray::Manager, so arrays and
+ *  record views that refer to its memory keep it alive.  Unlike those blocks, it initializes and
+ *  destroys the fields of the records it holds itself, so no record objects need to exist.
+ *
+ *  Records can only be appended, and appending is not thread-safe.
+ */
+class RecordStore final : public ndarray::Manager {
+public:
+    typedef boost::intrusive_ptr<RecordStore> Ptr;
+
+    /// Allocate space for the given number of records with the given table schema.
+    static Ptr make(Schema const& schema, std::size_t capacity) {
+        return Ptr(new RecordStore(schema, capacity));
+    }
+
+    /// Return the number of records in the store.
+    std::size_t size() const { return _size; }
+
+    /// Return the number of records the store can hold.
+    std::size_t getCapacity() const { return _capacity; }
+
+    /// Return the field data of the record with the given index.
+    char* getRecord(std::size_t index) const { return _mem.get() + index * _recordSize; }
+
+    /// Initialize the fields of a new record at the end of the store and return its index.
+    std::size_t append();
+
+    ~RecordStore();
+
+private:
+    RecordStore(Schema const& schema, std::size_t capacity);
+
+    Schema _schema;                // schema of the records; already padded by the table
+    std::size_t _recordSize;       // size of each record in bytes
+    std::size_t _capacity;         // number of records the store can hold
+    std::size_t _size;             // number of records initialized so far
+    std::unique_ptr<char[]> _mem;  // zero-initialized field data
+};
+
+}  // namespace detail
+}  // namespace table
+}  // namespace afw
+}  // namespace lsst
+
+#endif  // !AFW_TABLE_DETAIL_RecordStore_h_INCLUDED
@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <map>
 #include <set>
+#include <unordered_map>
 
 #include "boost/variant.hpp"
 #include "boost/mpl/transform.hpp"
@@ -69,8 +70,10 @@ public:
     typedef boost::make_variant_over<ItemTypes>::type ItemVariant;
     /// A std::vector whose elements can be any of the allowed SchemaItem types.
     typedef std::vector<ItemVariant> ItemContainer;
-    /// A map from field names to position in the vector, so we can do name lookups.
+    /// A sorted map from field names to position in the vector, so we can do prefix and subfield lookups.
     typedef std::map<std::string, int> NameMap;
+    /// A hash map from field names to position in the vector, so we can do exact name lookups quickly.
+    typedef std::unordered_map<std::string, int> NameIndex;
     /// A map from standard field offsets to position in the vector, so we can do field lookups.
     typedef std::map<int, int> OffsetMap;
     /// A map from Flag field offset/bit pairs to position in the vector, so we can do Flag field lookups.
@@ -102,8 +105,8 @@ public:
     /// Find an item by name and run the given functor on it.
     template <typename F>
     void findAndApply(std::string const& name, F&& func) const {
-        auto iter = _names.find(name);
-        if (iter == _names.end()) {
+        auto iter = _nameIndex.find(name);
+        if (iter == _nameIndex.end()) {
             throw LSST_EXCEPT(pex::exceptions::NotFoundError,
                               (boost::format("Field with name '%s' not found") % name).str());
         }
@@ -202,6 +205,7 @@ private:
     int _lastFlagBit;      // Bit of the last flag field.
     ItemContainer _items;  // Vector of variants of SchemaItem<T>.
     NameMap _names;        // Field name to vector-index map.
+    NameIndex _nameIndex;  // Field name to vector-index hash; always has the same contents as _names.
     OffsetMap _offsets;    // Offset to vector-index map for regular fields.
     FlagMap _flags;        // Offset to vector-index map for flags.
 };
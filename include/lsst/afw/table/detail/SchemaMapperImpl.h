@@ -3,6 +3,7 @@
 #define AFW_TABLE_DETAIL_SchemaMapperImpl_h_INCLUDED
 
 #include <map>
+#include <memory>
 #include <algorithm>
 
 #include "boost/variant.hpp"
@@ -18,6 +19,8 @@ class SchemaMapper;
 
 namespace detail {
 
+struct RecordCopyPlan;
+
 /**
  *  A private implementation class to hide the messy details of SchemaMapper.
  *
@@ -85,6 +88,26 @@ private:
     Schema _input;
     Schema _output;
     KeyPairMap _map;
+    mutable std::shared_ptr<RecordCopyPlan const> _plan;  // compiled from _map on demand; reset on changes
+};
+
+/**
+ *  A SchemaMapper compiled into the operations needed to copy a record.
+ *
+ *  Mapped fixed-size fields are merged into runs of bytes that are contiguous in both the input and
+ *  output records, in mapping order, so mapping most of a schema into an extended schema usually
+ *  takes only a few memcpy calls.  Flags and variable-length fields are copied field by field.
+ */
+struct RecordCopyPlan final {
+    struct Run {
+        std::size_t inputOffset;
+        std::size_t outputOffset;
+        std::size_t nBytes;
+    };
+
+    std::vector<Run> runs;                                  // byte runs, in mapping order
+    std::vector<std::pair<Key<Flag>, Key<Flag> > > flags;  // flag fields
+    SchemaMapperImpl::KeyPairMap others;                    // variable-length fields
 };
 }  // namespace detail
 }  // namespace table
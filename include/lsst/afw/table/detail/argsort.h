@@ -0,0 +1,97 @@
+// -*- lsst-c++ -*-
+#ifndef AFW_TABLE_DETAIL_argsort_h_INCLUDED
+#define AFW_TABLE_DETAIL_argsort_h_INCLUDED
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+#include "lsst/afw/detail/parallel.h"
+
+namespace lsst {
+namespace afw {
+namespace table {
+namespace detail {
+
+/**
+ *  @internal Return the number of chunks to split a problem of the given size into.
+ *
+ *  Chunks are never smaller than a few tens of thousands of elements, as smaller ones aren't worth a
+ *  thread.  nThreads <= 0 means one chunk per hardware thread.
+ */
+std::size_t getChunkCount(std::size_t size, int nThreads);
+
+/**
+ *  @internal Return the permutation that stably sorts the given keys in ascending order.
+ *
+ *  This is a least-significant-digit radix sort, which skips the digits all keys share (such as the
+ *  high bytes of most IDs).
+ */
+std::vector<std::size_t> radixArgsort(std::vector<std::uint64_t> const& keys, int nThreads);
+
+/// @internal Map an integer to an unsigned 64-bit key with the same ordering.
+template <typename T>
+std::uint64_t makeRadixKey(T value) {
+    if (std::is_signed<T>::value) {
+        return static_cast<std::uint64_t>(static_cast<std::int64_t>(value)) ^ (std::uint64_t(1) << 63);
+    }
+    return static_cast<std::uint64_t>(value);
+}
+
+/// @internal Stably sort a vector with the given comparison, using a parallel merge sort.
+template <typename T, typename Compare>
+void parallelStableSort(std::vector<T>& values, Compare less, int nThreads) {
+    std::size_t const nChunks = getChunkCount(values.size(), nThreads);
+    auto bound = [&values, nChunks](std::size_t chunk) {
+        return std::min(chunk, nChunks) * values.size() / nChunks;
+    };
+    auto begin = values.begin();
+    afw::detail::runParallel(nChunks, [&](std::size_t chunk) {
+        std::stable_sort(begin + bound(chunk), begin + bound(chunk + 1), less);
+    });
+    // inplace_merge is stable, and each chunk holds elements that were before those of the next.
+    for (std::size_t width = 1; width < nChunks; width *= 2) {
+        afw::detail::runParallel((nChunks - width + 2 * width - 1) / (2 * width), [&](std::size_t merge) {
+            std::size_t const chunk = merge * 2 * width;
+            std::inplace_merge(begin + bound(chunk), begin + bound(chunk + width),
+                               begin + bound(chunk + 2 * width), less);
+        });
+    }
+}
+
+/// @internal Return the permutation that stably sorts the given values by operator<, using a merge sort.
+template <typename T>
+std::vector<std::size_t> mergeArgsort(std::vector<T> const& values, int nThreads) {
+    std::vector<std::size_t> indices(values.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    parallelStableSort(indices, [&values](std::size_t a, std::size_t b) { return values[a] < values[b]; },
+                       nThreads);
+    return indices;
+}
+
+/// @internal Return the permutation that stably sorts the given values in ascending order.
+template <typename T>
+std::vector<std::size_t> argsort(std::vector<T> const& values, int nThreads, std::true_type isIntegral) {
+    std::vector<std::uint64_t> keys(values.size());
+    std::transform(values.begin(), values.end(), keys.begin(), &makeRadixKey<T>);
+    return radixArgsort(keys, nThreads);
+}
+
+template <typename T>
+std::vector<std::size_t> argsort(std::vector<T> const& values, int nThreads, std::false_type isIntegral) {
+    return mergeArgsort(values, nThreads);
+}
+
+template <typename T>
+std::vector<std::size_t> argsort(std::vector<T> const& values, int nThreads) {
+    return argsort(values, nThreads, std::is_integral<T>());
+}
+
+}  // namespace detail
+}  // namespace table
+}  // namespace afw
+}  // namespace lsst
+
+#endif  // !AFW_TABLE_DETAIL_argsort_h_INCLUDED
@@ -0,0 +1,150 @@
+// -*- lsst-c++ -*-
+#ifndef AFW_TABLE_IO_FitsChunkReader_h_INCLUDED
+#define AFW_TABLE_IO_FitsChunkReader_h_INCLUDED
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "lsst/pex/exceptions.h"
+#include "lsst/afw/fits.h"
+#include "lsst/afw/table/Schema.h"
+#include "lsst/afw/table/io/FitsReader.h"
+#include "lsst/afw/table/io/FitsSchemaInputMapper.h"
+
+namespace lsst {
+namespace afw {
+namespace table {
+namespace io {
+
+/**
+ *  A reader that reads a FITS binary table a chunk of rows at a time.
+ *
+ *  CatalogT::readFits reads an entire HDU into memory at once; FitsChunkReader instead returns
+ *  successive catalogs of at most chunkSize records from each call to next(), so a catalog of any
+ *  size can be scanned in bounded memory:
+ *  @code
+ *  io::FitsChunkReader<SourceCatalog> reader(filename, 1, 100000, {"id", "coord", "parent", "base_PsfFlux"});
+ *  while (!reader.isDone()) {
+ *      SourceCatalog chunk = reader.next();
+ *      ...
+ *  }
+ *  @endcode
+ *
+ *  All chunks share a single table, whose memory blocks are reused (see BaseTable::setBlockReuse):
+ *  as long as the caller releases all records of one chunk before calling next() again, each chunk
+ *  is read into the same memory.  Records that are kept simply keep their own block alive.
+ *
+ *  The table type and schema are determined from the file, as they are by FitsReader::apply.
+ *  Reading only some of the columns (see FitsSchemaInputMapper::retain) is a projection of the
+ *  schema, so it must still include the fields the table class requires (e.g. those of
+ *  SourceTable::makeMinimalSchema()); BaseCatalog can read any subset of columns.
+ *
+ *  FitsChunkReader holds the FITS file open until it is destroyed.  If it was constructed from a
+ *  MemFileManager, that must outlive the reader.
+ */
+template <typename ContainerT>
+class FitsChunkReader {
+public:
+    typedef typename ContainerT::Table Table;
+
+    /**
+     *  Open a FITS binary table for reading in chunks.
+     *
+     *  @param[in] source     Filename or afw::fits::MemFileManager to read from.
+     *  @param[in] hdu        HDU to read, where 0 is the primary.  The special value of
+     *                        afw::fits::DEFAULT_HDU skips the primary HDU if it is empty.
+     *  @param[in] chunkSize  Maximum number of records in each chunk.
+     *  @param[in] columns    Column names (or prefixes of names) to read; an empty vector reads all
+     *                        columns.  See FitsSchemaInputMapper::retain.
+     *  @param[in] begin      First row to read.
+     *  @param[in] end        One past the last row to read; clipped to the number of rows in the table.
+     *  @param[in] ioFlags    Subclass-dependent bitflags, as for FitsReader::apply.
+     *
+     *  @throws lsst::pex::exceptions::InvalidParameterError if chunkSize is zero.
+     */
+    template <typename SourceT>
+    FitsChunkReader(SourceT& source, int hdu, std::size_t chunkSize,
+                    std::vector<std::string> const& columns = std::vector<std::string>(),
+                    std::size_t begin = 0, std::size_t end = std::numeric_limits<std::size_t>::max(),
+                    int ioFlags = 0)
+            : _chunkSize(chunkSize),
+              _fits(new afw::fits::Fits(source, "r",
+                                        afw::fits::Fits::AUTO_CLOSE | afw::fits::Fits::AUTO_CHECK)),
+              _metadata(std::make_shared<daf::base::PropertyList>()) {
+        if (chunkSize == 0) {
+            throw LSST_EXCEPT(pex::exceptions::InvalidParameterError, "Chunk size must be positive.");
+        }
+        _fits->setHdu(hdu);
+        _fits->readMetadata(*_metadata, true);
+        FitsReader const* reader = FitsReader::_lookupFitsReader(*_metadata);
+        _mapper.reset(new FitsSchemaInputMapper(*_metadata, true));
+        if (!columns.empty()) {
+            _mapper->retain(columns);
+        }
+        reader->_setupArchive(*_fits, *_mapper, std::shared_ptr<InputArchive>(), ioFlags);
+        _table = std::dynamic_pointer_cast<Table>(reader->makeTable(*_mapper, _metadata, ioFlags, true));
+        if (!_table) {
+            throw LSST_EXCEPT(pex::exceptions::RuntimeError, "Invalid table class for catalog.");
+        }
+        _table->setBlockReuse(true);
+        _end = std::min(end, _fits->countRows());
+        _row = std::min(begin, _end);
+    }
+
+    FitsChunkReader(FitsChunkReader const&) = delete;
+    FitsChunkReader(FitsChunkReader&&) = default;
+    FitsChunkReader& operator=(FitsChunkReader const&) = delete;
+    FitsChunkReader& operator=(FitsChunkReader&&) = default;
+    ~FitsChunkReader() = default;
+
+    /// Return the schema of the records read, which reflects any column selection.
+    Schema getSchema() const { return _table->getSchema(); }
+
+    /// Return the table shared by all chunks.
+    std::shared_ptr<Table> getTable() const { return _table; }
+
+    /// Return the next row to be read.
+    std::size_t getNextRow() const { return _row; }
+
+    /// Return the number of rows not yet read.
+    std::size_t getRemainingCount() const { return _end - _row; }
+
+    /// Return true if all rows have been read.
+    bool isDone() const { return _row == _end; }
+
+    /// Read and return the next chunk of records; the result is empty if all rows have been read.
+    ContainerT next() {
+        ContainerT chunk(_table);
+        std::size_t const n = std::min(_chunkSize, _end - _row);
+        if (n == 0) return chunk;
+        chunk.reserve(n);
+        for (std::size_t i = 0; i < n; ++i, ++_row) {
+            // Like FitsReader::apply, we need to support reading Catalog<T const>.
+            _mapper->readRecord(
+                    const_cast<typename std::remove_const<typename ContainerT::Record>::type&>(
+                            *chunk.addNew()),
+                    *_fits, _row);
+        }
+        return chunk;
+    }
+
+private:
+    std::size_t _chunkSize;
+    std::size_t _row;
+    std::size_t _end;
+    std::unique_ptr<afw::fits::Fits> _fits;
+    std::shared_ptr<daf::base::PropertyList> _metadata;
+    std::unique_ptr<FitsSchemaInputMapper> _mapper;
+    std::shared_ptr<Table> _table;
+};
+
+}  // namespace io
+}  // namespace table
+}  // namespace afw
+}  // namespace lsst
+
+#endif  // !AFW_TABLE_IO_FitsChunkReader_h_INCLUDED
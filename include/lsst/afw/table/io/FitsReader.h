@@ -16,6 +16,9 @@ namespace afw {
 namespace table {
 namespace io {
 
+template <typename ContainerT>
+class FitsChunkReader;
+
 /**
  *  A utility class for reading FITS binary tables.
  *
@@ -140,6 +143,9 @@ public:
     virtual ~FitsReader() = default;
 
 private:
+    template <typename ContainerT>
+    friend class FitsChunkReader;
+
     static FitsReader const* _lookupFitsReader(daf::base::PropertyList const& metadata);
 
     void _setupArchive(afw::fits::Fits& fits, FitsSchemaInputMapper& mapper,
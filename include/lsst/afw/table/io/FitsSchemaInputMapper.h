@@ -122,6 +122,17 @@ public:
      */
     void erase(int column);
 
+    /**
+     *  Remove all items except those with the given column names (ttypes) from the mapping.
+     *
+     *  A name also selects all columns whose names start with it followed by an underscore, so
+     *  a prefix such as "slot_Centroid" or "base_PsfFlux" selects all of the columns of a compound
+     *  field or measurement.  Names that match no column are ignored.  This must be called
+     *  before finalize(), and should usually be called before any items are customized, so
+     *  unwanted columns are never read.
+     */
+    void retain(std::vector<std::string> const &ttypes);
+
     /**
      *  Customize a mapping by providing a FitsColumnReader instance that will be invoked by readRecords().
      */
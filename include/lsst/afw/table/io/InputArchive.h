@@ -66,12 +66,27 @@ public:
     /// Load and return all objects in the archive.
     Map const& getAll() const;
 
+    /**
+     *  Return the archive's data catalogs, reading any a lazy archive has not yet read.
+     *
+     *  The catalogs are shared with this archive and must not be modified.
+     */
+    CatalogVector const& getDataCatalogs() const;
+
     /**
      *  Read an object from an already open FITS object.
      *
+     *  If lazy is true, only the archive's index is read immediately; each of the data catalogs that
+     *  follow it is read (and kept for reuse) the first time an object that needs it is loaded.  Loading
+     *  a few small objects from a large archive then reads only the HDUs that hold them.  A lazy archive
+     *  keeps a pointer to fitsfile, which must remain open for as long as the archive (or any copy of
+     *  it) is used to load objects; it moves fitsfile to other HDUs while loading, but restores the
+     *  current HDU afterwards.
+     *
      *  @param[in]  fitsfile     FITS object to read from, already positioned at the desired HDU.
+     *  @param[in]  lazy         Whether to defer reading data catalogs until they are needed.
      */
-    static InputArchive readFits(fits::Fits& fitsfile);
+    static InputArchive readFits(fits::Fits& fitsfile, bool lazy = false);
 
 private:
     class Impl;
@@ -82,6 +82,25 @@ public:
     int put(Persistable const & obj, bool permissive = false) { return put(&obj, permissive); }
     ///@}
 
+    /**
+     *  Set whether objects with the same content as one already saved share its ID.
+     *
+     *  Normally only a pointer that has already been saved (via the shared_ptr overload of put())
+     *  reuses an ID.  With content deduplication enabled, each object is compared (by a hash, and
+     *  then exactly) to those already saved after it is written, and if it is identical to one of
+     *  them, what it wrote is removed and the earlier object's ID is returned instead.  This makes
+     *  archives with many separately allocated but equal objects (such as the Psfs and Wcss of
+     *  CoaddInputs) smaller and faster to read, at the cost of some time to compare objects when
+     *  writing.  Objects read from such an archive are shared where the originals were only equal.
+     *
+     *  Objects that save nested objects that were not themselves found to be duplicates are never
+     *  deduplicated.  Disabled by default; changing it does not affect objects already saved.
+     */
+    void setContentDeduplication(bool deduplicate);
+
+    /// Return whether objects with the same content share an ID; see setContentDeduplication().
+    bool getContentDeduplication() const;
+
     /**
      *  @brief Return the index catalog that specifies where objects are stored in the
      *         data catalogs.
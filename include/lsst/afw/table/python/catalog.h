@@ -85,7 +85,7 @@ void declareCatalogOverloads(PyCatalog<Record> &cls) {
     typedef typename Field<T>::Value Value;
 
     cls.def("isSorted", (bool (Catalog::*)(Key<T> const &) const) & Catalog::isSorted);
-    cls.def("sort", (void (Catalog::*)(Key<T> const &)) & Catalog::sort);
+    cls.def("sort", (void (Catalog::*)(Key<T> const &, int)) & Catalog::sort, "key"_a, "nThreads"_a = 1);
     cls.def("find", [](Catalog &self, Value const &value, Key<T> const &key) -> std::shared_ptr<Record> {
         auto iter = self.find(value, key);
         if (iter == self.end()) {
@@ -0,0 +1,120 @@
+/*
+ * LSST Data Management System
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+#ifndef AFW_TABLE_PYTHON_COMPACTCATALOG_H_INCLUDED
+#define AFW_TABLE_PYTHON_COMPACTCATALOG_H_INCLUDED
+
+#include "pybind11/pybind11.h"
+
+#include "lsst/utils/python.h"
+#include "lsst/afw/table/Catalog.h"
+#include "lsst/afw/table/CompactCatalog.h"
+
+namespace lsst {
+namespace afw {
+namespace table {
+namespace python {
+
+template <typename Record>
+using PyCompactCatalog = pybind11::class_<CompactCatalogT<Record>, std::shared_ptr<CompactCatalogT<Record>>>;
+
+/**
+Declare field-type-specific overloaded compact catalog member functions for one field type
+
+@tparam T  Field type.
+@tparam Record  Record type, e.g. BaseRecord or SimpleRecord.
+
+@param[in] cls  CompactCatalog pybind11 class.
+*/
+template <typename T, typename Record>
+void declareCompactCatalogOverloads(PyCompactCatalog<Record> &cls) {
+    using namespace pybind11::literals;
+
+    typedef CompactCatalogT<Record> CompactCatalog;
+    typedef typename Field<T>::Value Value;
+
+    cls.def("get", [](CompactCatalog const &self, std::ptrdiff_t i, Key<T> const &key) -> Value {
+        return self.get(utils::python::cppIndex(self.size(), i), key);
+    }, "index"_a, "key"_a);
+    cls.def("set", [](CompactCatalog const &self, std::ptrdiff_t i, Key<T> const &key, Value const &value) {
+        self.set(utils::python::cppIndex(self.size(), i), key, value);
+    }, "index"_a, "key"_a, "value"_a);
+}
+
+/**
+Wrap an instantiation of lsst::afw::table::CompactCatalogT<Record>.
+
+Records are returned as new views of the catalog's field data, so iterating in Python (which uses
+__getitem__) yields records that remain valid independently of each other.
+
+@tparam Record  Record type, e.g. BaseRecord or SimpleRecord.
+
+@param[in] mod    Module object class will be added to.
+@param[in] name   Name prefix of the record type, e.g. "Base" or "Simple".
+*/
+template <typename Record>
+PyCompactCatalog<Record> declareCompactCatalog(pybind11::module &mod, std::string const &name) {
+    namespace py = pybind11;
+    using namespace pybind11::literals;
+
+    using CompactCatalog = CompactCatalogT<Record>;
+    using Table = typename Record::Table;
+
+    PyCompactCatalog<Record> cls(mod, (name + "CompactCatalog").c_str());
+
+    /* Constructors */
+    cls.def(py::init<Schema const &>(), "schema"_a);
+    cls.def(py::init<std::shared_ptr<Table> const &>(), "table"_a);
+    cls.def(py::init<CompactCatalog const &>(), "other"_a);
+
+    /* Methods */
+    cls.def("getTable", &CompactCatalog::getTable);
+    cls.def_property_readonly("table", &CompactCatalog::getTable);
+    cls.def("getSchema", &CompactCatalog::getSchema);
+    cls.def_property_readonly("schema", &CompactCatalog::getSchema);
+    cls.def("__len__", &CompactCatalog::size);
+    cls.def("__getitem__", [](CompactCatalog const &self, std::ptrdiff_t i) {
+        return self.get(utils::python::cppIndex(self.size(), i));
+    });
+    cls.def("isContiguous", &CompactCatalog::isContiguous);
+    cls.def("reserve", &CompactCatalog::reserve, "n"_a);
+    cls.def("addNew", &CompactCatalog::addNew);
+    cls.def("append", &CompactCatalog::append, "record"_a);
+    cls.def("extend", [](CompactCatalog &self, CatalogT<Record> const &other) {
+        self.extend(other.begin(), other.end());
+    }, "other"_a);
+    cls.def("clear", &CompactCatalog::clear);
+    cls.def("getColumnView", &CompactCatalog::getColumnView);
+    cls.def("toCatalog", [](CompactCatalog const &self) -> CatalogT<Record> { return self.toCatalog(); });
+
+    declareCompactCatalogOverloads<std::int32_t>(cls);
+    declareCompactCatalogOverloads<std::int64_t>(cls);
+    declareCompactCatalogOverloads<float>(cls);
+    declareCompactCatalogOverloads<double>(cls);
+    declareCompactCatalogOverloads<lsst::geom::Angle>(cls);
+
+    return cls;
+}
+}  // namespace python
+}  // namespace table
+}  // namespace afw
+}  // namespace lsst
+
+#endif  // !AFW_TABLE_PYTHON_COMPACTCATALOG_H_INCLUDED
@@ -99,13 +99,13 @@ PySortedCatalog<Record> declareSortedCatalog(pybind11::module &mod, std::string
             },
             "key"_a = py::none());
     cls.def("sort",
-            [clsBase](py::object const &self, py::object key) -> py::object {
+            [clsBase](py::object const &self, py::object key, int nThreads) -> py::object {
                 if (key.is(py::none())) {
                     key = self.attr("table").attr("getIdKey")();
                 }
-                return clsBase.attr("sort")(self, key);
+                return clsBase.attr("sort")(self, key, nThreads);
             },
-            "key"_a = py::none());
+            "key"_a = py::none(), "nThreads"_a = 1);
     cls.def("find",
             [clsBase](py::object const &self, py::object const &value, py::object key) -> py::object {
                 if (key.is(py::none())) {
@@ -32,6 +32,7 @@
 #include "lsst/afw/image/Image.h"
 
 #include "lsst/afw/fits.h"
+#include "lsst/afw/fitsReadCache.h"
 
 namespace py = pybind11;
 
@@ -94,9 +95,10 @@ void declareImageScalingOptions(py::module & mod) {
 
     cls.def(py::init<>());
     cls.def(py::init<ImageScalingOptions::ScalingAlgorithm, int, std::vector<std::string> const&,
-                     unsigned long, float, float, bool, double, double>(),
+                     unsigned long, float, float, bool, double, double, std::size_t>(),
             "algorithm"_a, "bitpix"_a, "maskPlanes"_a=std::vector<std::string>(), "seed"_a=1,
-            "quantizeLevel"_a=4.0, "quantizePad"_a=5.0, "fuzz"_a=true, "bscale"_a=1.0, "bzero"_a=0.0);
+            "quantizeLevel"_a=4.0, "quantizePad"_a=5.0, "fuzz"_a=true, "bscale"_a=1.0, "bzero"_a=0.0,
+            "maxSamples"_a=0);
 
     cls.def_readonly("algorithm", &ImageScalingOptions::algorithm);
     cls.def_readonly("bitpix", &ImageScalingOptions::bitpix);
@@ -107,6 +109,7 @@ void declareImageScalingOptions(py::module & mod) {
     cls.def_readonly("fuzz", &ImageScalingOptions::fuzz);
     cls.def_readonly("bscale", &ImageScalingOptions::bscale);
     cls.def_readonly("bzero", &ImageScalingOptions::bzero);
+    cls.def_readonly("maxSamples", &ImageScalingOptions::maxSamples);
 
     declareImageScalingOptionsTemplates<float>(cls);
     declareImageScalingOptionsTemplates<double>(cls);
@@ -173,8 +176,14 @@ void declareFits(py::module & mod) {
     cls.def("countHdus", &Fits::countHdus);
 
     cls.def("writeMetadata", &Fits::writeMetadata);
-    cls.def("readMetadata", [](Fits & self, bool strip=false) { return readMetadata(self, strip); },
-            "strip"_a=false);
+    cls.def("readMetadata",
+            [](Fits &self, bool strip, py::object const &keys) {
+                if (keys.is_none()) {
+                    return readMetadata(self, strip);
+                }
+                return readMetadata(self, strip, keys.cast<std::vector<std::string>>());
+            },
+            "strip"_a = false, "keys"_a = py::none());
     cls.def("createEmpty", &Fits::createEmpty);
 
     cls.def("gotoFirstHdu", [](Fits & self) { self.setHdu(DEFAULT_HDU); });
@@ -187,6 +196,19 @@ void declareFits(py::module & mod) {
 }
 
 
+void declareReadCache(py::module & mod) {
+    py::class_<ReadCache, std::unique_ptr<ReadCache, py::nodelete>> cls(mod, "ReadCache");
+
+    cls.def_static("getInstance", &ReadCache::getInstance, py::return_value_policy::reference);
+    cls.def("setCapacity", &ReadCache::setCapacity, "nBytes"_a);
+    cls.def("getCapacity", &ReadCache::getCapacity);
+    cls.def("getSize", &ReadCache::getSize);
+    cls.def("getCount", &ReadCache::getCount);
+    cls.def("getHitCount", &ReadCache::getHitCount);
+    cls.def("getMissCount", &ReadCache::getMissCount);
+    cls.def("clear", &ReadCache::clear);
+}
+
 PYBIND11_MODULE(fits, mod) {
     py::class_<MemFileManager> clsMemFileManager(mod, "MemFileManager");
 
@@ -211,26 +233,37 @@ PYBIND11_MODULE(fits, mod) {
         memcpy(m.getData(), PyBytes_AsString(d.ptr()), size);
     });
     clsMemFileManager.def("readMetadata",
-                          [](MemFileManager & self, int hdu=DEFAULT_HDU, bool strip=false) {
-                              return readMetadata(self, hdu, strip);
-                          }, "hdu"_a=DEFAULT_HDU, "strip"_a=false);
+                          [](MemFileManager &self, int hdu, bool strip, py::object const &keys) {
+                              if (keys.is_none()) {
+                                  return readMetadata(self, hdu, strip);
+                              }
+                              return readMetadata(self, hdu, strip, keys.cast<std::vector<std::string>>());
+                          },
+                          "hdu"_a = DEFAULT_HDU, "strip"_a = false, "keys"_a = py::none());
 
     declareImageCompression(mod);
     declareImageScalingOptions(mod);
     declareImageScale(mod);
     declareImageWriteOptions(mod);
     declareFits(mod);
+    declareReadCache(mod);
 
     mod.attr("DEFAULT_HDU") = DEFAULT_HDU;
     mod.def("combineMetadata", combineMetadata, "first"_a, "second"_a);
     mod.def("makeLimitedFitsHeader", &makeLimitedFitsHeader, "metadata"_a,
             "excludeNames"_a = std::set<std::string>());
     mod.def("readMetadata",
-            [](std::string const& filename, int hdu=DEFAULT_HDU, bool strip=false) {
-                return readMetadata(filename, hdu, strip);
-            }, "fileName"_a, "hdu"_a=DEFAULT_HDU, "strip"_a=false);
+            [](std::string const &filename, int hdu, bool strip, py::object const &keys) {
+                if (keys.is_none()) {
+                    return readMetadata(filename, hdu, strip);
+                }
+                return readMetadata(filename, hdu, strip, keys.cast<std::vector<std::string>>());
+            },
+            "fileName"_a, "hdu"_a = DEFAULT_HDU, "strip"_a = false, "keys"_a = py::none());
     mod.def("setAllowImageCompression", &setAllowImageCompression, "allow"_a);
     mod.def("getAllowImageCompression", &getAllowImageCompression);
+    mod.def("setCompressionThreads", &setCompressionThreads, "nThreads"_a);
+    mod.def("getCompressionThreads", &getCompressionThreads);
 
     mod.def("compressionAlgorithmFromString", &compressionAlgorithmFromString);
     mod.def("compressionAlgorithmToString", &compressionAlgorithmToString);
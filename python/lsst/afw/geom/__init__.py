@@ -30,6 +30,7 @@ from .ellipses import Ellipse, Quadrupole
 from .polygon import *
 from .span import *
 from .spanSet import *
+from .compactSpanSet import *
 
 from . import python
 from .transformConfig import *
@@ -0,0 +1,69 @@
+/*
+ * LSST Data Management System
+ * Copyright 2008-2018  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#include "pybind11/pybind11.h"
+
+#include "lsst/afw/geom/CompactSpanSet.h"
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+
+namespace lsst {
+namespace afw {
+namespace geom {
+namespace {
+
+using PyCompactSpanSet = py::class_<CompactSpanSet, std::shared_ptr<CompactSpanSet>>;
+
+PYBIND11_MODULE(compactSpanSet, mod) {
+    py::module::import("lsst.geom");
+    py::module::import("lsst.afw.geom.span");
+    py::module::import("lsst.afw.geom.spanSet");
+
+    PyCompactSpanSet cls(mod, "CompactSpanSet");
+    cls.def(py::init<>());
+    cls.def(py::init<SpanSet const &>(), "spanSet"_a);
+    cls.def("__len__", &CompactSpanSet::size);
+    // Spans are decoded into the iterator, so each must be copied out before the next is decoded.
+    cls.def("__iter__",
+            [](CompactSpanSet const &self) {
+                return py::make_iterator<py::return_value_policy::copy>(self.begin(), self.end());
+            },
+            py::keep_alive<0, 1>());
+    cls.def("__eq__", &CompactSpanSet::operator==, py::is_operator());
+    cls.def("__ne__", &CompactSpanSet::operator!=, py::is_operator());
+    cls.def("empty", &CompactSpanSet::empty);
+    cls.def("getArea", &CompactSpanSet::getArea);
+    cls.def("getBBox", &CompactSpanSet::getBBox);
+    cls.def("getEncodedSize", &CompactSpanSet::getEncodedSize);
+    cls.def("sharesStorageWith", &CompactSpanSet::sharesStorageWith);
+    cls.def("toSpanSet", &CompactSpanSet::toSpanSet);
+    cls.def("shiftedBy", (CompactSpanSet (CompactSpanSet::*)(int, int) const) & CompactSpanSet::shiftedBy);
+    cls.def("shiftedBy", (CompactSpanSet (CompactSpanSet::*)(lsst::geom::Extent2I const &) const) &
+                                 CompactSpanSet::shiftedBy);
+    cls.def("clippedTo", &CompactSpanSet::clippedTo);
+}
+
+}  // namespace
+}  // namespace geom
+}  // namespace afw
+}  // namespace lsst
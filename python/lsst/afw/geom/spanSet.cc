@@ -243,6 +243,10 @@ PYBIND11_MODULE(spanSet, mod) {
     cls.def("intersectNot",
             (std::shared_ptr<SpanSet>(SpanSet::*)(SpanSet const &) const) & SpanSet::intersectNot);
     cls.def("union", (std::shared_ptr<SpanSet>(SpanSet::*)(SpanSet const &) const) & SpanSet::union_);
+    using SpanSetList = std::vector<std::shared_ptr<SpanSet>>;
+    cls.def("intersect", (SpanSetList(SpanSet::*)(SpanSetList const &) const) & SpanSet::intersect);
+    cls.def("intersectNot", (SpanSetList(SpanSet::*)(SpanSetList const &) const) & SpanSet::intersectNot);
+    cls.def("union", (SpanSetList(SpanSet::*)(SpanSetList const &) const) & SpanSet::union_);
     cls.def_static("fromShape",
                    (std::shared_ptr<SpanSet>(*)(int, Stencil, lsst::geom::Point2I)) & SpanSet::fromShape,
                    "radius"_a, "stencil"_a = Stencil::CIRCLE, "offset"_a = lsst::geom::Point2I());
@@ -27,6 +27,7 @@
 #include "lsst/afw/image/PhotoCalib.h"
 #include "lsst/afw/image/Filter.h"
 #include "lsst/afw/image/Exposure.h"
+#include "lsst/afw/image/ScratchFile.h"
 #include "lsst/afw/detection/Psf.h"
 
 namespace py = pybind11;
@@ -144,6 +145,11 @@ PyExposure<PixelT> declareExposure(py::module &mod, const std::string &suffix) {
 
     cls.def_static("readFits", (ExposureT(*)(std::string const &))ExposureT::readFits);
     cls.def_static("readFits", (ExposureT(*)(fits::MemFileManager &))ExposureT::readFits);
+    cls.def("writeScratch",
+            (void (ExposureT::*)(std::string const &, ScratchWriteOptions const &) const) &
+                    ExposureT::writeScratch,
+            "fileName"_a, "options"_a = ScratchWriteOptions());
+    cls.def_static("readScratch", &ExposureT::readScratch, "fileName"_a);
 
     cls.def("getCutout", &ExposureT::getCutout, "center"_a, "size"_a);
 
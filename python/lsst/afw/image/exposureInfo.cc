@@ -153,6 +153,10 @@ PYBIND11_MODULE(exposureInfo, mod) {
     cls.def("hasTransmissionCurve", &ExposureInfo::hasTransmissionCurve);
     cls.def("getTransmissionCurve", &ExposureInfo::getTransmissionCurve);
     cls.def("setTransmissionCurve", &ExposureInfo::setTransmissionCurve, "transmissionCurve"_a);
+
+    cls.def("getArchiveContentDeduplication", &ExposureInfo::getArchiveContentDeduplication);
+    cls.def("setArchiveContentDeduplication", &ExposureInfo::setArchiveContentDeduplication,
+            "deduplicate"_a);
 }
 }  // namespace
 }  // namespace image
@@ -27,6 +27,7 @@
 #include "lsst/afw/image/Image.h"
 #include "lsst/afw/image/ImageSlice.h"
 #include "lsst/afw/image/Mask.h"
+#include "lsst/afw/image/ScratchFile.h"
 #include "lsst/afw/fits.h"
 #include "lsst/afw/image/python/indexing.h"
 
@@ -212,6 +213,11 @@ static void declareMask(py::module &mod, std::string const &suffix) {
                    "filename"_a, "hdu"_a = fits::DEFAULT_HDU);
     cls.def_static("readFits", (Mask<MaskPixelT>(*)(fits::MemFileManager &, int))Mask<MaskPixelT>::readFits,
                    "manager"_a, "hdu"_a = fits::DEFAULT_HDU);
+    cls.def("writeScratch",
+            (void (Mask<MaskPixelT>::*)(std::string const &, ScratchWriteOptions const &) const) &
+                    Mask<MaskPixelT>::writeScratch,
+            "fileName"_a, "options"_a = ScratchWriteOptions());
+    cls.def_static("readScratch", &Mask<MaskPixelT>::readScratch, "fileName"_a);
     cls.def_static("interpret", Mask<MaskPixelT>::interpret);
     cls.def("subset", &Mask<MaskPixelT>::subset, "bbox"_a, "origin"_a = PARENT);
     cls.def("getAsString", &Mask<MaskPixelT>::getAsString);
@@ -236,6 +242,18 @@ static void declareMask(py::module &mod, std::string const &suffix) {
     cls.def_static("addMaskPlane", (int (*)(const std::string &))Mask<MaskPixelT>::addMaskPlane);
 }
 
+static void declareScratchWriteOptions(py::module &mod) {
+    py::class_<ScratchWriteOptions> cls(mod, "ScratchWriteOptions");
+    py::enum_<ScratchWriteOptions::Compression>(cls, "Compression")
+            .value("NONE", ScratchWriteOptions::NONE)
+            .value("GZIP", ScratchWriteOptions::GZIP)
+            .export_values();
+    cls.def(py::init<ScratchWriteOptions::Compression, int>(), "compression"_a = ScratchWriteOptions::NONE,
+            "tileRows"_a = 64);
+    cls.def_readwrite("compression", &ScratchWriteOptions::compression);
+    cls.def_readwrite("tileRows", &ScratchWriteOptions::tileRows);
+}
+
 template <typename PixelT>
 static PyImage<PixelT> declareImage(py::module &mod, const std::string &suffix) {
     PyImage<PixelT> cls(mod, ("Image" + suffix).c_str());
@@ -327,6 +345,11 @@ static PyImage<PixelT> declareImage(py::module &mod, const std::string &suffix)
                    "filename"_a, "hdu"_a = fits::DEFAULT_HDU);
     cls.def_static("readFits", (Image<PixelT>(*)(fits::MemFileManager &, int))Image<PixelT>::readFits,
                    "manager"_a, "hdu"_a = fits::DEFAULT_HDU);
+    cls.def("writeScratch",
+            (void (Image<PixelT>::*)(std::string const &, ScratchWriteOptions const &) const) &
+                    Image<PixelT>::writeScratch,
+            "fileName"_a, "options"_a = ScratchWriteOptions());
+    cls.def_static("readScratch", &Image<PixelT>::readScratch, "fileName"_a);
     cls.def("sqrt", &Image<PixelT>::sqrt);
 
     return cls;
@@ -434,6 +457,9 @@ PYBIND11_MODULE(image, mod) {
     declareImageBase<std::uint16_t>(mod, "U");
     declareImageBase<std::uint64_t>(mod, "L");
 
+    // ScratchWriteOptions is used as a default value in Mask and Image methods
+    declareScratchWriteOptions(mod);
+
     // Mask must be declared before Image because a mask is used as a default value in at least one method
     declareMask<MaskPixel>(mod, "X");
 
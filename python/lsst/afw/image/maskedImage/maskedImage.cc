@@ -25,6 +25,7 @@
 
 #include "lsst/afw/fits.h"
 #include "lsst/afw/image/MaskedImage.h"
+#include "lsst/afw/image/ScratchFile.h"
 
 namespace py = pybind11;
 using namespace pybind11::literals;
@@ -176,6 +177,10 @@ PyMaskedImage<ImagePixelT> declareMaskedImage(py::module &mod, const std::string
 
     cls.def_static("readFits", (MI(*)(std::string const &))MI::readFits, "filename"_a);
     cls.def_static("readFits", (MI(*)(fits::MemFileManager &))MI::readFits, "manager"_a);
+    cls.def("writeScratch", (void (MI::*)(std::string const &, ScratchWriteOptions const &) const) &
+                                    MI::writeScratch,
+            "fileName"_a, "options"_a = ScratchWriteOptions());
+    cls.def_static("readScratch", &MI::readScratch, "fileName"_a);
     cls.def("getImage", &MI::getImage);
     cls.def("setImage", &MI::setImage);
     cls.def_property("image", &MI::getImage, &MI::setImage);
@@ -20,6 +20,7 @@
  */
 
 #include "pybind11/pybind11.h"
+#include "pybind11/stl.h"
 
 #include "ndarray/pybind11.h"
 
@@ -29,6 +30,8 @@
 #include "lsst/afw/image/MaskFitsReader.h"
 #include "lsst/afw/image/MaskedImageFitsReader.h"
 #include "lsst/afw/image/ExposureFitsReader.h"
+#include "lsst/afw/image/ExposureCutoutReader.h"
+#include "lsst/afw/image/ScratchFile.h"
 #include "lsst/afw/geom/SkyWcs.h"
 #include "lsst/afw/geom/polygon/Polygon.h"
 #include "lsst/afw/detection/Psf.h"
@@ -72,6 +75,9 @@ void declareSinglePlaneMethods(py::class_<Class, Args...> & cls) {
     cls.def("readDType", [](Class & self) { return py::dtype(self.readDType()); });
     cls.def("getHdu", &Class::getHdu);
     cls.def_property_readonly("hdu", &Class::getHdu);
+    cls.def("setMapping", &Class::setMapping, "mapping"_a);
+    cls.def("getMapping", &Class::getMapping);
+    cls.def_property("mapping", &Class::getMapping, &Class::setMapping);
     cls.def(
         "readArray",
         [](Class & self, lsst::geom::Box2I const & bbox, ImageOrigin origin, bool allowUnsafe,
@@ -260,6 +266,9 @@ void declareMaskedImageFitsReader(py::module & mod) {
     cls.def("readImageMetadata", &MaskedImageFitsReader::readImageMetadata);
     cls.def("readMaskMetadata", &MaskedImageFitsReader::readMaskMetadata);
     cls.def("readVarianceMetadata", &MaskedImageFitsReader::readVarianceMetadata);
+    cls.def("setMapping", &MaskedImageFitsReader::setMapping, "mapping"_a);
+    cls.def("getMapping", &MaskedImageFitsReader::getMapping);
+    cls.def_property("mapping", &MaskedImageFitsReader::getMapping, &MaskedImageFitsReader::setMapping);
     cls.def(
         "read",
         [](MaskedImageFitsReader & self, lsst::geom::Box2I const & bbox, ImageOrigin origin,
@@ -336,6 +345,122 @@ void declareExposureFitsReader(py::module & mod) {
     );
 }
 
+void declareExposureCutoutReader(py::module & mod) {
+    py::class_<ExposureCutoutReader, std::shared_ptr<ExposureCutoutReader>> cls(mod, "ExposureCutoutReader");
+    py::class_<ExposureCutoutReader::Request> clsRequest(cls, "Request");
+    clsRequest.def(
+        py::init([](std::string const & fileName, lsst::geom::Box2I const & bbox) {
+            return ExposureCutoutReader::Request{fileName, bbox};
+        }),
+        "fileName"_a, "bbox"_a
+    );
+    clsRequest.def_readwrite("fileName", &ExposureCutoutReader::Request::fileName);
+    clsRequest.def_readwrite("bbox", &ExposureCutoutReader::Request::bbox);
+    cls.def(py::init<int, std::size_t>(), "nThreads"_a=1, "maxOpenFiles"_a=16);
+    cls.def("getThreadCount", &ExposureCutoutReader::getThreadCount);
+    cls.def("getMaxOpenFiles", &ExposureCutoutReader::getMaxOpenFiles);
+    cls.def("closeFiles", &ExposureCutoutReader::closeFiles);
+    cls.def(
+        "readMaskedImages",
+        [](ExposureCutoutReader & self, std::vector<ExposureCutoutReader::Request> const & requests,
+           ImageOrigin origin, bool allowUnsafe, py::object dtype) {
+            return utils::python::TemplateInvoker().apply(
+                [&](auto t) {
+                    py::gil_scoped_release release;
+                    return self.readMaskedImages<decltype(t)>(requests, origin, allowUnsafe);
+                },
+                py::dtype(dtype),
+                utils::python::TemplateInvoker::Tag<std::uint16_t, int, float, double, std::uint64_t>()
+            );
+        },
+        "requests"_a, "origin"_a=PARENT, "allowUnsafe"_a=false, "dtype"_a=py::dtype("float32")
+    );
+    cls.def(
+        "readExposures",
+        [](ExposureCutoutReader & self, std::vector<ExposureCutoutReader::Request> const & requests,
+           ImageOrigin origin, bool allowUnsafe, py::object dtype) {
+            return utils::python::TemplateInvoker().apply(
+                [&](auto t) {
+                    py::gil_scoped_release release;
+                    return self.readExposures<decltype(t)>(requests, origin, allowUnsafe);
+                },
+                py::dtype(dtype),
+                utils::python::TemplateInvoker::Tag<std::uint16_t, int, float, double, std::uint64_t>()
+            );
+        },
+        "requests"_a, "origin"_a=PARENT, "allowUnsafe"_a=false, "dtype"_a=py::dtype("float32")
+    );
+}
+
+void declareScratchFileReader(py::module & mod) {
+    py::class_<ScratchFileReader, std::shared_ptr<ScratchFileReader>> cls(mod, "ScratchFileReader");
+    cls.def(py::init<std::string const &>(), "fileName"_a);
+    cls.def("getFileName", &ScratchFileReader::getFileName);
+    cls.def_property_readonly("fileName", &ScratchFileReader::getFileName);
+    cls.def("readBBox", &ScratchFileReader::readBBox, "origin"_a=PARENT);
+    cls.def("readImageDType", [](ScratchFileReader & self) { return py::dtype(self.readImageDType()); });
+    cls.def("hasMask", &ScratchFileReader::hasMask);
+    cls.def("hasVariance", &ScratchFileReader::hasVariance);
+    cls.def("hasExposureInfo", &ScratchFileReader::hasExposureInfo);
+    cls.def("setMapping", &ScratchFileReader::setMapping, "mapping"_a);
+    cls.def("getMapping", &ScratchFileReader::getMapping);
+    cls.def_property("mapping", &ScratchFileReader::getMapping, &ScratchFileReader::setMapping);
+    cls.def(
+        "readImage",
+        [](ScratchFileReader & self, lsst::geom::Box2I const & bbox, ImageOrigin origin, py::object dtype) {
+            if (dtype.is(py::none())) {
+                dtype = py::dtype(self.readImageDType());
+            }
+            return utils::python::TemplateInvoker().apply(
+                [&](auto t) {
+                    return self.readImage<decltype(t)>(bbox, origin);
+                },
+                py::dtype(dtype),
+                utils::python::TemplateInvoker::Tag<std::uint16_t, int, float, double, std::uint64_t>()
+            );
+        },
+        "bbox"_a=lsst::geom::Box2I(), "origin"_a=PARENT, "dtype"_a=py::none()
+    );
+    cls.def("readMask", &ScratchFileReader::readMask<MaskPixel>,
+            "bbox"_a=lsst::geom::Box2I(), "origin"_a=PARENT, "conformMasks"_a=false);
+    cls.def("readVariance", &ScratchFileReader::readVariance<VariancePixel>,
+            "bbox"_a=lsst::geom::Box2I(), "origin"_a=PARENT);
+    cls.def("readExposureInfo", &ScratchFileReader::readExposureInfo);
+    cls.def(
+        "readMaskedImage",
+        [](ScratchFileReader & self, lsst::geom::Box2I const & bbox, ImageOrigin origin,
+           bool conformMasks, py::object dtype) {
+            if (dtype.is(py::none())) {
+                dtype = py::dtype(self.readImageDType());
+            }
+            return utils::python::TemplateInvoker().apply(
+                [&](auto t) {
+                    return self.readMaskedImage<decltype(t)>(bbox, origin, conformMasks);
+                },
+                py::dtype(dtype),
+                utils::python::TemplateInvoker::Tag<std::uint16_t, int, float, double, std::uint64_t>()
+            );
+        },
+        "bbox"_a=lsst::geom::Box2I(), "origin"_a=PARENT, "conformMasks"_a=false, "dtype"_a=py::none()
+    );
+    cls.def(
+        "readExposure",
+        [](ScratchFileReader & self, lsst::geom::Box2I const & bbox, ImageOrigin origin,
+           bool conformMasks, py::object dtype) {
+            if (dtype.is(py::none())) {
+                dtype = py::dtype(self.readImageDType());
+            }
+            return utils::python::TemplateInvoker().apply(
+                [&](auto t) {
+                    return self.readExposure<decltype(t)>(bbox, origin, conformMasks);
+                },
+                py::dtype(dtype),
+                utils::python::TemplateInvoker::Tag<std::uint16_t, int, float, double, std::uint64_t>()
+            );
+        },
+        "bbox"_a=lsst::geom::Box2I(), "origin"_a=PARENT, "conformMasks"_a=false, "dtype"_a=py::none()
+    );
+}
 
 PYBIND11_MODULE(readers, mod) {
     py::module::import("lsst.daf.base");
@@ -347,6 +472,8 @@ PYBIND11_MODULE(readers, mod) {
     declareMaskFitsReader(mod);
     declareMaskedImageFitsReader(mod);
     declareExposureFitsReader(mod);
+    declareExposureCutoutReader(mod);
+    declareScratchFileReader(mod);
 }
 
 }}}}  // namespace lsst::afw::image::<anonymous>
@@ -32,6 +32,7 @@ from .simple import *
 from .source import *
 from .ampInfo import *
 from .exposure import *
+from .catalogIndex import *
 from .match import *
 from .catalogMatches import *
 from .wcsUtils import *
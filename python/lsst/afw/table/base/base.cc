@@ -40,6 +40,7 @@ and makes wrapping Base catalogs more similar to all other types of catalog.
 #include "lsst/afw/table/BaseTable.h"
 #include "lsst/afw/table/python/catalog.h"
 #include "lsst/afw/table/python/columnView.h"
+#include "lsst/afw/table/python/compactCatalog.h"
 
 namespace py = pybind11;
 using namespace pybind11::literals;
@@ -161,6 +162,8 @@ PyBaseTable declareBaseTable(py::module &mod) {
     cls.def("getBufferSize", &BaseTable::getBufferSize);
     cls.def("clone", &BaseTable::clone);
     cls.def("preallocate", &BaseTable::preallocate);
+    cls.def("setColumnar", &BaseTable::setColumnar, "columnar"_a);
+    cls.def("isColumnar", &BaseTable::isColumnar);
 
     return cls;
 }
@@ -173,6 +176,7 @@ PYBIND11_MODULE(base, mod) {
     auto clsBaseRecord = declareBaseRecord(mod);
     auto clsBaseCatalog = table::python::declareCatalog<BaseRecord>(mod, "Base");
     auto clsBaseColumnView = table::python::declareColumnView<BaseRecord>(mod, "Base");
+    auto clsBaseCompactCatalog = table::python::declareCompactCatalog<BaseRecord>(mod, "Base");
 
     clsBaseRecord.attr("Table") = clsBaseTable;
     clsBaseRecord.attr("ColumnView") = clsBaseColumnView;
@@ -183,6 +187,8 @@ PYBIND11_MODULE(base, mod) {
     clsBaseCatalog.attr("Record") = clsBaseRecord;
     clsBaseCatalog.attr("Table") = clsBaseTable;
     clsBaseCatalog.attr("ColumnView") = clsBaseColumnView;
+    clsBaseCompactCatalog.attr("Record") = clsBaseRecord;
+    clsBaseCompactCatalog.attr("Table") = clsBaseTable;
 }
 }
 }
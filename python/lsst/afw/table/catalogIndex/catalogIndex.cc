@@ -0,0 +1,135 @@
+/*
+ * LSST Data Management System
+ * Copyright 2018  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#include "pybind11/pybind11.h"
+#include "pybind11/stl.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "lsst/afw/table/BaseRecord.h"
+#include "lsst/afw/table/Catalog.h"
+#include "lsst/afw/table/CatalogIndex.h"
+#include "lsst/afw/table/Simple.h"
+#include "lsst/afw/table/Source.h"
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+
+namespace lsst {
+namespace afw {
+namespace table {
+namespace {
+
+// Add join overloads to an index class for catalogs of one record type.
+template <typename OtherRecordT, typename PyClass, typename Index, typename... T>
+void declareJoin(PyClass &cls) {
+    cls.def("join", [](Index const &self, CatalogT<OtherRecordT> const &catalog, Key<T> const &... keys) {
+        return self.join(catalog, keys...);
+    });
+}
+
+// Declare the methods HashIndex and SortedIndex have in common, and add the class to the registry.
+template <typename RecordT, typename Index, typename... T>
+py::class_<Index, std::shared_ptr<Index>> declareIndex(py::module &mod, std::string const &kind,
+                                                       std::string const &record, std::string const &suffix) {
+    py::class_<Index, std::shared_ptr<Index>> cls(mod, (record + kind + suffix).c_str());
+    cls.def(py::init<Key<T> const &...>());
+    cls.def("__len__", &Index::size);
+    cls.def("clear", &Index::clear);
+    cls.def("getValue", &Index::getValue, "record"_a);
+    cls.def("insert", &Index::insert, "record"_a);
+    cls.def("extend",
+            [](Index &self, CatalogT<RecordT> const &catalog, int nThreads) {
+                self.extend(catalog, nThreads);
+            },
+            "catalog"_a, "nThreads"_a = 1);
+    cls.def("erase", &Index::erase, "record"_a);
+    cls.def("find", &Index::find, "value"_a);
+    cls.def("findAll", &Index::findAll, "value"_a);
+    cls.def("count", &Index::count, "value"_a);
+    declareJoin<BaseRecord, decltype(cls), Index, T...>(cls);
+    declareJoin<SimpleRecord, decltype(cls), Index, T...>(cls);
+    declareJoin<SourceRecord, decltype(cls), Index, T...>(cls);
+    py::dict registry = mod.attr(("_" + kind).c_str());
+    registry[py::make_tuple(record, suffix)] = cls;
+    return cls;
+}
+
+template <typename RecordT, typename... T>
+void declareHashIndex(py::module &mod, std::string const &record, std::string const &suffix) {
+    declareIndex<RecordT, HashIndex<RecordT, T...>, T...>(mod, "HashIndex", record, suffix);
+}
+
+template <typename RecordT, typename... T>
+void declareSortedIndex(py::module &mod, std::string const &record, std::string const &suffix) {
+    using Index = SortedIndex<RecordT, T...>;
+    using Value = typename Index::Value;
+    auto cls = declareIndex<RecordT, Index, T...>(mod, "SortedIndex", record, suffix);
+    cls.def("findRange", &Index::findRange, "lower"_a, "upper"_a);
+    cls.def("__iter__", [](Index const &self) { return py::make_iterator(self.begin(), self.end()); },
+            py::keep_alive<0, 1>());
+    cls.def("lower_bound", [](Index const &self, Value const &value) -> std::ptrdiff_t {
+        return self.lower_bound(value) - self.begin();
+    });
+    cls.def("upper_bound", [](Index const &self, Value const &value) -> std::ptrdiff_t {
+        return self.upper_bound(value) - self.begin();
+    });
+}
+
+// Declare indexes on the field types (and pairs of them) that are commonly used to identify records:
+// IDs and visit/detector numbers.
+template <typename RecordT>
+void declareIndexes(py::module &mod, std::string const &record) {
+    declareHashIndex<RecordT, std::int32_t>(mod, record, "I");
+    declareHashIndex<RecordT, std::int64_t>(mod, record, "L");
+    declareHashIndex<RecordT, std::int64_t, std::int32_t>(mod, record, "LI");
+    declareHashIndex<RecordT, std::int64_t, std::int64_t>(mod, record, "LL");
+    declareHashIndex<RecordT, std::int32_t, std::int32_t>(mod, record, "II");
+    declareSortedIndex<RecordT, std::int32_t>(mod, record, "I");
+    declareSortedIndex<RecordT, std::int64_t>(mod, record, "L");
+    declareSortedIndex<RecordT, float>(mod, record, "F");
+    declareSortedIndex<RecordT, double>(mod, record, "D");
+    declareSortedIndex<RecordT, std::int64_t, std::int32_t>(mod, record, "LI");
+    declareSortedIndex<RecordT, std::int64_t, std::int64_t>(mod, record, "LL");
+    declareSortedIndex<RecordT, std::int32_t, std::int32_t>(mod, record, "II");
+}
+
+PYBIND11_MODULE(catalogIndex, mod) {
+    py::module::import("lsst.afw.table.base");
+    py::module::import("lsst.afw.table.simple");
+    py::module::import("lsst.afw.table.source");
+
+    // Dicts of index classes, keyed by (record type name prefix, key type suffixes), used by
+    // makeHashIndex and makeSortedIndex.
+    mod.attr("_HashIndex") = py::dict();
+    mod.attr("_SortedIndex") = py::dict();
+
+    declareIndexes<BaseRecord>(mod, "Base");
+    declareIndexes<SimpleRecord>(mod, "Simple");
+    declareIndexes<SourceRecord>(mod, "Source");
+}
+}
+}
+}
+}  // namespace lsst::afw::table::<anonymous>
@@ -0,0 +1,86 @@
+#
+# LSST Data Management System
+# Copyright 2018 LSST/AURA.
+#
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the LSST License Statement and
+# the GNU General Public License along with this program.  If not,
+# see <http://www.lsstcorp.org/LegalNotices/>.
+#
+
+__all__ = ["makeHashIndex", "makeSortedIndex"]
+
+from . import catalogIndex
+
+
+def _makeIndex(registry, kind, catalog, keys, nThreads):
+    record = catalog.Record.__name__[:-len("Record")]
+    # Key classes are named KeyI, KeyL, etc.
+    suffix = "".join(type(key).__name__[len("Key"):] for key in keys)
+    try:
+        cls = registry[(record, suffix)]
+    except KeyError:
+        raise TypeError("No %s for %s records on keys of type %s" % (kind, record, suffix))
+    index = cls(*keys)
+    index.extend(catalog, nThreads=nThreads)
+    return index
+
+
+def makeHashIndex(catalog, *keys, nThreads=1):
+    """Build a hash index on one or more fields of a catalog's records.
+
+    Parameters
+    ----------
+    catalog : `lsst.afw.table.BaseCatalog`, `SimpleCatalog` or `SourceCatalog`
+        Catalog whose records are added to the index.
+    *keys : `lsst.afw.table.Key`
+        Keys of the indexed fields; indexes on more than one field are
+        looked up by tuples of values.
+    nThreads : `int`
+        Number of threads used to extract the indexed values (<= 0 for one
+        per core).
+
+    Returns
+    -------
+    index
+        A ``HashIndex`` holding all records of the catalog.  The index is
+        not updated when the catalog changes; use its ``insert`` and
+        ``erase`` methods to mirror such changes.
+    """
+    return _makeIndex(catalogIndex._HashIndex, "HashIndex", catalog, keys, nThreads)
+
+
+def makeSortedIndex(catalog, *keys, nThreads=1):
+    """Build a sorted index on one or more fields of a catalog's records.
+
+    Parameters
+    ----------
+    catalog : `lsst.afw.table.BaseCatalog`, `SimpleCatalog` or `SourceCatalog`
+        Catalog whose records are added to the index.
+    *keys : `lsst.afw.table.Key`
+        Keys of the indexed fields; indexes on more than one field are
+        looked up by tuples of values.
+    nThreads : `int`
+        Number of threads used to extract and sort the indexed values (<= 0
+        for one per core).
+
+    Returns
+    -------
+    index
+        A ``SortedIndex`` holding all records of the catalog.  The index is
+        not updated when the catalog changes; use its ``insert`` and
+        ``erase`` methods to mirror such changes.
+    """
+    return _makeIndex(catalogIndex._SortedIndex, "SortedIndex", catalog, keys, nThreads)
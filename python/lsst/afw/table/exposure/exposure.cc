@@ -169,6 +169,10 @@ PYBIND11_MODULE(exposure, mod) {
     py::module::import("lsst.afw.geom");
     // afw.image and afw.detection cannot be imported due to circular dependencies
 
+    // ExposureFitsFlags enum values are used as integer masks, so wrap as attributes instead of an enum
+    mod.attr("EXPOSURE_IO_DEDUPLICATE_ARCHIVE") =
+            static_cast<int>(ExposureFitsFlags::EXPOSURE_IO_DEDUPLICATE_ARCHIVE);
+
     auto clsExposureRecord = declareExposureRecord(mod);
     auto clsExposureTable = declareExposureTable(mod);
     auto clsExposureColumnView = table::python::declareColumnView<ExposureRecord>(mod, "Exposure");
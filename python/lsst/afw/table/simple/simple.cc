@@ -28,6 +28,7 @@
 #include "lsst/afw/table/Simple.h"
 #include "lsst/afw/table/python/catalog.h"
 #include "lsst/afw/table/python/columnView.h"
+#include "lsst/afw/table/python/compactCatalog.h"
 #include "lsst/afw/table/python/sortedCatalog.h"
 
 namespace py = pybind11;
@@ -92,6 +93,7 @@ PYBIND11_MODULE(simple, mod) {
     auto clsSimpleTable = declareSimpleTable(mod);
     auto clsSimpleColumnView = table::python::declareColumnView<SimpleRecord>(mod, "Simple");
     auto clsSimpleCatalog = table::python::declareSortedCatalog<SimpleRecord>(mod, "Simple");
+    auto clsSimpleCompactCatalog = table::python::declareCompactCatalog<SimpleRecord>(mod, "Simple");
 
     clsSimpleRecord.attr("Table") = clsSimpleTable;
     clsSimpleRecord.attr("ColumnView") = clsSimpleColumnView;
@@ -102,6 +104,8 @@ PYBIND11_MODULE(simple, mod) {
     clsSimpleCatalog.attr("Record") = clsSimpleRecord;
     clsSimpleCatalog.attr("Table") = clsSimpleTable;
     clsSimpleCatalog.attr("ColumnView") = clsSimpleColumnView;
+    clsSimpleCompactCatalog.attr("Record") = clsSimpleRecord;
+    clsSimpleCompactCatalog.attr("Table") = clsSimpleTable;
 }
 }
 }
@@ -43,11 +43,14 @@
 #include <memory>
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <set>
 #include <string>
 #include <typeinfo>
+#include <vector>
 #include "boost/format.hpp"
 #include "lsst/pex/exceptions.h"
+#include "lsst/afw/detail/parallel.h"
 #include "lsst/afw/image/MaskedImage.h"
 #include "lsst/afw/math/Statistics.h"
 #include "lsst/afw/detection/Peak.h"
@@ -189,20 +192,53 @@ private:
     T _old;
 };
 
+/*
+ * Return true if a peak of value a sorts before one of value b: brightest first, and NaNs, which
+ * compare false with everything and would otherwise break the sort's strict weak ordering, last
+ */
+template <typename T>
+inline bool peakValueBefore(T a, T b) {
+    if (std::isnan(a) || std::isnan(b)) {
+        return !std::isnan(a) && std::isnan(b);
+    }
+    return a > b;
+}
+
+/*
+ * A peak found in a Footprint, before it has been turned into a PeakRecord
+ *
+ * Candidates are found without touching the Footprint's PeakCatalog, so the search may run
+ * concurrently on many Footprints; the PeakRecords are then added serially.
+ */
+struct PeakCandidate {
+    int x, y;
+    float value;
+};
+
 /*
  * Sort peaks by decreasing pixel value.  N.b. -ve peaks are sorted the same way as +ve ones
+ *
+ * PeakCandidates are sorted in the same order as the PeakRecords they will become.
  */
 struct SortPeaks {
-    bool operator()(std::shared_ptr<PeakRecord const> a, std::shared_ptr<PeakRecord const> b) {
-        if (a->getPeakValue() != b->getPeakValue()) {
-            return (a->getPeakValue() > b->getPeakValue());
+    bool operator()(std::shared_ptr<PeakRecord const> a, std::shared_ptr<PeakRecord const> b) const {
+        return (*this)(PeakCandidate{a->getIx(), a->getIy(), a->getPeakValue()},
+                       PeakCandidate{b->getIx(), b->getIy(), b->getPeakValue()});
+    }
+
+    bool operator()(PeakCandidate const &a, PeakCandidate const &b) const {
+        if (peakValueBefore(a.value, b.value)) {
+            return true;
+        }
+        if (peakValueBefore(b.value, a.value)) {
+            return false;
         }
 
-        if (a->getIx() != b->getIx()) {
-            return (a->getIx() < b->getIx());
+        if (a.x != b.x) {
+            return (a.x < b.x);
         }
 
-        return (a->getIy() < b->getIy());
+        return (a.y < b.y);
     }
 };
 /*
@@ -470,8 +506,8 @@ int resolve_alias(std::vector<int> const &aliases, /* list of aliases */
 
 namespace {
 template <typename ImageT>
-void findPeaksInFootprint(ImageT const &image, bool polarity, PeakCatalog &peaks, Footprint &foot,
-                          std::size_t const margin = 0) {
+void findPeaksInFootprint(ImageT const &image, bool polarity, Footprint const &foot,
+                          std::vector<PeakCandidate> &candidates, std::size_t const margin = 0) {
     auto spanSet = foot.getSpans();
     if (spanSet->size() == 0) {
         return;
@@ -503,7 +539,8 @@ void findPeaksInFootprint(ImageT const &image, bool polarity, PeakCatalog &peaks
                 }
             }
 
-            foot.addPeak(x + image.getX0(), y + image.getY0(), val);
+            candidates.push_back(
+                    PeakCandidate{x + image.getX0(), y + image.getY0(), static_cast<float>(val)});
         }
     }
 }
@@ -534,7 +571,9 @@ public:
         }
     }
 
-    void addRecord(Footprint &foot) const { foot.addPeak(_x, _y, _polarity ? _max : _min); }
+    PeakCandidate getCandidate() const {
+        return PeakCandidate{_x, _y, static_cast<float>(_polarity ? _max : _min)};
+    }
 
 private:
     bool _polarity;
@@ -542,28 +581,73 @@ private:
     double _min, _max;
 };
 
+/*
+ * Find the sorted peak candidates in a single Footprint
+ *
+ * Only reads the Footprint and image (through pixel accessors rather than ndarray views, whose
+ * reference counts are not thread safe), so may be called concurrently for different Footprints.
+ */
 template <typename ImageT, typename ThresholdT>
-void findPeaks(std::shared_ptr<Footprint> foot, ImageT const &img, bool polarity, ThresholdT) {
-    findPeaksInFootprint(img, polarity, foot->getPeaks(), *foot, 1);
+void findPeakCandidates(Footprint const &foot, ImageT const &img, bool polarity,
+                        std::vector<PeakCandidate> &candidates, ThresholdT) {
+    findPeaksInFootprint(img, polarity, foot, candidates, 1);
+    // Candidates are at distinct pixels so the ordering is total, and need not be stable
+    std::sort(candidates.begin(), candidates.end(), SortPeaks());
 
-    // We use getInternal() here to get the vector of shared_ptr that Catalog uses internally,
-    // which causes the STL algorithm to copy pointers instead of PeakRecords (which is what
-    // it'd try to do if we passed Catalog's own iterators).
-    std::stable_sort(foot->getPeaks().getInternal().begin(), foot->getPeaks().getInternal().end(),
-                     SortPeaks());
-
-    if (foot->getPeaks().empty()) {
+    if (candidates.empty()) {
         FindMaxInFootprint<typename ImageT::Pixel> maxFinder(polarity);
-        foot->getSpans()->applyFunctor(maxFinder, ndarray::ndImage(img.getArray(), img.getXY0()));
-        maxFinder.addRecord(*foot);
+        for (auto const &spn : *foot.getSpans()) {
+            int const y = spn.getY();
+            for (int x = spn.getX0(); x <= spn.getX1(); ++x) {
+                maxFinder(lsst::geom::Point2I(x, y), img(x - img.getX0(), y - img.getY0()));
+            }
+        }
+        candidates.push_back(maxFinder.getCandidate());
     }
 }
 
 // No need to search for peaks when processing a Mask
 template <typename ImageT>
-void findPeaks(std::shared_ptr<Footprint>, ImageT const &, bool, ThresholdBitmask_traits) {
+void findPeakCandidates(Footprint const &, ImageT const &, bool, std::vector<PeakCandidate> &,
+                        ThresholdBitmask_traits) {
     ;
 }
+
+/*
+ * Find and set the peaks of all Footprints, using up to nThreads threads
+ *
+ * Candidates are found for each Footprint in parallel, then added to the Footprints serially in
+ * Footprint order, so the result does not depend on nThreads. All Footprints share the PeakTable
+ * for the minimal schema, whose record storage is allocated in a single block.
+ */
+template <typename ImageT, typename ThresholdT>
+void findPeaks(FootprintSet::FootprintList &footprints, ImageT const &img, bool polarity, int nThreads,
+               ThresholdT) {
+    std::size_t const nFootprints = footprints.size();
+    std::vector<std::vector<PeakCandidate>> candidates(nFootprints);
+
+    // Footprint sizes vary widely, so hand them out one at a time rather than in fixed chunks
+    lsst::afw::detail::forEachParallel(
+            nFootprints, lsst::afw::detail::getThreadCount(nThreads), [&](std::size_t, std::size_t i) {
+                findPeakCandidates(*footprints[i], img, polarity, candidates[i], ThresholdT());
+            });
+
+    std::size_t nPeaks = 0;
+    for (auto const &footCandidates : candidates) {
+        nPeaks += footCandidates.size();
+    }
+    if (nPeaks == 0) {
+        return;
+    }
+    footprints.front()->getPeaks().getTable()->preallocate(nPeaks);
+    for (std::size_t i = 0; i < nFootprints; ++i) {
+        PeakCatalog &peaks = footprints[i]->getPeaks();
+        peaks.reserve(peaks.size() + candidates[i].size());
+        for (auto const &candidate : candidates[i]) {
+            footprints[i]->addPeak(candidate.x, candidate.y, candidate.value);
+        }
+    }
+}
 }  // namespace
 
 /*
@@ -614,7 +698,8 @@ static void findFootprints(
         double const includeThresholdMultiplier,  // threshold (relative to footprintThreshold) for inclusion
         bool const polarity,                      // if false, search _below_ thresholdVal
         int const npixMin,                        // minimum number of pixels in an object
-        bool const setPeaks                       // should I set the Peaks list?
+        bool const setPeaks,                      // should I set the Peaks list?
+        int const nThreads = 1                    // number of threads to use when setting Peaks
 ) {
     int id;       /* object ID */
     int in_span;  /* object ID of current IdSpan */
@@ -761,22 +846,19 @@ static void findFootprints(
      * Find all peaks within those Footprints
      */
     if (setPeaks) {
-        typedef FootprintSet::FootprintList::iterator fiterator;
-        for (fiterator ptr = _footprints->begin(), end = _footprints->end(); ptr != end; ++ptr) {
-            findPeaks(*ptr, img, polarity, ThresholdTraitT());
-        }
+        findPeaks(*_footprints, img, polarity, nThreads, ThresholdTraitT());
     }
 }
 
 template <typename ImagePixelT>
 FootprintSet::FootprintSet(image::Image<ImagePixelT> const &img, Threshold const &threshold,
-                           int const npixMin, bool const setPeaks)
+                           int const npixMin, bool const setPeaks, int const nThreads)
         : daf::base::Citizen(typeid(this)), _footprints(new FootprintList()), _region(img.getBBox()) {
     typedef float VariancePixelT;
 
     findFootprints<ImagePixelT, image::MaskPixel, VariancePixelT, ThresholdLevel_traits>(
             _footprints.get(), _region, img, NULL, threshold.getValue(img), threshold.getIncludeMultiplier(),
-            threshold.getPolarity(), npixMin, setPeaks);
+            threshold.getPolarity(), npixMin, setPeaks, nThreads);
 }
 
 // NOTE: not a template to appease swig (see note by instantiations at bottom)
@@ -806,7 +888,7 @@ FootprintSet::FootprintSet(image::Mask<MaskPixelT> const &msk, Threshold const &
 template <typename ImagePixelT, typename MaskPixelT>
 FootprintSet::FootprintSet(const image::MaskedImage<ImagePixelT, MaskPixelT> &maskedImg,
                            Threshold const &threshold, std::string const &planeName, int const npixMin,
-                           bool const setPeaks)
+                           bool const setPeaks, int const nThreads)
         : daf::base::Citizen(typeid(this)),
           _footprints(new FootprintList()),
           _region(lsst::geom::Point2I(maskedImg.getX0(), maskedImg.getY0()),
@@ -818,13 +900,13 @@ FootprintSet::FootprintSet(const image::MaskedImage<ImagePixelT, MaskPixelT> &ma
             findFootprints<ImagePixelT, MaskPixelT, VariancePixelT, ThresholdPixelLevel_traits>(
                     _footprints.get(), _region, *maskedImg.getImage(), maskedImg.getVariance().get(),
                     threshold.getValue(maskedImg), threshold.getIncludeMultiplier(), threshold.getPolarity(),
-                    npixMin, setPeaks);
+                    npixMin, setPeaks, nThreads);
             break;
         default:
             findFootprints<ImagePixelT, MaskPixelT, VariancePixelT, ThresholdLevel_traits>(
                     _footprints.get(), _region, *maskedImg.getImage(), maskedImg.getVariance().get(),
                     threshold.getValue(maskedImg), threshold.getIncludeMultiplier(), threshold.getPolarity(),
-                    npixMin, setPeaks);
+                    npixMin, setPeaks, nThreads);
             break;
     }
     // Set Mask if requested
@@ -972,9 +1054,10 @@ void FootprintSet::makeSources(afw::table::SourceCatalog &cat) const {
 
 #define INSTANTIATE(PIXEL)                                                                              \
     template FootprintSet::FootprintSet(image::Image<PIXEL> const &, Threshold const &, int const,      \
-                                        bool const);                                                    \
+                                        bool const, int const);                                         \
     template FootprintSet::FootprintSet(image::MaskedImage<PIXEL, image::MaskPixel> const &,            \
-                                        Threshold const &, std::string const &, int const, bool const); \
+                                        Threshold const &, std::string const &, int const, bool const,  \
+                                        int const);                                                     \
     template void FootprintSet::makeHeavy(image::MaskedImage<PIXEL, image::MaskPixel> const &,          \
                                           HeavyFootprintCtrl const *)
 
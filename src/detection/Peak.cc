@@ -92,6 +92,9 @@ static PeakFitsReader const peakFitsReader;
 
 PeakRecord::PeakRecord(std::shared_ptr<PeakTable> const& table) : BaseRecord(table) {}
 
+PeakRecord::PeakRecord(std::shared_ptr<PeakTable> const& table, afw::table::detail::RecordView const& view)
+        : BaseRecord(table, view) {}
+
 std::ostream& operator<<(std::ostream& os, PeakRecord const& record) {
     return os << (boost::format("%d: (%d,%d)  (%.3f,%.3f)") % record.getId() % record.getIx() %
                   record.getIy() % record.getFx() % record.getFy());
@@ -172,6 +175,11 @@ std::shared_ptr<afw::table::BaseRecord> PeakTable::_makeRecord() {
     return record;
 }
 
+std::shared_ptr<afw::table::BaseRecord> PeakTable::_makeRecordView(
+        afw::table::detail::RecordView const& view) {
+    return std::shared_ptr<PeakRecord>(new PeakRecord(getSelf<PeakTable>(), view));
+}
+
 }  // namespace detection
 
 namespace table {
@@ -1,19 +1,26 @@
 // -*- lsst-c++ -*-
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <complex>
 #include <cmath>
 #include <sstream>
 #include <unordered_set>
 #include <unordered_map>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include "fitsio.h"
 extern "C" {
 #include "fitsio2.h"
 }
 
-#include "boost/regex.hpp"
 #include "boost/filesystem.hpp"
 #include "boost/preprocessor/seq/for_each.hpp"
 #include "boost/format.hpp"
@@ -21,6 +28,7 @@ extern "C" {
 #include "lsst/pex/exceptions.h"
 #include "lsst/log/Log.h"
 #include "lsst/afw/fits.h"
+#include "lsst/afw/detail/parallel.h"
 #include "lsst/geom/Angle.h"
 #include "lsst/afw/geom/wcsUtils.h"
 #include "lsst/afw/fitsCompression.h"
@@ -347,6 +355,14 @@ bool isFitsImageTypeSigned(int constant) {
 }
 
 static bool allowImageCompression = true;
+static int compressionThreads = 0;
+static thread_local int compressionThreadLimit = 0;  // per-thread cap on compressionThreads; zero for none
+
+// Number of threads on which the calling thread should compress or decompress tiles
+static std::size_t getCompressionThreadCount() {
+    std::size_t const nThreads = afw::detail::getThreadCount(compressionThreads);
+    return compressionThreadLimit > 0 ? std::min<std::size_t>(nThreads, compressionThreadLimit) : nThreads;
+}
 
 int fitsTypeForBitpix(int bitpix) {
     switch (bitpix) {
@@ -759,61 +775,208 @@ void Fits::readKey(std::string const &key, T &value) {
     }
 }
 
-void Fits::forEachKey(HeaderIterationFunctor &functor) {
-    char key[81];  // allow for terminating NUL
-    char value[81];
-    char comment[81];
+namespace {
+
+std::size_t const CARD_LENGTH = 80;
+
+// Length of a header card without its trailing blanks, as cfitsio's ffgrec returns it.
+std::size_t getCardLength(char const *card) {
+    std::size_t length = CARD_LENGTH;
+    while (length > 0 && (card[length - 1] == ' ' || card[length - 1] == '\0')) {
+        --length;
+    }
+    return length;
+}
+
+// Remove trailing blanks, as cfitsio does for comments.
+void stripTrailingBlanks(std::string &s) {
+    std::size_t const end = s.find_last_not_of(' ');
+    s.erase(end == std::string::npos ? 0 : end + 1);
+}
+
+// Extract the keyword name from a header card; this follows cfitsio's ffgknm.
+std::string parseCardKey(char const *card, std::size_t length) {
+    std::size_t const maxLength = FLEN_KEYWORD - 1;
+    if (length >= 9 && std::strncmp(card, "HIERARCH ", 9) == 0) {
+        char const *equals = static_cast<char const *>(std::memchr(card, '=', length));
+        if (!equals) {
+            return "HIERARCH";
+        }
+        char const *begin = card + 9;
+        while (*begin == ' ') ++begin;
+        char const *end = equals;
+        while (end > begin && end[-1] == ' ') --end;
+        return std::string(begin, end);
+    }
+    std::size_t n = 0;
+    while (n < maxLength && n < length && card[n] != ' ' && card[n] != '=') ++n;
+    return std::string(card, n);
+}
+
+// Split a header card into its value and comment strings; this follows cfitsio's ffpsvc,
+// including keeping the quotes around string values.  Returns a cfitsio status code.
+int parseCardValue(char const *card, std::size_t length, std::string &value, std::string &comment) {
+    value.clear();
+    comment.clear();
+    std::size_t pos;  // start of the value
+    if (length < 9 || std::strncmp(card, "COMMENT ", 8) == 0 || std::strncmp(card, "HISTORY ", 8) == 0 ||
+        std::strncmp(card, "END     ", 8) == 0 || std::strncmp(card, "CONTINUE", 8) == 0 ||
+        std::strncmp(card, "        ", 8) == 0) {
+        // keywords with no value: the comment is the rest of the card
+        if (length > 8) comment.assign(card + 8, length - 8);
+        return 0;
+    } else if (std::strncmp(card, "HIERARCH ", 9) == 0) {
+        char const *equals = static_cast<char const *>(std::memchr(card, '=', length));
+        if (!equals) {
+            comment.assign(card + 8, length - 8);
+            stripTrailingBlanks(comment);
+            return 0;
+        }
+        pos = equals - card + 1;
+    } else if (card[8] != '=' || card[9] != ' ') {  // cards are always 80 characters, so this is safe
+        // no value indicator
+        comment.assign(card + 8, length - 8);
+        stripTrailingBlanks(comment);
+        return 0;
+    } else {
+        pos = 10;
+    }
+    while (pos < length && card[pos] == ' ') ++pos;
+    if (pos >= length) {
+        // no value: the keyword is undefined
+        return 0;
+    }
+    if (card[pos] == '/') {
+        ++pos;
+    } else if (card[pos] == '\'') {
+        std::size_t end = pos + 1;
+        for (; end < length; ++end) {
+            if (card[end] == '\'') {
+                if (end + 1 < length && card[end + 1] == '\'') {
+                    ++end;  // escaped quote, which we keep doubled like cfitsio
+                } else {
+                    break;
+                }
+            }
+        }
+        if (end == length) {
+            value.assign(card + pos, std::min<std::size_t>(length - pos, 69));
+            value += '\'';
+            ffpmsg("This keyword string value has no closing quote:");
+            ffpmsg(std::string(card, length).c_str());
+            return NO_QUOTE;
+        }
+        value.assign(card + pos, end + 1 - pos);
+        pos = end + 1;
+    } else if (card[pos] == '(') {
+        char const *close = static_cast<char const *>(std::memchr(card + pos, ')', length - pos));
+        if (!close) {
+            ffpmsg("This complex keyword value has no closing ')':");
+            ffpmsg(std::string(card, length).c_str());
+            return NO_QUOTE;
+        }
+        std::size_t const end = close - card + 1;
+        value.assign(card + pos, end - pos);
+        pos = end;
+    } else {
+        std::size_t end = pos;
+        while (end < length && card[end] != ' ' && card[end] != '/') ++end;
+        value.assign(card + pos, end - pos);
+        pos = end;
+    }
+    while (pos < length && card[pos] == ' ') ++pos;
+    if (pos < length) {
+        if (card[pos] == '/') {
+            ++pos;
+            if (pos < length && card[pos] == ' ') ++pos;
+        }
+        comment.assign(card + pos, length - pos);
+        stripTrailingBlanks(comment);
+    }
+    return 0;
+}
+
+/*
+ *  Call a functor for the keys in the current HDU, optionally only those in a set.
+ *
+ *  Rather than asking cfitsio for each card in turn, this reads the whole header in one call and
+ *  splits the cards itself, with the same results as fits_read_keyn.  Cards for keys not in the set
+ *  are skipped without being parsed further.
+ */
+void readHeaderCards(Fits &fits, HeaderIterationFunctor &functor,
+                     std::unordered_set<std::string> const *keys = nullptr) {
+    fitsfile *fptr = reinterpret_cast<fitsfile *>(fits.fptr);
     int nKeys = 0;
-    fits_get_hdrspace(reinterpret_cast<fitsfile *>(fptr), &nKeys, 0, &status);
+    // This also loads the current HDU, so the header position below is valid.
+    fits_get_hdrspace(fptr, &nKeys, 0, &fits.status);
+    std::vector<char> header(CARD_LENGTH * std::max(nKeys, 0));
+    if (!header.empty()) {
+        ffmbyt(fptr, fptr->Fptr->headstart[fptr->Fptr->curhdu], REPORT_EOF, &fits.status);
+        ffgbyt(fptr, header.size(), header.data(), &fits.status);
+    }
+    if (fits.behavior & Fits::AUTO_CHECK) {
+        LSST_FITS_CHECK_STATUS(fits, "Reading header");
+    }
+    if (fits.status != 0) {
+        return;
+    }
     std::string keyStr;
     std::string valueStr;
     std::string commentStr;
-    int i = 1;
-    while (i <= nKeys) {
-        fits_read_keyn(reinterpret_cast<fitsfile *>(fptr), i, key, value, comment, &status);
-        keyStr = key;
-        valueStr = value;
-        commentStr = comment;
+    int i = 0;  // index of the next card
+    while (i < nKeys) {
+        char const *card = &header[CARD_LENGTH * i];
+        std::size_t const length = getCardLength(card);
         ++i;
-        while (valueStr.size() > 2 && valueStr[valueStr.size() - 2] == '&' && i <= nKeys) {
-            // we're using key to hold the entire record here; the actual key is safe in keyStr
-            fits_read_record(reinterpret_cast<fitsfile *>(fptr), i, key, &status);
-            if (strncmp(key, "CONTINUE", 8) != 0) {
+        keyStr = parseCardKey(card, length);
+        if (keys && keys->find(keyStr) == keys->end()) {
+            continue;
+        }
+        int cardStatus = 0;
+        if (std::any_of(keyStr.begin(), keyStr.end(), [](char c) { return c < 32 || c > 126; })) {
+            ffpmsg((boost::format("Name of keyword no. %d contains illegal character(s): %s") % i %
+                    keyStr).str().c_str());
+            cardStatus = BAD_KEYCHAR;
+        } else {
+            cardStatus = parseCardValue(card, length, valueStr, commentStr);
+        }
+        if (fits.status == 0) {
+            fits.status = cardStatus;
+        }
+        while (valueStr.size() > 2 && valueStr[valueStr.size() - 2] == '&' && i < nKeys) {
+            card = &header[CARD_LENGTH * i];
+            if (strncmp(card, "CONTINUE", 8) != 0) {
                 // require both trailing '&' and CONTINUE to invoke long-string handling
                 break;
             }
-            std::string card = key;
+            std::string const cardStr(card, getCardLength(card));
             valueStr.erase(valueStr.size() - 2);
-            std::size_t firstQuote = card.find('\'');
-            if (firstQuote == std::string::npos) {
-                throw LSST_EXCEPT(
-                        FitsError,
-                        makeErrorMessage(
-                                fptr, status,
-                                boost::format("Invalid CONTINUE at header key %d: \"%s\".") % i % card));
-            }
-            std::size_t lastQuote = card.find('\'', firstQuote + 1);
+            std::size_t firstQuote = cardStr.find('\'');
+            std::size_t lastQuote =
+                    (firstQuote == std::string::npos) ? firstQuote : cardStr.find('\'', firstQuote + 1);
             if (lastQuote == std::string::npos) {
-                throw LSST_EXCEPT(
-                        FitsError,
-                        makeErrorMessage(
-                                fptr, status,
-                                boost::format("Invalid CONTINUE at header key %d: \"%s\".") % i % card));
+                throw LSST_FITS_EXCEPT(FitsError, fits,
+                                       boost::format("Invalid CONTINUE at header key %d: \"%s\".") % (i + 1) %
+                                               cardStr);
             }
-            valueStr += card.substr(firstQuote + 1, lastQuote - firstQuote);
-            std::size_t slash = card.find('/', lastQuote + 1);
+            valueStr += cardStr.substr(firstQuote + 1, lastQuote - firstQuote);
+            std::size_t slash = cardStr.find('/', lastQuote + 1);
             if (slash != std::string::npos) {
-                commentStr += strip(card.substr(slash + 1));
+                commentStr += strip(cardStr.substr(slash + 1));
             }
             ++i;
         }
-        if (behavior & AUTO_CHECK) {
-            LSST_FITS_CHECK_STATUS(*this, boost::format("Reading key '%s'") % keyStr);
+        if (fits.behavior & Fits::AUTO_CHECK) {
+            LSST_FITS_CHECK_STATUS(fits, boost::format("Reading key '%s'") % keyStr);
         }
         functor(keyStr, valueStr, commentStr);
     }
 }
 
+}  // namespace
+
+void Fits::forEachKey(HeaderIterationFunctor &functor) { readHeaderCards(*this, functor); }
+
 // ---- Reading and writing PropertySet/PropertyList --------------------------------------------------------
 
 namespace {
@@ -885,50 +1048,108 @@ public:
     daf::base::PropertyList *list;
 };
 
+// The types a header value string may be interpreted as.
+enum class ValueKind { BOOL, INT, DOUBLE, STRING, OTHER };
+
+bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+/*
+ *  Classify a header value string as returned by Fits::forEachKey.
+ *
+ *  Integers match [+-]?[0-9]+, floating-point values match
+ *  [+-]?([0-9]*\.?[0-9]+|[0-9]+\.?[0-9]*)([eE][+-]?[0-9]+)?, and strings are enclosed in single quotes.
+ */
+ValueKind classifyValue(std::string const &value) {
+    std::size_t const n = value.size();
+    if (n == 0) {
+        return ValueKind::OTHER;
+    }
+    if (n == 1 && (value[0] == 'T' || value[0] == 't' || value[0] == 'F' || value[0] == 'f')) {
+        return ValueKind::BOOL;
+    }
+    if (value[0] == '\'') {
+        return (n >= 2 && value[n - 1] == '\'') ? ValueKind::STRING : ValueKind::OTHER;
+    }
+    std::size_t i = (value[0] == '+' || value[0] == '-') ? 1 : 0;
+    std::size_t nDigits = 0;
+    for (; i < n && isDigit(value[i]); ++i) ++nDigits;
+    if (i == n) {
+        return (nDigits > 0) ? ValueKind::INT : ValueKind::OTHER;
+    }
+    if (value[i] == '.') {
+        for (++i; i < n && isDigit(value[i]); ++i) ++nDigits;
+    }
+    if (nDigits == 0) {
+        return ValueKind::OTHER;
+    }
+    if (i < n && (value[i] == 'e' || value[i] == 'E')) {
+        ++i;
+        if (i < n && (value[i] == '+' || value[i] == '-')) ++i;
+        std::size_t const expStart = i;
+        while (i < n && isDigit(value[i])) ++i;
+        if (i == expStart) {
+            return ValueKind::OTHER;
+        }
+    }
+    return (i == n) ? ValueKind::DOUBLE : ValueKind::OTHER;
+}
+
+// Whether a comment is part of the two-line comment added to all FITS headers by cfitsio.
+bool isFitsDefinitionComment(std::string const &comment) {
+    static char const *const starts[] = {"FITS (Flexible Image Transport System)",
+                                         "and Astrophysics', volume 376, page 359"};
+    std::size_t const begin = comment.find_first_not_of(' ');
+    if (begin == std::string::npos) {
+        return false;
+    }
+    for (char const *start : starts) {
+        if (comment.compare(begin, std::strlen(start), start) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void MetadataIterationFunctor::operator()(std::string const &key, std::string const &value,
                                           std::string const &comment) {
-    static boost::regex const boolRegex("[tTfF]");
-    static boost::regex const intRegex("[+-]?[0-9]+");
-    static boost::regex const doubleRegex("[+-]?([0-9]*\\.?[0-9]+|[0-9]+\\.?[0-9]*)([eE][+-]?[0-9]+)?");
-    static boost::regex const fitsStringRegex("'(.*?) *'");
-    // regex for two-line comment added to all FITS headers by CFITSIO
-    static boost::regex const fitsDefinitionCommentRegex(
-        " *(FITS \\(Flexible Image Transport System\\)|and Astrophysics', volume 376, page 359).*");
-    boost::smatch matchStrings;
-
     if (strip && isKeyIgnored(key)) {
         return;
     }
 
-    std::istringstream converter(value);
-    if (boost::regex_match(value, boolRegex)) {
-        // convert the string to an bool
-        add(key, bool(value == "T" || value == "t"), comment);
-    } else if (boost::regex_match(value, intRegex)) {
-        // convert the string to an int
-        std::int64_t val;
-        converter >> val;
-        if (val < (1LL << 31) && val > -(1LL << 31)) {
-            add(key, static_cast<int>(val), comment);
-        } else {
-            add(key, val, comment);
-        }
-    } else if (boost::regex_match(value, doubleRegex)) {
-        // convert the string to a double
-        double val;
-        converter >> val;
-        add(key, val, comment);
-    } else if (boost::regex_match(value, matchStrings, fitsStringRegex)) {
-        std::string const str = matchStrings[1].str();  // strip off the enclosing single quotes
-        double val = stringToNonFiniteDouble(str);
-        if (val != 0.0) {
-            add(key, val, comment);
-        } else {
-            add(key, str, comment);
+    switch (classifyValue(value)) {
+        case ValueKind::BOOL:
+            add(key, bool(value == "T" || value == "t"), comment);
+            return;
+        case ValueKind::INT: {
+            std::int64_t val = std::strtoll(value.c_str(), nullptr, 10);
+            if (val < (1LL << 31) && val > -(1LL << 31)) {
+                add(key, static_cast<int>(val), comment);
+            } else {
+                add(key, val, comment);
+            }
+            return;
+        }
+        case ValueKind::DOUBLE:
+            add(key, std::strtod(value.c_str(), nullptr), comment);
+            return;
+        case ValueKind::STRING: {
+            // strip off the enclosing single quotes and trailing blanks
+            std::string str = value.substr(1, value.size() - 2);
+            str.erase(str.find_last_not_of(' ') + 1);
+            double val = stringToNonFiniteDouble(str);
+            if (val != 0.0) {
+                add(key, val, comment);
+            } else {
+                add(key, str, comment);
+            }
+            return;
         }
-    } else if (key == "HISTORY") {
+        case ValueKind::OTHER:
+            break;
+    }
+    if (key == "HISTORY") {
         add(key, comment, "");
-    } else if (key == "COMMENT" && !(strip && boost::regex_match(comment, fitsDefinitionCommentRegex))) {
+    } else if (key == "COMMENT" && !(strip && isFitsDefinitionComment(comment))) {
         add(key, comment, "");
     } else if (value.empty()) {
         // do nothing for empty values that are comments
@@ -1051,6 +1272,15 @@ void Fits::readMetadata(daf::base::PropertySet &metadata, bool strip) {
     forEachKey(f);
 }
 
+void Fits::readMetadata(daf::base::PropertySet &metadata, bool strip, std::vector<std::string> const &keys) {
+    MetadataIterationFunctor f;
+    f.strip = strip;
+    f.set = &metadata;
+    f.list = dynamic_cast<daf::base::PropertyList *>(&metadata);
+    std::unordered_set<std::string> const keySet(keys.begin(), keys.end());
+    readHeaderCards(*this, f, &keySet);
+}
+
 void Fits::writeMetadata(daf::base::PropertySet const &metadata) {
     typedef std::vector<std::string> NameList;
     daf::base::PropertyList const *pl = dynamic_cast<daf::base::PropertyList const *>(&metadata);
@@ -1147,6 +1377,23 @@ void Fits::writeTableScalar(std::size_t row, int col, std::string const &value)
     }
 }
 
+void Fits::writeTableBytes(std::size_t row, std::size_t nBytes, std::uint8_t const *data) {
+    fits_write_tblbytes(reinterpret_cast<fitsfile *>(fptr), row + 1, 1, nBytes,
+                        const_cast<unsigned char *>(data), &status);
+    if (behavior & AUTO_CHECK) {
+        LSST_FITS_CHECK_STATUS(*this, boost::format("Writing %d bytes starting at table row %d") % nBytes %
+                                              row);
+    }
+}
+
+void Fits::readTableBytes(std::size_t row, std::size_t nBytes, std::uint8_t *data) {
+    fits_read_tblbytes(reinterpret_cast<fitsfile *>(fptr), row + 1, 1, nBytes, data, &status);
+    if (behavior & AUTO_CHECK) {
+        LSST_FITS_CHECK_STATUS(*this, boost::format("Reading %d bytes starting at table row %d") % nBytes %
+                                              row);
+    }
+}
+
 template <typename T>
 void Fits::readTableArray(std::size_t row, int col, int nElements, T *value) {
     int anynul = false;
@@ -1249,6 +1496,284 @@ private:
     ImageCompressionOptions old;  // Former compression options, to be restored
 };
 
+/// cfitsio's Rice coder for each pixel type we compress and decompress ourselves
+template <typename T>
+struct RiceCodec {
+    static bool constexpr supported = false;
+};
+
+template <>
+struct RiceCodec<std::uint8_t> {
+    static bool constexpr supported = true;
+    static int constexpr bitpix = 8;
+    static double constexpr bzero = 0.0;
+    static int compress(std::uint8_t *in, int n, unsigned char *out, int outSize, int blockSize) {
+        return fits_rcomp_byte(reinterpret_cast<signed char *>(in), n, out, outSize, blockSize);
+    }
+    static int decompress(unsigned char *in, int inSize, std::uint8_t *out, int n, int blockSize) {
+        return fits_rdecomp_byte(in, inSize, out, n, blockSize);
+    }
+};
+
+template <>
+struct RiceCodec<std::int16_t> {
+    static bool constexpr supported = true;
+    static int constexpr bitpix = 16;
+    static double constexpr bzero = 0.0;
+    static int compress(std::int16_t *in, int n, unsigned char *out, int outSize, int blockSize) {
+        return fits_rcomp_short(in, n, out, outSize, blockSize);
+    }
+    static int decompress(unsigned char *in, int inSize, std::int16_t *out, int n, int blockSize) {
+        return fits_rdecomp_short(in, inSize, reinterpret_cast<unsigned short *>(out), n, blockSize);
+    }
+};
+
+/// Unsigned 16-bit integers are stored as signed integers with BZERO = 32768, which flips the sign bit.
+template <>
+struct RiceCodec<std::uint16_t> {
+    static bool constexpr supported = true;
+    static int constexpr bitpix = 16;
+    static double constexpr bzero = 32768.0;
+    static int compress(std::uint16_t *in, int n, unsigned char *out, int outSize, int blockSize) {
+        for (int i = 0; i < n; ++i) in[i] ^= 0x8000;
+        return fits_rcomp_short(reinterpret_cast<short *>(in), n, out, outSize, blockSize);
+    }
+    static int decompress(unsigned char *in, int inSize, std::uint16_t *out, int n, int blockSize) {
+        int const result = fits_rdecomp_short(in, inSize, out, n, blockSize);
+        for (int i = 0; i < n; ++i) out[i] ^= 0x8000;
+        return result;
+    }
+};
+
+template <>
+struct RiceCodec<std::int32_t> {
+    static bool constexpr supported = true;
+    static int constexpr bitpix = 32;
+    static double constexpr bzero = 0.0;
+    static int compress(std::int32_t *in, int n, unsigned char *out, int outSize, int blockSize) {
+        return fits_rcomp(in, n, out, outSize, blockSize);
+    }
+    static int decompress(unsigned char *in, int inSize, std::int32_t *out, int n, int blockSize) {
+        return fits_rdecomp(in, inSize, reinterpret_cast<unsigned int *>(out), n, blockSize);
+    }
+};
+
+/// Layout of a 2-d RICE_1 tile-compressed image HDU
+struct RiceTiling {
+    long nx, ny;        // image dimensions
+    long tileX, tileY;  // nominal tile dimensions; tiles on the upper edges may be smaller
+    long blockSize;     // pixels per Rice block
+    int column;         // COMPRESSED_DATA column
+
+    long getNumTilesX() const { return (nx + tileX - 1) / tileX; }
+    long getNumTilesY() const { return (ny + tileY - 1) / tileY; }
+
+    /// Pixel bounds [x0, x1) x [y0, y1) of a tile; tiles are numbered (from zero) with x varying fastest
+    void getTileBounds(long tile, long &x0, long &x1, long &y0, long &y1) const {
+        x0 = (tile % getNumTilesX()) * tileX;
+        y0 = (tile / getNumTilesX()) * tileY;
+        x1 = std::min(x0 + tileX, nx);
+        y1 = std::min(y0 + tileY, ny);
+    }
+};
+
+/**
+ *  Determine whether the current HDU is a RICE_1 compressed image we can compress or decompress
+ *  ourselves, and if so how it is tiled.
+ *
+ *  This is deliberately conservative: anything but a 2-d integer image with the given ZBITPIX and
+ *  BZERO (and no BSCALE), stored entirely in the COMPRESSED_DATA column, is left to cfitsio.
+ */
+bool readRiceTiling(fitsfile *fits, int zbitpix, double zero, RiceTiling &tiling) {
+    int status = 0;  // failures here only mean we fall back to cfitsio
+    if (!fits_is_compressed_image(fits, &status) || status) {
+        return false;
+    }
+    fits_write_errmark();  // missing keywords aren't errors worth reporting
+    bool const result = [&]() {
+        char value[FLEN_VALUE];
+        long bitpix = 0, naxis = 0;
+        fits_read_key_str(fits, "ZCMPTYPE", value, nullptr, &status);
+        fits_read_key_lng(fits, "ZBITPIX", &bitpix, nullptr, &status);
+        fits_read_key_lng(fits, "ZNAXIS", &naxis, nullptr, &status);
+        if (status || std::string(value) != "RICE_1" || bitpix != zbitpix || naxis != 2) {
+            return false;
+        }
+        fits_read_key_lng(fits, "ZNAXIS1", &tiling.nx, nullptr, &status);
+        fits_read_key_lng(fits, "ZNAXIS2", &tiling.ny, nullptr, &status);
+        fits_read_key_lng(fits, "ZTILE1", &tiling.tileX, nullptr, &status);
+        fits_read_key_lng(fits, "ZTILE2", &tiling.tileY, nullptr, &status);
+        if (status || tiling.nx <= 0 || tiling.ny <= 0 || tiling.tileX <= 0 || tiling.tileY <= 0 ||
+            tiling.getNumTilesX() * tiling.getNumTilesY() <= 1) {
+            return false;  // a single tile gains nothing from threads
+        }
+        // Compression parameters, with the defaults of the tiled image convention
+        tiling.blockSize = 32;
+        long bytePix = 4;
+        for (int i = 1; status == 0; ++i) {
+            long param = 0;
+            fits_read_key_str(fits, ("ZNAME" + std::to_string(i)).c_str(), value, nullptr, &status);
+            fits_read_key_lng(fits, ("ZVAL" + std::to_string(i)).c_str(), &param, nullptr, &status);
+            if (status) break;
+            if (std::string(value) == "BLOCKSIZE") {
+                tiling.blockSize = param;
+            } else if (std::string(value) == "BYTEPIX") {
+                bytePix = param;
+            }
+        }
+        if (status != KEY_NO_EXIST || bytePix != zbitpix / 8) {
+            return false;
+        }
+        status = 0;
+        double bscale = 1.0, bzero = 0.0;
+        fits_read_key_dbl(fits, "BSCALE", &bscale, nullptr, &status);
+        if (status == KEY_NO_EXIST) status = 0;
+        fits_read_key_dbl(fits, "BZERO", &bzero, nullptr, &status);
+        if (status == KEY_NO_EXIST) status = 0;
+        if (status || bscale != 1.0 || bzero != zero) {
+            return false;
+        }
+        int nColumns = 0;
+        fits_get_num_cols(fits, &nColumns, &status);
+        tiling.column = 0;
+        for (int i = 1; i <= nColumns && status == 0; ++i) {
+            fits_read_key_str(fits, ("TTYPE" + std::to_string(i)).c_str(), value, nullptr, &status);
+            if (std::string(value) == "COMPRESSED_DATA") {
+                tiling.column = i;
+            } else if (status == 0) {
+                return false;  // e.g. UNCOMPRESSED_DATA, ZSCALE, ZZERO, ZBLANK
+            }
+        }
+        return status == 0 && tiling.column > 0;
+    }();
+    fits_clear_errmark();
+    return result;
+}
+
+/**
+ *  Compress the image tiles of a freshly-created RICE_1 image HDU in parallel, and write them.
+ *
+ *  @returns false (having written nothing) if the HDU isn't one we handle, in which case the
+ *           pixels should be written by cfitsio.
+ */
+template <typename T>
+bool writeRiceTiles(Fits &file, T const *data) {
+    auto fits = reinterpret_cast<fitsfile *>(file.fptr);
+    RiceTiling tiling;
+    // BSCALE and BZERO are only written after the pixels (see Fits::writeImage), so none may be present yet.
+    if (!readRiceTiling(fits, RiceCodec<T>::bitpix, 0.0, tiling)) {
+        return false;
+    }
+    long const nTiles = tiling.getNumTilesX() * tiling.getNumTilesY();
+    std::size_t const nThreads = std::min<std::size_t>(getCompressionThreadCount(), nTiles);
+    std::vector<std::vector<unsigned char>> compressed(nTiles);
+    std::atomic<bool> failed(false);
+    // Tiles are handed out one at a time, since the cost of compressing one depends on its content.
+    afw::detail::forEachParallel(nTiles, nThreads, [&](std::size_t, std::size_t tile) {
+        long x0, x1, y0, y1;
+        tiling.getTileBounds(tile, x0, x1, y0, y1);
+        std::vector<T> pixels;
+        pixels.reserve((x1 - x0) * (y1 - y0));
+        for (long y = y0; y < y1; ++y) {
+            pixels.insert(pixels.end(), data + y * tiling.nx + x0, data + y * tiling.nx + x1);
+        }
+        // Incompressible data costs a few bits per block more than the raw pixels.
+        std::vector<unsigned char> &buffer = compressed[tile];
+        buffer.resize(pixels.size() * sizeof(T) + pixels.size() / 4 + 64);
+        int const size = RiceCodec<T>::compress(pixels.data(), pixels.size(), buffer.data(), buffer.size(),
+                                                tiling.blockSize);
+        if (size < 0) {
+            failed = true;
+        } else {
+            buffer.resize(size);
+        }
+    });
+    if (failed) {
+        return false;
+    }
+    LOGLS_DEBUG("afw.fits", "Compressed " << nTiles << " RICE_1 tiles on " << nThreads << " thread(s)");
+    // Tile i goes in row i + 1 of the table, and the data go on the heap in the order written.
+    for (long tile = 0; tile < nTiles && file.status == 0; ++tile) {
+        fits_write_col_byt(fits, tiling.column, tile + 1, 1, compressed[tile].size(),
+                           compressed[tile].data(), &file.status);
+    }
+    return true;
+}
+
+/**
+ *  Read a 2-d subimage of a RICE_1 image HDU, decompressing the tiles it overlaps in parallel.
+ *
+ *  @returns false (having read nothing) if the HDU isn't one we handle, in which case the pixels
+ *           should be read by cfitsio.
+ */
+template <typename T>
+bool readRiceTiles(Fits &file, T *data, long const *begin, long const *end, std::true_type) {
+    auto fits = reinterpret_cast<fitsfile *>(file.fptr);
+    RiceTiling tiling;
+    if (!readRiceTiling(fits, RiceCodec<T>::bitpix, RiceCodec<T>::bzero, tiling)) {
+        return false;
+    }
+    // begin and end are the (inclusive, unit-indexed) FITS pixel bounds; convert to [x0, x1) x [y0, y1)
+    long const x0 = begin[0] - 1, x1 = end[0], y0 = begin[1] - 1, y1 = end[1];
+    if (x0 < 0 || y0 < 0 || x1 > tiling.nx || y1 > tiling.ny || x0 >= x1 || y0 >= y1) {
+        return false;  // let cfitsio report the error
+    }
+    std::vector<long> tiles;
+    for (long ty = y0 / tiling.tileY; ty <= (y1 - 1) / tiling.tileY; ++ty) {
+        for (long tx = x0 / tiling.tileX; tx <= (x1 - 1) / tiling.tileX; ++tx) {
+            tiles.push_back(ty * tiling.getNumTilesX() + tx);
+        }
+    }
+    // cfitsio isn't thread-safe on a single file, so the compressed bytes are read serially.
+    std::vector<std::vector<unsigned char>> compressed(tiles.size());
+    for (std::size_t i = 0; i < tiles.size() && file.status == 0; ++i) {
+        LONGLONG size = 0, offset = 0;
+        int anyNulls = 0;
+        fits_read_descriptll(fits, tiling.column, tiles[i] + 1, &size, &offset, &file.status);
+        compressed[i].resize(size);
+        fits_read_col_byt(fits, tiling.column, tiles[i] + 1, 1, size, 0, compressed[i].data(), &anyNulls,
+                          &file.status);
+    }
+    if (file.status != 0) {
+        return true;  // leave the error for the caller to report
+    }
+    long const width = x1 - x0;
+    std::size_t const nThreads = std::min(getCompressionThreadCount(), tiles.size());
+    // cfitsio's error stack is global, so workers only note the first tile that fails to decompress,
+    // and the error is reported from this thread.
+    std::atomic<long> failedTile(-1);
+    afw::detail::forEachParallel(tiles.size(), nThreads, [&](std::size_t, std::size_t i) {
+        long tx0, tx1, ty0, ty1;
+        tiling.getTileBounds(tiles[i], tx0, tx1, ty0, ty1);
+        long const tileWidth = tx1 - tx0;
+        std::vector<T> pixels(tileWidth * (ty1 - ty0));
+        if (compressed[i].empty() ||
+            RiceCodec<T>::decompress(compressed[i].data(), compressed[i].size(), pixels.data(),
+                                     pixels.size(), tiling.blockSize) != 0) {
+            long expected = -1;
+            failedTile.compare_exchange_strong(expected, tiles[i]);
+            return;
+        }
+        long const cx0 = std::max(x0, tx0), cx1 = std::min(x1, tx1);
+        for (long y = std::max(y0, ty0); y < std::min(y1, ty1); ++y) {
+            T const *row = pixels.data() + (y - ty0) * tileWidth;
+            std::copy(row + cx0 - tx0, row + cx1 - tx0, data + (y - y0) * width + cx0 - x0);
+        }
+    });
+    if (failedTile >= 0) {
+        throw LSST_EXCEPT(FitsError, makeErrorMessage(fits, DATA_DECOMPRESSION_ERR,
+                                                      "Decompressing tile " + std::to_string(failedTile)));
+    }
+    LOGLS_DEBUG("afw.fits",
+                "Decompressed " << tiles.size() << " RICE_1 tiles on " << nThreads << " thread(s)");
+    return true;
+}
+
+template <typename T>
+bool readRiceTiles(Fits &, T *, long const *, long const *, std::false_type) {
+    return false;
+}
+
 }  // anonymous namespace
 
 template <typename T>
@@ -1304,8 +1829,33 @@ void Fits::writeImage(image::ImageBase<T> const &image, ImageWriteOptions const
 
     // Write the pixels
     int const fitsType = scale.bitpix == 0 ? FitsType<T>::CONSTANT : fitsTypeForBitpix(scale.bitpix);
-    fits_write_img(fits, fitsType, 1, pixels->getNumElements(), const_cast<void *>(pixels->getData()),
-                   &status);
+    // Rice-compressed integer tiles are compressed on our own threads; anything else is left to cfitsio.
+    bool written = false;
+    if (compression.algorithm == ImageCompressionOptions::RICE) {
+        switch (fitsType) {
+            case TBYTE:
+                written = writeRiceTiles(*this, static_cast<std::uint8_t const *>(pixels->getData()));
+                break;
+            case TSHORT:
+                written = writeRiceTiles(*this, static_cast<std::int16_t const *>(pixels->getData()));
+                break;
+            case TUSHORT:
+                // Unscaled unsigned pixels are stored with the sign bit flipped, which the BZERO written
+                // with the other scaling keywords below must then undo.
+                if (scale.bscale == 1.0 && scale.bzero == 0.0) {
+                    written = writeRiceTiles(*this, static_cast<std::uint16_t const *>(pixels->getData()));
+                    if (written) scale.bzero = RiceCodec<std::uint16_t>::bzero;
+                }
+                break;
+            case TINT:
+                written = writeRiceTiles(*this, static_cast<std::int32_t const *>(pixels->getData()));
+                break;
+        }
+    }
+    if (!written) {
+        fits_write_img(fits, fitsType, 1, pixels->getNumElements(), const_cast<void *>(pixels->getData()),
+                       &status);
+    }
     if (behavior & AUTO_CHECK) {
         LSST_FITS_CHECK_STATUS(*this, "Writing image");
     }
@@ -1371,6 +1921,11 @@ struct NullValue<T, typename std::enable_if<std::numeric_limits<T>::has_quiet_Na
 
 template <typename T>
 void Fits::readImageImpl(int nAxis, T *data, long *begin, long *end, long *increment) {
+    if (nAxis == 2 && increment[0] == 1 && increment[1] == 1 &&
+        readRiceTiles(*this, data, begin, end, std::integral_constant<bool, RiceCodec<T>::supported>())) {
+        if (behavior & AUTO_CHECK) LSST_FITS_CHECK_STATUS(*this, "Reading image");
+        return;
+    }
     T null = NullValue<T>::value;
     int anyNulls = 0;
     fits_read_subset(reinterpret_cast<fitsfile *>(fptr), FitsType<T>::CONSTANT, begin, end, increment,
@@ -1378,6 +1933,104 @@ void Fits::readImageImpl(int nAxis, T *data, long *begin, long *end, long *incre
     if (behavior & AUTO_CHECK) LSST_FITS_CHECK_STATUS(*this, "Reading image");
 }
 
+namespace {
+
+bool isLittleEndian() {
+    std::uint16_t const one = 1;
+    return *reinterpret_cast<unsigned char const *>(&one) == 1;
+}
+
+/// Convert N-byte pixels from FITS (big-endian) to native form in place, flipping the sign bit of
+/// unsigned integers stored with a BZERO offset.
+template <std::size_t N>
+void convertFromFits(unsigned char *data, std::size_t nPixels, bool swap, bool flipSign) {
+    for (std::size_t i = 0; i < nPixels; ++i, data += N) {
+        if (swap) std::reverse(data, data + N);
+        if (flipSign) data[swap ? N - 1 : 0] ^= 0x80;
+    }
+}
+
+}  // namespace
+
+template <typename T>
+ndarray::Array<T, 2, 1> Fits::mapImage(ndarray::Vector<int, 2> const &shape,
+                                       ndarray::Vector<int, 2> const &offset) {
+    auto fits = reinterpret_cast<fitsfile *>(fptr);
+    int localStatus = 0;  // failures here only mean the image can't be mapped
+    int mode = 0;
+    char urlType[FLEN_FILENAME];
+    fits_file_mode(fits, &mode, &localStatus);
+    fits_url_type(fits, urlType, &localStatus);
+    // Anything but a plain file opened read-only may differ from what's on disk (e.g. gzipped files,
+    // which cfitsio decompresses into memory, or buffered writes).
+    if (localStatus || mode != READONLY || std::string(urlType) != "file://" ||
+        fits_is_compressed_image(fits, &localStatus) || localStatus) {
+        return ndarray::Array<T, 2, 1>();
+    }
+    int bitpix = 0, nAxis = 0;
+    long nAxes[3] = {0, 0, 1};
+    fits_get_img_type(fits, &bitpix, &localStatus);
+    fits_get_img_dim(fits, &nAxis, &localStatus);
+    fits_get_img_size(fits, 3, nAxes, &localStatus);
+    if (localStatus || bitpix != detail::Bitpix<T>::value || nAxis < 2 || nAxis > 3 || nAxes[2] != 1 ||
+        offset[0] < 0 || offset[1] < 0 || shape[0] <= 0 || shape[1] <= 0 || offset[0] + shape[0] > nAxes[1] ||
+        offset[1] + shape[1] > nAxes[0]) {
+        return ndarray::Array<T, 2, 1>();
+    }
+    // Unsigned integers are stored as signed integers with BZERO = 2^(bits - 1); anything else scaled
+    // must be read through cfitsio.
+    bool const flipSign = std::numeric_limits<T>::is_integer && !std::numeric_limits<T>::is_signed &&
+                          sizeof(T) > 1;
+    double const expectedZero = flipSign ? std::ldexp(1.0, static_cast<int>(8 * sizeof(T) - 1)) : 0.0;
+    double bscale = 1.0, bzero = 0.0;
+    fits_write_errmark();  // missing keywords aren't errors worth reporting
+    fits_read_key_dbl(fits, "BSCALE", &bscale, nullptr, &localStatus);
+    if (localStatus == KEY_NO_EXIST) localStatus = 0;
+    fits_read_key_dbl(fits, "BZERO", &bzero, nullptr, &localStatus);
+    if (localStatus == KEY_NO_EXIST) localStatus = 0;
+    fits_clear_errmark();
+    LONGLONG headStart = 0, dataStart = 0, dataEnd = 0;
+    fits_get_hduaddrll(fits, &headStart, &dataStart, &dataEnd, &localStatus);
+    if (localStatus || bscale != 1.0 || bzero != expectedZero) {
+        return ndarray::Array<T, 2, 1>();
+    }
+
+    // Map only the pages holding the requested rows; the data unit starts on a 2880-byte FITS block, so
+    // the pixels are aligned.
+    std::size_t const rowBytes = nAxes[0] * sizeof(T);
+    std::size_t const first = dataStart + offset[0] * rowBytes + offset[1] * sizeof(T);
+    std::size_t const last =
+            dataStart + (offset[0] + shape[0] - 1) * rowBytes + (offset[1] + shape[1]) * sizeof(T);
+    std::size_t const mapStart = first - first % sysconf(_SC_PAGESIZE);
+    std::size_t const mapSize = last - mapStart;
+    int const fd = ::open(getFileName().c_str(), O_RDONLY);
+    if (fd < 0) {
+        return ndarray::Array<T, 2, 1>();
+    }
+    struct stat info;
+    void *mem = MAP_FAILED;
+    if (::fstat(fd, &info) == 0 && static_cast<std::size_t>(info.st_size) >= last) {
+        mem = ::mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, mapStart);
+    }
+    ::close(fd);  // the mapping holds its own reference to the file
+    if (mem == MAP_FAILED) {
+        return ndarray::Array<T, 2, 1>();
+    }
+    std::shared_ptr<unsigned char> mapping(static_cast<unsigned char *>(mem),
+                                           [mapSize](unsigned char *p) { ::munmap(p, mapSize); });
+    T *data = reinterpret_cast<T *>(mapping.get() + (first - mapStart));
+
+    bool const swap = sizeof(T) > 1 && isLittleEndian();
+    if (swap || flipSign) {
+        for (int y = 0; y < shape[0]; ++y) {
+            convertFromFits<sizeof(T)>(reinterpret_cast<unsigned char *>(data + y * nAxes[0]), shape[1], swap,
+                                       flipSign);
+        }
+    }
+    return ndarray::external(data, ndarray::makeVector(shape[0], shape[1]),
+                             ndarray::makeVector(static_cast<int>(nAxes[0]), 1), mapping);
+}
+
 int Fits::getImageDim() {
     int nAxis = 0;
     fits_get_img_dim(reinterpret_cast<fitsfile *>(fptr), &nAxis, &status);
@@ -1506,6 +2159,14 @@ void setAllowImageCompression(bool allow) { allowImageCompression = allow; }
 
 bool getAllowImageCompression() { return allowImageCompression; }
 
+void setCompressionThreads(int nThreads) { compressionThreads = nThreads; }
+
+int getCompressionThreads() { return compressionThreads; }
+
+void setCompressionThreadLimit(int nThreads) { compressionThreadLimit = nThreads; }
+
+int getCompressionThreadLimit() { return compressionThreadLimit; }
+
 // ---- Manipulating files ----------------------------------------------------------------------------------
 
 Fits::Fits(std::string const &filename, std::string const &mode, int behavior_)
@@ -1613,21 +2274,27 @@ std::shared_ptr<daf::base::PropertyList> combineMetadata(
     return combined;
 }
 
-std::shared_ptr<daf::base::PropertyList> readMetadata(std::string const &fileName, int hdu, bool strip) {
-    fits::Fits fp(fileName, "r", fits::Fits::AUTO_CLOSE | fits::Fits::AUTO_CHECK);
-    fp.setHdu(hdu);
-    return readMetadata(fp, strip);
-}
-
-std::shared_ptr<daf::base::PropertyList> readMetadata(fits::MemFileManager &manager, int hdu, bool strip) {
-    fits::Fits fp(manager, "r", fits::Fits::AUTO_CLOSE | fits::Fits::AUTO_CHECK);
-    fp.setHdu(hdu);
-    return readMetadata(fp, strip);
-}
+namespace {
 
-std::shared_ptr<daf::base::PropertyList> readMetadata(fits::Fits &fitsfile, bool strip) {
+// Read a header with INHERIT support, optionally only the given keys.
+std::shared_ptr<daf::base::PropertyList> readMetadataImpl(fits::Fits &fitsfile, bool strip,
+                                                          std::vector<std::string> const *keys) {
+    // INHERIT decides whether the primary HDU is read too, so we need it whether or not it was asked for.
+    std::vector<std::string> keysWithInherit;
+    bool const keepInherit = !keys || std::find(keys->begin(), keys->end(), "INHERIT") != keys->end();
+    if (keys) {
+        keysWithInherit = *keys;
+        if (!keepInherit) keysWithInherit.push_back("INHERIT");
+    }
+    auto readHdu = [&](daf::base::PropertyList &metadata) {
+        if (keys) {
+            fitsfile.readMetadata(metadata, strip, keysWithInherit);
+        } else {
+            fitsfile.readMetadata(metadata, strip);
+        }
+    };
     auto metadata = std::make_shared<lsst::daf::base::PropertyList>();
-    fitsfile.readMetadata(*metadata, strip);
+    readHdu(*metadata);
     // if INHERIT=T, we want to also include header entries from the primary HDU
     int oldHdu = fitsfile.getHdu();
     if (oldHdu != 0 && metadata->exists("INHERIT")) {
@@ -1637,24 +2304,64 @@ std::shared_ptr<daf::base::PropertyList> readMetadata(fits::Fits &fitsfile, bool
         } else {
             inherit = metadata->get<bool>("INHERIT");
         }
-        if (strip) metadata->remove("INHERIT");
+        if (strip || !keepInherit) metadata->remove("INHERIT");
         if (inherit) {
             HduMoveGuard guard(fitsfile, 0);
             // Combine the metadata from the primary HDU with the metadata from the specified HDU,
             // with non-comment values from the specified HDU superseding those in the primary HDU
             // and comments from the specified HDU appended to comments from the primary HDU
             auto primaryHduMetadata = std::make_shared<daf::base::PropertyList>();
-            fitsfile.readMetadata(*primaryHduMetadata, strip);
+            readHdu(*primaryHduMetadata);
+            if (!keepInherit) primaryHduMetadata->remove("INHERIT");
             metadata = combineMetadata(primaryHduMetadata, metadata);
         } else {
             // Purge invalid values
             auto const emptyMetadata = std::make_shared<lsst::daf::base::PropertyList>();
             metadata = combineMetadata(metadata, emptyMetadata);
         }
+    } else if (!keepInherit) {
+        metadata->remove("INHERIT");
     }
     return metadata;
 }
 
+}  // namespace
+
+std::shared_ptr<daf::base::PropertyList> readMetadata(std::string const &fileName, int hdu, bool strip) {
+    fits::Fits fp(fileName, "r", fits::Fits::AUTO_CLOSE | fits::Fits::AUTO_CHECK);
+    fp.setHdu(hdu);
+    return readMetadata(fp, strip);
+}
+
+std::shared_ptr<daf::base::PropertyList> readMetadata(std::string const &fileName, int hdu, bool strip,
+                                                      std::vector<std::string> const &keys) {
+    fits::Fits fp(fileName, "r", fits::Fits::AUTO_CLOSE | fits::Fits::AUTO_CHECK);
+    fp.setHdu(hdu);
+    return readMetadata(fp, strip, keys);
+}
+
+std::shared_ptr<daf::base::PropertyList> readMetadata(fits::MemFileManager &manager, int hdu, bool strip) {
+    fits::Fits fp(manager, "r", fits::Fits::AUTO_CLOSE | fits::Fits::AUTO_CHECK);
+    fp.setHdu(hdu);
+    return readMetadata(fp, strip);
+}
+
+std::shared_ptr<daf::base::PropertyList> readMetadata(fits::MemFileManager &manager, int hdu, bool strip,
+                                                      std::vector<std::string> const &keys) {
+    fits::Fits fp(manager, "r", fits::Fits::AUTO_CLOSE | fits::Fits::AUTO_CHECK);
+    fp.setHdu(hdu);
+    return readMetadata(fp, strip, keys);
+}
+
+std::shared_ptr<daf::base::PropertyList> readMetadata(fits::Fits &fitsfile, bool strip) {
+    return readMetadataImpl(fitsfile, strip, nullptr);
+}
+
+std::shared_ptr<daf::base::PropertyList> readMetadata(fits::Fits &fitsfile, bool strip,
+                                                      std::vector<std::string> const &keys) {
+    return readMetadataImpl(fitsfile, strip, &keys);
+}
+
 
 HduMoveGuard::HduMoveGuard(Fits & fits, int hdu, bool relative) :
     _fits(fits),
@@ -1719,7 +2426,8 @@ ImageWriteOptions::ImageWriteOptions(daf::base::PropertySet const &config)
                                                       : std::vector<std::string>{},
                   config.getAsInt("scaling.seed"), config.getAsDouble("scaling.quantizeLevel"),
                   config.getAsDouble("scaling.quantizePad"), config.get<bool>("scaling.fuzz"),
-                  config.getAsDouble("scaling.bscale"), config.getAsDouble("scaling.bzero")) {}
+                  config.getAsDouble("scaling.bscale"), config.getAsDouble("scaling.bzero"),
+                  config.exists("scaling.maxSamples") ? config.getAsInt64("scaling.maxSamples") : 0) {}
 
 namespace {
 
@@ -1754,6 +2462,7 @@ std::shared_ptr<daf::base::PropertySet> ImageWriteOptions::validate(daf::base::P
     validateEntry(*validated, config, "scaling.fuzz", true);
     validateEntry(*validated, config, "scaling.bscale", 1.0);
     validateEntry(*validated, config, "scaling.bzero", 0.0);
+    validateEntry(*validated, config, "scaling.maxSamples", 0);
 
     // Check for additional entries that we don't support (e.g., from typos)
     for (auto const &name : config.names(false)) {
@@ -1784,6 +2493,8 @@ std::shared_ptr<daf::base::PropertySet> ImageWriteOptions::validate(daf::base::P
                                    std::shared_ptr<daf::base::PropertySet const>,          \
                                    std::shared_ptr<image::Mask<image::MaskPixel> const>);  \
     template void Fits::readImageImpl(int, T *, long *, long *, long *);                   \
+    template ndarray::Array<T, 2, 1> Fits::mapImage(ndarray::Vector<int, 2> const &,       \
+                                                    ndarray::Vector<int, 2> const &);      \
     template bool Fits::checkImageType<T>();                                               \
     template int getBitPix<T>();
 
@@ -0,0 +1,109 @@
+// -*- lsst-c++ -*-
+
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+#include "fitsio.h"
+
+#include "lsst/log/Log.h"
+#include "lsst/afw/fits.h"
+#include "lsst/afw/fitsAsyncWriter.h"
+#include "lsst/afw/detail/parallel.h"
+
+namespace lsst {
+namespace afw {
+namespace fits {
+
+AsyncWriter::AsyncWriter(int nThreads, std::size_t maxPending)
+        : _maxPending(maxPending), _pending(0), _stopping(false) {
+    std::size_t const nWriters = afw::detail::getThreadCount(nThreads);
+    if (_maxPending == 0) {
+        _maxPending = 2 * nWriters;
+    }
+    if (!fits_is_reentrant()) {
+        LOGLS_WARN("afw.fits.AsyncWriter",
+                   "cfitsio is not reentrant; FITS files will be written on the calling thread.");
+        return;
+    }
+    // Share the hardware threads among the writers, rather than have each compress on all of them.
+    int const compressionThreadLimit =
+            std::max<std::size_t>(1, afw::detail::getThreadCount(0) / nWriters);
+    _threads.reserve(nWriters);
+    try {
+        for (std::size_t i = 0; i < nWriters; ++i) {
+            _threads.emplace_back(&AsyncWriter::_run, this, compressionThreadLimit);
+        }
+    } catch (...) {
+        _stop();  // the destructor won't be called
+        throw;
+    }
+}
+
+AsyncWriter::~AsyncWriter() noexcept { _stop(); }
+
+void AsyncWriter::_stop() noexcept {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _workAvailable.notify_all();
+    for (auto &thread : _threads) {
+        thread.join();  // threads finish everything queued before exiting
+    }
+}
+
+std::future<void> AsyncWriter::submit(std::function<void()> write) {
+    std::packaged_task<void()> task(std::move(write));
+    std::future<void> result = task.get_future();
+    if (_threads.empty()) {
+        task();  // any exception is stored in the future
+        return result;
+    }
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _taskDone.wait(lock, [this] { return _pending < _maxPending; });
+        _queue.push_back(std::move(task));
+        ++_pending;
+    }
+    _workAvailable.notify_one();
+    return result;
+}
+
+void AsyncWriter::wait() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _taskDone.wait(lock, [this] { return _pending == 0; });
+}
+
+std::size_t AsyncWriter::getPending() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _pending;
+}
+
+void AsyncWriter::_run(int compressionThreadLimit) {
+    setCompressionThreadLimit(compressionThreadLimit);
+    while (true) {
+        std::packaged_task<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _workAvailable.wait(lock, [this] { return _stopping || !_queue.empty(); });
+            if (_queue.empty()) {
+                return;  // stopping, and nothing left to do
+            }
+            task = std::move(_queue.front());
+            _queue.pop_front();
+        }
+        task();  // exceptions are stored in the future, not thrown
+        task = std::packaged_task<void()>();  // release the object written before making room for more
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            --_pending;
+        }
+        // Both submitters waiting for space and callers of wait() may be waiting.
+        _taskDone.notify_all();
+    }
+}
+
+}  // namespace fits
+}  // namespace afw
+}  // namespace lsst
@@ -130,7 +130,7 @@ std::string scalingAlgorithmToString(ImageScalingOptions::ScalingAlgorithm algor
 ImageScalingOptions::ImageScalingOptions(ScalingAlgorithm algorithm_, int bitpix_,
                                          std::vector<std::string> const& maskPlanes_, int seed_,
                                          float quantizeLevel_, float quantizePad_, bool fuzz_, double bscale_,
-                                         double bzero_)
+                                         double bzero_, std::size_t maxSamples_)
         : algorithm(algorithm_),
           bitpix(bitpix_),
           fuzz(fuzz_),
@@ -140,28 +140,65 @@ ImageScalingOptions::ImageScalingOptions(ScalingAlgorithm algorithm_, int bitpix
           quantizeLevel(quantizeLevel_),
           quantizePad(quantizePad_),
           bscale(bscale_),
-          bzero(bzero_) {}
+          bzero(bzero_),
+          maxSamples(maxSamples_) {}
 
 namespace {
 
 /// Calculate median and standard deviation for an image
+///
+/// If maxSamples is non-zero and smaller than the number of unmasked pixels, the statistics are
+/// estimated from maxSamples pixels instead of all of them: the unmasked pixels are divided into
+/// maxSamples runs of (nearly) equal length, and one pixel is chosen from each run at random, using a
+/// generator seeded with the given seed so the result is reproducible.  This avoids both aliasing
+/// with any regular pattern in the image (as a fixed stride would suffer) and clumping of the samples.
+/// For Gaussian noise, the standard error of the median estimate is then about 1.25/sqrt(maxSamples)
+/// times the standard deviation, and the relative standard error of the standard deviation estimate
+/// is about 1.17/sqrt(maxSamples) (e.g., 0.4% for 10^5 samples); estimates from all pixels have the
+/// same errors with maxSamples replaced by the number of unmasked pixels.
 template <typename T, int N>
 std::pair<T, T> calculateMedianStdev(ndarray::Array<T const, N, N> const& image,
-                                     ndarray::Array<bool, N, N> const& mask) {
+                                     ndarray::Array<bool, N, N> const& mask, std::size_t maxSamples,
+                                     int seed) {
     std::size_t num = 0;
     auto const& flatMask = ndarray::flatten<1>(mask);
     for (auto mm = flatMask.begin(); mm != flatMask.end(); ++mm) {
         if (!*mm) ++num;
     }
-    ndarray::Array<T, 1, 1> array = ndarray::allocate(num);
+    std::size_t const numSamples = (maxSamples > 0 && maxSamples < num) ? maxSamples : num;
+    ndarray::Array<T, 1, 1> array = ndarray::allocate(numSamples);
     auto const& flatImage = ndarray::flatten<1>(image);
     auto mm = ndarray::flatten<1>(mask).begin();
     auto aa = array.begin();
-    for (auto ii = flatImage.begin(); ii != flatImage.end(); ++ii, ++mm) {
-        if (*mm) continue;
-        *aa = *ii;
-        ++aa;
+    if (numSamples == num) {
+        for (auto ii = flatImage.begin(); ii != flatImage.end(); ++ii, ++mm) {
+            if (*mm) continue;
+            *aa = *ii;
+            ++aa;
+        }
+    } else {
+        math::Random rng(math::Random::MT19937, seed);
+        // Index (among unmasked pixels) of the pixel to take from run number k
+        auto choose = [num, numSamples, &rng](std::size_t k) {
+            std::size_t const begin = k * num / numSamples;
+            std::size_t const end = (k + 1) * num / numSamples;
+            return begin + rng.uniformInt(end - begin);
+        };
+        std::size_t index = 0;  // index of the current pixel among unmasked pixels
+        std::size_t sample = 0;
+        std::size_t target = choose(0);
+        for (auto ii = flatImage.begin(); ii != flatImage.end(); ++ii, ++mm) {
+            if (*mm) continue;
+            if (index == target) {
+                *aa = *ii;
+                ++aa;
+                if (++sample == numSamples) break;
+                target = choose(sample);
+            }
+            ++index;
+        }
     }
+    num = numSamples;
 
     // Quartiles; from https://stackoverflow.com/a/11965377/834250
     auto const q1 = num / 4;
@@ -233,7 +270,7 @@ template <typename T, int N>
 ImageScale ImageScalingOptions::determineFromStdev(ndarray::Array<T const, N, N> const& image,
                                                    ndarray::Array<bool, N, N> const& mask, bool isUnsigned,
                                                    bool cfitsioPadding) const {
-    auto stats = calculateMedianStdev(image, mask);
+    auto stats = calculateMedianStdev(image, mask, maxSamples, seed);
     auto const median = stats.first, stdev = stats.second;
     double const bscale = static_cast<T>(stdev / quantizeLevel);
 
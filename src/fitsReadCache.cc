@@ -0,0 +1,147 @@
+// -*- lsst-c++ -*-
+
+#include <climits>
+#include <cstdlib>
+#include <utility>
+
+#include <sys/stat.h>
+
+#include "boost/format.hpp"
+
+#include "lsst/pex/exceptions.h"
+#include "lsst/daf/base/PropertySet.h"
+#include "lsst/afw/fitsReadCache.h"
+
+namespace lsst {
+namespace afw {
+namespace fits {
+
+ReadCache &ReadCache::getInstance() {
+    static ReadCache instance;
+    return instance;
+}
+
+ReadCache::FileId ReadCache::identify(std::string const &fileName) const {
+    FileId result;
+    if (getCapacity() == 0) {
+        return result;
+    }
+    struct stat st;
+    char path[PATH_MAX];
+    if (::stat(fileName.c_str(), &st) != 0 || !S_ISREG(st.st_mode) || !::realpath(fileName.c_str(), path)) {
+        return result;
+    }
+#ifdef __APPLE__
+    struct timespec const &mtime = st.st_mtimespec;
+#else
+    struct timespec const &mtime = st.st_mtim;
+#endif
+    result.path = path;
+    result.mtime = static_cast<std::int64_t>(mtime.tv_sec) * 1000000000 + mtime.tv_nsec;
+    result.size = st.st_size;
+    return result;
+}
+
+std::string ReadCache::makeKey(FileId const &file, int hdu, std::string const &kind) {
+    return (boost::format("%s\n%d\n%d\n%d\n%s") % file.path % file.mtime % file.size % hdu % kind).str();
+}
+
+std::size_t ReadCache::estimateSize(daf::base::PropertySet const &metadata) {
+    // Roughly a FITS card per value, plus the overhead of each name.
+    return 128 * metadata.paramNames(false).size();
+}
+
+std::shared_ptr<void const> ReadCache::_find(std::string const &key, std::type_info const &type) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto iter = _index.find(key);
+    if (iter == _index.end()) {
+        ++_misses;
+        return nullptr;
+    }
+    if (iter->second->type != std::type_index(type)) {
+        throw LSST_EXCEPT(pex::exceptions::TypeError,
+                          (boost::format("Cached object has type %s, not %s") % iter->second->type.name() %
+                           type.name())
+                                  .str());
+    }
+    ++_hits;
+    _entries.splice(_entries.begin(), _entries, iter->second);
+    return iter->second->value;
+}
+
+void ReadCache::_insert(std::string key, std::type_info const &type, std::shared_ptr<void const> value,
+                        std::size_t nBytes) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_capacity == 0 || nBytes > _capacity) {
+        return;
+    }
+    auto iter = _index.find(key);
+    if (iter != _index.end()) {
+        // Another reader got here first; keep the newer object.
+        _size -= iter->second->nBytes;
+        _entries.erase(iter->second);
+        _index.erase(iter);
+    }
+    _entries.push_front(Entry{key, std::type_index(type), std::move(value), nBytes});
+    _index.emplace(std::move(key), _entries.begin());
+    _size += nBytes;
+    _evict();
+}
+
+void ReadCache::_evict() {
+    while (_size > _capacity) {
+        Entry const &last = _entries.back();
+        _size -= last.nBytes;
+        _index.erase(last.key);
+        _entries.pop_back();
+    }
+}
+
+void ReadCache::setCapacity(std::size_t nBytes) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _capacity = nBytes;
+    if (_capacity == 0) {
+        _entries.clear();
+        _index.clear();
+        _size = 0;
+    }
+    _evict();
+}
+
+std::size_t ReadCache::getCapacity() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _capacity;
+}
+
+std::size_t ReadCache::getSize() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _size;
+}
+
+std::size_t ReadCache::getCount() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _entries.size();
+}
+
+std::size_t ReadCache::getHitCount() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _hits;
+}
+
+std::size_t ReadCache::getMissCount() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _misses;
+}
+
+void ReadCache::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.clear();
+    _index.clear();
+    _size = 0;
+    _hits = 0;
+    _misses = 0;
+}
+
+}  // namespace fits
+}  // namespace afw
+}  // namespace lsst
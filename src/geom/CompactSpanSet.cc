@@ -0,0 +1,177 @@
+/*
+ * LSST Data Management System
+ * Copyright 2008-2018  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#include <algorithm>
+#include "lsst/afw/geom/CompactSpanSet.h"
+
+namespace lsst {
+namespace afw {
+namespace geom {
+namespace {
+
+/* Integers are stored as unsigned LEB128 varints, seven bits per byte with the high bit
+ * marking that more bytes follow. Signed deltas are zig-zag encoded first so that values
+ * of small magnitude take a single byte regardless of sign.
+ */
+void putVarint(std::vector<std::uint8_t>& out, std::uint32_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+std::uint32_t getVarint(std::uint8_t const*& in) {
+    std::uint32_t value = 0;
+    int shift = 0;
+    while (*in & 0x80) {
+        value |= static_cast<std::uint32_t>(*in++ & 0x7f) << shift;
+        shift += 7;
+    }
+    value |= static_cast<std::uint32_t>(*in++) << shift;
+    return value;
+}
+
+std::uint32_t zigzag(int value) {
+    return (static_cast<std::uint32_t>(value) << 1) ^ static_cast<std::uint32_t>(value >> 31);
+}
+
+int unzigzag(std::uint32_t value) { return static_cast<int>(value >> 1) ^ -static_cast<int>(value & 1); }
+
+}  // namespace
+
+CompactSpanSet::Iterator::Iterator(std::uint8_t const* data, std::size_t nSpans,
+                                   lsst::geom::Point2I const& origin)
+        : _next(data), _remaining(nSpans + 1), _span(origin.getY(), origin.getX(), origin.getX()) {
+    _decode();
+}
+
+void CompactSpanSet::Iterator::_decode() {
+    // Step past the current Span; if there is another, decode it relative to the current one
+    if (_remaining == 0 || --_remaining == 0) {
+        // Past the end: match a default-constructed (end) iterator
+        _next = nullptr;
+        _span = Span();
+        return;
+    }
+    int const y = _span.getY() + unzigzag(getVarint(_next));
+    int const x0 = _span.getX0() + unzigzag(getVarint(_next));
+    int const width = static_cast<int>(getVarint(_next)) + 1;
+    _span = Span(y, x0, x0 + width - 1);
+}
+
+CompactSpanSet::CompactSpanSet() : _data(), _offset(), _bbox(), _area(0) {}
+
+CompactSpanSet::CompactSpanSet(SpanSet const& spanSet) : CompactSpanSet(_encode(spanSet)) {}
+
+CompactSpanSet::CompactSpanSet(std::shared_ptr<Data const> data, lsst::geom::Extent2I const& offset,
+                               lsst::geom::Box2I const& bbox, std::size_t area)
+        : _data(std::move(data)), _offset(offset), _bbox(bbox), _area(area) {}
+
+template <typename Container>
+CompactSpanSet CompactSpanSet::_encode(Container const& spans) {
+    if (spans.begin() == spans.end()) {
+        return CompactSpanSet();
+    }
+    auto data = std::make_shared<Data>();
+    // The first Span is encoded relative to its own row and starting column
+    data->origin = lsst::geom::Point2I(spans.begin()->getX0(), spans.begin()->getY());
+    data->nSpans = 0;
+    int prevY = data->origin.getY();
+    int prevX0 = data->origin.getX();
+    lsst::geom::Box2I bbox;
+    std::size_t area = 0;
+    for (auto const& spn : spans) {
+        putVarint(data->bytes, zigzag(spn.getY() - prevY));
+        putVarint(data->bytes, zigzag(spn.getX0() - prevX0));
+        putVarint(data->bytes, static_cast<std::uint32_t>(spn.getWidth() - 1));
+        prevY = spn.getY();
+        prevX0 = spn.getX0();
+        bbox.include(lsst::geom::Point2I(spn.getX0(), spn.getY()));
+        bbox.include(lsst::geom::Point2I(spn.getX1(), spn.getY()));
+        area += spn.getWidth();
+        ++data->nSpans;
+    }
+    data->bytes.shrink_to_fit();
+    return CompactSpanSet(std::move(data), lsst::geom::Extent2I(0, 0), bbox, area);
+}
+
+CompactSpanSet::const_iterator CompactSpanSet::begin() const {
+    if (!_data) {
+        return end();
+    }
+    return Iterator(_data->bytes.data(), _data->nSpans, _data->origin + _offset);
+}
+
+CompactSpanSet::size_type CompactSpanSet::size() const { return _data ? _data->nSpans : 0; }
+
+std::size_t CompactSpanSet::getEncodedSize() const { return _data ? _data->bytes.size() : 0; }
+
+std::shared_ptr<SpanSet> CompactSpanSet::toSpanSet() const {
+    if (empty()) {
+        return std::make_shared<SpanSet>();
+    }
+    return std::make_shared<SpanSet>(begin(), end(), false);
+}
+
+CompactSpanSet CompactSpanSet::shiftedBy(int x, int y) const {
+    return shiftedBy(lsst::geom::Extent2I(x, y));
+}
+
+CompactSpanSet CompactSpanSet::shiftedBy(lsst::geom::Extent2I const& offset) const {
+    if (empty()) {
+        return *this;
+    }
+    lsst::geom::Box2I bbox(_bbox);
+    bbox.shift(offset);
+    return CompactSpanSet(_data, _offset + offset, bbox, _area);
+}
+
+CompactSpanSet CompactSpanSet::clippedTo(lsst::geom::Box2I const& box) const {
+    // Share the encoded data if nothing would be removed
+    if (empty() || box.contains(_bbox)) {
+        return *this;
+    }
+    std::vector<Span> tempVec;
+    for (auto const& spn : *this) {
+        if (spn.getY() >= box.getMinY() && spn.getY() <= box.getMaxY() && spn.getX1() >= box.getMinX() &&
+            spn.getX0() <= box.getMaxX()) {
+            tempVec.push_back(Span(spn.getY(), std::max(box.getMinX(), spn.getX0()),
+                                   std::min(box.getMaxX(), spn.getX1())));
+        }
+    }
+    return _encode(tempVec);
+}
+
+bool CompactSpanSet::operator==(CompactSpanSet const& other) const {
+    if (size() != other.size() || _area != other._area || _bbox != other._bbox) {
+        return false;
+    }
+    if (_data == other._data && _offset == other._offset) {
+        return true;
+    }
+    return std::equal(begin(), end(), other.begin());
+}
+
+}  // namespace geom
+}  // namespace afw
+}  // namespace lsst
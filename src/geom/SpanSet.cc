@@ -122,53 +122,139 @@ std::shared_ptr<SpanSet> maskIntersect(SpanSet const& spanSet, image::Mask<T> co
     // This vector will store our output spans
     std::vector<Span> newVec;
     auto maskBBox = mask.getBBox();
+    auto const maskArray = mask.getArray();
+    auto const rowStride = maskArray.template getStride<0>();
     for (auto const& spn : spanSet) {
-        // Variable to mark if a new span has been started
-        // Reset the started flag for each different span
-        bool started = false;
         // Limit the y iteration to be within the mask's bounding box
         int y = spn.getY();
         if (y < maskBBox.getMinY() || y > maskBBox.getMaxY()) {
             continue;
         }
-        // Reset the min and max variables
-        int minX = 0;
-        int maxX = 0;
         // Limit the scope of iteration to be within the mask's bounds
         int startX = std::max(spn.getMinX(), maskBBox.getMinX());
         int endX = std::min(spn.getMaxX(), maskBBox.getMaxX());
-        for (int x = startX; x <= endX; ++x) {
-            // Find if the pixel matches the given bit pattern
-            bool pixelCompare = mask.get0(x, y) & bitmask;
-            // if the templated boolean indicates the compliment of the mask is desired, invert the
-            // pixel comparison
-            if (invert) {
-                pixelCompare = !pixelCompare;
+        if (endX < startX) {
+            continue;
+        }
+        // Find the runs of pixels matching (or, if inverted, not matching) the bit pattern in the
+        // part of the mask row covered by the span
+        T const* row = maskArray.getData() + (y - maskBBox.getMinY()) * rowStride +
+                       (startX - maskBBox.getMinX());
+        details::appendMaskRuns<invert>(row, endX - startX + 1, bitmask, y, startX, newVec);
+    }
+    return std::make_shared<SpanSet>(std::move(newVec));
+}
+
+/* The set operations between two SpanSets sweep over both normalized span vectors at once, one row
+ * at a time. Within a row each operation is a linear merge of two sorted lists of disjoint intervals,
+ * and the Spans it emits are already sorted and normalized, so the result needs no further sorting.
+ */
+typedef SpanSet::const_iterator SpanIterator;
+
+// Return the first Span after first which is not on the same row as first
+SpanIterator rowEnd(SpanIterator first, SpanIterator last) {
+    int const y = first->getY();
+    while (first != last && first->getY() == y) {
+        ++first;
+    }
+    return first;
+}
+
+// Return true if the Spans are sorted and no two Spans on a row overlap or touch; SpanSets built with
+// normalize=false need not be, and must be normalized before they can be swept
+bool spansNormalized(SpanSet const& spanSet) {
+    return std::adjacent_find(spanSet.begin(), spanSet.end(), [](Span const& a, Span const& b) {
+               return b.getY() < a.getY() || (b.getY() == a.getY() && b.getMinX() <= a.getMaxX() + 1);
+           }) == spanSet.end();
+}
+
+// Return the first Span on or after row y
+SpanIterator lowerRow(SpanIterator first, SpanIterator last, int y) {
+    return std::lower_bound(first, last, y, [](Span const& spn, int yval) { return spn.getY() < yval; });
+}
+
+void intersectRow(int y, SpanIterator a, SpanIterator aLast, SpanIterator b, SpanIterator bLast,
+                  std::vector<Span>& out) {
+    while (a != aLast && b != bLast) {
+        int const x0 = std::max(a->getMinX(), b->getMinX());
+        int const x1 = std::min(a->getMaxX(), b->getMaxX());
+        if (x0 <= x1) {
+            out.push_back(Span(y, x0, x1));
+        }
+        // Whichever span ends first can not overlap anything further along the other list
+        if (a->getMaxX() < b->getMaxX()) {
+            ++a;
+        } else {
+            ++b;
+        }
+    }
+}
+
+void subtractRow(int y, SpanIterator a, SpanIterator aLast, SpanIterator b, SpanIterator bLast,
+                 std::vector<Span>& out) {
+    for (; a != aLast; ++a) {
+        int x0 = a->getMinX();
+        int const x1 = a->getMaxX();
+        // Spans of b entirely before this span can not overlap any later span of a either
+        while (b != bLast && b->getMaxX() < x0) {
+            ++b;
+        }
+        // Remove each span of b which overlaps this one, emitting the pieces left in between
+        while (b != bLast && b->getMinX() <= x1) {
+            if (b->getMinX() > x0) {
+                out.push_back(Span(y, x0, b->getMinX() - 1));
             }
-            // If the pixel is to be included in the operation, start or append recording values
-            // needed to later construct a Span
-            if (pixelCompare) {
-                if (!started) {
-                    started = true;
-                    minX = x;
-                    maxX = x;
-                } else {
-                    maxX = x;
-                }
-                if (x == endX) {
-                    // We have reached the end of a row and the pixel evaluates true, should add the
-                    // Span
-                    newVec.push_back(Span(y, minX, maxX));
-                }
-            } else if (started) {
-                // A span was started but the current pixel is not to be included in the new SpanSet,
-                // the current SpanSet should be close and added to the vector
-                newVec.push_back(Span(y, minX, maxX));
-                started = false;
+            x0 = std::max(x0, b->getMaxX() + 1);
+            if (b->getMaxX() > x1) {
+                // This span of b may also overlap the next span of a
+                break;
             }
+            ++b;
+        }
+        if (x0 <= x1) {
+            out.push_back(Span(y, x0, x1));
         }
     }
-    return std::make_shared<SpanSet>(std::move(newVec));
+}
+
+void unionRow(int y, SpanIterator a, SpanIterator aLast, SpanIterator b, SpanIterator bLast,
+              std::vector<Span>& out) {
+    bool started = false;
+    int x0 = 0;
+    int x1 = 0;
+    while (a != aLast || b != bLast) {
+        // Take whichever span starts first, and merge it with the current one if they touch
+        Span const& next = (b == bLast || (a != aLast && a->getMinX() <= b->getMinX())) ? *a++ : *b++;
+        if (started && next.getMinX() <= x1 + 1) {
+            x1 = std::max(x1, next.getMaxX());
+        } else {
+            if (started) {
+                out.push_back(Span(y, x0, x1));
+            }
+            started = true;
+            x0 = next.getMinX();
+            x1 = next.getMaxX();
+        }
+    }
+    if (started) {
+        out.push_back(Span(y, x0, x1));
+    }
+}
+
+template <typename RowOperation>
+std::vector<Span> sweepRows(SpanIterator a, SpanIterator aLast, SpanIterator b, SpanIterator bLast,
+                            RowOperation rowOperation) {
+    std::vector<Span> out;
+    out.reserve(std::distance(a, aLast) + std::distance(b, bLast));
+    while (a != aLast || b != bLast) {
+        int const y = (b == bLast || (a != aLast && a->getY() <= b->getY())) ? a->getY() : b->getY();
+        auto const aEnd = (a != aLast && a->getY() == y) ? rowEnd(a, aLast) : a;
+        auto const bEnd = (b != bLast && b->getY() == y) ? rowEnd(b, bLast) : b;
+        rowOperation(y, a, aEnd, b, bEnd, out);
+        a = aEnd;
+        b = bEnd;
+    }
+    return out;
 }
 
 }  // namespace
@@ -280,9 +366,31 @@ void SpanSet::_initialize() {
                               lsst::geom::Point2I(maxX, _spanVector.back().getY()));
 }
 
+constexpr std::size_t SpanSet::parallelMinArea;
+
 // Getter for the area property
 std::size_t SpanSet::getArea() const { return _area; }
 
+std::vector<SpanSet::size_type> SpanSet::_partitionRows(std::size_t maxChunks,
+                                                        std::vector<std::size_t>& offsets) const {
+    // Walk the spans accumulating area, and close a range at the first row boundary after
+    // each multiple of the target area has been reached, so that a row is never split
+    std::vector<size_type> bounds(1, 0);
+    offsets.assign(1, 0);
+    std::size_t const target = std::max<std::size_t>(_area / std::max<std::size_t>(maxChunks, 1), 1);
+    std::size_t pixels = 0;
+    for (size_type i = 0; i < _spanVector.size(); ++i) {
+        if (i > 0 && bounds.size() < maxChunks && _spanVector[i].getY() != _spanVector[i - 1].getY() &&
+            pixels >= target * bounds.size()) {
+            bounds.push_back(i);
+            offsets.push_back(pixels);
+        }
+        pixels += _spanVector[i].getWidth();
+    }
+    bounds.push_back(_spanVector.size());
+    return bounds;
+}
+
 // Getter for the bounding box of the SpanSet
 lsst::geom::Box2I SpanSet::getBBox() const { return _bbox; }
 
@@ -719,6 +827,9 @@ std::shared_ptr<SpanSet> SpanSet::fromShape(ellipses::Ellipse const& ellipse) {
 }
 
 std::shared_ptr<SpanSet> SpanSet::intersect(SpanSet const& other) const {
+    if (!spansNormalized(*this) || !spansNormalized(other)) {
+        return SpanSet(begin(), end()).intersect(SpanSet(other.begin(), other.end()));
+    }
     // Check if the bounding boxes overlap, if not return null SpanSet
     if (!_bbox.overlaps(other.getBBox())) {
         return std::make_shared<SpanSet>();
@@ -727,23 +838,30 @@ std::shared_ptr<SpanSet> SpanSet::intersect(SpanSet const& other) const {
     if (other == *this) {
         return std::make_shared<SpanSet>(this->_spanVector);
     }
-    std::vector<Span> tempVec;
-    auto otherIter = other.begin();
-    for (auto const& spn : _spanVector) {
-        while (otherIter != other.end() && otherIter->getY() <= spn.getY()) {
-            if (spansOverlap(spn, *otherIter)) {
-                auto newMin = std::max(spn.getMinX(), otherIter->getMinX());
-                auto newMax = std::min(spn.getMaxX(), otherIter->getMaxX());
-                auto newSpan = Span(spn.getY(), newMin, newMax);
-                tempVec.push_back(newSpan);
-            }
-            ++otherIter;
-        }
+    // Only rows common to both bounding boxes can contribute
+    int const minY = std::max(_bbox.getMinY(), other.getBBox().getMinY());
+    int const maxY = std::min(_bbox.getMaxY(), other.getBBox().getMaxY());
+    auto const aFirst = lowerRow(begin(), end(), minY);
+    auto const bFirst = lowerRow(other.begin(), other.end(), minY);
+    auto tempVec = sweepRows(aFirst, lowerRow(aFirst, end(), maxY + 1), bFirst,
+                             lowerRow(bFirst, other.end(), maxY + 1), intersectRow);
+    return std::make_shared<SpanSet>(std::move(tempVec), false);
+}
+
+std::vector<std::shared_ptr<SpanSet>> SpanSet::intersect(
+        std::vector<std::shared_ptr<SpanSet>> const& others) const {
+    std::vector<std::shared_ptr<SpanSet>> result;
+    result.reserve(others.size());
+    for (auto const& other : others) {
+        result.push_back(intersect(*other));
     }
-    return std::make_shared<SpanSet>(std::move(tempVec));
+    return result;
 }
 
 std::shared_ptr<SpanSet> SpanSet::intersectNot(SpanSet const& other) const {
+    if (!spansNormalized(*this) || !spansNormalized(other)) {
+        return SpanSet(begin(), end()).intersectNot(SpanSet(other.begin(), other.end()));
+    }
     // Check if the bounding boxes overlap, if not simply return a copy of this
     if (!getBBox().overlaps(other.getBBox())) {
         return std::make_shared<SpanSet>(this->begin(), this->end());
@@ -752,91 +870,51 @@ std::shared_ptr<SpanSet> SpanSet::intersectNot(SpanSet const& other) const {
     if (other == *this) {
         return std::make_shared<SpanSet>();
     }
-    /* This function must find all the areas in this and not in other. These SpanSets
-     * may be overlapping with this less than other a1|    b1|   a2|    b2|,
-     * with this greater than other b1|    a1|     b2|    a2|,
-     * with this containing other a1|    b1|     b2|     a2|,
-     * or with other containing this  b1|    a1|    a2|   b2|
+    /* Rows of this outside the rows of other are copied unchanged, and within the rows common to
+     * both, the spans of other are removed from those of this. Each span in *this may be split into
+     * several pieces if more than one span of other falls on it.
      */
+    int const minY = other.getBBox().getMinY();
+    int const maxY = other.getBBox().getMaxY();
+    auto const aFirst = lowerRow(begin(), end(), minY);
+    auto const aLast = lowerRow(aFirst, end(), maxY + 1);
     std::vector<Span> tempVec;
-    auto otherIter = other.begin();
-    for (auto const& spn : _spanVector) {
-        bool added = false;
-        bool spanStarted = false;
-        int spanBottom = 0;
-        while (otherIter != other.end() && otherIter->getY() <= spn.getY()) {
-            if (spansOverlap(spn, *otherIter)) {
-                added = true;
-                /* To handle one span containing the other, the spans will be added
-                 * piecewise, and let the SpanSet constructor normalize spans which
-                 * end up contiguous. In the case where this is contained in other,
-                 * these statements will all be false, and nothing will be added,
-                 * which is the expected behavior.
-                 *
-                 * Intersection with the logical not of another SpanSet requires that the Intersection
-                 * be tested against the condition that multiple Spans may be present in the other
-                 * SpanSet at the same Y coordinate. I.E. If one row in *this would contain two
-                 * disconnected Spans in other, the result should be three new Spans.
-                 */
-                // Check if a span is in the process of being created
-                if (!spanStarted) {
-                    // If the minimum value of the Span in  *this is less than that of other, add a new Span
-                    if (spn.getMinX() < otherIter->getMinX()) {
-                        tempVec.push_back(Span(spn.getY(), spn.getMinX(), otherIter->getMinX() - 1));
-                    }
-                    // Conversely if the maximum value of the Span in *this is greater than that of other,
-                    // Start a new span, and record what the minimum value of that span should be. This is
-                    // because SpanSets can be disconnected, and the function must check if there are any
-                    // additional Spans which fall in the same row
-                    if (spn.getMaxX() > otherIter->getMaxX()) {
-                        spanStarted = true;
-                        spanBottom = otherIter->getMaxX() + 1;
-                    }
-                } else {
-                    // A span is in the process of being created and should be finished and added
-                    tempVec.push_back(
-                            Span(spn.getY(), spanBottom, std::min(spn.getMaxX(), otherIter->getMinX() - 1)));
-                    spanStarted = false;
-                    // Check if the span in *this extends past that of the Span from other, if so
-                    // begin a new Span
-                    if (spn.getMaxX() > otherIter->getMaxX()) {
-                        spanStarted = true;
-                        spanBottom = otherIter->getMaxX() + 1;
-                    }
-                }
-            }
-            if (otherIter->getMaxX() > spn.getMaxX()) {
-                break;
-            }
-            ++otherIter;
-        }
-        // Check if a span has been started but not finished, if that is the case that means there are
-        // no further spans on this row to consider and the span should be closed and added
-        if (spanStarted) {
-            tempVec.push_back(Span(spn.getY(), spanBottom, spn.getMaxX()));
-        }
-        /* If added is still zero, that means it did not overlap any of the spans in other
-         * and should be included in the new span
-         */
-        if (!added) {
-            tempVec.push_back(Span(spn));
-        }
+    tempVec.reserve(size() + other.size());
+    tempVec.insert(tempVec.end(), begin(), aFirst);
+    auto middle = sweepRows(aFirst, aLast, other.begin(), other.end(), subtractRow);
+    tempVec.insert(tempVec.end(), middle.begin(), middle.end());
+    tempVec.insert(tempVec.end(), aLast, end());
+    return std::make_shared<SpanSet>(std::move(tempVec), false);
+}
+
+std::vector<std::shared_ptr<SpanSet>> SpanSet::intersectNot(
+        std::vector<std::shared_ptr<SpanSet>> const& others) const {
+    std::vector<std::shared_ptr<SpanSet>> result;
+    result.reserve(others.size());
+    for (auto const& other : others) {
+        result.push_back(intersectNot(*other));
     }
-    return std::make_shared<SpanSet>(std::move(tempVec));
+    return result;
 }
 
 std::shared_ptr<SpanSet> SpanSet::union_(SpanSet const& other) const {
-    /* Simply include Spans from both SpanSets in a new vector and let the SpanSet
-     * constructor normalize any of the SpanSets which may be contiguous
+    if (!spansNormalized(*this) || !spansNormalized(other)) {
+        return SpanSet(begin(), end()).union_(SpanSet(other.begin(), other.end()));
+    }
+    /* Merge the Spans of both SpanSets row by row, combining any Spans which are contiguous
      */
-    std::size_t combineSize = size() + other.size();
-    std::vector<Span> tempVec;
-    tempVec.reserve(combineSize);
-    // Copy this
-    tempVec.insert(tempVec.end(), _spanVector.begin(), _spanVector.end());
-    // Copy other
-    tempVec.insert(tempVec.end(), other.begin(), other.end());
-    return std::make_shared<SpanSet>(std::move(tempVec));
+    auto tempVec = sweepRows(begin(), end(), other.begin(), other.end(), unionRow);
+    return std::make_shared<SpanSet>(std::move(tempVec), false);
+}
+
+std::vector<std::shared_ptr<SpanSet>> SpanSet::union_(
+        std::vector<std::shared_ptr<SpanSet>> const& others) const {
+    std::vector<std::shared_ptr<SpanSet>> result;
+    result.reserve(others.size());
+    for (auto const& other : others) {
+        result.push_back(union_(*other));
+    }
+    return result;
 }
 
 std::shared_ptr<SpanSet> SpanSet::transformedBy(lsst::geom::LinearTransform const& t) const {
@@ -959,8 +1037,7 @@ std::shared_ptr<SpanSet> SpanSet::intersectNot(image::Mask<T> const& other, T bi
 
 template <typename T>
 std::shared_ptr<SpanSet> SpanSet::union_(image::Mask<T> const& other, T bitmask) const {
-    auto comparator = [bitmask](T pixelValue) { return (pixelValue & bitmask); };
-    auto spanSetFromMask = fromMask(other, comparator);
+    auto spanSetFromMask = fromMask(other, bitmask);
     return union_(*spanSetFromMask);
 }
 
@@ -41,6 +41,7 @@
 #include "lsst/afw/cameraGeom/Detector.h"
 #include "lsst/afw/fits.h"
 #include "lsst/afw/image/ExposureFitsReader.h"
+#include "lsst/afw/image/ScratchFile.h"
 
 namespace lsst {
 namespace afw {
@@ -190,6 +191,23 @@ void Exposure<ImageT, MaskT, VarianceT>::writeFits(fits::Fits &fitsfile,
     _info->_finishWriteFits(fitsfile, data);
 }
 
+template <typename ImageT, typename MaskT, typename VarianceT>
+void Exposure<ImageT, MaskT, VarianceT>::writeScratch(std::string const &fileName,
+                                                      ScratchWriteOptions const &options) const {
+    image::writeScratch(fileName, *this, options);
+}
+
+template <typename ImageT, typename MaskT, typename VarianceT>
+void Exposure<ImageT, MaskT, VarianceT>::writeScratch(std::string const &fileName) const {
+    image::writeScratch(fileName, *this);
+}
+
+template <typename ImageT, typename MaskT, typename VarianceT>
+Exposure<ImageT, MaskT, VarianceT> Exposure<ImageT, MaskT, VarianceT>::readScratch(
+        std::string const &fileName) {
+    return ScratchFileReader(fileName).readExposure<ImageT, MaskT, VarianceT>();
+}
+
 namespace {
 /**
  * Copy all overlapping pixels from one Exposure to another.
@@ -0,0 +1,212 @@
+/*
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+#include "fitsio.h"
+
+#include "lsst/log/Log.h"
+#include "lsst/afw/detail/parallel.h"
+#include "lsst/afw/fits.h"
+#include "lsst/afw/image/ExposureCutoutReader.h"
+
+namespace lsst {
+namespace afw {
+namespace image {
+
+namespace {
+
+LOG_LOGGER _log = LOG_GET("afw.image.fits.ExposureCutoutReader");
+
+// Return the canonical absolute path of a file, so that requests naming the same file differently share
+// a reader, or the name as given if it cannot be resolved (leaving the reader to report the error).
+std::string canonicalFileName(std::string const& fileName) {
+    char path[PATH_MAX];
+    return ::realpath(fileName.c_str(), path) ? std::string(path) : fileName;
+}
+
+// Restore the calling thread's compression thread limit, which the first worker (run on that thread)
+// changes.
+class CompressionThreadLimitGuard {
+public:
+    CompressionThreadLimitGuard() : _old(fits::getCompressionThreadLimit()) {}
+    ~CompressionThreadLimitGuard() { fits::setCompressionThreadLimit(_old); }
+
+    CompressionThreadLimitGuard(CompressionThreadLimitGuard const&) = delete;
+    CompressionThreadLimitGuard& operator=(CompressionThreadLimitGuard const&) = delete;
+
+    int getOld() const { return _old; }
+
+private:
+    int _old;
+};
+
+}  // namespace
+
+class ExposureCutoutReader::ReaderPool {
+public:
+    explicit ReaderPool(std::size_t maxOpenFiles) : _maxOpenFiles(std::max<std::size_t>(maxOpenFiles, 1)) {}
+
+    // Return a reader for the given file, opening it (and closing another) if necessary.
+    ExposureFitsReader& get(std::string const& fileName) {
+        for (auto iter = _readers.begin(); iter != _readers.end(); ++iter) {
+            if (iter->first == fileName) {
+                _readers.splice(_readers.begin(), _readers, iter);
+                return *_readers.front().second;
+            }
+        }
+        auto reader = std::make_unique<ExposureFitsReader>(fileName);
+        _readers.emplace_front(fileName, std::move(reader));
+        if (_readers.size() > _maxOpenFiles) {
+            _readers.pop_back();
+        }
+        return *_readers.front().second;
+    }
+
+    void clear() { _readers.clear(); }
+
+private:
+    std::size_t _maxOpenFiles;
+    std::list<std::pair<std::string, std::unique_ptr<ExposureFitsReader>>> _readers;  // most recent first
+};
+
+ExposureCutoutReader::ExposureCutoutReader(int nThreads, std::size_t maxOpenFiles)
+        : _maxOpenFiles(maxOpenFiles) {
+    std::size_t nReaders = afw::detail::getThreadCount(nThreads);
+    if (nReaders > 1 && !fits_is_reentrant()) {
+        LOGLS_WARN(_log, "cfitsio is not reentrant; cutouts will be read on the calling thread.");
+        nReaders = 1;
+    }
+    _pools.reserve(nReaders);
+    for (std::size_t i = 0; i < nReaders; ++i) {
+        _pools.push_back(std::make_unique<ReaderPool>(maxOpenFiles));
+    }
+}
+
+ExposureCutoutReader::~ExposureCutoutReader() noexcept = default;
+
+void ExposureCutoutReader::closeFiles() {
+    for (auto& pool : _pools) {
+        pool->clear();
+    }
+}
+
+template <typename T, typename ReadFunc>
+std::vector<T> ExposureCutoutReader::_readAll(std::vector<Request> const& requests,
+                                              ReadFunc const& readOne) {
+    // Group the requests by file, in the order each file was first requested, and put each file's
+    // requests in row order.
+    std::vector<std::string> fileNames;  // canonical name of each group's file
+    std::vector<std::vector<std::size_t>> groups;
+    {
+        std::unordered_map<std::string, std::size_t> namedGroups;  // group for each name requested
+        std::unordered_map<std::string, std::size_t> fileGroups;   // group for each canonical name
+        for (std::size_t i = 0; i < requests.size(); ++i) {
+            auto named = namedGroups.emplace(requests[i].fileName, groups.size());
+            if (named.second) {
+                auto file = fileGroups.emplace(canonicalFileName(requests[i].fileName), groups.size());
+                if (file.second) {
+                    fileNames.push_back(file.first->first);
+                    groups.emplace_back();
+                }
+                named.first->second = file.first->second;
+            }
+            groups[named.first->second].push_back(i);
+        }
+    }
+    for (auto& group : groups) {
+        std::stable_sort(group.begin(), group.end(), [&requests](std::size_t a, std::size_t b) {
+            auto const& boxA = requests[a].bbox;
+            auto const& boxB = requests[b].bbox;
+            return std::make_pair(boxA.getMinY(), boxA.getMinX()) <
+                   std::make_pair(boxB.getMinY(), boxB.getMinX());
+        });
+    }
+
+    std::vector<std::unique_ptr<T>> results(requests.size());
+    // Each reader decompresses tiles on its share of the cores, so the readers together don't
+    // oversubscribe them (but not on more threads than the caller allows).
+    std::size_t const nWorkers = std::min(_pools.size(), groups.size());
+    CompressionThreadLimitGuard limitGuard;
+    std::size_t const nCores = afw::detail::getThreadCount(0);
+    int limit = static_cast<int>(std::max<std::size_t>(1, nCores / std::max<std::size_t>(nWorkers, 1)));
+    if (limitGuard.getOld() > 0) {
+        limit = std::min(limit, limitGuard.getOld());
+    }
+    // Files are handed out one at a time, since the number and size of cutouts varies between them.
+    afw::detail::forEachParallel(groups.size(), nWorkers, [&](std::size_t worker, std::size_t g) {
+        fits::setCompressionThreadLimit(limit);
+        ExposureFitsReader& reader = _pools[worker]->get(fileNames[g]);
+        for (std::size_t i : groups[g]) {
+            results[i] = std::make_unique<T>(readOne(reader, requests[i].bbox));
+        }
+    });
+
+    std::vector<T> output;
+    output.reserve(results.size());
+    for (auto& result : results) {
+        output.push_back(std::move(*result));
+    }
+    return output;
+}
+
+template <typename ImagePixelT>
+std::vector<MaskedImage<ImagePixelT>> ExposureCutoutReader::readMaskedImages(
+        std::vector<Request> const& requests, ImageOrigin origin, bool allowUnsafe) {
+    return _readAll<MaskedImage<ImagePixelT>>(
+            requests, [origin, allowUnsafe](ExposureFitsReader& reader, lsst::geom::Box2I const& bbox) {
+                return reader.readMaskedImage<ImagePixelT>(bbox, origin, false, allowUnsafe);
+            });
+}
+
+template <typename ImagePixelT>
+std::vector<Exposure<ImagePixelT>> ExposureCutoutReader::readExposures(std::vector<Request> const& requests,
+                                                                       ImageOrigin origin,
+                                                                       bool allowUnsafe) {
+    return _readAll<Exposure<ImagePixelT>>(
+            requests, [origin, allowUnsafe](ExposureFitsReader& reader, lsst::geom::Box2I const& bbox) {
+                auto exposure = reader.read<ImagePixelT>(bbox, origin, false, allowUnsafe);
+                // The reader returns the same metadata object every time; give each cutout its own.
+                exposure.setMetadata(exposure.getMetadata()->deepCopy());
+                return exposure;
+            });
+}
+
+#define INSTANTIATE(ImagePixelT)                                                                       \
+    template std::vector<MaskedImage<ImagePixelT>> ExposureCutoutReader::readMaskedImages(             \
+            std::vector<Request> const&, ImageOrigin, bool);                                           \
+    template std::vector<Exposure<ImagePixelT>> ExposureCutoutReader::readExposures(                   \
+            std::vector<Request> const&, ImageOrigin, bool)
+
+INSTANTIATE(std::uint16_t);
+INSTANTIATE(int);
+INSTANTIATE(float);
+INSTANTIATE(double);
+INSTANTIATE(std::uint64_t);
+
+}  // namespace image
+}  // namespace afw
+}  // namespace lsst
@@ -19,6 +19,14 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "fitsio.h"
+
 #include "lsst/log/Log.h"
 
 #include "lsst/afw/image/PhotoCalib.h"
@@ -28,6 +36,8 @@
 #include "lsst/afw/image/ApCorrMap.h"
 #include "lsst/afw/detection/Psf.h"
 #include "lsst/afw/image/TransmissionCurve.h"
+#include "lsst/afw/table/io/CatalogVector.h"
+#include "lsst/afw/fitsReadCache.h"
 #include "lsst/afw/image/ExposureFitsReader.h"
 
 namespace lsst {
@@ -38,6 +48,57 @@ namespace {
 
 LOG_LOGGER _log = LOG_GET("afw.image.fits.ExposureFitsReader");
 
+// The HDUs of an archive, as stored in the read cache: a FITS file in memory with an empty primary HDU.
+//
+// Readers on other threads parse their own catalogs from these bytes; sharing the catalogs themselves
+// would update their ndarray reference counts, which are not thread-safe, from several threads.
+struct CachedArchive {
+    std::vector<char> data;
+};
+
+// A private copy of a cached archive's HDUs, opened for a lazy InputArchive to read catalogs from.
+struct ArchiveFile {
+    explicit ArchiveFile(std::vector<char> data_)
+            : data(std::move(data_)),
+              manager(data.data(), data.size()),
+              file(manager, "r", fits::Fits::AUTO_CLOSE | fits::Fits::AUTO_CHECK) {
+        file.setHdu(1);
+    }
+
+    std::vector<char> data;
+    fits::MemFileManager manager;
+    fits::Fits file;
+};
+
+// Return a component shared through the read cache to a caller that may keep and modify it.
+// Exposure components are immutable, except for ApCorrMap, which is copied (as ExposureInfo does).
+template <typename T>
+std::shared_ptr<T> shareComponent(std::shared_ptr<T const> const& component) {
+    return std::const_pointer_cast<T>(component);
+}
+
+std::shared_ptr<ApCorrMap> shareComponent(std::shared_ptr<ApCorrMap const> const& component) {
+    return std::make_shared<ApCorrMap>(*component);
+}
+
+// Copy nHdus HDUs, starting with the current one, to a FITS file in memory, and return its bytes.
+std::vector<char> copyHdus(fits::Fits& fitsFile, int nHdus) {
+    fits::MemFileManager manager;
+    fits::Fits out(manager, "w", fits::Fits::AUTO_CLOSE | fits::Fits::AUTO_CHECK);
+    out.createEmpty();
+    for (int i = 0; i < nHdus; ++i) {
+        if (i > 0) {
+            fitsFile.setHdu(1, true);  // increment HDU by one
+        }
+        fits_copy_hdu(reinterpret_cast<fitsfile*>(fitsFile.fptr), reinterpret_cast<fitsfile*>(out.fptr), 0,
+                      &out.status);
+        LSST_FITS_CHECK_STATUS(out, "Copying archive HDU to memory");
+    }
+    out.closeFile();
+    auto data = static_cast<char const*>(manager.getData());
+    return std::vector<char>(data, data + manager.getLength());
+}
+
 }  // namespace
 
 class ExposureFitsReader::MetadataReader {
@@ -126,7 +187,7 @@ public:
         N_ARCHIVE_COMPONENTS
     };
 
-    explicit ArchiveReader(daf::base::PropertyList& metadata) {
+    ArchiveReader(daf::base::PropertyList& metadata, fits::ReadCache::FileId file) : _file(std::move(file)) {
         auto popInt = [&metadata](std::string const& name) {
             // The default of zero will cause archive.get to return a
             // null/empty pointer, just as if a null/empty pointer was
@@ -160,6 +221,10 @@ public:
 
     template <typename T>
     std::shared_ptr<T> readComponent(afw::fits::Fits* fitsFile, Component c) {
+        // CoaddInputs hold catalogs, which must not be shared between threads (see CachedArchive).
+        if (_file && _state != ArchiveState::MISSING && _ids[c] != 0 && c != COADD_INPUTS) {
+            return _readCachedComponent<T>(fitsFile, c);
+        }
         if (!_ensureLoaded(fitsFile)) {
             return nullptr;
         }
@@ -172,18 +237,65 @@ private:
             return false;
         }
         if (_state == ArchiveState::PRESENT) {
-            afw::fits::HduMoveGuard guard(*fitsFile, _hdu);
-            _archive = table::io::InputArchive::readFits(*fitsFile);
+            // Components are read one at a time, so only read the archive catalogs each one needs.
+            if (_file) {
+                _archiveFile = _openCachedArchive(fitsFile);
+                _archive = table::io::InputArchive::readFits(_archiveFile->file, true);
+            } else {
+                afw::fits::HduMoveGuard guard(*fitsFile, _hdu);
+                // The file outlives the archive, which belongs to the ExposureFitsReader that owns both.
+                _archive = table::io::InputArchive::readFits(*fitsFile, true);
+            }
             _state = ArchiveState::LOADED;
         }
         assert(_state == ArchiveState::LOADED);  // constructor body should guarantee it's not UNKNOWN
         return true;
     }
 
+    // Return a component from the read cache, decoding and caching it if needed.
+    template <typename T>
+    std::shared_ptr<T> _readCachedComponent(afw::fits::Fits* fitsFile, Component c) {
+        auto& cache = fits::ReadCache::getInstance();
+        std::string const kind = "archive component " + std::to_string(_ids[c]);
+        std::shared_ptr<T const> component = cache.find<T>(_file, _hdu, kind);
+        if (!component) {
+            _ensureLoaded(fitsFile);
+            component = _archive.get<T>(_ids[c]);
+            if (!component) {
+                return nullptr;
+            }
+            // The archive's size, shared among its components, stands in for that of the decoded object.
+            std::size_t const nComponents =
+                    std::count_if(_ids.begin(), _ids.end(), [](int id) { return id != 0; });
+            cache.insert<T>(_file, _hdu, kind, component, _archiveFile->data.size() / nComponents);
+        }
+        return shareComponent(component);
+    }
+
+    // Return a private copy of the archive's HDUs from the read cache, reading and caching them if needed.
+    std::shared_ptr<ArchiveFile> _openCachedArchive(afw::fits::Fits* fitsFile) {
+        auto& cache = fits::ReadCache::getInstance();
+        auto cached = cache.find<CachedArchive>(_file, _hdu, "archive");
+        if (!cached) {
+            afw::fits::HduMoveGuard guard(*fitsFile, _hdu);
+            int nHdus = 0;
+            fitsFile->readKey("AR_NCAT", nHdus);  // counts the index, too
+            auto toCache = std::make_shared<CachedArchive>();
+            toCache->data = copyHdus(*fitsFile, nHdus);
+            std::size_t const nBytes = toCache->data.size();
+            cache.insert<CachedArchive>(_file, _hdu, "archive", toCache, nBytes);
+            cached = std::move(toCache);
+        }
+        // Read a copy, so this reader's catalogs are not shared with any other reader.
+        return std::make_shared<ArchiveFile>(cached->data);
+    }
+
     enum class ArchiveState { UNKNOWN, MISSING, PRESENT, LOADED };
 
+    fits::ReadCache::FileId _file;  // empty unless the archive may be shared through the read cache
     int _hdu = 0;
     ArchiveState _state = ArchiveState::UNKNOWN;
+    std::shared_ptr<ArchiveFile> _archiveFile;  // what _archive reads from, if read through the cache
     table::io::InputArchive _archive;
     std::array<int, N_ARCHIVE_COMPONENTS> _ids = {0};
 };
@@ -393,10 +505,35 @@ Exposure<ImagePixelT, MaskPixelT, VariancePixelT> ExposureFitsReader::read(lsst:
 
 void ExposureFitsReader::_ensureReaders() {
     if (!_metadataReader) {
-        auto metadataReader = std::make_unique<MetadataReader>(_maskedImageReader.readPrimaryMetadata(),
-                                                               _maskedImageReader.readImageMetadata(),
-                                                               _maskedImageReader.readXY0());
-        _archiveReader = std::make_unique<ArchiveReader>(*metadataReader->metadata);
+        // The readers as constructed, before any archive is loaded; this is what the read cache holds.
+        using CachedReaders = std::pair<MetadataReader, ArchiveReader>;
+        auto& cache = fits::ReadCache::getInstance();
+        auto const& cacheFile = _maskedImageReader._getCacheFile();
+        int const hdu = _maskedImageReader._imageReader.getHdu();
+        std::shared_ptr<CachedReaders const> cached;
+        if (cacheFile) {
+            cached = cache.find<CachedReaders>(cacheFile, hdu, "exposure components");
+        }
+        std::unique_ptr<MetadataReader> metadataReader;
+        if (cached) {
+            metadataReader = std::make_unique<MetadataReader>(cached->first);
+            metadataReader->metadata =
+                    std::static_pointer_cast<daf::base::PropertyList>(cached->first.metadata->deepCopy());
+            _archiveReader = std::make_unique<ArchiveReader>(cached->second);
+        } else {
+            metadataReader = std::make_unique<MetadataReader>(_maskedImageReader.readPrimaryMetadata(),
+                                                              _maskedImageReader.readImageMetadata(),
+                                                              _maskedImageReader.readXY0());
+            _archiveReader = std::make_unique<ArchiveReader>(*metadataReader->metadata, cacheFile);
+            if (cacheFile) {
+                auto toCache = std::make_shared<CachedReaders>(*metadataReader, *_archiveReader);
+                toCache->first.metadata = std::static_pointer_cast<daf::base::PropertyList>(
+                        metadataReader->metadata->deepCopy());
+                // The WCS, VisitInfo, etc. are small next to the rest of the header; allow a few kB.
+                std::size_t const nBytes = fits::ReadCache::estimateSize(*metadataReader->metadata) + 8192;
+                cache.insert<CachedReaders>(cacheFile, hdu, "exposure components", toCache, nBytes);
+            }
+        }
         _metadataReader = std::move(metadataReader);  // deferred for exception safety
     }
     assert(_archiveReader);  // should always be initialized with _metadataReader.
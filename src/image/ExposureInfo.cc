@@ -97,7 +97,8 @@ ExposureInfo::ExposureInfo(ExposureInfo const& other)
           _coaddInputs(other._coaddInputs),
           _apCorrMap(_cloneApCorrMap(other._apCorrMap)),
           _visitInfo(other._visitInfo),
-          _transmissionCurve(other._transmissionCurve) {}
+          _transmissionCurve(other._transmissionCurve),
+          _deduplicateArchive(other._deduplicateArchive) {}
 
 // Delegate to copy-constructor for backwards compatibility
 ExposureInfo::ExposureInfo(ExposureInfo&& other) : ExposureInfo(other) {}
@@ -113,7 +114,8 @@ ExposureInfo::ExposureInfo(ExposureInfo const& other, bool copyMetadata)
           _coaddInputs(other._coaddInputs),
           _apCorrMap(_cloneApCorrMap(other._apCorrMap)),
           _visitInfo(other._visitInfo),
-          _transmissionCurve(other._transmissionCurve) {
+          _transmissionCurve(other._transmissionCurve),
+          _deduplicateArchive(other._deduplicateArchive) {
     if (copyMetadata) _metadata = _metadata->deepCopy();
 }
 
@@ -130,6 +132,7 @@ ExposureInfo& ExposureInfo::operator=(ExposureInfo const& other) {
         _apCorrMap = _cloneApCorrMap(other._apCorrMap);
         _visitInfo = other._visitInfo;
         _transmissionCurve = other._transmissionCurve;
+        _deduplicateArchive = other._deduplicateArchive;
     }
     return *this;
 }
@@ -159,6 +162,7 @@ ExposureInfo::FitsWriteData ExposureInfo::_startWriteFits(lsst::geom::Point2I co
     // this is still the case so we're setting AR_HDU to 5 == 4 + 1
     //
     data.metadata->set("AR_HDU", 5, "HDU (1-indexed) containing the archive used to store ancillary objects");
+    data.archive.setContentDeduplication(getArchiveContentDeduplication());
     if (hasCoaddInputs()) {
         int coaddInputsId = data.archive.put(getCoaddInputs());
         data.metadata->set("COADD_INPUTS_ID", coaddInputsId, "archive ID for coadd inputs catalogs");
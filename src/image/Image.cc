@@ -49,6 +49,7 @@
 #include "lsst/afw/image/ImageAlgorithm.h"
 #include "lsst/afw/fits.h"
 #include "lsst/afw/image/ImageFitsReader.h"
+#include "lsst/afw/image/ScratchFile.h"
 
 namespace lsst {
 namespace afw {
@@ -458,6 +459,21 @@ void Image<PixelT>::writeFits(fits::Fits& fitsfile, fits::ImageWriteOptions cons
     fitsfile.writeImage(*this, options, header, mask);
 }
 
+template <typename PixelT>
+void Image<PixelT>::writeScratch(std::string const& fileName, ScratchWriteOptions const& options) const {
+    image::writeScratch(fileName, *this, options);
+}
+
+template <typename PixelT>
+void Image<PixelT>::writeScratch(std::string const& fileName) const {
+    image::writeScratch(fileName, *this);
+}
+
+template <typename PixelT>
+Image<PixelT> Image<PixelT>::readScratch(std::string const& fileName) {
+    return ScratchFileReader(fileName).readImage<PixelT>();
+}
+
 #endif  // !DOXYGEN
 
 template <typename PixelT>
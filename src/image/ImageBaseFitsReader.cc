@@ -27,7 +27,8 @@ namespace lsst { namespace afw { namespace image {
 ImageBaseFitsReader::ImageBaseFitsReader(std::string const& fileName, int hdu) :
     _ownsFitsFile(true),
     _hdu(0),
-    _fitsFile(new fits::Fits(fileName, "r", fits::Fits::AUTO_CLOSE | fits::Fits::AUTO_CHECK))
+    _fitsFile(new fits::Fits(fileName, "r", fits::Fits::AUTO_CLOSE | fits::Fits::AUTO_CHECK)),
+    _cacheFile(fits::ReadCache::getInstance().identify(fileName))
 {
     _fitsFile->setHdu(hdu);
     _fitsFile->checkCompressedImagePhu();
@@ -75,6 +76,12 @@ void checkFitsFile(fits::Fits * f) {
     }
 }
 
+// A header and the bounding box read from it, as stored in the read cache.
+struct CachedHeader {
+    std::shared_ptr<daf::base::PropertyList const> metadata;
+    lsst::geom::Box2I bbox;
+};
+
 } // anonymous
 
 std::string ImageBaseFitsReader::readDType() const {
@@ -104,6 +111,13 @@ lsst::geom::Point2I ImageBaseFitsReader::readXY0(lsst::geom::Box2I const & bbox,
 
 std::shared_ptr<daf::base::PropertyList> ImageBaseFitsReader::readMetadata() {
     checkFitsFile(_fitsFile);
+    if (_metadata == nullptr && _cacheFile) {
+        auto cached = fits::ReadCache::getInstance().find<CachedHeader>(_cacheFile, _hdu, "image header");
+        if (cached) {
+            _bbox = cached->bbox;
+            _metadata = std::static_pointer_cast<daf::base::PropertyList>(cached->metadata->deepCopy());
+        }
+    }
     if (_metadata == nullptr) {
         fits::HduMoveGuard guard(*_fitsFile, _hdu);
         auto metadata = fits::readMetadata(*_fitsFile, /*strip=*/true);
@@ -135,6 +149,13 @@ std::shared_ptr<daf::base::PropertyList> ImageBaseFitsReader::readMetadata() {
         ndarray::Vector<ndarray::Size, 2> shape = computeShape();
         auto xy0 = afw::geom::getImageXY0FromMetadata(*metadata, detail::wcsNameForXY0, /*strip=*/true);
         _bbox = lsst::geom::Box2I(xy0, lsst::geom::Extent2I(shape[1], shape[0]));
+        if (_cacheFile) {
+            auto cached = std::make_shared<CachedHeader>();
+            cached->metadata = std::static_pointer_cast<daf::base::PropertyList>(metadata->deepCopy());
+            cached->bbox = _bbox;
+            fits::ReadCache::getInstance().insert<CachedHeader>(_cacheFile, _hdu, "image header", cached,
+                                                                fits::ReadCache::estimateSize(*metadata));
+        }
         _metadata = std::move(metadata);
     }
     return _metadata;
@@ -199,12 +220,38 @@ ndarray::Array<T, 2, 2> ImageBaseFitsReader::readArray(lsst::geom::Box2I const &
     return result;
 }
 
+template <typename T>
+ndarray::Array<T, 2, 1> ImageBaseFitsReader::_readMappableArray(lsst::geom::Box2I const & bbox,
+                                                                ImageOrigin origin, bool allowUnsafe) {
+    if (_mapping) {
+        checkFitsFile(_fitsFile);
+        auto fullBBox = readBBox(origin);
+        auto subBBox = bbox.isEmpty() ? fullBBox : bbox;
+        if (fullBBox.contains(subBBox)) {
+            fits::HduMoveGuard guard(*_fitsFile, _hdu);
+            ndarray::Array<T, 2, 1> result = _fitsFile->mapImage<T>(
+                ndarray::makeVector(subBBox.getHeight(), subBBox.getWidth()),
+                ndarray::makeVector(subBBox.getMinY() - fullBBox.getMinY(),
+                                    subBBox.getMinX() - fullBBox.getMinX()));
+            if (!result.isEmpty()) {
+                return result;
+            }
+        }
+    }
+    // Anything we can't map (including bad boxes, which readArray reports) is read as usual.
+    return readArray<T>(bbox, origin, allowUnsafe);
+}
 
 #define INSTANTIATE(T) \
     template ndarray::Array<T, 2, 2> ImageBaseFitsReader::readArray( \
         lsst::geom::Box2I const & bbox, \
         ImageOrigin origin, \
         bool \
+    ); \
+    template ndarray::Array<T, 2, 1> ImageBaseFitsReader::_readMappableArray( \
+        lsst::geom::Box2I const & bbox, \
+        ImageOrigin origin, \
+        bool \
     )
 
 INSTANTIATE(std::uint16_t);
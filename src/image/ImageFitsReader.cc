@@ -25,7 +25,8 @@ namespace lsst { namespace afw { namespace image {
 
 template <typename PixelT>
 Image<PixelT> ImageFitsReader::read(lsst::geom::Box2I const & bbox, ImageOrigin origin, bool allowUnsafe) {
-    return Image<PixelT>(readArray<PixelT>(bbox, origin, allowUnsafe), false, readXY0(bbox, origin));
+    return Image<PixelT>(_readMappableArray<PixelT>(bbox, origin, allowUnsafe), false,
+                         readXY0(bbox, origin));
 }
 
 #define INSTANTIATE(T) \
@@ -49,6 +49,7 @@
 #include "lsst/afw/image/LsstImageTypes.h"
 #include "lsst/afw/image/detail/MaskDict.h"
 #include "lsst/afw/image/MaskFitsReader.h"
+#include "lsst/afw/image/ScratchFile.h"
 
 namespace dafBase = lsst::daf::base;
 namespace pexExcept = lsst::pex::exceptions;
@@ -249,6 +250,21 @@ void Mask<MaskPixelT>::writeFits(fits::Fits& fitsfile, fits::ImageWriteOptions c
     fitsfile.writeImage(*this, options, useHeader);
 }
 
+template <typename MaskPixelT>
+void Mask<MaskPixelT>::writeScratch(std::string const& fileName, ScratchWriteOptions const& options) const {
+    image::writeScratch(fileName, *this, options);
+}
+
+template <typename MaskPixelT>
+void Mask<MaskPixelT>::writeScratch(std::string const& fileName) const {
+    image::writeScratch(fileName, *this);
+}
+
+template <typename MaskPixelT>
+Mask<MaskPixelT> Mask<MaskPixelT>::readScratch(std::string const& fileName) {
+    return ScratchFileReader(fileName).readMask<MaskPixelT>();
+}
+
 #endif  // !DOXYGEN
 
 
@@ -27,7 +27,8 @@ namespace lsst { namespace afw { namespace image {
 template <typename PixelT>
 Mask<PixelT> MaskFitsReader::read(lsst::geom::Box2I const & bbox, ImageOrigin origin, bool conformMasks,
                                   bool allowUnsafe) {
-    Mask<PixelT> result(readArray<PixelT>(bbox, origin, allowUnsafe), false, readXY0(bbox, origin));
+    Mask<PixelT> result(_readMappableArray<PixelT>(bbox, origin, allowUnsafe), false,
+                        readXY0(bbox, origin));
     auto metadata = readMetadata();
     // look for mask planes in the file
     detail::MaskPlaneDict fileMaskDict = Mask<PixelT>::parseMaskPlaneMetadata(metadata);
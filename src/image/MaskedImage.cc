@@ -39,6 +39,7 @@
 #include "lsst/afw/image/MaskedImage.h"
 #include "lsst/afw/fits.h"
 #include "lsst/afw/image/MaskedImageFitsReader.h"
+#include "lsst/afw/image/ScratchFile.h"
 
 namespace lsst {
 namespace afw {
@@ -525,6 +526,23 @@ void MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::writeFits(
     _variance->writeFits(fitsfile, varianceOptions, header, _mask);
 }
 
+template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
+void MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::writeScratch(
+        std::string const& fileName, ScratchWriteOptions const& options) const {
+    image::writeScratch(fileName, *this, options);
+}
+
+template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
+void MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::writeScratch(std::string const& fileName) const {
+    image::writeScratch(fileName, *this);
+}
+
+template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
+MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>
+MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::readScratch(std::string const& fileName) {
+    return ScratchFileReader(fileName).readMaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>();
+}
+
 // private function conformSizes() ensures that the Mask and Variance have the same dimensions
 // as Image.  If Mask and/or Variance have non-zero dimensions that conflict with the size of Image,
 // a lsst::pex::exceptions::LengthError is thrown.
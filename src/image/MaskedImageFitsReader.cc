@@ -47,7 +47,11 @@ MaskedImageFitsReader::MaskedImageFitsReader(std::string const& fileName, int hd
     _imageReader(fileName, hdu),
     _maskReader(nextHdu(_imageReader._fitsFile)),
     _varianceReader(nextHdu(_maskReader._fitsFile))
-{}
+{
+    // The mask and variance readers share the image reader's file, so they may share its cache entries.
+    _maskReader._cacheFile = _imageReader._cacheFile;
+    _varianceReader._cacheFile = _imageReader._cacheFile;
+}
 
 MaskedImageFitsReader::MaskedImageFitsReader(fits::MemFileManager& manager, int hdu) :
     _imageReader(manager, hdu),
@@ -98,9 +102,24 @@ void checkExtType(ImageBaseFitsReader const & reader, std::shared_ptr<daf::base:
 } // anonymous
 
 std::shared_ptr<daf::base::PropertyList> MaskedImageFitsReader::readPrimaryMetadata() {
+    auto const& cacheFile = _imageReader._cacheFile;
+    if (cacheFile) {
+        auto cached = fits::ReadCache::getInstance().find<daf::base::PropertyList>(cacheFile, 0,
+                                                                                   "primary header");
+        if (cached) {
+            return std::static_pointer_cast<daf::base::PropertyList>(cached->deepCopy());
+        }
+    }
     auto fitsFile = _imageReader._fitsFile;
     fits::HduMoveGuard guard(*fitsFile, 0);
-    return fits::readMetadata(*fitsFile, /*strip=*/true);
+    auto metadata = fits::readMetadata(*fitsFile, /*strip=*/true);
+    if (cacheFile) {
+        fits::ReadCache::getInstance().insert<daf::base::PropertyList>(
+                cacheFile, 0, "primary header",
+                std::static_pointer_cast<daf::base::PropertyList>(metadata->deepCopy()),
+                fits::ReadCache::estimateSize(*metadata));
+    }
+    return metadata;
 }
 
 std::shared_ptr<daf::base::PropertyList> MaskedImageFitsReader::readImageMetadata() {
@@ -0,0 +1,794 @@
+/*
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <sstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "boost/format.hpp"
+
+#include "fitsio.h"
+#include <zlib.h>
+
+#include "lsst/pex/exceptions.h"
+#include "lsst/afw/fits.h"
+#include "lsst/afw/image/ScratchFile.h"
+#include "lsst/afw/image/ExposureFitsReader.h"
+#include "lsst/afw/image/detail/MaskDict.h"
+
+namespace lsst {
+namespace afw {
+namespace image {
+
+/*
+ * File layout (all integers little-endian):
+ *
+ *   magic       8 bytes   "AFWSCRAT"
+ *   version     uint32
+ *   nSections   uint32
+ *   sections    nSections x 48 bytes:
+ *       kind, pixelType                    uint32 x 2
+ *       x0, y0, width, height              int32 x 4
+ *       compression, tileRows              uint32 x 2
+ *       offset, size                       uint64 x 2   (bytes, from the start of the file)
+ *   section contents, each starting on a multiple of ALIGNMENT bytes.
+ *
+ * Uncompressed planes are stored row by row.  Compressed planes start with nTiles + 1 uint64 offsets
+ * (from the start of the section) of each tile and of the end of the last, followed by the tiles,
+ * each of tileRows rows (fewer for the last) that are byte-shuffled and then zlib-compressed.
+ */
+
+namespace {
+
+char const MAGIC[8] = {'A', 'F', 'W', 'S', 'C', 'R', 'A', 'T'};
+std::uint32_t const VERSION = 2;
+std::size_t const FILE_HEADER_SIZE = 16;
+std::size_t const SECTION_HEADER_SIZE = 48;
+std::size_t const ALIGNMENT = 64;
+
+enum SectionKind : std::uint32_t {
+    IMAGE_SECTION = 1,
+    MASK_SECTION = 2,
+    VARIANCE_SECTION = 3,
+    MASK_PLANES_SECTION = 4,  // "name bit" lines
+    COMPONENTS_SECTION = 5,   // FITS file holding the Exposure components
+};
+
+// Describe a section for error messages.
+std::string getSectionName(std::uint32_t kind) {
+    switch (kind) {
+        case IMAGE_SECTION:
+            return "image plane";
+        case MASK_SECTION:
+            return "mask plane";
+        case VARIANCE_SECTION:
+            return "variance plane";
+        case MASK_PLANES_SECTION:
+            return "mask plane dictionary";
+        case COMPONENTS_SECTION:
+            return "Exposure components";
+    }
+    return (boost::format("section of kind %d") % kind).str();
+}
+
+// Codes for pixel types; zero for sections that aren't planes.
+template <typename T>
+struct PixelType;
+
+template <>
+struct PixelType<std::uint16_t> {
+    static constexpr std::uint32_t code = 1;
+};
+template <>
+struct PixelType<int> {
+    static constexpr std::uint32_t code = 2;
+};
+template <>
+struct PixelType<float> {
+    static constexpr std::uint32_t code = 3;
+};
+template <>
+struct PixelType<double> {
+    static constexpr std::uint32_t code = 4;
+};
+template <>
+struct PixelType<std::uint64_t> {
+    static constexpr std::uint32_t code = 5;
+};
+
+std::string getDTypeName(std::uint32_t pixelType) {
+    switch (pixelType) {
+        case PixelType<std::uint16_t>::code:
+            return "uint16";
+        case PixelType<int>::code:
+            return "int32";
+        case PixelType<float>::code:
+            return "float32";
+        case PixelType<double>::code:
+            return "float64";
+        case PixelType<std::uint64_t>::code:
+            return "uint64";
+    }
+    return "unknown";
+}
+
+bool isLittleEndian() {
+    std::uint16_t const one = 1;
+    unsigned char first;
+    std::memcpy(&first, &one, 1);
+    return first == 1;
+}
+
+// Convert elements between native and little-endian order (a no-op on little-endian machines).
+void toLittleEndian(unsigned char *data, std::size_t nElements, std::size_t elementSize) {
+    if (elementSize > 1 && !isLittleEndian()) {
+        for (std::size_t i = 0; i < nElements; ++i, data += elementSize) {
+            std::reverse(data, data + elementSize);
+        }
+    }
+}
+
+// Fixed-size little-endian integers for the file and section headers.
+class Encoder {
+public:
+    template <typename T>
+    void put(T value) {
+        unsigned char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        toLittleEndian(bytes, 1, sizeof(T));
+        _bytes.insert(_bytes.end(), bytes, bytes + sizeof(T));
+    }
+
+    std::vector<unsigned char> const &getBytes() const { return _bytes; }
+
+private:
+    std::vector<unsigned char> _bytes;
+};
+
+class Decoder {
+public:
+    explicit Decoder(unsigned char const *bytes) : _next(bytes) {}
+
+    template <typename T>
+    T get() {
+        unsigned char bytes[sizeof(T)];
+        std::memcpy(bytes, _next, sizeof(T));
+        _next += sizeof(T);
+        toLittleEndian(bytes, 1, sizeof(T));
+        T value;
+        std::memcpy(&value, bytes, sizeof(T));
+        return value;
+    }
+
+private:
+    unsigned char const *_next;
+};
+
+// Group the bytes of each element together (all first bytes, then all second bytes, ...), which makes
+// slowly-varying pixels much more compressible.
+std::vector<unsigned char> shuffle(std::vector<unsigned char> const &data, std::size_t elementSize) {
+    std::size_t const n = data.size() / elementSize;
+    std::vector<unsigned char> result(data.size());
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < elementSize; ++j) {
+            result[j * n + i] = data[i * elementSize + j];
+        }
+    }
+    return result;
+}
+
+std::vector<unsigned char> unshuffle(std::vector<unsigned char> const &data, std::size_t elementSize) {
+    std::size_t const n = data.size() / elementSize;
+    std::vector<unsigned char> result(data.size());
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < elementSize; ++j) {
+            result[i * elementSize + j] = data[j * n + i];
+        }
+    }
+    return result;
+}
+
+// zlib, with the fast setting cfitsio uses for compressing files in memory.
+std::vector<unsigned char> compress(std::vector<unsigned char> const &data) {
+    if (data.empty()) {
+        return data;
+    }
+    uLongf nBytes = compressBound(data.size());
+    std::vector<unsigned char> result(nBytes);
+    int const status = compress2(result.data(), &nBytes, data.data(), data.size(), Z_BEST_SPEED);
+    if (status != Z_OK) {
+        throw LSST_EXCEPT(pex::exceptions::IoError,
+                          (boost::format("Error %d compressing scratch file tile") % status).str());
+    }
+    result.resize(nBytes);
+    return result;
+}
+
+std::vector<unsigned char> decompress(std::vector<unsigned char> const &data, std::size_t expectedSize,
+                                      std::string const &fileName) {
+    if (expectedSize == 0) {
+        return std::vector<unsigned char>();
+    }
+    std::vector<unsigned char> result(expectedSize);
+    uLongf nBytes = expectedSize;
+    int const status = uncompress(result.data(), &nBytes, data.data(), data.size());
+    if (status != Z_OK || nBytes != expectedSize) {
+        throw LSST_EXCEPT(pex::exceptions::IoError,
+                          (boost::format("Corrupt compressed tile in scratch file %s") % fileName).str());
+    }
+    return result;
+}
+
+std::size_t align(std::size_t offset) { return (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT; }
+
+// Accumulates the sections of a scratch file, then writes them.
+class ScratchFileWriter {
+public:
+    explicit ScratchFileWriter(ScratchWriteOptions const &options) : _options(options) {}
+
+    template <typename T>
+    void addPlane(std::uint32_t kind, ImageBase<T> const &image) {
+        Section section;
+        section.kind = kind;
+        section.pixelType = PixelType<T>::code;
+        section.bbox = image.getBBox();
+        section.compression = _options.compression;
+        ndarray::Array<T const, 2, 1> array = image.getArray();
+        std::size_t const width = image.getWidth();
+        std::size_t const height = image.getHeight();
+        std::size_t const rowBytes = width * sizeof(T);
+        // Copy a block of rows into little-endian bytes.
+        auto getRows = [array, width, rowBytes](std::size_t begin, std::size_t end) {
+            std::vector<unsigned char> bytes((end - begin) * rowBytes);
+            for (std::size_t y = begin; y < end; ++y) {
+                std::memcpy(bytes.data() + (y - begin) * rowBytes, array[y].getData(), rowBytes);
+            }
+            toLittleEndian(bytes.data(), (end - begin) * width, sizeof(T));
+            return bytes;
+        };
+        if (_options.compression == ScratchWriteOptions::NONE) {
+            section.tileRows = std::max<std::size_t>(height, 1);
+            section.size = height * rowBytes;
+            section.write = [array, height, rowBytes, getRows](std::ostream &stream) {
+                if (isLittleEndian() && array.getStrides()[0] * sizeof(T) == rowBytes) {
+                    stream.write(reinterpret_cast<char const *>(array.getData()), height * rowBytes);
+                } else {
+                    for (std::size_t y = 0; y < height; ++y) {
+                        auto row = getRows(y, y + 1);
+                        stream.write(reinterpret_cast<char const *>(row.data()), row.size());
+                    }
+                }
+            };
+        } else {
+            std::size_t const tileRows =
+                    _options.tileRows > 0 ? _options.tileRows : std::max<std::size_t>(height, 1);
+            std::size_t const nTiles = (height + tileRows - 1) / tileRows;
+            section.tileRows = tileRows;
+            std::vector<std::vector<unsigned char>> tiles(nTiles);
+            Encoder offsets;
+            std::uint64_t offset = (nTiles + 1) * sizeof(std::uint64_t);
+            for (std::size_t t = 0; t < nTiles; ++t) {
+                tiles[t] = compress(shuffle(getRows(t * tileRows, std::min(height, (t + 1) * tileRows)),
+                                            sizeof(T)));
+                offsets.put<std::uint64_t>(offset);
+                offset += tiles[t].size();
+            }
+            offsets.put<std::uint64_t>(offset);
+            section.bytes = offsets.getBytes();
+            for (auto const &tile : tiles) {
+                section.bytes.insert(section.bytes.end(), tile.begin(), tile.end());
+            }
+            section.size = section.bytes.size();
+        }
+        _sections.push_back(std::move(section));
+    }
+
+    void addBlob(std::uint32_t kind, std::vector<unsigned char> bytes) {
+        Section section;
+        section.kind = kind;
+        section.size = bytes.size();
+        section.bytes = std::move(bytes);
+        _sections.push_back(std::move(section));
+    }
+
+    void write(std::string const &fileName) const {
+        Encoder header;
+        for (char c : MAGIC) {
+            header.put(c);
+        }
+        header.put<std::uint32_t>(VERSION);
+        header.put<std::uint32_t>(_sections.size());
+        std::vector<std::uint64_t> offsets;
+        std::uint64_t end = FILE_HEADER_SIZE + _sections.size() * SECTION_HEADER_SIZE;
+        for (auto const &section : _sections) {
+            offsets.push_back(align(end));
+            end = offsets.back() + section.size;
+            header.put<std::uint32_t>(section.kind);
+            header.put<std::uint32_t>(section.pixelType);
+            header.put<std::int32_t>(section.bbox.getMinX());
+            header.put<std::int32_t>(section.bbox.getMinY());
+            header.put<std::int32_t>(section.bbox.getWidth());
+            header.put<std::int32_t>(section.bbox.getHeight());
+            header.put<std::uint32_t>(section.compression);
+            header.put<std::uint32_t>(section.tileRows);
+            header.put<std::uint64_t>(offsets.back());
+            header.put<std::uint64_t>(section.size);
+        }
+
+        std::ofstream stream(fileName, std::ios::binary | std::ios::trunc);
+        if (!stream) {
+            throw LSST_EXCEPT(pex::exceptions::IoError,
+                              (boost::format("Could not open scratch file %s for writing: %s") % fileName %
+                               std::strerror(errno))
+                                      .str());
+        }
+        auto const &headerBytes = header.getBytes();
+        stream.write(reinterpret_cast<char const *>(headerBytes.data()), headerBytes.size());
+        std::uint64_t position = headerBytes.size();
+        char const padding[ALIGNMENT] = {0};
+        for (std::size_t i = 0; i < _sections.size(); ++i) {
+            stream.write(padding, offsets[i] - position);
+            if (_sections[i].write) {
+                _sections[i].write(stream);
+            } else {
+                stream.write(reinterpret_cast<char const *>(_sections[i].bytes.data()),
+                             _sections[i].bytes.size());
+            }
+            position = offsets[i] + _sections[i].size;
+        }
+        stream.close();
+        if (!stream) {
+            throw LSST_EXCEPT(pex::exceptions::IoError,
+                              (boost::format("Error writing scratch file %s") % fileName).str());
+        }
+    }
+
+private:
+    struct Section {
+        std::uint32_t kind = 0;
+        std::uint32_t pixelType = 0;
+        lsst::geom::Box2I bbox;
+        std::uint32_t compression = ScratchWriteOptions::NONE;
+        std::uint32_t tileRows = 0;
+        std::uint64_t size = 0;
+        std::vector<unsigned char> bytes;              // the contents, unless...
+        std::function<void(std::ostream &)> write;  // ...they are written directly from an image
+    };
+
+    ScratchWriteOptions _options;
+    std::vector<Section> _sections;
+};
+
+template <typename MaskPixelT>
+void addMask(ScratchFileWriter &writer, Mask<MaskPixelT> const &mask) {
+    writer.addPlane(MASK_SECTION, mask);
+    std::ostringstream planes;
+    for (auto const &plane : mask.getMaskPlaneDict()) {
+        planes << plane.first << " " << plane.second << "\n";
+    }
+    std::string const text = planes.str();
+    writer.addBlob(MASK_PLANES_SECTION, std::vector<unsigned char>(text.begin(), text.end()));
+}
+
+template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
+void addMaskedImage(ScratchFileWriter &writer,
+                    MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT> const &maskedImage) {
+    writer.addPlane(IMAGE_SECTION, *maskedImage.getImage());
+    addMask(writer, *maskedImage.getMask());
+    writer.addPlane(VARIANCE_SECTION, *maskedImage.getVariance());
+}
+
+}  // namespace
+
+template <typename PixelT>
+void writeScratch(std::string const &fileName, Image<PixelT> const &image,
+                  ScratchWriteOptions const &options) {
+    ScratchFileWriter writer(options);
+    writer.addPlane(IMAGE_SECTION, image);
+    writer.write(fileName);
+}
+
+template <typename MaskPixelT>
+void writeScratch(std::string const &fileName, Mask<MaskPixelT> const &mask,
+                  ScratchWriteOptions const &options) {
+    ScratchFileWriter writer(options);
+    addMask(writer, mask);
+    writer.write(fileName);
+}
+
+template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
+void writeScratch(std::string const &fileName,
+                  MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT> const &maskedImage,
+                  ScratchWriteOptions const &options) {
+    ScratchFileWriter writer(options);
+    addMaskedImage(writer, maskedImage);
+    writer.write(fileName);
+}
+
+template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
+void writeScratch(std::string const &fileName,
+                  Exposure<ImagePixelT, MaskPixelT, VariancePixelT> const &exposure,
+                  ScratchWriteOptions const &options) {
+    ScratchFileWriter writer(options);
+    addMaskedImage(writer, exposure.getMaskedImage());
+    // The components are saved as a FITS Exposure with a single pixel at the real one's origin, so
+    // they go through exactly the same archive and header code as in Exposure::writeFits (which
+    // needs the origin to write the Wcs), and are read back with ExposureFitsReader.
+    MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT> stub(
+            lsst::geom::Box2I(exposure.getXY0(), lsst::geom::Extent2I(1, 1)));
+    Exposure<ImagePixelT, MaskPixelT, VariancePixelT> components(
+            stub, std::make_shared<ExposureInfo>(*exposure.getInfo()));
+    fits::MemFileManager manager;
+    components.writeFits(manager);
+    auto data = static_cast<unsigned char const *>(manager.getData());
+    writer.addBlob(COMPONENTS_SECTION, std::vector<unsigned char>(data, data + manager.getLength()));
+    writer.write(fileName);
+}
+
+ScratchFileReader::ScratchFileReader(std::string const &fileName)
+        : _fileName(fileName), _fd(::open(fileName.c_str(), O_RDONLY)), _mapping(false) {
+    if (_fd < 0) {
+        throw LSST_EXCEPT(pex::exceptions::IoError,
+                          (boost::format("Could not open scratch file %s: %s") % fileName %
+                           std::strerror(errno))
+                                  .str());
+    }
+    try {
+        struct stat info;
+        if (::fstat(_fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < FILE_HEADER_SIZE) {
+            throw LSST_EXCEPT(pex::exceptions::IoError,
+                              (boost::format("%s is not a scratch file") % fileName).str());
+        }
+        unsigned char header[FILE_HEADER_SIZE];
+        _readBytes(header, FILE_HEADER_SIZE, 0);
+        Decoder decoder(header + sizeof(MAGIC));
+        std::uint32_t const version = decoder.get<std::uint32_t>();
+        std::uint32_t const nSections = decoder.get<std::uint32_t>();
+        if (std::memcmp(header, MAGIC, sizeof(MAGIC)) != 0 || version != VERSION ||
+            static_cast<std::size_t>(info.st_size) < FILE_HEADER_SIZE + nSections * SECTION_HEADER_SIZE) {
+            throw LSST_EXCEPT(
+                    pex::exceptions::IoError,
+                    (boost::format("%s is not a version %d scratch file") % fileName % VERSION).str());
+        }
+        std::vector<unsigned char> table(nSections * SECTION_HEADER_SIZE);
+        _readBytes(table.data(), table.size(), FILE_HEADER_SIZE);
+        Decoder entries(table.data());
+        for (std::uint32_t i = 0; i < nSections; ++i) {
+            Section section;
+            section.kind = entries.get<std::uint32_t>();
+            section.pixelType = entries.get<std::uint32_t>();
+            auto const x0 = entries.get<std::int32_t>();
+            auto const y0 = entries.get<std::int32_t>();
+            auto const width = entries.get<std::int32_t>();
+            auto const height = entries.get<std::int32_t>();
+            section.bbox =
+                    lsst::geom::Box2I(lsst::geom::Point2I(x0, y0), lsst::geom::Extent2I(width, height));
+            section.compression = entries.get<std::uint32_t>();
+            section.tileRows = entries.get<std::uint32_t>();
+            section.offset = entries.get<std::uint64_t>();
+            section.size = entries.get<std::uint64_t>();
+            if (section.offset + section.size > static_cast<std::uint64_t>(info.st_size)) {
+                throw LSST_EXCEPT(pex::exceptions::IoError,
+                                  (boost::format("Scratch file %s is truncated") % fileName).str());
+            }
+            _sections.push_back(section);
+        }
+    } catch (...) {
+        ::close(_fd);
+        throw;
+    }
+}
+
+ScratchFileReader::~ScratchFileReader() noexcept { ::close(_fd); }
+
+void ScratchFileReader::_readBytes(void *buffer, std::size_t nBytes, std::uint64_t offset) const {
+    auto next = static_cast<char *>(buffer);
+    while (nBytes > 0) {
+        ssize_t n = ::pread(_fd, next, nBytes, offset);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            throw LSST_EXCEPT(pex::exceptions::IoError,
+                              (boost::format("Error reading scratch file %s: %s") % _fileName %
+                               (n < 0 ? std::strerror(errno) : "unexpected end of file"))
+                                      .str());
+        }
+        next += n;
+        nBytes -= n;
+        offset += n;
+    }
+}
+
+ScratchFileReader::Section const *ScratchFileReader::_findSection(std::uint32_t kind) const {
+    for (auto const &section : _sections) {
+        if (section.kind == kind) {
+            return &section;
+        }
+    }
+    return nullptr;
+}
+
+ScratchFileReader::Section const &ScratchFileReader::_getSection(std::uint32_t kind) const {
+    auto section = _findSection(kind);
+    if (!section) {
+        throw LSST_EXCEPT(
+                pex::exceptions::NotFoundError,
+                (boost::format("Scratch file %s has no %s") % _fileName % getSectionName(kind)).str());
+    }
+    return *section;
+}
+
+ScratchFileReader::Section const &ScratchFileReader::_getImageOrMaskSection() const {
+    auto section = _findSection(IMAGE_SECTION);
+    if (!section) section = _findSection(MASK_SECTION);
+    if (!section) {
+        throw LSST_EXCEPT(pex::exceptions::NotFoundError,
+                          (boost::format("Scratch file %s has neither an image nor a mask plane") % _fileName)
+                                  .str());
+    }
+    return *section;
+}
+
+lsst::geom::Box2I ScratchFileReader::readBBox(ImageOrigin origin) const {
+    lsst::geom::Box2I bbox = _getImageOrMaskSection().bbox;
+    if (origin == LOCAL) {
+        return lsst::geom::Box2I(lsst::geom::Point2I(), bbox.getDimensions());
+    }
+    return bbox;
+}
+
+std::string ScratchFileReader::readImageDType() const {
+    return getDTypeName(_getImageOrMaskSection().pixelType);
+}
+
+bool ScratchFileReader::hasMask() const { return _findSection(MASK_SECTION) != nullptr; }
+
+bool ScratchFileReader::hasVariance() const { return _findSection(VARIANCE_SECTION) != nullptr; }
+
+bool ScratchFileReader::hasExposureInfo() const { return _findSection(COMPONENTS_SECTION) != nullptr; }
+
+lsst::geom::Box2I ScratchFileReader::_getSubBBox(Section const &section, lsst::geom::Box2I const &bbox,
+                                                 ImageOrigin origin) const {
+    if (bbox.isEmpty()) {
+        return section.bbox;
+    }
+    lsst::geom::Box2I subBBox = bbox;
+    if (origin == LOCAL) {
+        subBBox.shift(lsst::geom::Extent2I(section.bbox.getMin()));
+    }
+    if (!section.bbox.contains(subBBox)) {
+        throw LSST_EXCEPT(
+                pex::exceptions::LengthError,
+                str(boost::format("Subimage box (%d,%d) %dx%d doesn't fit in image (%d,%d) %dx%d in %s") %
+                    subBBox.getMinX() % subBBox.getMinY() % subBBox.getWidth() % subBBox.getHeight() %
+                    section.bbox.getMinX() % section.bbox.getMinY() % section.bbox.getWidth() %
+                    section.bbox.getHeight() % _fileName));
+    }
+    return subBBox;
+}
+
+template <typename T>
+ndarray::Array<T, 2, 1> ScratchFileReader::_readArray(Section const &section,
+                                                      lsst::geom::Box2I const &subBBox) {
+    if (section.pixelType != PixelType<T>::code) {
+        throw LSST_EXCEPT(pex::exceptions::TypeError,
+                          (boost::format("Incompatible type for scratch image: on disk is %s, "
+                                         "in-memory is %s") %
+                           getDTypeName(section.pixelType) % getDTypeName(PixelType<T>::code))
+                                  .str());
+    }
+    std::size_t const fullWidth = section.bbox.getWidth();
+    std::size_t const fullHeight = section.bbox.getHeight();
+    std::size_t const width = subBBox.getWidth();
+    std::size_t const height = subBBox.getHeight();
+    std::size_t const x0 = subBBox.getMinX() - section.bbox.getMinX();
+    std::size_t const y0 = subBBox.getMinY() - section.bbox.getMinY();
+    std::size_t const rowBytes = fullWidth * sizeof(T);
+    if (width == 0 || height == 0) {
+        return ndarray::allocate(static_cast<int>(height), static_cast<int>(width));
+    }
+
+    if (section.compression == ScratchWriteOptions::NONE) {
+        if (_mapping && isLittleEndian()) {
+            // Map only the pages holding the requested rows, as in fits::Fits::mapImage.
+            std::size_t const first = section.offset + y0 * rowBytes + x0 * sizeof(T);
+            std::size_t const last = section.offset + (y0 + height - 1) * rowBytes + (x0 + width) * sizeof(T);
+            std::size_t const mapStart = first - first % sysconf(_SC_PAGESIZE);
+            std::size_t const mapSize = last - mapStart;
+            void *mem = ::mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, _fd, mapStart);
+            if (mem != MAP_FAILED) {
+                std::shared_ptr<unsigned char> mapping(static_cast<unsigned char *>(mem),
+                                                       [mapSize](unsigned char *p) { ::munmap(p, mapSize); });
+                T *data = reinterpret_cast<T *>(mapping.get() + (first - mapStart));
+                return ndarray::external(data, ndarray::makeVector<int>(height, width),
+                                         ndarray::makeVector<int>(fullWidth, 1), mapping);
+            }
+            // fall back to reading
+        }
+        ndarray::Array<T, 2, 2> result = ndarray::allocate(static_cast<int>(height), static_cast<int>(width));
+        if (width == fullWidth) {
+            _readBytes(result.getData(), height * rowBytes, section.offset + y0 * rowBytes);
+        } else {
+            for (std::size_t y = 0; y < height; ++y) {
+                _readBytes(result[y].getData(), width * sizeof(T),
+                           section.offset + (y0 + y) * rowBytes + x0 * sizeof(T));
+            }
+        }
+        toLittleEndian(reinterpret_cast<unsigned char *>(result.getData()), height * width, sizeof(T));
+        return result;
+    }
+
+    if (section.compression != ScratchWriteOptions::GZIP || section.tileRows == 0) {
+        throw LSST_EXCEPT(pex::exceptions::IoError,
+                          (boost::format("Unknown compression %d in scratch file %s") % section.compression %
+                           _fileName)
+                                  .str());
+    }
+    std::size_t const tileRows = section.tileRows;
+    std::size_t const nTiles = (fullHeight + tileRows - 1) / tileRows;
+    std::vector<unsigned char> offsetBytes((nTiles + 1) * sizeof(std::uint64_t));
+    _readBytes(offsetBytes.data(), offsetBytes.size(), section.offset);
+    Decoder offsets(offsetBytes.data());
+    std::vector<std::uint64_t> tileOffsets(nTiles + 1);
+    for (auto &offset : tileOffsets) {
+        offset = offsets.get<std::uint64_t>();
+    }
+    ndarray::Array<T, 2, 2> result = ndarray::allocate(static_cast<int>(height), static_cast<int>(width));
+    // Only decompress the tiles overlapping the requested rows.
+    for (std::size_t t = y0 / tileRows; t <= (y0 + height - 1) / tileRows; ++t) {
+        std::size_t const tileBegin = t * tileRows;
+        std::size_t const tileEnd = std::min(fullHeight, tileBegin + tileRows);
+        if (tileOffsets[t + 1] < tileOffsets[t] || tileOffsets[t + 1] > section.size) {
+            throw LSST_EXCEPT(pex::exceptions::IoError,
+                              (boost::format("Corrupt tile index in scratch file %s") % _fileName).str());
+        }
+        std::vector<unsigned char> compressed(tileOffsets[t + 1] - tileOffsets[t]);
+        _readBytes(compressed.data(), compressed.size(), section.offset + tileOffsets[t]);
+        auto tile = unshuffle(decompress(compressed, (tileEnd - tileBegin) * rowBytes, _fileName), sizeof(T));
+        toLittleEndian(tile.data(), (tileEnd - tileBegin) * fullWidth, sizeof(T));
+        for (std::size_t y = std::max(tileBegin, y0); y < std::min(tileEnd, y0 + height); ++y) {
+            std::memcpy(result[y - y0].getData(), tile.data() + (y - tileBegin) * rowBytes + x0 * sizeof(T),
+                        width * sizeof(T));
+        }
+    }
+    return result;
+}
+
+detail::MaskPlaneDict ScratchFileReader::_readMaskPlanes() const {
+    detail::MaskPlaneDict result;
+    auto section = _findSection(MASK_PLANES_SECTION);
+    if (!section) {
+        return result;
+    }
+    std::string text(section->size, '\0');
+    _readBytes(&text[0], text.size(), section->offset);
+    std::istringstream lines(text);
+    std::string name;
+    int bit;
+    while (lines >> name >> bit) {
+        result[name] = bit;
+    }
+    return result;
+}
+
+template <typename ImagePixelT>
+Image<ImagePixelT> ScratchFileReader::readImage(lsst::geom::Box2I const &bbox, ImageOrigin origin) {
+    auto const &section = _getSection(IMAGE_SECTION);
+    auto const subBBox = _getSubBBox(section, bbox, origin);
+    return Image<ImagePixelT>(_readArray<ImagePixelT>(section, subBBox), false, subBBox.getMin());
+}
+
+template <typename MaskPixelT>
+Mask<MaskPixelT> ScratchFileReader::readMask(lsst::geom::Box2I const &bbox, ImageOrigin origin,
+                                             bool conformMasks) {
+    auto const &section = _getSection(MASK_SECTION);
+    auto const subBBox = _getSubBBox(section, bbox, origin);
+    Mask<MaskPixelT> result(_readArray<MaskPixelT>(section, subBBox), false, subBBox.getMin());
+    // As in MaskFitsReader::read.
+    detail::MaskPlaneDict fileMaskDict = _readMaskPlanes();
+    std::shared_ptr<detail::MaskDict> fileMD = detail::MaskDict::copyOrGetDefault(fileMaskDict);
+    if (*fileMD == *detail::MaskDict::getDefault()) {  // file is already consistent with Mask
+        return result;
+    }
+    if (conformMasks) {  // adopt the definitions in the file
+        detail::MaskDict::setDefault(fileMD);
+        result._maskDict = fileMD;
+    }
+    result.conformMaskPlanes(fileMaskDict);
+    return result;
+}
+
+template <typename VariancePixelT>
+Image<VariancePixelT> ScratchFileReader::readVariance(lsst::geom::Box2I const &bbox, ImageOrigin origin) {
+    auto const &section = _getSection(VARIANCE_SECTION);
+    auto const subBBox = _getSubBBox(section, bbox, origin);
+    return Image<VariancePixelT>(_readArray<VariancePixelT>(section, subBBox), false, subBBox.getMin());
+}
+
+template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
+MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT> ScratchFileReader::readMaskedImage(
+        lsst::geom::Box2I const &bbox, ImageOrigin origin, bool conformMasks) {
+    auto image = std::make_shared<Image<ImagePixelT>>(readImage<ImagePixelT>(bbox, origin));
+    std::shared_ptr<Mask<MaskPixelT>> mask;
+    if (hasMask()) {
+        mask = std::make_shared<Mask<MaskPixelT>>(readMask<MaskPixelT>(bbox, origin, conformMasks));
+    }
+    std::shared_ptr<Image<VariancePixelT>> variance;
+    if (hasVariance()) {
+        variance = std::make_shared<Image<VariancePixelT>>(readVariance<VariancePixelT>(bbox, origin));
+    }
+    return MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>(image, mask, variance);
+}
+
+std::shared_ptr<ExposureInfo> ScratchFileReader::readExposureInfo() {
+    auto section = _findSection(COMPONENTS_SECTION);
+    if (!section) {
+        return std::make_shared<ExposureInfo>();
+    }
+    std::vector<char> data(section->size);
+    _readBytes(data.data(), data.size(), section->offset);
+    fits::MemFileManager manager(data.data(), data.size());
+    ExposureFitsReader reader(manager);
+    return reader.readExposureInfo();
+}
+
+template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
+Exposure<ImagePixelT, MaskPixelT, VariancePixelT> ScratchFileReader::readExposure(
+        lsst::geom::Box2I const &bbox, ImageOrigin origin, bool conformMasks) {
+    auto maskedImage = readMaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>(bbox, origin, conformMasks);
+    return Exposure<ImagePixelT, MaskPixelT, VariancePixelT>(maskedImage, readExposureInfo());
+}
+
+#define INSTANTIATE(ImagePixelT)                                                                        \
+    template void writeScratch(std::string const &, Image<ImagePixelT> const &,                        \
+                               ScratchWriteOptions const &);                                           \
+    template void writeScratch(std::string const &, MaskedImage<ImagePixelT> const &,                  \
+                               ScratchWriteOptions const &);                                           \
+    template void writeScratch(std::string const &, Exposure<ImagePixelT> const &,                     \
+                               ScratchWriteOptions const &);                                           \
+    template Image<ImagePixelT> ScratchFileReader::readImage(lsst::geom::Box2I const &, ImageOrigin);  \
+    template MaskedImage<ImagePixelT> ScratchFileReader::readMaskedImage(lsst::geom::Box2I const &,    \
+                                                                         ImageOrigin, bool);           \
+    template Exposure<ImagePixelT> ScratchFileReader::readExposure(lsst::geom::Box2I const &,          \
+                                                                   ImageOrigin, bool)
+
+INSTANTIATE(std::uint16_t);
+INSTANTIATE(int);
+INSTANTIATE(float);
+INSTANTIATE(double);
+INSTANTIATE(std::uint64_t);
+
+template void writeScratch(std::string const &, Mask<MaskPixel> const &, ScratchWriteOptions const &);
+template Mask<MaskPixel> ScratchFileReader::readMask(lsst::geom::Box2I const &, ImageOrigin, bool);
+template Image<VariancePixel> ScratchFileReader::readVariance(lsst::geom::Box2I const &, ImageOrigin);
+
+}  // namespace image
+}  // namespace afw
+}  // namespace lsst
@@ -70,6 +70,9 @@ static AmpInfoFitsReader const ampInfoFitsReader;
 
 AmpInfoRecord::AmpInfoRecord(std::shared_ptr<AmpInfoTable> const &table) : BaseRecord(table) {}
 
+AmpInfoRecord::AmpInfoRecord(std::shared_ptr<AmpInfoTable> const &table, detail::RecordView const &view)
+        : BaseRecord(table, view) {}
+
 AmpInfoRecord::~AmpInfoRecord() = default;
 
 std::shared_ptr<AmpInfoTable> AmpInfoTable::make(Schema const &schema) {
@@ -170,6 +173,10 @@ std::shared_ptr<BaseRecord> AmpInfoTable::_makeRecord() {
     return std::shared_ptr<AmpInfoRecord>(new AmpInfoRecord(getSelf<AmpInfoTable>()));
 }
 
+std::shared_ptr<BaseRecord> AmpInfoTable::_makeRecordView(detail::RecordView const &view) {
+    return std::shared_ptr<AmpInfoRecord>(new AmpInfoRecord(getSelf<AmpInfoTable>(), view));
+}
+
 //-------------------------------------------------------------------------------------------------
 // Getters and Setters
 //-------------------------------------------------------------------------------------------------
@@ -53,20 +53,44 @@ BitsColumn::BitsColumn(int size) : _array(ndarray::allocate(size)) { _array.deep
 // =============== BaseColumnView private Impl object =======================================================
 
 struct BaseColumnView::Impl {
-    int recordCount;                   // number of records
-    void *buf;                         // pointer to the beginning of the first record's data
-    std::shared_ptr<BaseTable> table;  // table that owns the records
-    ndarray::Manager::Ptr manager;     // manages lifetime of 'buf'
+    int recordCount;                      // number of records
+    void *buf;                            // pointer to the beginning of the first record's data
+    std::shared_ptr<BaseTable> table;     // table that owns the records
+    ndarray::Manager::Ptr manager;        // manages lifetime of 'buf'
+    detail::ColumnLayout const *columns;  // layout of columnar records; null for row-major records
+    std::size_t firstRow;                 // index of the first columnar record in its block
+    std::size_t capacity;                 // number of records in the block of columnar records
 
     Impl(std::shared_ptr<BaseTable> const &table_, int recordCount_, void *buf_,
-         ndarray::Manager::Ptr const &manager_)
-            : recordCount(recordCount_), buf(buf_), table(table_), manager(manager_) {}
+         ndarray::Manager::Ptr const &manager_, detail::ColumnLayout const *columns_, std::size_t firstRow_,
+         std::size_t capacity_)
+            : recordCount(recordCount_),
+              buf(buf_),
+              table(table_),
+              manager(manager_),
+              columns(columns_),
+              firstRow(firstRow_),
+              capacity(capacity_) {}
+
+    // Return the address of the first element of the column holding the given row-major offset.
+    char *getColumn(int offset) const {
+        char *data = reinterpret_cast<char *>(buf);
+        return columns ? columns->getElement(data, capacity, firstRow, offset) : data + offset;
+    }
+
+    // Return the stride of the column holding the given row-major offset, in units of T.
+    template <typename T>
+    int getStride(int offset) const {
+        return int((columns ? columns->getStride(offset) : table->getSchema().getRecordSize()) / sizeof(T));
+    }
 };
 
 // =============== BaseColumnView member function implementations ===========================================
 
 std::shared_ptr<BaseTable> BaseColumnView::getTable() const { return _impl->table; }
 
+std::size_t BaseColumnView::size() const { return _impl->recordCount; }
+
 template <typename T>
 typename ndarray::ArrayRef<T, 1> const BaseColumnView::operator[](Key<T> const &key) const {
     if (!key.isValid()) {
@@ -74,10 +98,9 @@ typename ndarray::ArrayRef<T, 1> const BaseColumnView::operator[](Key<T> const &
             pex::exceptions::LogicError,
             "Key is not valid (if this is a SourceCatalog, make sure slot aliases have been set up).");
     }
-    return ndarray::external(reinterpret_cast<T *>(reinterpret_cast<char *>(_impl->buf) + key.getOffset()),
+    return ndarray::external(reinterpret_cast<T *>(_impl->getColumn(key.getOffset())),
                              ndarray::makeVector(_impl->recordCount),
-                             ndarray::makeVector(int(_impl->table->getSchema().getRecordSize() / sizeof(T))),
-                             _impl->manager);
+                             ndarray::makeVector(_impl->getStride<T>(key.getOffset())), _impl->manager);
 }
 
 template <typename T>
@@ -90,11 +113,9 @@ typename ndarray::ArrayRef<T, 2, 1> const BaseColumnView::operator[](Key<Array<T
     if (key.isVariableLength()) {
         throw LSST_EXCEPT(pex::exceptions::LogicError, "Cannot get columns for variable-length array fields");
     }
-    return ndarray::external(
-            reinterpret_cast<T *>(reinterpret_cast<char *>(_impl->buf) + key.getOffset()),
-            ndarray::makeVector(_impl->recordCount, key.getSize()),
-            ndarray::makeVector(int(_impl->table->getSchema().getRecordSize() / sizeof(T)), 1),
-            _impl->manager);
+    return ndarray::external(reinterpret_cast<T *>(_impl->getColumn(key.getOffset())),
+                             ndarray::makeVector(_impl->recordCount, key.getSize()),
+                             ndarray::makeVector(_impl->getStride<T>(key.getOffset()), 1), _impl->manager);
 }
 
 ndarray::result_of::vectorize<detail::FlagExtractor, ndarray::Array<Field<Flag>::Element const, 1> >::type
@@ -107,10 +128,10 @@ ndarray::result_of::vectorize<detail::FlagExtractor, ndarray::Array<Field<Flag>:
     return ndarray::vectorize(detail::FlagExtractor(key),
                               ndarray::Array<Field<Flag>::Element const, 1>(ndarray::external(
                                       reinterpret_cast<Field<Flag>::Element *>(
-                                              reinterpret_cast<char *>(_impl->buf) + key.getOffset()),
+                                              _impl->getColumn(key.getOffset())),
                                       ndarray::makeVector(_impl->recordCount),
-                                      ndarray::makeVector(int(_impl->table->getSchema().getRecordSize() /
-                                                              sizeof(Field<Flag>::Element))),
+                                      ndarray::makeVector(
+                                              _impl->getStride<Field<Flag>::Element>(key.getOffset())),
                                       _impl->manager)));
 }
 
@@ -171,8 +192,9 @@ BaseColumnView &BaseColumnView::operator=(BaseColumnView &&) = default;
 BaseColumnView::~BaseColumnView() = default;
 
 BaseColumnView::BaseColumnView(std::shared_ptr<BaseTable> const &table, int recordCount, void *buf,
-                               ndarray::Manager::Ptr const &manager)
-        : _impl(std::make_shared<Impl>(table, recordCount, buf, manager)) {}
+                               ndarray::Manager::Ptr const &manager, detail::ColumnLayout const *columns,
+                               std::size_t firstRow, std::size_t capacity)
+        : _impl(std::make_shared<Impl>(table, recordCount, buf, manager, columns, firstRow, capacity)) {}
 
 // =============== Explicit instantiations ==================================================================
 
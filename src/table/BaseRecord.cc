@@ -1,11 +1,15 @@
 // -*- lsst-c++ -*-
 
+#include <algorithm>
 #include <cstring>
 #include <iostream>
+#include <vector>
 
 #include "lsst/pex/exceptions.h"
+#include "lsst/afw/detail/parallel.h"
 #include "lsst/afw/table/BaseRecord.h"
 #include "lsst/afw/table/SchemaMapper.h"
+#include "lsst/afw/table/detail/Access.h"
 
 namespace lsst {
 namespace afw {
@@ -88,10 +92,77 @@ void BaseRecord::assign(BaseRecord const& other, SchemaMapper const& mapper) {
         throw LSST_EXCEPT(lsst::pex::exceptions::LogicError,
                           "Unequal schemas between output record and mapper.");
     }
-    mapper.forEach(CopyValue(&other, this));  // use the functor we defined above
-    this->_assign(other);                     // let derived classes assign their own stuff
+    _assignMapped(other, mapper, *detail::Access::getCopyPlan(mapper));
+    this->_assign(other);  // let derived classes assign their own stuff
+}
+
+void BaseRecord::_assignMapped(BaseRecord const& other, SchemaMapper const& mapper,
+                               detail::RecordCopyPlan const& plan) {
+    if (_columns || other._columns) {
+        // Runs of bytes aren't contiguous in columnar records, so copy field by field.
+        mapper.forEach(CopyValue(&other, this));
+        return;
+    }
+    char const* input = reinterpret_cast<char const*>(other._data);
+    char* output = reinterpret_cast<char*>(_data);
+    for (auto const& run : plan.runs) {
+        std::memcpy(output + run.outputOffset, input + run.inputOffset, run.nBytes);
+    }
+    for (auto const& pair : plan.flags) {
+        set(pair.second, other.get(pair.first));
+    }
+    std::for_each(plan.others.begin(), plan.others.end(),
+                  detail::SchemaMapperImpl::VisitorWrapper<CopyValue>(CopyValue(&other, this)));
+}
+
+namespace detail {
+
+void assignRecords(std::vector<BaseRecord const*> const& inputs, std::vector<BaseRecord*> const& outputs,
+                   SchemaMapper const& mapper, int nThreads) {
+    if (inputs.size() != outputs.size()) {
+        throw LSST_EXCEPT(pex::exceptions::LengthError,
+                          (boost::format("Number of input records (%d) does not match outputs (%d)") %
+                           inputs.size() % outputs.size())
+                                  .str());
+    }
+    // Check each table's schema once, rather than once for every record
+    Schema const inputSchema = mapper.getInputSchema();
+    Schema const outputSchema = mapper.getOutputSchema();
+    BaseTable const* lastInputTable = nullptr;
+    BaseTable const* lastOutputTable = nullptr;
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        if (inputs[i]->_table.get() != lastInputTable) {
+            lastInputTable = inputs[i]->_table.get();
+            if (!lastInputTable->getSchema().contains(inputSchema)) {
+                throw LSST_EXCEPT(lsst::pex::exceptions::LogicError,
+                                  "Unequal schemas between input record and mapper.");
+            }
+        }
+        if (outputs[i]->_table.get() != lastOutputTable) {
+            lastOutputTable = outputs[i]->_table.get();
+            if (!lastOutputTable->getSchema().contains(outputSchema)) {
+                throw LSST_EXCEPT(lsst::pex::exceptions::LogicError,
+                                  "Unequal schemas between output record and mapper.");
+            }
+        }
+    }
+    std::shared_ptr<RecordCopyPlan const> plan = Access::getCopyPlan(mapper);
+    auto assignRange = [&inputs, &outputs, &mapper, &plan](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            outputs[i]->_assignMapped(*inputs[i], mapper, *plan);
+            outputs[i]->_assign(*inputs[i]);
+        }
+    };
+    std::size_t const size = inputs.size();
+    std::size_t const nChunks = std::min(afw::detail::getThreadCount(nThreads), size);
+    // Each thread copies a contiguous range of records.
+    afw::detail::runParallel(nChunks, [&assignRange, size, nChunks](std::size_t chunk) {
+        assignRange(chunk * size / nChunks, (chunk + 1) * size / nChunks);
+    });
 }
 
+}  // namespace detail
+
 void BaseRecord::_stream(std::ostream& os) const {
     getSchema().forEach([&os, this](auto const& item) {
         os << item.field.getName() << ": " << this->get(item.key) << std::endl;
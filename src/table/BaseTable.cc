@@ -1,6 +1,10 @@
 // -*- lsst-c++ -*-
 
+#include <cstring>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <tuple>
 
 #include "boost/shared_ptr.hpp"  // only for ndarray
 
@@ -11,6 +15,7 @@
 #include "lsst/afw/table/SchemaMapper.h"
 #include "lsst/afw/table/io/FitsWriter.h"
 #include "lsst/afw/table/detail/Access.h"
+#include "lsst/afw/table/detail/RecordStore.h"
 
 namespace lsst {
 namespace afw {
@@ -31,8 +36,52 @@ namespace table {
 //      records and/or iterators to them from being invalidated, and it keeps tables from having
 //      to track all the records whose data it owns.
 
+//  Tables that reuse blocks (see BaseTable::setBlockReuse) keep the memory of the most recently
+//  released block in a BlockCache, so a table that repeatedly fills a block and lets it go (as
+//  io::FitsChunkReader does) allocates memory only once.  Blocks hold only a weak reference to the
+//  cache, since they may outlive their table.
+
+namespace detail {
+
+class BlockCache {
+public:
+    struct AllocType {
+        double element[2];
+    };
+
+    // Return memory for at least the given number of bytes, taking the spare buffer if it is big
+    // enough.  The memory is not initialized.
+    std::unique_ptr<AllocType[]> take(std::size_t nBytes, std::size_t &capacity) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_mem && _capacity >= nBytes) {
+            capacity = _capacity;
+            return std::move(_mem);
+        }
+        capacity = nBytes;
+        return std::unique_ptr<AllocType[]>(new AllocType[nBytes / sizeof(AllocType)]);
+    }
+
+    // Keep the given memory for the next call to take, if it is bigger than the buffer we have.
+    void give(std::unique_ptr<AllocType[]> mem, std::size_t capacity) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_mem || capacity > _capacity) {
+            _mem = std::move(mem);
+            _capacity = capacity;
+        }
+    }
+
+private:
+    std::mutex _mutex;
+    std::unique_ptr<AllocType[]> _mem;
+    std::size_t _capacity = 0;
+};
+
+}  // namespace detail
+
 namespace {
 
+typedef detail::BlockCache::AllocType AllocType;
+
 class Block : public ndarray::Manager {
 public:
     typedef boost::intrusive_ptr<Block> Ptr;
@@ -49,14 +98,27 @@ public:
 
     // Ensure we have space for at least the given number of records as a contiguous block.
     // May not actually allocate anything if we already do.
-    static void preallocate(std::size_t recordSize, std::size_t recordCount, ndarray::Manager::Ptr &manager) {
+    static void preallocate(std::size_t recordSize, std::size_t recordCount, ndarray::Manager::Ptr &manager,
+                            std::shared_ptr<detail::BlockCache> const &cache) {
         Ptr block = boost::static_pointer_cast<Block>(manager);
         if (!block || static_cast<std::size_t>(block->_end - block->_next) < recordSize * recordCount) {
-            block = Ptr(new Block(recordSize, recordCount));
-            manager = block;
+            // Let go of the old block first, so its memory can be reused if no records refer to it.
+            block.reset();
+            manager.reset();
+            manager = Ptr(new Block(recordSize, recordCount, cache));
         }
     }
 
+    // Return the start of the block and the number of records it holds, for columnar records.
+    static char *getBegin(ndarray::Manager::Ptr const &manager) {
+        return reinterpret_cast<char *>(boost::static_pointer_cast<Block>(manager)->_mem.get());
+    }
+
+    static std::size_t getCapacity(std::size_t recordSize, ndarray::Manager::Ptr const &manager) {
+        Ptr block = boost::static_pointer_cast<Block>(manager);
+        return static_cast<std::size_t>(block->_end - getBegin(manager)) / recordSize;
+    }
+
     static std::size_t getBufferSize(std::size_t recordSize, ndarray::Manager::Ptr const &manager) {
         Ptr block = boost::static_pointer_cast<Block>(manager);
         return static_cast<std::size_t>(block->_end - block->_next) / recordSize;
@@ -64,10 +126,13 @@ public:
 
     // Get the next chunk from the block, making a new block and installing it into the table
     // if we're all out of space.
-    static void *get(std::size_t recordSize, ndarray::Manager::Ptr &manager) {
+    static void *get(std::size_t recordSize, ndarray::Manager::Ptr &manager,
+                     std::shared_ptr<detail::BlockCache> const &cache) {
         Ptr block = boost::static_pointer_cast<Block>(manager);
         if (!block || block->_next == block->_end) {
-            block = Ptr(new Block(recordSize, BaseTable::nRecordsPerBlock));
+            block.reset();
+            manager.reset();
+            block = Ptr(new Block(recordSize, BaseTable::nRecordsPerBlock, cache));
             manager = block;
         }
         void *r = block->_next;
@@ -86,29 +151,106 @@ public:
         }
     }
 
-private:
-    struct AllocType {
-        double element[2];
-    };
+    ~Block() {
+        if (auto cache = _cache.lock()) {
+            cache->give(std::move(_mem), _memSize);
+        }
+    }
 
-    explicit Block(std::size_t recordSize, std::size_t recordCount)
-            : _mem(new AllocType[(recordSize * recordCount) / sizeof(AllocType)]),
-              _next(reinterpret_cast<char *>(_mem.get())),
-              _end(_next + recordSize * recordCount) {
-        assert((recordSize * recordCount) % sizeof(AllocType) == 0);
+private:
+    explicit Block(std::size_t recordSize, std::size_t recordCount,
+                   std::shared_ptr<detail::BlockCache> const &cache)
+            : _cache(cache) {
+        std::size_t const nBytes = recordSize * recordCount;
+        assert(nBytes % sizeof(AllocType) == 0);
+        if (cache) {
+            _mem = cache->take(nBytes, _memSize);
+        } else {
+            _mem.reset(new AllocType[nBytes / sizeof(AllocType)]);
+            _memSize = nBytes;
+        }
+        _next = reinterpret_cast<char *>(_mem.get());
+        _end = _next + nBytes;
         std::fill(_next, _end, 0);  // initialize to zero; we'll later initialize floats to NaN.
     }
 
+    std::weak_ptr<detail::BlockCache> _cache;  // where to return _mem when done; may be expired
     std::unique_ptr<AllocType[]> _mem;
+    std::size_t _memSize;  // size of _mem in bytes, which may be more than we use
     char *_next;
     char *_end;
 };
 
+// A Schema functor that records the storage size of each field, and whether it holds plain data.
+struct ColumnSizes {
+    template <typename T>
+    void operator()(SchemaItem<T> const &item) const {
+        add(item.key.getOffset(), sizeof(typename Field<T>::Element) * item.key.getElementCount(), true);
+    }
+
+    template <typename T>
+    void operator()(SchemaItem<Array<T> > const &item) const {
+        if (item.key.isVariableLength()) {
+            add(item.key.getOffset(), sizeof(ndarray::Array<T, 1, 1>), false);
+        } else {
+            add(item.key.getOffset(), sizeof(T) * item.key.getElementCount(), true);
+        }
+    }
+
+    void operator()(SchemaItem<std::string> const &item) const {
+        if (item.key.isVariableLength()) {
+            add(item.key.getOffset(), sizeof(std::string), false);
+        } else {
+            add(item.key.getOffset(), item.key.getElementCount(), true);
+        }
+    }
+
+    void operator()(SchemaItem<Flag> const &item) const {
+        add(item.key.getOffset(), sizeof(Field<Flag>::Element), true);
+    }
+
+    void add(int offset, std::size_t size, bool fixed) const { fields->emplace(offset, size, fixed); }
+
+    std::set<std::tuple<int, std::size_t, bool> > *fields;
+};
+
 }  // namespace
 
+// =============== ColumnLayout =============================================================================
+
+namespace detail {
+
+ColumnLayout::ColumnLayout(Schema const &schema) : _columns(schema.getRecordSize(), Column{0, 0}) {
+    // Flag fields share their storage, so we use a set to visit each field only once.
+    std::set<std::tuple<int, std::size_t, bool> > fields;
+    schema.forEach(ColumnSizes{&fields});
+    for (auto const &field : fields) {
+        Column const column = {static_cast<std::uint32_t>(std::get<0>(field)),
+                               static_cast<std::uint32_t>(std::get<1>(field))};
+        std::fill(_columns.begin() + column.offset, _columns.begin() + column.offset + column.size, column);
+        if (std::get<2>(field)) _fixed.push_back(column);
+    }
+}
+
+void ColumnLayout::gather(char const *block, std::size_t capacity, std::size_t row, char *out) const {
+    for (auto const &column : _fixed) {
+        std::memcpy(out + column.offset, block + column.offset * capacity + row * column.size, column.size);
+    }
+}
+
+void ColumnLayout::scatter(char const *in, char *block, std::size_t capacity, std::size_t row) const {
+    for (auto const &column : _fixed) {
+        std::memcpy(block + column.offset * capacity + row * column.size, in + column.offset, column.size);
+    }
+}
+
+}  // namespace detail
+
 // =============== BaseTable implementation (see header for docs) ===========================================
 
-void BaseTable::preallocate(std::size_t n) { Block::preallocate(_schema.getRecordSize(), n, _manager); }
+void BaseTable::preallocate(std::size_t n) {
+    Block::preallocate(_schema.getRecordSize(), n, _manager, _getBlockCache());
+}
 
 std::size_t BaseTable::getBufferSize() const {
     if (_manager) {
@@ -118,6 +260,24 @@ std::size_t BaseTable::getBufferSize() const {
     }
 }
 
+void BaseTable::setColumnar(bool columnar) {
+    if (columnar == isColumnar()) return;
+    _columns = columnar ? std::make_shared<detail::ColumnLayout>(_schema) : nullptr;
+    _manager.reset();  // start a new block so the two layouts never share one
+}
+
+void BaseTable::setBlockReuse(bool reuse) {
+    _reuseBlocks = reuse;
+    if (!reuse) _blockCache.reset();
+}
+
+std::shared_ptr<detail::BlockCache> const &BaseTable::_getBlockCache() {
+    if (_reuseBlocks && !_blockCache) {
+        _blockCache = std::make_shared<detail::BlockCache>();
+    }
+    return _blockCache;
+}
+
 std::shared_ptr<BaseTable> BaseTable::make(Schema const &schema) {
     return std::shared_ptr<BaseTable>(new BaseTable(schema));
 }
@@ -146,6 +306,10 @@ std::shared_ptr<BaseRecord> BaseTable::_makeRecord() {
     return std::shared_ptr<BaseRecord>(new BaseRecord(shared_from_this()));
 }
 
+std::shared_ptr<BaseRecord> BaseTable::_makeRecordView(detail::RecordView const &view) {
+    return std::shared_ptr<BaseRecord>(new BaseRecord(shared_from_this(), view));
+}
+
 BaseTable::BaseTable(Schema const &schema) : daf::base::Citizen(typeid(this)), _schema(schema) {
     Block::padSchema(_schema);
     _schema.disconnectAliases();
@@ -176,7 +340,7 @@ struct RecordInitializer {
 
     template <typename T>
     void operator()(SchemaItem<T> const &item) const {
-        fill(reinterpret_cast<typename Field<T>::Element *>(data + item.key.getOffset()),
+        fill(reinterpret_cast<typename Field<T>::Element *>(at(item.key.getOffset())),
              item.key.getElementCount());
     }
 
@@ -184,9 +348,9 @@ struct RecordInitializer {
     void operator()(SchemaItem<Array<T> > const &item) const {
         if (item.key.isVariableLength()) {
             // Use placement new because the memory (for one ndarray) is already allocated
-            new (data + item.key.getOffset()) ndarray::Array<T, 1, 1>();
+            new (at(item.key.getOffset())) ndarray::Array<T, 1, 1>();
         } else {
-            fill(reinterpret_cast<typename Field<T>::Element *>(data + item.key.getOffset()),
+            fill(reinterpret_cast<typename Field<T>::Element *>(at(item.key.getOffset())),
                  item.key.getElementCount());
         }
     }
@@ -194,15 +358,20 @@ struct RecordInitializer {
     void operator()(SchemaItem<std::string> const &item) const {
         if (item.key.isVariableLength()) {
             // Use placement new because the memory (for one std::string) is already allocated
-            new (reinterpret_cast<std::string *>(data + item.key.getOffset())) std::string();
+            new (reinterpret_cast<std::string *>(at(item.key.getOffset()))) std::string();
         } else {
-            fill(reinterpret_cast<char *>(data + item.key.getOffset()), item.key.getElementCount());
+            fill(reinterpret_cast<char *>(at(item.key.getOffset())), item.key.getElementCount());
         }
     }
 
     void operator()(SchemaItem<Flag> const &item) const {}  // do nothing for Flag fields; already 0
 
-    char *data;
+    char *at(int offset) const {
+        return record ? detail::Access::getElementData(*record, offset) : data + offset;
+    }
+
+    BaseRecord *record;
+    char *data;  // row-major field data to use when there is no record
 };
 
 // A Schema Functor used to set destroy variable-length array fields using an explicit call to their
@@ -215,7 +384,7 @@ struct RecordDestroyer {
     void operator()(SchemaItem<Array<T> > const &item) const {
         typedef ndarray::Array<T, 1, 1> Element;
         if (item.key.isVariableLength()) {
-            (*reinterpret_cast<Element *>(data + item.key.getOffset())).~Element();
+            (*reinterpret_cast<Element *>(at(item.key.getOffset()))).~Element();
         }
     }
 
@@ -223,27 +392,51 @@ struct RecordDestroyer {
         if (item.key.isVariableLength()) {
             using std::string;  // invoking the destructor on a qualified name doesn't compile in gcc 4.8.1
                                 // https://stackoverflow.com/q/24593942
-            (*reinterpret_cast<string *>(data + item.key.getOffset())).~string();
+            (*reinterpret_cast<string *>(at(item.key.getOffset()))).~string();
         }
     }
 
-    char *data;
+    char *at(int offset) const {
+        return record ? detail::Access::getElementData(*record, offset) : data + offset;
+    }
+
+    BaseRecord *record;
+    char *data;  // row-major field data to use when there is no record
 };
 
 }  // namespace
 
 void BaseTable::_initialize(BaseRecord &record) {
-    record._data = Block::get(_schema.getRecordSize(), _manager);
-    RecordInitializer f = {reinterpret_cast<char *>(record._data)};
+    record._view = false;
+    std::size_t const recordSize = _schema.getRecordSize();
+    char *slot = reinterpret_cast<char *>(Block::get(recordSize, _manager, _getBlockCache()));
+    if (_columns) {
+        char *begin = Block::getBegin(_manager);
+        record._data = begin;
+        record._columns = _columns.get();
+        record._row = (slot - begin) / recordSize;
+        record._capacity = Block::getCapacity(recordSize, _manager);
+    } else {
+        record._data = slot;
+        record._columns = nullptr;
+        record._row = 0;
+        record._capacity = 0;
+    }
+    RecordInitializer f = {&record, nullptr};
     _schema.forEach(f);
     record._manager = _manager;  // manager always points to the most recently-used block.
 }
 
 void BaseTable::_destroy(BaseRecord &record) {
     assert(record._table.get() == this);
-    RecordDestroyer f = {reinterpret_cast<char *>(record._data)};
+    if (record._view) return;
+    RecordDestroyer f = {&record, nullptr};
     _schema.forEach(f);
-    if (record._manager == _manager) Block::reclaim(_schema.getRecordSize(), record._data, _manager);
+    if (record._manager == _manager) {
+        std::size_t const recordSize = _schema.getRecordSize();
+        char *slot = reinterpret_cast<char *>(record._data) + record._row * recordSize;
+        Block::reclaim(recordSize, slot, _manager);
+    }
 }
 
 /*
@@ -254,6 +447,33 @@ void BaseTable::_destroy(BaseRecord &record) {
  */
 int BaseTable::nRecordsPerBlock = 100;
 
+// =============== RecordStore ==============================================================================
+
+namespace detail {
+
+RecordStore::RecordStore(Schema const &schema, std::size_t capacity)
+        : _schema(schema),
+          _recordSize(schema.getRecordSize()),
+          _capacity(capacity),
+          _size(0),
+          _mem(new char[_recordSize * capacity]()) {}
+
+std::size_t RecordStore::append() {
+    assert(_size < _capacity);
+    RecordInitializer f = {nullptr, getRecord(_size)};
+    _schema.forEach(f);
+    return _size++;
+}
+
+RecordStore::~RecordStore() {
+    for (std::size_t i = 0; i < _size; ++i) {
+        RecordDestroyer f = {nullptr, getRecord(i)};
+        _schema.forEach(f);
+    }
+}
+
+}  // namespace detail
+
 // =============== BaseCatalog instantiation =================================================================
 
 template class CatalogT<BaseRecord>;
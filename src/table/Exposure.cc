@@ -201,6 +201,7 @@ public:
         if (!_archive) {
             _doWriteArchive = true;
             _archive.reset(new io::OutputArchive());
+            _archive->setContentDeduplication((flags & EXPOSURE_IO_DEDUPLICATE_ARCHIVE) != 0);
         }
     }
 
@@ -374,6 +375,9 @@ bool ExposureRecord::contains(lsst::geom::Point2D const &point, geom::SkyWcs con
 
 ExposureRecord::ExposureRecord(std::shared_ptr<ExposureTable> const &table) : BaseRecord(table) {}
 
+ExposureRecord::ExposureRecord(std::shared_ptr<ExposureTable> const &table, detail::RecordView const &view)
+        : BaseRecord(table, view) {}
+
 ExposureRecord::~ExposureRecord() = default;
 
 void ExposureRecord::_assign(BaseRecord const &other) {
@@ -391,6 +395,17 @@ void ExposureRecord::_assign(BaseRecord const &other) {
     }
 }
 
+void ExposureRecord::_resetView() {
+    _psf.reset();
+    _wcs.reset();
+    _photoCalib.reset();
+    _apCorrMap.reset();
+    _validPolygon.reset();
+    _visitInfo.reset();
+    _transmissionCurve.reset();
+    _detector.reset();
+}
+
 std::shared_ptr<ExposureTable> ExposureTable::make(Schema const &schema) {
     if (!checkSchema(schema)) {
         throw LSST_EXCEPT(
@@ -437,6 +452,10 @@ std::shared_ptr<BaseRecord> ExposureTable::_makeRecord() {
     return std::shared_ptr<ExposureRecord>(new ExposureRecord(getSelf<ExposureTable>()));
 }
 
+std::shared_ptr<BaseRecord> ExposureTable::_makeRecordView(detail::RecordView const &view) {
+    return std::shared_ptr<ExposureRecord>(new ExposureRecord(getSelf<ExposureTable>(), view));
+}
+
 //-----------------------------------------------------------------------------------------------------------
 //----- ExposureCatalogT member function implementations ----------------------------------------------------
 //-----------------------------------------------------------------------------------------------------------
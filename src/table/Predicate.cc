@@ -0,0 +1,264 @@
+// -*- lsst-c++ -*-
+
+#include <algorithm>
+#include <functional>
+
+#include "boost/preprocessor/seq/for_each.hpp"
+#include "boost/preprocessor/tuple/to_seq.hpp"
+
+#include "lsst/pex/exceptions.h"
+#include "lsst/afw/table/Predicate.h"
+#include "lsst/afw/table/detail/Access.h"
+
+namespace lsst {
+namespace afw {
+namespace table {
+
+namespace {
+
+// Number of records evaluated at a time; small enough that a block's temporaries stay in cache.
+std::size_t const BLOCK_SIZE = 4096;
+
+// The loops below are written so the compiler can vectorize them: no branches, and unit stride
+// whenever the column has it.
+template <typename T, typename Op>
+void compareColumn(T const* data, std::ptrdiff_t stride, std::size_t n, T const& value, Op op,
+                   unsigned char* out) {
+    if (stride == 1) {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = op(data[i], value);
+        }
+    } else {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = op(data[i * stride], value);
+        }
+    }
+}
+
+// Call func with the function object that implements a comparison operator.
+template <typename T, typename Func>
+void dispatchComparison(Predicate::Comparison op, Func func) {
+    switch (op) {
+        case Predicate::EQUAL:
+            return func(std::equal_to<T>());
+        case Predicate::NOT_EQUAL:
+            return func(std::not_equal_to<T>());
+        case Predicate::LESS:
+            return func(std::less<T>());
+        case Predicate::LESS_EQUAL:
+            return func(std::less_equal<T>());
+        case Predicate::GREATER:
+            return func(std::greater<T>());
+        case Predicate::GREATER_EQUAL:
+            return func(std::greater_equal<T>());
+    }
+    throw LSST_EXCEPT(pex::exceptions::InvalidParameterError, "Unknown comparison operator.");
+}
+
+void checkKey(bool isValid) {
+    if (!isValid) {
+        throw LSST_EXCEPT(pex::exceptions::LogicError,
+                          "Key is not valid (if this is a SourceCatalog, make sure slot aliases have been "
+                          "set up).");
+    }
+}
+
+}  // namespace
+
+// =============== Nodes ====================================================================================
+
+// A node in the expression tree.  Nodes evaluate a block of rows of a column view, writing 0 or 1
+// to each element of out.
+class Predicate::Node {
+public:
+    virtual void evaluate(BaseColumnView const& columns, std::size_t begin, std::size_t n,
+                          unsigned char* out) const = 0;
+
+    virtual bool evaluate(BaseRecord const& record) const = 0;
+
+    virtual ~Node() = default;
+};
+
+template <typename T>
+class Predicate::ComparisonNode final : public Predicate::Node {
+public:
+    ComparisonNode(Key<T> const& key, Comparison op, T const& value) : _key(key), _op(op), _value(value) {
+        checkKey(key.isValid());
+    }
+
+    void evaluate(BaseColumnView const& columns, std::size_t begin, std::size_t n,
+                  unsigned char* out) const override {
+        ndarray::ArrayRef<T, 1> const column = columns[_key];
+        std::ptrdiff_t const stride = column.template getStride<0>();
+        T const* data = column.getData() + begin * stride;
+        dispatchComparison<T>(_op, [&](auto op) { compareColumn(data, stride, n, _value, op, out); });
+    }
+
+    bool evaluate(BaseRecord const& record) const override {
+        bool result = false;
+        dispatchComparison<T>(_op, [&](auto op) { result = op(record.get(_key), _value); });
+        return result;
+    }
+
+private:
+    Key<T> _key;
+    Comparison _op;
+    T _value;
+};
+
+class Predicate::FlagNode final : public Predicate::Node {
+public:
+    FlagNode(Key<Flag> const& key, bool value)
+            : _storage(detail::Access::makeKey<Field<Flag>::Element>(key.getOffset())),
+              _bit(key.getBit()),
+              _value(value) {
+        checkKey(key.isValid());
+    }
+
+    void evaluate(BaseColumnView const& columns, std::size_t begin, std::size_t n,
+                  unsigned char* out) const override {
+        ndarray::ArrayRef<Field<Flag>::Element, 1> const column = columns[_storage];
+        std::ptrdiff_t const stride = column.getStride<0>();
+        Field<Flag>::Element const* data = column.getData() + begin * stride;
+        unsigned char const expected = _value;
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = ((data[i * stride] >> _bit) & 1) == expected;
+        }
+    }
+
+    bool evaluate(BaseRecord const& record) const override {
+        return ((record.get(_storage) >> _bit) & 1) == static_cast<Field<Flag>::Element>(_value);
+    }
+
+private:
+    Key<Field<Flag>::Element> _storage;  // the integer the flag is a bit of
+    int _bit;
+    bool _value;
+};
+
+class Predicate::AndNode final : public Predicate::Node {
+public:
+    AndNode(std::shared_ptr<Node const> left, std::shared_ptr<Node const> right)
+            : _left(std::move(left)), _right(std::move(right)) {}
+
+    void evaluate(BaseColumnView const& columns, std::size_t begin, std::size_t n,
+                  unsigned char* out) const override {
+        _left->evaluate(columns, begin, n, out);
+        if (std::none_of(out, out + n, [](unsigned char v) { return v; })) return;
+        std::vector<unsigned char> other(n);
+        _right->evaluate(columns, begin, n, other.data());
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] &= other[i];
+        }
+    }
+
+    bool evaluate(BaseRecord const& record) const override {
+        return _left->evaluate(record) && _right->evaluate(record);
+    }
+
+private:
+    std::shared_ptr<Node const> _left;
+    std::shared_ptr<Node const> _right;
+};
+
+class Predicate::OrNode final : public Predicate::Node {
+public:
+    OrNode(std::shared_ptr<Node const> left, std::shared_ptr<Node const> right)
+            : _left(std::move(left)), _right(std::move(right)) {}
+
+    void evaluate(BaseColumnView const& columns, std::size_t begin, std::size_t n,
+                  unsigned char* out) const override {
+        _left->evaluate(columns, begin, n, out);
+        if (std::all_of(out, out + n, [](unsigned char v) { return v; })) return;
+        std::vector<unsigned char> other(n);
+        _right->evaluate(columns, begin, n, other.data());
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] |= other[i];
+        }
+    }
+
+    bool evaluate(BaseRecord const& record) const override {
+        return _left->evaluate(record) || _right->evaluate(record);
+    }
+
+private:
+    std::shared_ptr<Node const> _left;
+    std::shared_ptr<Node const> _right;
+};
+
+class Predicate::NotNode final : public Predicate::Node {
+public:
+    explicit NotNode(std::shared_ptr<Node const> operand) : _operand(std::move(operand)) {}
+
+    void evaluate(BaseColumnView const& columns, std::size_t begin, std::size_t n,
+                  unsigned char* out) const override {
+        _operand->evaluate(columns, begin, n, out);
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] ^= 1;
+        }
+    }
+
+    bool evaluate(BaseRecord const& record) const override { return !_operand->evaluate(record); }
+
+private:
+    std::shared_ptr<Node const> _operand;
+};
+
+// =============== Predicate implementation (see header for docs) ===========================================
+
+Predicate::Predicate(Key<Flag> const& key, bool value) : _node(std::make_shared<FlagNode>(key, value)) {}
+
+Predicate::Predicate(std::shared_ptr<Node const> node) : _node(std::move(node)) {}
+
+Predicate::Predicate(Predicate const&) = default;
+Predicate::Predicate(Predicate&&) = default;
+Predicate& Predicate::operator=(Predicate const&) = default;
+Predicate& Predicate::operator=(Predicate&&) = default;
+Predicate::~Predicate() = default;
+
+Predicate Predicate::operator&&(Predicate const& other) const {
+    return Predicate(std::make_shared<AndNode>(_node, other._node));
+}
+
+Predicate Predicate::operator||(Predicate const& other) const {
+    return Predicate(std::make_shared<OrNode>(_node, other._node));
+}
+
+Predicate Predicate::operator!() const { return Predicate(std::make_shared<NotNode>(_node)); }
+
+bool Predicate::operator()(BaseRecord const& record) const { return _node->evaluate(record); }
+
+ndarray::Array<bool, 1, 1> Predicate::evaluate(BaseColumnView const& columns) const {
+    std::size_t const size = columns.size();
+    ndarray::Array<bool, 1, 1> result = ndarray::allocate(size);
+    std::vector<unsigned char> block(BLOCK_SIZE);
+    for (std::size_t begin = 0; begin < size; begin += BLOCK_SIZE) {
+        std::size_t const n = std::min(BLOCK_SIZE, size - begin);
+        _node->evaluate(columns, begin, n, block.data());
+        std::copy(block.begin(), block.begin() + n, result.begin() + begin);
+    }
+    return result;
+}
+
+template <typename T>
+std::shared_ptr<Predicate::Node const> Predicate::_makeComparison(Key<T> const& key, Comparison op,
+                                                                  typename Field<T>::Value const& value) {
+    return std::make_shared<ComparisonNode<T>>(key, op, value);
+}
+
+std::size_t Predicate::_count(ndarray::Array<bool, 1, 1> const& mask) {
+    return std::count(mask.begin(), mask.end(), true);
+}
+
+// =============== Explicit instantiations ==================================================================
+
+#define INSTANTIATE_PREDICATE_COMPARISON(r, data, elem)                         \
+    template std::shared_ptr<Predicate::Node const> Predicate::_makeComparison( \
+            Key<elem> const&, Comparison, Field<elem>::Value const&);
+
+BOOST_PP_SEQ_FOR_EACH(INSTANTIATE_PREDICATE_COMPARISON, _,
+                      BOOST_PP_TUPLE_TO_SEQ(AFW_TABLE_SCALAR_FIELD_TYPE_N, AFW_TABLE_SCALAR_FIELD_TYPE_TUPLE))
+
+}  // namespace table
+}  // namespace afw
+}  // namespace lsst
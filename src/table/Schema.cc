@@ -200,18 +200,17 @@ struct ExtractItemByName : public boost::static_visitor<> {
 // Here's the driver for the find-by-name algorithm.
 template <typename T>
 SchemaItem<T> SchemaImpl::find(std::string const &name) const {
-    NameMap::const_iterator i = _names.lower_bound(name);
-    if (i != _names.end()) {
-        if (i->first == name) {
-            // got an exact match; we're done if it has the right type, and dead if it doesn't.
-            try {
-                return boost::get<SchemaItem<T> const>(_items[i->second]);
-            } catch (boost::bad_get &err) {
-                throw LSST_EXCEPT(lsst::pex::exceptions::TypeError,
-                                  (boost::format("Field '%s' does not have the given type.") % name).str());
-            }
+    NameIndex::const_iterator j = _nameIndex.find(name);
+    if (j != _nameIndex.end()) {
+        // got an exact match; we're done if it has the right type, and dead if it doesn't.
+        try {
+            return boost::get<SchemaItem<T> const>(_items[j->second]);
+        } catch (boost::bad_get &err) {
+            throw LSST_EXCEPT(lsst::pex::exceptions::TypeError,
+                              (boost::format("Field '%s' does not have the given type.") % name).str());
         }
     }
+    NameMap::const_iterator i = _names.lower_bound(name);
     // We didn't get an exact match, but we might be searching for "a.x/a_x" and "a" might be a point field.
     // Because the names are sorted, we know we overshot it, so we work backwards.
     ExtractItemByName<T> extractor(name, getDelimiter());
@@ -404,6 +403,8 @@ void SchemaImpl::replaceField(Key<T> const &key, Field<T> const &field) {
         }
         j = _names.find(item->field.getName());
         _names.insert(j, std::pair<std::string, int>(field.getName(), j->second));
+        _nameIndex.erase(item->field.getName());
+        _nameIndex.emplace(field.getName(), j->second);
         _names.erase(j);
     }
     item->field = field;
@@ -548,6 +549,7 @@ Key<Flag> SchemaImpl::addField(Field<Flag> const &field, bool doReplace) {
         ++_lastFlagBit;
         _flags.insert(std::pair<std::pair<int, int>, int>(
                 std::make_pair(item.key.getOffset(), item.key.getBit()), _items.size()));
+        _nameIndex.emplace(field.getName(), _items.size());
         _items.push_back(item);
         return item.key;
     }
@@ -593,6 +595,7 @@ Key<T> SchemaImpl::addFieldImpl(int elementSize, int elementCount, Field<T> cons
         SchemaItem<T> item(detail::Access::makeKey(field, _recordSize), field);
         _recordSize += elementCount * elementSize;
         _offsets.insert(std::pair<int, int>(item.key.getOffset(), _items.size()));
+        _nameIndex.emplace(field.getName(), _items.size());
         _items.push_back(item);
         return item.key;
     }
@@ -93,6 +93,53 @@ struct AddUnmapped {
     std::string prefix;
 };
 
+// SchemaMapper::forEach functor that compiles the mapping into a RecordCopyPlan.
+struct CompileCopyPlan {
+    template <typename T>
+    void operator()(Key<T> const &inputKey, Key<T> const &outputKey) const {
+        addRun(inputKey, outputKey, sizeof(typename Field<T>::Element) * inputKey.getElementCount());
+    }
+
+    template <typename T>
+    void operator()(Key<Array<T> > const &inputKey, Key<Array<T> > const &outputKey) const {
+        if (inputKey.isVariableLength() || outputKey.isVariableLength()) {
+            plan->others.push_back(std::make_pair(inputKey, outputKey));
+        } else {
+            addRun(inputKey, outputKey, sizeof(T) * inputKey.getElementCount());
+        }
+    }
+
+    void operator()(Key<std::string> const &inputKey, Key<std::string> const &outputKey) const {
+        if (inputKey.isVariableLength() || outputKey.isVariableLength()) {
+            plan->others.push_back(std::make_pair(inputKey, outputKey));
+        } else {
+            addRun(inputKey, outputKey, inputKey.getElementCount());
+        }
+    }
+
+    void operator()(Key<Flag> const &inputKey, Key<Flag> const &outputKey) const {
+        plan->flags.push_back(std::make_pair(inputKey, outputKey));
+    }
+
+    // Append a run, merging it with the previous one when both sides are contiguous.
+    template <typename T>
+    void addRun(Key<T> const &inputKey, Key<T> const &outputKey, std::size_t nBytes) const {
+        detail::RecordCopyPlan::Run const run = {static_cast<std::size_t>(inputKey.getOffset()),
+                                                 static_cast<std::size_t>(outputKey.getOffset()), nBytes};
+        if (!plan->runs.empty()) {
+            detail::RecordCopyPlan::Run &last = plan->runs.back();
+            if (last.inputOffset + last.nBytes == run.inputOffset &&
+                last.outputOffset + last.nBytes == run.outputOffset) {
+                last.nBytes += run.nBytes;
+                return;
+            }
+        }
+        plan->runs.push_back(run);
+    }
+
+    detail::RecordCopyPlan *plan;
+};
+
 struct RemoveMinimalSchema {
     template <typename T>
     void operator()(SchemaItem<T> const &item) const {
@@ -145,6 +192,7 @@ Key<T> SchemaMapper::addMapping(Key<T> const &inputKey, bool doReplace) {
     } else {
         Key<T> outputKey = _impl->_output.addField(inputField, doReplace);
         _impl->_map.insert(i, std::make_pair(inputKey, outputKey));
+        _impl->_plan.reset();
         return outputKey;
     }
 }
@@ -160,6 +208,7 @@ Key<T> SchemaMapper::addMapping(Key<T> const &inputKey, Field<T> const &field, b
     } else {
         Key<T> outputKey = _impl->_output.addField(field, doReplace);
         _impl->_map.insert(i, std::make_pair(inputKey, outputKey));
+        _impl->_plan.reset();
         return outputKey;
     }
 }
@@ -179,6 +228,7 @@ Key<T> SchemaMapper::addMapping(Key<T> const &inputKey, std::string const &outpu
         Field<T> outputField = inputField.copyRenamed(outputName);
         Key<T> outputKey = _impl->_output.addField(outputField, doReplace);
         _impl->_map.insert(i, std::make_pair(inputKey, outputKey));
+        _impl->_plan.reset();
         return outputKey;
     }
 }
@@ -202,6 +252,19 @@ SchemaMapper SchemaMapper::removeMinimalSchema(Schema const &input, Schema const
 void SchemaMapper::invert() {
     std::swap(_impl->_input, _impl->_output);
     std::for_each(_impl->_map.begin(), _impl->_map.end(), SwapKeyPair());
+    _impl->_plan.reset();
+}
+
+std::shared_ptr<detail::RecordCopyPlan const> SchemaMapper::_getCopyPlan() const {
+    // The plan is immutable once built, so threads that race to build it just make identical copies.
+    std::shared_ptr<detail::RecordCopyPlan const> plan = std::atomic_load(&_impl->_plan);
+    if (!plan) {
+        auto compiled = std::make_shared<detail::RecordCopyPlan>();
+        forEach(CompileCopyPlan{compiled.get()});
+        plan = compiled;
+        std::atomic_store(&_impl->_plan, plan);
+    }
+    return plan;
 }
 
 template <typename T>
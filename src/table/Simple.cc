@@ -72,6 +72,9 @@ static SimpleFitsReader const simpleFitsReader;
 
 SimpleRecord::SimpleRecord(std::shared_ptr<SimpleTable> const& table) : BaseRecord(table) {}
 
+SimpleRecord::SimpleRecord(std::shared_ptr<SimpleTable> const& table, detail::RecordView const& view)
+        : BaseRecord(table, view) {}
+
 SimpleRecord::~SimpleRecord() = default;
 
 std::shared_ptr<SimpleTable> SimpleTable::make(Schema const& schema,
@@ -118,6 +121,10 @@ std::shared_ptr<BaseRecord> SimpleTable::_makeRecord() {
     return record;
 }
 
+std::shared_ptr<BaseRecord> SimpleTable::_makeRecordView(detail::RecordView const& view) {
+    return std::shared_ptr<SimpleRecord>(new SimpleRecord(getSelf<SimpleTable>(), view));
+}
+
 template class CatalogT<SimpleRecord>;
 template class CatalogT<SimpleRecord const>;
 
@@ -365,6 +365,9 @@ static SourceFitsReader const sourceFitsReader;
 
 SourceRecord::SourceRecord(std::shared_ptr<SourceTable> const &table) : SimpleRecord(table) {}
 
+SourceRecord::SourceRecord(std::shared_ptr<SourceTable> const &table, detail::RecordView const &view)
+        : SimpleRecord(table, view) {}
+
 SourceRecord::~SourceRecord() = default;
 
 void SourceRecord::updateCoord(geom::SkyWcs const &wcs) { setCoord(wcs.pixelToSky(getCentroid())); }
@@ -381,6 +384,8 @@ void SourceRecord::_assign(BaseRecord const &other) {
     }
 }
 
+void SourceRecord::_resetView() { _footprint.reset(); }
+
 std::shared_ptr<SourceTable> SourceTable::make(Schema const &schema,
                                                std::shared_ptr<IdFactory> const &idFactory) {
     if (!checkSchema(schema)) {
@@ -429,6 +434,10 @@ std::shared_ptr<BaseRecord> SourceTable::_makeRecord() {
     return record;
 }
 
+std::shared_ptr<BaseRecord> SourceTable::_makeRecordView(detail::RecordView const &view) {
+    return std::shared_ptr<SourceRecord>(new SourceRecord(getSelf<SourceTable>(), view));
+}
+
 template class CatalogT<SourceRecord>;
 template class CatalogT<SourceRecord const>;
 
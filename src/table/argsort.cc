@@ -0,0 +1,75 @@
+// -*- lsst-c++ -*-
+
+#include <array>
+
+#include "lsst/afw/table/detail/argsort.h"
+
+namespace lsst {
+namespace afw {
+namespace table {
+namespace detail {
+
+namespace {
+
+std::size_t const MIN_CHUNK_SIZE = 1 << 15;
+
+struct RadixItem {
+    std::uint64_t key;
+    std::size_t index;
+};
+
+}  // namespace
+
+std::size_t getChunkCount(std::size_t size, int nThreads) {
+    return std::max<std::size_t>(1, std::min(afw::detail::getThreadCount(nThreads), size / MIN_CHUNK_SIZE));
+}
+
+std::vector<std::size_t> radixArgsort(std::vector<std::uint64_t> const& keys, int nThreads) {
+    std::size_t const size = keys.size();
+    std::vector<RadixItem> items(size);
+    std::vector<RadixItem> buffer(size);
+    std::uint64_t varying = 0;  // bits that differ between keys
+    for (std::size_t i = 0; i < size; ++i) {
+        items[i] = RadixItem{keys[i], i};
+        varying |= keys[i] ^ keys.front();
+    }
+    std::size_t const nChunks = getChunkCount(size, nThreads);
+    auto bound = [size, nChunks](std::size_t chunk) { return chunk * size / nChunks; };
+    std::vector<std::array<std::size_t, 256> > offsets(nChunks);
+    for (int shift = 0; shift < 64; shift += 8) {
+        if (((varying >> shift) & 0xFF) == 0) continue;
+        // Each chunk counts its digits, then scatters its items to positions that follow those of
+        // all items with smaller digits and of earlier chunks with the same digit, which keeps the
+        // sort stable.
+        afw::detail::runParallel(nChunks, [&](std::size_t chunk) {
+            offsets[chunk].fill(0);
+            for (std::size_t i = bound(chunk); i < bound(chunk + 1); ++i) {
+                ++offsets[chunk][(items[i].key >> shift) & 0xFF];
+            }
+        });
+        std::size_t total = 0;
+        for (std::size_t digit = 0; digit < 256; ++digit) {
+            for (std::size_t chunk = 0; chunk < nChunks; ++chunk) {
+                std::size_t const count = offsets[chunk][digit];
+                offsets[chunk][digit] = total;
+                total += count;
+            }
+        }
+        afw::detail::runParallel(nChunks, [&](std::size_t chunk) {
+            for (std::size_t i = bound(chunk); i < bound(chunk + 1); ++i) {
+                buffer[offsets[chunk][(items[i].key >> shift) & 0xFF]++] = items[i];
+            }
+        });
+        items.swap(buffer);
+    }
+    std::vector<std::size_t> indices(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        indices[i] = items[i].index;
+    }
+    return indices;
+}
+
+}  // namespace detail
+}  // namespace table
+}  // namespace afw
+}  // namespace lsst
@@ -105,8 +105,36 @@ ArrayKey<T> &ArrayKey<T>::operator=(ArrayKey &&) noexcept = default;
 template <typename T>
 ArrayKey<T>::~ArrayKey() noexcept = default;
 
+namespace {
+
+// Return true if the elements of an ArrayKey are contiguous in a record.  They are not when the record
+// is columnar and the elements are separate scalar fields, as each field then has a column of its own.
+template <typename T>
+bool isContiguous(BaseRecord const &record, ArrayKey<T> const &key) {
+    return key.getSize() <= 1 ||
+           record.getElement(key[key.getSize() - 1]) - record.getElement(key[0]) == key.getSize() - 1;
+}
+
+template <typename T>
+void checkContiguous(BaseRecord const &record, ArrayKey<T> const &key) {
+    if (!isContiguous(record, key)) {
+        throw LSST_EXCEPT(pex::exceptions::LogicError,
+                          "Cannot make a reference to an ArrayKey whose elements are separate fields of a "
+                          "columnar record; use get() and set() instead");
+    }
+}
+
+}  // namespace
+
 template <typename T>
 ndarray::Array<T const, 1, 1> ArrayKey<T>::get(BaseRecord const &record) const {
+    if (!isContiguous(record, *this)) {
+        ndarray::Array<T, 1, 1> result = ndarray::allocate(_size);
+        for (int i = 0; i < _size; ++i) {
+            result[i] = *record.getElement((*this)[i]);
+        }
+        return result;
+    }
     return ndarray::external(record.getElement(_begin), ndarray::makeVector(_size), ndarray::ROW_MAJOR,
                              record.getManager());
 }
@@ -116,17 +144,28 @@ void ArrayKey<T>::set(BaseRecord &record, ndarray::Array<T const, 1, 1> const &v
     LSST_THROW_IF_NE(value.template getSize<0>(), static_cast<std::size_t>(_size),
                      pex::exceptions::LengthError,
                      "Size of input array (%d) does not match size of array field (%d)");
+    if (!isContiguous(record, *this)) {
+        for (int i = 0; i < _size; ++i) {
+            *record.getElement((*this)[i]) = value[i];
+        }
+        return;
+    }
     std::copy(value.begin(), value.end(), record.getElement(_begin));
 }
 
 template <typename T>
 ndarray::ArrayRef<T, 1, 1> ArrayKey<T>::getReference(BaseRecord &record) const {
+    checkContiguous(record, *this);
     return ndarray::external(record.getElement(_begin), ndarray::makeVector(_size), ndarray::ROW_MAJOR,
                              record.getManager());
 }
 
 template <typename T>
 ndarray::ArrayRef<T const, 1, 1> ArrayKey<T>::getConstReference(BaseRecord const &record) const {
+    if (!isContiguous(record, *this)) {
+        // A read-only view of a copy behaves like the view get() returns for such records
+        return get(record).deep();
+    }
     return ndarray::external(record.getElement(_begin), ndarray::makeVector(_size), ndarray::ROW_MAJOR,
                              record.getManager());
 }
@@ -7,6 +7,9 @@
 #include <string>
 #include <algorithm>
 #include <cctype>
+#include <limits>
+#include <type_traits>
+#include <vector>
 
 #include "boost/regex.hpp"
 #include "boost/multi_index_container.hpp"
@@ -19,6 +22,8 @@
 #include "lsst/geom.h"
 #include "lsst/afw/table/io/FitsSchemaInputMapper.h"
 #include "lsst/afw/table/aggregates.h"
+#include "lsst/afw/table/detail/Access.h"
+#include "lsst/afw/table/detail/FitsRowCopy.h"
 
 namespace lsst {
 namespace afw {
@@ -41,6 +46,47 @@ private:
     std::string const &_v;
 };
 
+// Return the number of bytes a column with the given TFORM takes up in each row, or -1 if the
+// format is not understood.
+long getColumnWidth(std::string const &tform) {
+    static boost::regex const regex("(\\d+)?([PQ])?(\\u)\\(?(\\d)*\\)?", boost::regex::perl);
+    boost::smatch m;
+    if (!boost::regex_match(tform, m, regex)) {
+        return -1;
+    }
+    long repeat = 1;
+    if (m[1].matched) {
+        repeat = std::stol(m[1].str());
+    }
+    if (m[2].matched) {  // variable-length array descriptor
+        return repeat * (m[2].str()[0] == 'P' ? 8 : 16);
+    }
+    switch (m[3].str()[0]) {
+        case 'L':
+        case 'B':
+        case 'A':
+            return repeat;
+        case 'X':
+            return (repeat + 7) / 8;
+        case 'I':
+            return repeat * 2;
+        case 'J':
+        case 'E':
+            return repeat * 4;
+        case 'K':
+        case 'D':
+        case 'C':
+            return repeat * 8;
+        case 'M':
+            return repeat * 16;
+        default:
+            return -1;
+    }
+}
+
+// Target size of the buffer of raw rows read at a time.
+std::size_t const ROW_BUFFER_BYTES = 1 << 20;
+
 }  // namespace
 
 class FitsSchemaInputMapper::Impl {
@@ -80,7 +126,21 @@ public:
     ByName &byName() { return inputs.get<2>(); }
     AsList &asList() { return inputs.get<3>(); }
 
-    Impl() : version(0), flagColumn(0), archiveHdu(-1) {}
+    Impl()
+            : version(0),
+              flagColumn(0),
+              archiveHdu(-1),
+              rowSize(0),
+              planned(false),
+              useRawRows(false),
+              swap(detail::fitsNeedsByteSwap()),
+              nRows(0),
+              maxBufferRows(0),
+              bufferBegin(0),
+              bufferEnd(0) {}
+
+    // Work out which columns can be copied directly from raw rows; called before reading the first row.
+    void planRawRows(afw::fits::Fits &fits);
 
     int version;
     std::string type;
@@ -92,6 +152,25 @@ public:
     std::unique_ptr<bool[]> flagWorkspace;
     std::shared_ptr<io::InputArchive> archive;
     InputContainer inputs;
+
+    // Layout of the FITS rows, from the TFORM keys; columnOffsets is empty if it is not known.
+    std::vector<std::size_t> columnOffsets;
+    std::vector<std::size_t> columnWidths;
+    std::size_t rowSize;
+
+    // State for reading buffered raw rows.  Fixed-size columns are copied straight into records using
+    // the copy plan; all other columns are read cell by cell by cellReaders.
+    bool planned;
+    bool useRawRows;
+    bool swap;
+    std::vector<detail::FitsRowCopy> copies;
+    std::vector<FitsColumnReader const *> cellReaders;
+    std::size_t nRows;
+    std::size_t maxBufferRows;
+    std::size_t bufferBegin;  // first row in the buffer
+    std::size_t bufferEnd;    // one past the last row in the buffer
+    std::vector<std::uint8_t> buffer;
+    std::vector<char> scratch;  // row-major copy of a columnar record
 };
 
 FitsSchemaInputMapper::FitsSchemaInputMapper(daf::base::PropertyList &metadata, bool stripMetadata)
@@ -259,6 +338,27 @@ FitsSchemaInputMapper::FitsSchemaInputMapper(daf::base::PropertyList &metadata,
         }
     }
 
+    // Work out where each column lies in a row, so fixed-size columns can be read without cfitsio's
+    // per-cell conversions.  This must happen before any columns (e.g. the flag column) are erased.
+    std::size_t offset = 0;
+    int nextColumn = 0;
+    for (auto const &item : _impl->byColumn()) {
+        if (item.column < 0) {  // Flag fields have no column of their own
+            continue;
+        }
+        long width = getColumnWidth(item.tform);
+        if (item.column != nextColumn || width < 0) {
+            _impl->columnOffsets.clear();
+            _impl->columnWidths.clear();
+            break;
+        }
+        _impl->columnOffsets.push_back(offset);
+        _impl->columnWidths.push_back(width);
+        offset += width;
+        ++nextColumn;
+    }
+    _impl->rowSize = _impl->columnOffsets.empty() ? 0 : offset;
+
     // Find the column used to store flags, and setup the flag-handling data members from it.
     _impl->flagColumn = metadata.get("FLAGCOL", 0);
     if (_impl->flagColumn > 0) {
@@ -358,14 +458,62 @@ void FitsSchemaInputMapper::erase(int column) {
 
 void erase(int column);
 
+void FitsSchemaInputMapper::retain(std::vector<std::string> const &ttypes) {
+    auto isRetained = [&ttypes](std::string const &ttype) {
+        for (auto const &name : ttypes) {
+            if (ttype.compare(0, name.size(), name) == 0 &&
+                (ttype.size() == name.size() || ttype[name.size()] == '_')) {
+                return true;
+            }
+        }
+        return false;
+    };
+    for (auto iter = _impl->asList().begin(); iter != _impl->asList().end();) {
+        if (isRetained(iter->ttype)) {
+            ++iter;
+        } else {
+            iter = _impl->asList().erase(iter);
+        }
+    }
+}
+
 void FitsSchemaInputMapper::customize(std::unique_ptr<FitsColumnReader> reader) {
     _impl->readers.push_back(std::move(reader));
 }
 
 namespace {
 
+// A FitsColumnReader for a fixed-size column whose cells can instead be copied directly from the raw
+// bytes of a row, as long as the column is stored the way the copy expects.
+class RawColumnReader : public FitsColumnReader {
+public:
+    // Return the (0-indexed) column read.
+    virtual int getColumn() const = 0;
+
+    // Set copy to the copy plan entry for the column and return true, or return false if the column's
+    // width in bytes or TZERO offset isn't what a raw copy expects.
+    virtual bool makeRawCopy(std::size_t rowOffset, std::size_t width, double zero,
+                             detail::FitsRowCopy &copy) const = 0;
+
+protected:
+    template <typename Element>
+    static bool makeRawCopyImpl(int recordOffset, int nElements, std::size_t rowOffset, std::size_t width,
+                                double zero, detail::FitsRowCopy &copy) {
+        double expectedZero = 0.0;
+        if (detail::FitsRawFormat<Element>::flipSign) {
+            expectedZero = std::is_signed<Element>::value ? std::numeric_limits<Element>::min()
+                                                          : std::ldexp(1.0, 8 * sizeof(Element) - 1);
+        }
+        if (width != nElements * sizeof(Element) || zero != expectedZero) {
+            return false;
+        }
+        copy = detail::FitsRowCopy::make<Element>(recordOffset, rowOffset, nElements);
+        return true;
+    }
+};
+
 template <typename T>
-class StandardReader : public FitsColumnReader {
+class StandardReader : public RawColumnReader {
 public:
     static std::unique_ptr<FitsColumnReader> make(Schema &schema, FitsSchemaItem const &item,
                                                   FieldBase<T> const &base = FieldBase<T>()) {
@@ -380,12 +528,20 @@ public:
         fits.readTableArray(row, _column, _key.getElementCount(), record.getElement(_key));
     }
 
+    int getColumn() const override { return _column; }
+
+    bool makeRawCopy(std::size_t rowOffset, std::size_t width, double zero,
+                     detail::FitsRowCopy &copy) const override {
+        return makeRawCopyImpl<typename Field<T>::Element>(_key.getOffset(), _key.getElementCount(),
+                                                           rowOffset, width, zero, copy);
+    }
+
 private:
     int _column;
     Key<T> _key;
 };
 
-class AngleReader : public FitsColumnReader {
+class AngleReader : public RawColumnReader {
 public:
     static std::unique_ptr<FitsColumnReader> make(
             Schema &schema, FitsSchemaItem const &item,
@@ -412,6 +568,14 @@ public:
         record.set(_key, tmp * lsst::geom::radians);
     }
 
+    int getColumn() const override { return _column; }
+
+    // Angles are stored as radians, which is also their in-memory representation
+    bool makeRawCopy(std::size_t rowOffset, std::size_t width, double zero,
+                     detail::FitsRowCopy &copy) const override {
+        return makeRawCopyImpl<double>(_key.getOffset(), 1, rowOffset, width, zero, copy);
+    }
+
 private:
     int _column;
     Key<lsst::geom::Angle> _key;
@@ -823,13 +987,105 @@ Schema FitsSchemaInputMapper::finalize() {
         }
     }
     _impl->asList().clear();
+    if (std::none_of(_impl->flagKeys.begin(), _impl->flagKeys.end(),
+                     [](Key<Flag> const &key) { return key.isValid(); })) {
+        _impl->flagKeys.clear();  // don't bother reading the flag column if all flags were erased
+    }
     return _impl->schema;
 }
 
+namespace {
+
+// Return the value of a column's TZEROn or TSCALn key, or defaultValue if there is none.
+double readColumnScaling(afw::fits::Fits &fits, std::string const &key, int column, double defaultValue) {
+    double value = defaultValue;
+    try {
+        fits.readKey(key + std::to_string(column + 1), value);
+    } catch (afw::fits::FitsError &) {
+        value = defaultValue;
+    }
+    if (fits.status != 0) {
+        fits.status = 0;
+        value = defaultValue;
+    }
+    return value;
+}
+
+}  // namespace
+
+void FitsSchemaInputMapper::Impl::planRawRows(afw::fits::Fits &fits) {
+    planned = true;
+    useRawRows = false;
+    copies.clear();
+    cellReaders.clear();
+    if (rowSize > 0) {
+        long naxis1 = 0;
+        fits.readKey("NAXIS1", naxis1);
+        useRawRows = (static_cast<std::size_t>(naxis1) == rowSize);
+    }
+    for (auto const &reader : readers) {
+        auto raw = useRawRows ? dynamic_cast<RawColumnReader const *>(reader.get()) : nullptr;
+        detail::FitsRowCopy copy;
+        if (raw && static_cast<std::size_t>(raw->getColumn()) < columnOffsets.size() &&
+            readColumnScaling(fits, "TSCAL", raw->getColumn(), 1.0) == 1.0 &&
+            raw->makeRawCopy(columnOffsets[raw->getColumn()], columnWidths[raw->getColumn()],
+                             readColumnScaling(fits, "TZERO", raw->getColumn(), 0.0), copy)) {
+            detail::appendFitsRowCopy(copies, copy);
+        } else {
+            cellReaders.push_back(reader.get());
+        }
+    }
+    if (useRawRows) {
+        nRows = fits.countRows();
+        maxBufferRows = std::max<std::size_t>(1, ROW_BUFFER_BYTES / rowSize);
+        buffer.resize(std::min(maxBufferRows, nRows) * rowSize);
+        bufferBegin = bufferEnd = 0;
+    }
+}
+
 void FitsSchemaInputMapper::readRecord(BaseRecord &record, afw::fits::Fits &fits, std::size_t row) {
+    if (!_impl->planned) {
+        _impl->planRawRows(fits);
+    }
+    if (_impl->useRawRows && row < _impl->nRows) {
+        // Read a block of rows whenever we move outside the one we have
+        if (row < _impl->bufferBegin || row >= _impl->bufferEnd) {
+            std::size_t n = std::min(_impl->maxBufferRows, _impl->nRows - row);
+            fits.readTableBytes(row, n * _impl->rowSize, _impl->buffer.data());
+            _impl->bufferBegin = row;
+            _impl->bufferEnd = row + n;
+        }
+        std::uint8_t const *raw = _impl->buffer.data() + (row - _impl->bufferBegin) * _impl->rowSize;
+        bool const columnar = detail::Access::isColumnar(record);
+        char *data = detail::Access::getData(record);
+        if (columnar) {
+            // Columnar records are filled through a row-major copy laid out as the copy plan expects.
+            _impl->scratch.resize(record.getSchema().getRecordSize());
+            detail::Access::gatherData(record, _impl->scratch.data());
+            data = _impl->scratch.data();
+        }
+        for (auto const &op : _impl->copies) {
+            detail::copyFromFitsRow(op, raw, data, _impl->swap);
+        }
+        if (columnar) {
+            detail::Access::scatterData(_impl->scratch.data(), record);
+        }
+        if (!_impl->flagKeys.empty()) {
+            std::uint8_t const *bits = raw + _impl->columnOffsets[_impl->flagColumn];
+            for (std::size_t bit = 0; bit < _impl->flagKeys.size(); ++bit) {
+                if (!_impl->flagKeys[bit].isValid()) continue;  // flag was erased from the mapping
+                record.set(_impl->flagKeys[bit], (bits[bit >> 3] & (0x80 >> (bit & 7))) != 0);
+            }
+        }
+        for (auto reader : _impl->cellReaders) {
+            reader->readCell(record, row, fits, _impl->archive);
+        }
+        return;
+    }
     if (!_impl->flagKeys.empty()) {
         fits.readTableArray<bool>(row, _impl->flagColumn, _impl->flagKeys.size(), _impl->flagWorkspace.get());
         for (std::size_t bit = 0; bit < _impl->flagKeys.size(); ++bit) {
+            if (!_impl->flagKeys[bit].isValid()) continue;
             record.set(_impl->flagKeys[bit], _impl->flagWorkspace[bit]);
         }
     }
@@ -1,10 +1,16 @@
 // -*- lsst-c++ -*-
 
+#include <algorithm>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <vector>
 
 #include "lsst/afw/table/io/FitsWriter.h"
 #include "lsst/afw/table/BaseTable.h"
 #include "lsst/afw/table/BaseRecord.h"
+#include "lsst/afw/table/detail/Access.h"
+#include "lsst/afw/table/detail/FitsRowCopy.h"
 
 namespace lsst {
 namespace afw {
@@ -122,21 +128,91 @@ void FitsWriter::_writeTable(std::shared_ptr<BaseTable const> const& table, std:
     metadata->remove("AFW_TABLE_VERSION");
     _row = -1;
     _fits->addRows(nRows);
-    _processor = std::make_shared<ProcessRecords>(_fits, schema, nFlags, _row);
+    _processor = std::make_shared<ProcessRecords>(_fits, schema, nFlags, _row, nRows);
 }
 
 //----- Code for writing FITS records -----------------------------------------------------------------------
 
+// Records are normally copied directly into a buffer of FITS rows, which is written many rows at a
+// time; only strings and variable-length arrays are written cell by cell, after the block of rows they
+// belong to.  The code in this anonymous namespace computes where each field goes in the FITS row.
+
+namespace {
+
+// The location of a Flag field in a record.
+struct FlagBit {
+    std::size_t offset;
+    int bit;
+};
+
+// A Schema::forEach functor that computes the FITS row layout of the fields, in column order.
+struct ProcessLayout {
+    template <typename T>
+    void operator()(SchemaItem<T> const& item) {
+        addCopy<typename Field<T>::Element>(item.key.getOffset(), item.key.getElementCount());
+    }
+
+    template <typename T>
+    void operator()(SchemaItem<Array<T> > const& item) {
+        if (item.key.isVariableLength()) {
+            defer(DESCRIPTOR_SIZE);
+        } else {
+            addCopy<T>(item.key.getOffset(), item.key.getElementCount());
+        }
+    }
+
+    void operator()(SchemaItem<std::string> const& item) {
+        defer(item.key.isVariableLength() ? DESCRIPTOR_SIZE : item.key.getElementCount());
+    }
+
+    void operator()(SchemaItem<Flag> const& item) {
+        flagBits.push_back(FlagBit{static_cast<std::size_t>(item.key.getOffset()), item.key.getBit()});
+    }
+
+    template <typename T>
+    void addCopy(std::size_t recordOffset, std::size_t nElements) {
+        detail::appendFitsRowCopy(copies, detail::FitsRowCopy::make<T>(recordOffset, rowSize, nElements));
+        rowSize += nElements * sizeof(T);
+    }
+
+    void defer(std::size_t nBytes) {
+        rowSize += nBytes;
+        hasDeferred = true;
+    }
+
+    // Size of a 'Q' variable-length array descriptor: two 64-bit integers
+    static constexpr std::size_t DESCRIPTOR_SIZE = 16;
+
+    std::vector<detail::FitsRowCopy> copies;
+    std::vector<FlagBit> flagBits;
+    std::size_t rowSize;
+    bool hasDeferred;
+};
+
+constexpr std::size_t ProcessLayout::DESCRIPTOR_SIZE;
+
+// Target size of the row buffer; rows are written to the file whenever it fills up.
+std::size_t const ROW_BUFFER_BYTES = 1 << 20;
+
+}  // namespace
+
 // The driver code is at the bottom of this section; it's easier to understand if you start there
 // and work your way up.
 
 // A Schema::forEach functor that writes table data for a single record when it is called.
 // We instantiate one of these, then reuse it on all the records after updating the data
 // members that tell it which record and row number it's on.
+//
+// When the row layout is known (the usual case), the fixed-size fields are instead copied into
+// the row buffer, and the functor only saves the strings and variable-length arrays, which are
+// written cell by cell once the buffered rows have been written (writing the rows would otherwise
+// overwrite them).
 struct FitsWriter::ProcessRecords {
     template <typename T>
     void operator()(SchemaItem<T> const& item) const {
-        fits->writeTableArray(row, col, item.key.getElementCount(), record->getElement(item.key));
+        if (!bulk) {
+            fits->writeTableArray(row, col, item.key.getElementCount(), record->getElement(item.key));
+        }
         ++col;
     }
 
@@ -144,8 +220,14 @@ struct FitsWriter::ProcessRecords {
     void operator()(SchemaItem<Array<T> > const& item) const {
         if (item.key.isVariableLength()) {
             ndarray::Array<T const, 1, 1> array = record->get(item.key);
-            fits->writeTableArray(row, col, array.template getSize<0>(), array.getData());
-        } else {
+            if (bulk) {
+                deferred.emplace_back([f = fits, r = row, c = col, array]() {
+                    f->writeTableArray(r, c, array.template getSize<0>(), array.getData());
+                });
+            } else {
+                fits->writeTableArray(row, col, array.template getSize<0>(), array.getData());
+            }
+        } else if (!bulk) {
             fits->writeTableArray(row, col, item.key.getElementCount(), record->getElement(item.key));
         }
         ++col;
@@ -153,18 +235,47 @@ struct FitsWriter::ProcessRecords {
 
     void operator()(SchemaItem<std::string> const& item) const {
         // Write fixed-length and variable-length strings the same way
-        fits->writeTableScalar(row, col, record->get(item.key));
+        if (bulk) {
+            deferred.emplace_back([f = fits, r = row, c = col, value = record->get(item.key)]() {
+                f->writeTableScalar(r, c, value);
+            });
+        } else {
+            fits->writeTableScalar(row, col, record->get(item.key));
+        }
         ++col;
     }
 
     void operator()(SchemaItem<Flag> const& item) const {
-        flags[bit] = record->get(item.key);
-        ++bit;
+        if (!bulk) {
+            flags[bit] = record->get(item.key);
+            ++bit;
+        }
     }
 
-    ProcessRecords(Fits* fits_, Schema const& schema_, int nFlags_, std::size_t const& row_)
-            : row(row_), col(0), bit(0), nFlags(nFlags_), fits(fits_), schema(schema_) {
+    ProcessRecords(Fits* fits_, Schema const& schema_, int nFlags_, std::size_t const& row_,
+                   std::size_t nRows_)
+            : row(row_),
+              col(0),
+              bit(0),
+              nFlags(nFlags_),
+              fits(fits_),
+              schema(schema_),
+              bulk(false),
+              swap(detail::fitsNeedsByteSwap()),
+              nRows(nRows_),
+              nBuffered(0) {
         if (nFlags) flags.reset(new bool[nFlags]);
+        layout.rowSize = (nFlags + 7) / 8;
+        layout.hasDeferred = false;
+        schema.forEach(layout);
+        // Only use the row buffer if our layout agrees with cfitsio's
+        long naxis1 = 0;
+        fits->readKey("NAXIS1", naxis1);
+        if (layout.rowSize > 0 && static_cast<std::size_t>(naxis1) == layout.rowSize) {
+            bulk = true;
+            maxBuffered = std::max<std::size_t>(1, ROW_BUFFER_BYTES / layout.rowSize);
+            buffer.assign(std::min(maxBuffered, nRows) * layout.rowSize, 0);
+        }
     }
 
     void apply(BaseRecord const* r) {
@@ -172,8 +283,46 @@ struct FitsWriter::ProcessRecords {
         col = 0;
         bit = 0;
         if (nFlags) ++col;
-        schema.forEach(*this);
-        if (nFlags) fits->writeTableArray(row, 0, nFlags, flags.get());
+        if (!bulk) {
+            schema.forEach(*this);
+            if (nFlags) fits->writeTableArray(row, 0, nFlags, flags.get());
+            return;
+        }
+        packRow(buffer.data() + nBuffered * layout.rowSize);
+        ++nBuffered;
+        if (layout.hasDeferred) schema.forEach(*this);
+        if (nBuffered == maxBuffered || row + 1 == nRows) {
+            fits->writeTableBytes(row + 1 - nBuffered, nBuffered * layout.rowSize, buffer.data());
+            nBuffered = 0;
+            for (auto const& write : deferred) {
+                write();
+            }
+            deferred.clear();
+        }
+    }
+
+    // Copy the fixed-size fields and flags of the current record into a FITS row.
+    void packRow(std::uint8_t* out) {
+        char const* data = detail::Access::getData(*record);
+        if (detail::Access::isColumnar(*record)) {
+            // Columnar records are first gathered into the row-major layout the copy plan expects.
+            scratch.resize(schema.getRecordSize());
+            detail::Access::gatherData(*record, scratch.data());
+            data = scratch.data();
+        }
+        for (auto const& op : layout.copies) {
+            detail::copyToFitsRow(op, data, out, swap);
+        }
+        if (nFlags) {
+            std::fill(out, out + (nFlags + 7) / 8, 0);
+            for (std::size_t i = 0; i < layout.flagBits.size(); ++i) {
+                auto element =
+                        *reinterpret_cast<Field<Flag>::Element const*>(data + layout.flagBits[i].offset);
+                if (element & (Field<Flag>::Element(1) << layout.flagBits[i].bit)) {
+                    out[i >> 3] |= 0x80 >> (i & 7);
+                }
+            }
+        }
     }
 
     std::size_t const& row;
@@ -184,6 +333,15 @@ struct FitsWriter::ProcessRecords {
     std::unique_ptr<bool[]> flags;
     BaseRecord const* record;
     Schema schema;
+    ProcessLayout layout;
+    bool bulk;                         // use the row buffer rather than writing cell by cell
+    bool swap;                         // byte-swap elements into big-endian order
+    std::size_t nRows;                 // total number of rows in the table
+    std::size_t maxBuffered;           // number of rows that fit in the buffer
+    std::size_t nBuffered;             // number of rows currently in the buffer
+    std::vector<std::uint8_t> buffer;  // FITS rows not yet written
+    std::vector<char> scratch;         // row-major copy of a columnar record
+    mutable std::vector<std::function<void()>> deferred;  // cell writes for the buffered rows
 };
 
 void FitsWriter::_writeRecord(BaseRecord const& record) {
@@ -1,5 +1,8 @@
 // -*- lsst-c++ -*-
 
+#include <algorithm>
+#include <vector>
+
 #include "boost/format.hpp"
 
 #include "lsst/pex/exceptions.h"
@@ -31,6 +34,24 @@ struct IndexSortCompare {
     }
 };
 
+// Read the archive data catalog at the current HDU, checking that it is catalog n (1-indexed).
+BaseCatalog readDataCatalog(fits::Fits& fitsfile, int n) {
+    BaseCatalog catalog = BaseCatalog::readFits(fitsfile);
+    std::shared_ptr<daf::base::PropertyList> metadata = catalog.getTable()->popMetadata();
+    if (metadata->get<std::string>("EXTTYPE") != "ARCHIVE_DATA") {
+        throw LSST_FITS_EXCEPT(fits::FitsError, fitsfile,
+                               boost::format("Wrong value for archive data EXTTYPE: '%s'") %
+                                       metadata->get<std::string>("EXTTYPE"));
+    }
+    if (metadata->get<int>("AR_CATN") != n) {
+        throw LSST_FITS_EXCEPT(
+                fits::FitsError, fitsfile,
+                boost::format("Incorrect order for archive catalogs: AR_CATN=%d found at position %d") %
+                        metadata->get<int>("AR_CATN") % n);
+    }
+    return catalog;
+}
+
 }  // namespace
 
 // ----- InputArchive::Impl ---------------------------------------------------------------------------------
@@ -82,7 +103,7 @@ public:
                              indexIter->get(indexKeys.id) % catN % _catalogs.size())
                                     .str());
                 }
-                BaseCatalog& fullCatalog = _catalogs[catN];
+                BaseCatalog& fullCatalog = _getCatalog(catN);
                 std::size_t i1 = indexIter->get(indexKeys.row0);
                 std::size_t i2 = i1 + indexIter->get(indexKeys.nRows);
                 if (i2 > fullCatalog.size()) {
@@ -144,6 +165,25 @@ public:
         _index.sort(IndexSortCompare());
     }
 
+    // Construct an archive whose data catalogs are read from the given file only when needed.
+    Impl(BaseCatalog const& index, fits::Fits& fitsfile, int nCatalogs)
+            : Impl(index, CatalogVector()) {
+        _catalogs.assign(nCatalogs, BaseCatalog(indexKeys.schema));  // placeholders
+        _fits = &fitsfile;
+        _indexHdu = fitsfile.getHdu();
+        _unread.assign(nCatalogs, true);
+    }
+
+    // Return the data catalog with the given (0-indexed) number, reading it first if necessary.
+    BaseCatalog& _getCatalog(std::size_t catN) {
+        if (catN < _unread.size() && _unread[catN]) {
+            fits::HduMoveGuard guard(*_fits, _indexHdu + static_cast<int>(catN) + 1);
+            _catalogs[catN] = readDataCatalog(*_fits, catN + 1);
+            _unread[catN] = false;
+        }
+        return _catalogs[catN];
+    }
+
     // No copying
     Impl(const Impl&) = delete;
     Impl& operator=(const Impl&) = delete;
@@ -155,6 +195,12 @@ public:
     Map _map;
     BaseCatalog _index;
     CatalogVector _catalogs;
+
+    // State for lazy archives: the file, the HDU of the index (data catalog n is n HDUs after it),
+    // and which data catalogs are still placeholders.  _unread is empty for archives read up front.
+    fits::Fits* _fits = nullptr;
+    int _indexHdu = 0;
+    std::vector<bool> _unread;
 };
 
 // ----- InputArchive ---------------------------------------------------------------------------------------
@@ -183,7 +229,14 @@ std::shared_ptr<Persistable> InputArchive::get(int id) const { return _impl->get
 
 InputArchive::Map const& InputArchive::getAll() const { return _impl->getAll(*this); }
 
-InputArchive InputArchive::readFits(fits::Fits& fitsfile) {
+CatalogVector const& InputArchive::getDataCatalogs() const {
+    for (std::size_t catN = 0; catN < _impl->_unread.size(); ++catN) {
+        _impl->_getCatalog(catN);
+    }
+    return _impl->_catalogs;
+}
+
+InputArchive InputArchive::readFits(fits::Fits& fitsfile, bool lazy) {
     BaseCatalog index = BaseCatalog::readFits(fitsfile);
     std::shared_ptr<daf::base::PropertyList> metadata = index.getTable()->popMetadata();
     assert(metadata);  // BaseCatalog::readFits should always read metadata, even if there's nothing there
@@ -193,23 +246,15 @@ InputArchive InputArchive::readFits(fits::Fits& fitsfile) {
                                        metadata->get<std::string>("EXTTYPE"));
     }
     int nCatalogs = metadata->get<int>("AR_NCAT");
+    if (lazy) {
+        // AR_NCAT counts the index, too.
+        return InputArchive(std::make_shared<Impl>(index, fitsfile, std::max(nCatalogs - 1, 0)));
+    }
     CatalogVector catalogs;
     catalogs.reserve(nCatalogs);
     for (int n = 1; n < nCatalogs; ++n) {
         fitsfile.setHdu(1, true);  // increment HDU by one
-        catalogs.push_back(BaseCatalog::readFits(fitsfile));
-        metadata = catalogs.back().getTable()->popMetadata();
-        if (metadata->get<std::string>("EXTTYPE") != "ARCHIVE_DATA") {
-            throw LSST_FITS_EXCEPT(fits::FitsError, fitsfile,
-                                   boost::format("Wrong value for archive data EXTTYPE: '%s'") %
-                                           metadata->get<std::string>("EXTTYPE"));
-        }
-        if (metadata->get<int>("AR_CATN") != n) {
-            throw LSST_FITS_EXCEPT(
-                    fits::FitsError, fitsfile,
-                    boost::format("Incorrect order for archive catalogs: AR_CATN=%d found at position %d") %
-                            metadata->get<int>("AR_CATN") % n);
-        }
+        catalogs.push_back(readDataCatalog(fitsfile, n));
     }
     std::shared_ptr<Impl> impl(new Impl(index, catalogs));
     return InputArchive(impl);
@@ -1,9 +1,13 @@
 // -*- lsst-c++ -*-
 
+#include <type_traits>
+#include <functional>
 #include <typeinfo>
 #include <vector>
 #include <map>
 #include <memory>
+#include <string>
+#include <unordered_map>
 
 #include "boost/format.hpp"
 
@@ -30,6 +34,40 @@ using Map = std::map<std::weak_ptr<Persistable const>, int,
 
 typedef Map::value_type MapItem;
 
+// A Schema functor that appends a canonical byte representation of a record's field values to a
+// string, so records can be compared and hashed by value (variable-length arrays and strings by
+// their contents, not their addresses).
+struct ContentWriter {
+    template <typename T>
+    void operator()(SchemaItem<T> const &item) const {
+        append(record->get(item.key));
+    }
+
+    template <typename T>
+    void append(T const &value) const {
+        static_assert(std::is_arithmetic<T>::value, "unexpected field type in archive catalog");
+        out->append(reinterpret_cast<char const *>(&value), sizeof(T));
+    }
+
+    void append(lsst::geom::Angle const &value) const { append(value.asRadians()); }
+
+    void append(std::string const &value) const {
+        append(value.size());
+        out->append(value);
+    }
+
+    template <typename T>
+    void append(ndarray::Array<T, 1, 1> const &value) const {
+        append(value.template getSize<0>());
+        for (auto const &element : value) {
+            append(element);
+        }
+    }
+
+    BaseRecord const *record;
+    std::string *out;
+};
+
 }  // namespace
 
 // ----- OutputArchive::Impl --------------------------------------------------------------------------------
@@ -109,8 +147,12 @@ public:
         if (permissive && !obj->isPersistable()) return 0;
         int const currentId = _nextId;
         ++_nextId;
+        Checkpoint const start = _makeCheckpoint();
         OutputArchiveHandle handle(currentId, obj->getPersistenceName(), obj->getPythonModule(), self);
         obj->write(handle);
+        if (_deduplicateContent) {
+            return _deduplicate(currentId, start);
+        }
         return currentId;
     }
 
@@ -120,8 +162,9 @@ public:
         MapItem item(obj, _nextId);
         std::pair<Map::iterator, bool> r = _map.insert(item);
         if (r.second) {
-            // We've never seen this object before.  Save it.
-            return put(obj.get(), self, permissive);
+            // We've never seen this object before.  Save it (which may give it the ID of an object
+            // with the same content instead of the one we guessed).
+            return r.first->second = put(obj.get(), self, permissive);
         } else {
             // We had already saved this object, and insert returned an iterator
             // to the ID we used before; return that.
@@ -146,10 +189,93 @@ public:
         _index.getTable()->setMetadata(metadata);
     }
 
+    // The sizes of the index and data catalogs at some point, so what was saved after it can be
+    // identified and removed.
+    struct Checkpoint {
+        std::size_t indexSize;
+        std::vector<std::size_t> catalogSizes;
+    };
+
+    // Where the index records of a saved object are, for comparing the content of later objects.
+    struct SavedContent {
+        int id;
+        std::size_t indexBegin;
+        std::size_t indexEnd;
+    };
+
+    Checkpoint _makeCheckpoint() const {
+        Checkpoint checkpoint;
+        checkpoint.indexSize = _index.size();
+        for (auto const &catalog : _catalogs) {
+            checkpoint.catalogSizes.push_back(catalog.size());
+        }
+        return checkpoint;
+    }
+
+    // Remove everything saved after the given checkpoint, including any new catalogs.
+    void _rollback(Checkpoint const &checkpoint) {
+        _index.erase(_index.begin() + checkpoint.indexSize, _index.end());
+        _catalogs.erase(_catalogs.begin() + checkpoint.catalogSizes.size(), _catalogs.end());
+        for (std::size_t i = 0; i < _catalogs.size(); ++i) {
+            _catalogs[i].erase(_catalogs[i].begin() + checkpoint.catalogSizes[i], _catalogs[i].end());
+        }
+    }
+
+    // Return the canonical byte representation of the index records in [begin, end) and the
+    // data catalog rows they refer to; two objects are the same if these are equal.
+    std::string _getContent(std::size_t begin, std::size_t end) const {
+        std::string content;
+        ContentWriter writer = {nullptr, &content};
+        for (std::size_t i = begin; i < end; ++i) {
+            BaseRecord const &indexRecord = _index[i];
+            writer.append(indexRecord.get(indexKeys.name));
+            writer.append(indexRecord.get(indexKeys.module));
+            writer.append(indexRecord.get(indexKeys.catPersistable));
+            int const catArchive = indexRecord.get(indexKeys.catArchive);
+            writer.append(catArchive);
+            if (catArchive == ArchiveIndexSchema::NO_CATALOGS_SAVED) continue;
+            BaseCatalog const &catalog = _catalogs[catArchive - 1];
+            std::size_t const row0 = indexRecord.get(indexKeys.row0);
+            std::size_t const nRows = indexRecord.get(indexKeys.nRows);
+            writer.append(nRows);
+            for (std::size_t row = row0; row < row0 + nRows; ++row) {
+                writer.record = &catalog[row];
+                catalog.getSchema().forEach(writer);
+            }
+        }
+        return content;
+    }
+
+    // Called after the object with the given ID has been saved: if an object with the same content
+    // was saved earlier, remove the new one and return the earlier ID.
+    int _deduplicate(int id, Checkpoint const &start) {
+        std::size_t const end = _index.size();
+        if (end == start.indexSize) return id;  // object didn't save anything (shouldn't happen)
+        for (std::size_t i = start.indexSize; i < end; ++i) {
+            // If a nested object was saved too, our content refers to its ID, which is new, so
+            // nothing can match; and it couldn't be removed with ours anyway.
+            if (_index[i].get(indexKeys.id) != id) return id;
+        }
+        std::string const content = _getContent(start.indexSize, end);
+        std::size_t const hash = std::hash<std::string>()(content);
+        auto range = _contents.equal_range(hash);
+        for (auto iter = range.first; iter != range.second; ++iter) {
+            if (_getContent(iter->second.indexBegin, iter->second.indexEnd) == content) {
+                _rollback(start);
+                _nextId = id;  // nothing saved since start remains, so its IDs can be reused
+                return iter->second.id;
+            }
+        }
+        _contents.emplace(hash, SavedContent{id, start.indexSize, end});
+        return id;
+    }
+
     int _nextId;
     Map _map;
     BaseCatalog _index;
     CatalogVector _catalogs;
+    bool _deduplicateContent = false;
+    std::unordered_multimap<std::size_t, SavedContent> _contents;  // keyed by hash of content
 };
 
 // ----- OutputArchive --------------------------------------------------------------------------------------
@@ -185,6 +311,16 @@ int OutputArchive::put(std::shared_ptr<Persistable const> obj, bool permissive)
     return _impl->put(std::move(obj), _impl, permissive);
 }
 
+void OutputArchive::setContentDeduplication(bool deduplicate) {
+    if (!_impl.unique()) {  // copy on write
+        std::shared_ptr<Impl> tmp(new Impl(*_impl));
+        _impl.swap(tmp);
+    }
+    _impl->_deduplicateContent = deduplicate;
+}
+
+bool OutputArchive::getContentDeduplication() const { return _impl->_deduplicateContent; }
+
 BaseCatalog const &OutputArchive::getIndexCatalog() const { return _impl->_index; }
 
 BaseCatalog const &OutputArchive::getCatalog(int n) const {
@@ -0,0 +1,152 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE table - catalog index
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-variable"
+#include "boost/test/unit_test.hpp"
+#pragma clang diagnostic pop
+
+#include <string>
+#include <tuple>
+
+#include "lsst/afw/table/CatalogIndex.h"
+#include "lsst/afw/table/Source.h"
+
+namespace table = lsst::afw::table;
+
+namespace {
+
+table::SourceCatalog makeCatalog(table::Key<int>& visitKey, int n) {
+    table::Schema schema = table::SourceTable::makeMinimalSchema();
+    visitKey = schema.addField<int>("visit", "visit number");
+    table::SourceCatalog catalog(schema);
+    for (int i = 0; i < n; ++i) {
+        auto record = catalog.addNew();
+        record->setParent(i < 10 ? 0 : catalog[i % 10].getId());
+        record->set(visitKey, i % 7);
+    }
+    return catalog;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(testHashIndex) {
+    table::Key<int> visitKey;
+    auto catalog = makeCatalog(visitKey, 1000);
+    table::HashIndex<table::SourceRecord, table::RecordId> byParent(table::SourceTable::getParentKey());
+    byParent.extend(catalog, 4);
+    BOOST_CHECK_EQUAL(byParent.size(), catalog.size());
+    BOOST_CHECK_EQUAL(byParent.count(catalog[3].getId()), 99u);
+    for (auto const& child : byParent.findAll(catalog[3].getId())) {
+        BOOST_CHECK_EQUAL(child->getParent(), catalog[3].getId());
+    }
+    BOOST_CHECK(!byParent.find(-1));
+
+    // Composite keys, and mirroring catalog changes.
+    table::HashIndex<table::SourceRecord, table::RecordId, int> byParentVisit(
+            table::SourceTable::getParentKey(), visitKey);
+    byParentVisit.extend(catalog);
+    auto const value = std::make_tuple(catalog[3].getId(), 6);
+    std::size_t const count = byParentVisit.count(value);
+    BOOST_CHECK(count > 0);
+    auto record = catalog.addNew();
+    record->setParent(catalog[3].getId());
+    record->set(visitKey, 6);
+    byParentVisit.insert(record);
+    BOOST_CHECK_EQUAL(byParentVisit.count(value), count + 1);
+    BOOST_CHECK(byParentVisit.erase(*record));
+    BOOST_CHECK(!byParentVisit.erase(*record));
+    BOOST_CHECK_EQUAL(byParentVisit.count(value), count);
+}
+
+BOOST_AUTO_TEST_CASE(testSortedIndex) {
+    table::Key<int> visitKey;
+    auto catalog = makeCatalog(visitKey, 1000);
+    table::SortedIndex<table::SourceRecord, int> byVisit(visitKey);
+    byVisit.extend(catalog, 0);
+    BOOST_REQUIRE_EQUAL(byVisit.size(), catalog.size());
+
+    // Entries are in order, with ties in catalog order, and the catalog itself is unchanged.
+    for (auto i = byVisit.begin(), j = byVisit.begin() + 1; j != byVisit.end(); ++i, ++j) {
+        BOOST_CHECK(i->first < j->first ||
+                    (i->first == j->first && i->second->getId() < j->second->getId()));
+    }
+    BOOST_CHECK(catalog.isSorted());
+
+    auto range = byVisit.findRange(2, 4);
+    std::size_t expected = 0;
+    for (auto const& record : catalog) {
+        if (record.get(visitKey) >= 2 && record.get(visitKey) < 4) ++expected;
+    }
+    BOOST_CHECK_EQUAL(range.size(), expected);
+    for (auto const& record : range) {
+        BOOST_CHECK(record->get(visitKey) >= 2 && record->get(visitKey) < 4);
+    }
+    BOOST_CHECK_EQUAL(byVisit.find(5)->get(visitKey), 5);
+    BOOST_CHECK(!byVisit.find(7));
+
+    BOOST_CHECK(byVisit.erase(catalog[5]));
+    BOOST_CHECK_EQUAL(byVisit.size(), catalog.size() - 1);
+}
+
+BOOST_AUTO_TEST_CASE(testParallelBuild) {
+    // Large enough for the index to be built in several chunks, on several threads.
+    int const n = 100000;
+    BOOST_REQUIRE(table::detail::getChunkCount(n, 4) > 1);
+    table::Key<int> visitKey;
+    auto catalog = makeCatalog(visitKey, n);
+
+    table::SortedIndex<table::SourceRecord, int> serialByVisit(visitKey);
+    serialByVisit.extend(catalog, 1);
+    table::SortedIndex<table::SourceRecord, int> parallelByVisit(visitKey);
+    parallelByVisit.extend(catalog, 4);
+    BOOST_REQUIRE_EQUAL(parallelByVisit.size(), catalog.size());
+    for (auto i = serialByVisit.begin(), j = parallelByVisit.begin(); i != serialByVisit.end(); ++i, ++j) {
+        BOOST_REQUIRE_EQUAL(i->first, j->first);
+        BOOST_REQUIRE_EQUAL(i->second, j->second);
+    }
+
+    table::HashIndex<table::SourceRecord, table::RecordId> byParent(table::SourceTable::getParentKey());
+    byParent.extend(catalog, 4);
+    BOOST_CHECK_EQUAL(byParent.size(), catalog.size());
+    BOOST_CHECK_EQUAL(byParent.count(catalog[3].getId()), static_cast<std::size_t>((n - 10) / 10));
+    for (auto const& child : byParent.findAll(catalog[3].getId())) {
+        BOOST_CHECK_EQUAL(child->getParent(), catalog[3].getId());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testJoin) {
+    table::Key<int> visitKey;
+    auto catalog = makeCatalog(visitKey, 100);
+
+    // Join each record to its parent, as the nested loop over both catalogs would.
+    table::HashIndex<table::SourceRecord, table::RecordId> byId(table::SourceTable::getIdKey());
+    byId.extend(catalog);
+    auto pairs = byId.join(catalog, table::SourceTable::getParentKey());
+    BOOST_REQUIRE_EQUAL(pairs.size(), 90u);
+    for (auto const& pair : pairs) {
+        BOOST_CHECK_EQUAL(pair.first->getParent(), pair.second->getId());
+    }
+
+    // A sorted index gives the same matches, and composite keys work the same way.
+    table::SortedIndex<table::SourceRecord, int> byVisit(visitKey);
+    byVisit.extend(catalog);
+    table::HashIndex<table::SourceRecord, int> hashByVisit(visitKey);
+    hashByVisit.extend(catalog);
+    auto sortedPairs = byVisit.join(catalog, visitKey);
+    BOOST_CHECK_EQUAL(sortedPairs.size(), hashByVisit.join(catalog, visitKey).size());
+    for (auto const& pair : sortedPairs) {
+        BOOST_CHECK_EQUAL(pair.first->get(visitKey), pair.second->get(visitKey));
+    }
+    BOOST_CHECK_EQUAL(byVisit.count(3), byVisit.findAll(3).size());
+
+    table::HashIndex<table::SourceRecord, table::RecordId, int> byIdVisit(table::SourceTable::getIdKey(),
+                                                                          visitKey);
+    byIdVisit.extend(catalog);
+    BOOST_CHECK_EQUAL(byIdVisit.join(catalog, table::SourceTable::getIdKey(), visitKey).size(),
+                      catalog.size());
+
+    // Indexes are not updated when the catalog changes.
+    catalog.addNew()->setParent(catalog[0].getId());
+    BOOST_CHECK_EQUAL(byId.join(catalog, table::SourceTable::getParentKey()).size(), 91u);
+    BOOST_CHECK_EQUAL(byId.size(), 100u);
+}
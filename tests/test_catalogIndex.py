@@ -0,0 +1,116 @@
+# This file is part of afw.
+#
+# Developed for the LSST Data Management System.
+# This product includes software developed by the LSST Project
+# (https://www.lsst.org).
+# See the COPYRIGHT file at the top-level directory of this distribution
+# for details of code ownership.
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+"""
+Tests for HashIndex and SortedIndex
+
+Run with:
+   python test_catalogIndex.py
+or
+   pytest test_catalogIndex.py
+"""
+import unittest
+
+import numpy as np
+
+import lsst.utils.tests
+import lsst.afw.table as afwTable
+
+
+class CatalogIndexTestCase(lsst.utils.tests.TestCase):
+
+    def setUp(self):
+        schema = afwTable.SourceTable.makeMinimalSchema()
+        self.visitKey = schema.addField("visit", type=np.int32, doc="visit number")
+        self.fluxKey = schema.addField("flux", type=np.float64, doc="flux")
+        self.catalog = afwTable.SourceCatalog(schema)
+        for i in range(100):
+            record = self.catalog.addNew()
+            record.setId(i + 1)
+            record.setParent(0 if i < 10 else i % 10 + 1)
+            record.set(self.visitKey, i % 7)
+            record.set(self.fluxKey, 0.5*i)
+
+    def tearDown(self):
+        del self.catalog
+
+    def testHashIndex(self):
+        byId = afwTable.makeHashIndex(self.catalog, afwTable.SourceTable.getIdKey(), nThreads=2)
+        self.assertEqual(len(byId), 100)
+        self.assertEqual(byId.find(42).getId(), 42)
+        self.assertIsNone(byId.find(1000))
+        byVisit = afwTable.makeHashIndex(self.catalog, self.visitKey)
+        self.assertEqual(byVisit.count(3), 14)
+        self.assertEqual(sorted(r.getId() for r in byVisit.findAll(3)),
+                         [r.getId() for r in self.catalog if r.get(self.visitKey) == 3])
+        composite = afwTable.makeHashIndex(self.catalog, afwTable.SourceTable.getParentKey(), self.visitKey)
+        self.assertEqual(composite.count((1, 3)),
+                         sum(1 for r in self.catalog if r.getParent() == 1 and r.get(self.visitKey) == 3))
+        with self.assertRaises(TypeError):
+            afwTable.makeHashIndex(self.catalog, self.fluxKey)
+
+    def testSortedIndex(self):
+        byFlux = afwTable.makeSortedIndex(self.catalog, self.fluxKey)
+        self.assertEqual([r.get(self.fluxKey) for r in byFlux.findRange(10.0, 12.0)],
+                         [10.0, 10.5, 11.0, 11.5])
+        # Iteration yields (value, record) pairs in order of value.
+        fluxes = [value for value, record in byFlux]
+        self.assertEqual(fluxes, sorted(fluxes))
+        self.assertEqual(fluxes, [record.get(self.fluxKey) for value, record in byFlux])
+        byVisit = afwTable.makeSortedIndex(self.catalog, self.visitKey)
+        self.assertEqual(byVisit.count(3), 14)
+        self.assertEqual(byVisit.upper_bound(3) - byVisit.lower_bound(3), 14)
+
+    def testJoin(self):
+        byId = afwTable.makeHashIndex(self.catalog, afwTable.SourceTable.getIdKey())
+        pairs = byId.join(self.catalog, afwTable.SourceTable.getParentKey())
+        self.assertEqual(len(pairs), 90)
+        for child, parent in pairs:
+            self.assertEqual(child.getParent(), parent.getId())
+        sortedById = afwTable.makeSortedIndex(self.catalog, afwTable.SourceTable.getIdKey())
+        sortedPairs = sortedById.join(self.catalog, afwTable.SourceTable.getParentKey())
+        self.assertEqual([(c.getId(), p.getId()) for c, p in pairs],
+                         [(c.getId(), p.getId()) for c, p in sortedPairs])
+
+    def testNotInvalidated(self):
+        """Indexes do not follow changes to the catalog; they must be updated explicitly.
+        """
+        byId = afwTable.makeHashIndex(self.catalog, afwTable.SourceTable.getIdKey())
+        record = self.catalog.addNew()
+        record.setId(1000)
+        self.assertIsNone(byId.find(1000))
+        byId.insert(record)
+        self.assertEqual(byId.find(1000).getId(), 1000)
+        byId.erase(record)
+        self.assertIsNone(byId.find(1000))
+
+
+class TestMemory(lsst.utils.tests.MemoryTestCase):
+    pass
+
+
+def setup_module(module):
+    lsst.utils.tests.init()
+
+
+if __name__ == "__main__":
+    lsst.utils.tests.init()
+    unittest.main()
@@ -0,0 +1,61 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE table - catalog insert
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-variable"
+#include "boost/test/unit_test.hpp"
+#pragma clang diagnostic pop
+
+#include <cmath>
+#include <string>
+
+#include "lsst/afw/table/BaseRecord.h"
+#include "lsst/afw/table/BaseTable.h"
+#include "lsst/afw/table/Catalog.h"
+#include "lsst/afw/table/SchemaMapper.h"
+
+namespace table = lsst::afw::table;
+
+BOOST_AUTO_TEST_CASE(testMapperInsertThreads) {
+    table::Schema schema;
+    auto kI = schema.addField<int>("i", "int");
+    auto kD = schema.addField<double>("d", "double");
+    auto kFlag = schema.addField<table::Flag>("flag", "flag");
+    auto kS = schema.addField<std::string>("s", "variable-length string", "", 0);
+    table::SchemaMapper mapper(schema);
+    mapper.addOutputField(table::Field<float>("extra", "unmapped"));
+    auto outI = mapper.addMapping(kI);
+    auto outD = mapper.addMapping(kD);
+    auto outFlag = mapper.addMapping(kFlag);
+    auto outS = mapper.addMapping(kS);
+
+    table::BaseCatalog input(schema);
+    int const n = 1000;
+    for (int i = 0; i < n; ++i) {
+        auto record = input.addNew();
+        record->set(kI, i);
+        record->set(kD, 0.25 * i);
+        record->set(kFlag, i % 5 == 0);
+        record->set(kS, std::to_string(i));
+    }
+    for (int nThreads : {1, 4, 0}) {
+        table::BaseCatalog output(mapper.getOutputSchema());
+        output.addNew();  // records are inserted before this one
+        output.insert(mapper, output.begin(), input.begin(), input.end(), nThreads);
+        BOOST_REQUIRE_EQUAL(output.size(), static_cast<std::size_t>(n + 1));
+        for (int i = 0; i < n; ++i) {
+            BOOST_CHECK_EQUAL(output[i].get(outI), i);
+            BOOST_CHECK_EQUAL(output[i].get(outD), 0.25 * i);
+            BOOST_CHECK_EQUAL(output[i].get(outFlag), i % 5 == 0);
+            BOOST_CHECK_EQUAL(output[i].get(outS), std::to_string(i));
+        }
+        BOOST_CHECK(std::isnan(output[n].get(outD)));
+    }
+
+    // Records whose schema doesn't match the mapper are rejected before anything is inserted
+    table::BaseCatalog wrong(table::Schema{});
+    wrong.addNew();
+    table::BaseCatalog output(mapper.getOutputSchema());
+    BOOST_CHECK_THROW(output.insert(mapper, output.end(), wrong.begin(), wrong.end(), 2),
+                      lsst::pex::exceptions::LogicError);
+    BOOST_CHECK(output.empty());
+}
@@ -0,0 +1,155 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE table - compact catalog
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-variable"
+#include "boost/test/unit_test.hpp"
+#pragma clang diagnostic pop
+
+#include <cmath>
+#include <string>
+
+#include "lsst/afw/detection/Peak.h"
+#include "lsst/afw/table/BaseRecord.h"
+#include "lsst/afw/table/BaseTable.h"
+#include "lsst/afw/table/Catalog.h"
+#include "lsst/afw/table/CompactCatalog.h"
+#include "lsst/afw/table/Simple.h"
+#include "lsst/afw/table/Source.h"
+
+namespace table = lsst::afw::table;
+
+BOOST_AUTO_TEST_CASE(testCompactCatalogFields) {
+    table::Schema schema;
+    auto kI = schema.addField<int>("i", "int");
+    auto kD = schema.addField<double>("d", "double");
+    auto kFlag = schema.addField<table::Flag>("flag", "flag");
+    auto kS = schema.addField<std::string>("s", "variable-length string", "", 0);
+
+    table::CompactCatalogT<table::BaseRecord> catalog(schema);
+    int const n = 250;  // more than one default-sized store
+    for (int i = 0; i < n; ++i) {
+        auto record = catalog.addNew();
+        BOOST_CHECK(std::isnan(record->get(kD)));
+        record->set(kI, i);
+        record->set(kFlag, i % 3 == 0);
+        record->set(kS, std::to_string(i));
+        catalog.set(i, kD, 0.5 * i);
+    }
+    BOOST_REQUIRE_EQUAL(catalog.size(), static_cast<std::size_t>(n));
+    BOOST_CHECK(!catalog.isContiguous());
+    BOOST_CHECK_THROW(catalog.getColumnView(), lsst::pex::exceptions::RuntimeError);
+    BOOST_CHECK_THROW(catalog.at(n), lsst::pex::exceptions::LengthError);
+
+    int i = 0;
+    for (auto const& record : catalog) {
+        BOOST_CHECK_EQUAL(record.get(kI), i);
+        BOOST_CHECK_EQUAL(record.get(kD), 0.5 * i);
+        BOOST_CHECK_EQUAL(record.get(kFlag), i % 3 == 0);
+        BOOST_CHECK_EQUAL(catalog.get(i, kS), std::to_string(i));
+        ++i;
+    }
+
+    // Copies share data; records outlive the catalog that created them.
+    std::shared_ptr<table::BaseRecord> last;
+    {
+        auto copy = catalog;
+        copy.set(n - 1, kI, -1);
+        last = copy.get(n - 1);
+    }
+    catalog.clear();
+    BOOST_CHECK_EQUAL(last->get(kI), -1);
+    BOOST_CHECK_EQUAL(last->get(kS), std::to_string(n - 1));
+}
+
+BOOST_AUTO_TEST_CASE(testCompactCatalogConversions) {
+    table::Schema schema = table::SimpleTable::makeMinimalSchema();
+    auto kX = schema.addField<float>("x", "x");
+    table::SimpleCatalog input(schema);
+    for (int i = 0; i < 20; ++i) {
+        auto record = input.addNew();
+        record->setId(i + 100);
+        record->set(kX, 2.0f * i);
+    }
+
+    // Deep copies of a contiguous range support column views, and materializing records doesn't
+    // assign new IDs.
+    table::CompactCatalogT<table::SimpleRecord> compact(input.getTable(), input.begin(), input.end());
+    BOOST_REQUIRE(compact.isContiguous());
+    auto columns = compact.getColumnView();
+    for (int i = 0; i < 20; ++i) {
+        BOOST_CHECK_EQUAL(compact.get(i)->getId(), i + 100);
+        BOOST_CHECK_EQUAL(columns[kX][i], 2.0f * i);
+    }
+
+    auto output = compact.toCatalog();
+    BOOST_REQUIRE_EQUAL(output.size(), input.size());
+    for (std::size_t i = 0; i < output.size(); ++i) {
+        BOOST_CHECK_EQUAL(output[i].getId(), input[i].getId());
+        BOOST_CHECK_EQUAL(output[i].get(kX), input[i].get(kX));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testCompactCatalogPeaks) {
+    namespace detection = lsst::afw::detection;
+    auto table = detection::PeakTable::make(detection::PeakTable::makeMinimalSchema(), true);
+    table::CompactCatalogT<detection::PeakRecord> catalog(table);
+    int const n = 20;
+    for (int i = 0; i < n; ++i) {
+        auto peak = catalog.addNew();
+        peak->setId(1000 + i);
+        peak->setIx(i);
+        peak->setFx(0.5f * i);
+    }
+
+    // Materializing records, by get() or by dereferencing an iterator, must not assign them new IDs.
+    for (int pass = 0; pass < 3; ++pass) {
+        int i = 0;
+        for (auto const& peak : catalog) {
+            BOOST_CHECK_EQUAL(peak.getId(), static_cast<table::RecordId>(1000 + i));
+            BOOST_CHECK_EQUAL(peak.getIx(), i);
+            ++i;
+        }
+        for (i = 0; i < n; ++i) {
+            BOOST_CHECK_EQUAL(catalog.get(i)->getId(), static_cast<table::RecordId>(1000 + i));
+            BOOST_CHECK_EQUAL(catalog.get(i)->getFx(), 0.5f * i);
+        }
+    }
+
+    // Nor may it advance the table's IdFactory, so the first ordinary record still gets the first ID.
+    BOOST_CHECK_EQUAL(table->makeRecord()->getId(), static_cast<table::RecordId>(1));
+}
+
+BOOST_AUTO_TEST_CASE(testCompactCatalogIteratorView) {
+    table::Schema schema = table::SourceTable::makeMinimalSchema();
+    table::CompactCatalogT<table::SourceRecord> catalog(table::SourceTable::make(schema));
+    int const n = 10;
+    for (int i = 0; i < n; ++i) {
+        catalog.addNew()->setId(i);
+    }
+
+    // An iterator moves a single view from record to record, resetting any state outside the fields
+    auto iter = catalog.begin();
+    table::SourceRecord* view = &*iter;
+    iter->setFootprint(std::make_shared<lsst::afw::detection::Footprint>());
+    ++iter;
+    for (int i = 1; iter != catalog.end(); ++iter, ++i) {
+        BOOST_CHECK_EQUAL(&*iter, view);
+        BOOST_CHECK_EQUAL(iter->getId(), static_cast<table::RecordId>(i));
+        BOOST_CHECK(!iter->getFootprint());
+    }
+
+    // A copy of an iterator gets its own view once either moves, so both stay valid
+    auto first = catalog.begin();
+    table::SourceRecord const& firstRecord = *first;
+    auto second = first;
+    ++second;
+    BOOST_CHECK_EQUAL(second->getId(), static_cast<table::RecordId>(1));
+    BOOST_CHECK_EQUAL(firstRecord.getId(), static_cast<table::RecordId>(0));
+    BOOST_CHECK_EQUAL(first->getId(), static_cast<table::RecordId>(0));
+
+    // Records converted to shared_ptrs are independent of the iterator
+    std::shared_ptr<table::SourceRecord> kept = first;
+    ++first;
+    BOOST_CHECK_EQUAL(kept->getId(), static_cast<table::RecordId>(0));
+    BOOST_CHECK_EQUAL(first->getId(), static_cast<table::RecordId>(1));
+}
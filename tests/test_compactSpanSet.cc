@@ -0,0 +1,131 @@
+/*
+ * LSST Data Management System
+ * Copyright 2008-2018  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#include <iterator>
+#include <vector>
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE CompactSpanSet
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-variable"
+#include "boost/test/unit_test.hpp"
+#pragma clang diagnostic pop
+
+#include "lsst/geom.h"
+#include "lsst/afw/geom/SpanSet.h"
+#include "lsst/afw/geom/CompactSpanSet.h"
+#include "lsst/afw/image.h"
+
+namespace afwGeom = lsst::afw::geom;
+
+BOOST_AUTO_TEST_CASE(CompactSpanSet_testRoundTrip) {
+    // Include disjoint Spans, Spans on the same row, and negative coordinates
+    std::vector<afwGeom::Span> spans = {afwGeom::Span(-3, -10, -2), afwGeom::Span(-3, 4, 400),
+                                        afwGeom::Span(-2, -9, 1000), afwGeom::Span(50, 7, 7)};
+    afwGeom::SpanSet spanSet(spans);
+    afwGeom::CompactSpanSet compact(spanSet);
+
+    BOOST_CHECK(compact.size() == spanSet.size());
+    BOOST_CHECK(compact.getArea() == spanSet.getArea());
+    BOOST_CHECK(compact.getBBox() == spanSet.getBBox());
+    BOOST_CHECK(*compact.toSpanSet() == spanSet);
+
+    auto spanIter = spanSet.begin();
+    for (auto const& spn : compact) {
+        BOOST_CHECK(spn == *spanIter);
+        ++spanIter;
+    }
+    BOOST_CHECK(spanIter == spanSet.end());
+
+    // Regular shapes are much smaller than a vector of Spans
+    auto circle = afwGeom::SpanSet::fromShape(100, afwGeom::Stencil::CIRCLE);
+    afwGeom::CompactSpanSet compactCircle(*circle);
+    BOOST_CHECK(*compactCircle.toSpanSet() == *circle);
+    BOOST_CHECK(compactCircle.getEncodedSize() * 3 < circle->size() * sizeof(afwGeom::Span));
+
+    // Empty SpanSets
+    afwGeom::CompactSpanSet empty{afwGeom::SpanSet()};
+    BOOST_CHECK(empty.empty());
+    BOOST_CHECK(empty.begin() == empty.end());
+    BOOST_CHECK(empty.toSpanSet()->empty());
+}
+
+BOOST_AUTO_TEST_CASE(CompactSpanSet_testSharedStorage) {
+    auto spanSet = afwGeom::SpanSet::fromShape(5, afwGeom::Stencil::MANHATTAN);
+    afwGeom::CompactSpanSet compact(*spanSet);
+
+    auto shifted = compact.shiftedBy(3, -4);
+    BOOST_CHECK(shifted.sharesStorageWith(compact));
+    BOOST_CHECK(*shifted.toSpanSet() == *spanSet->shiftedBy(3, -4));
+    BOOST_CHECK(shifted.getBBox() == spanSet->shiftedBy(3, -4)->getBBox());
+    BOOST_CHECK(shifted.shiftedBy(-3, 4) == compact);
+
+    // Clipping to a box containing everything shares the data, otherwise a new encoding is made
+    auto unclipped = shifted.clippedTo(shifted.getBBox());
+    BOOST_CHECK(unclipped.sharesStorageWith(compact));
+    lsst::geom::Box2I box(lsst::geom::Point2I(0, -6), lsst::geom::Point2I(5, -2));
+    auto clipped = shifted.clippedTo(box);
+    BOOST_CHECK(!clipped.sharesStorageWith(compact));
+    BOOST_CHECK(*clipped.toSpanSet() == *spanSet->shiftedBy(3, -4)->clippedTo(box));
+}
+
+BOOST_AUTO_TEST_CASE(CompactSpanSet_testApplyFunctor) {
+    auto spanSet = afwGeom::SpanSet::fromShape(3, afwGeom::Stencil::CIRCLE)->shiftedBy(4, 4);
+    afwGeom::CompactSpanSet compact(*spanSet);
+
+    lsst::afw::image::Image<int> expected(10, 10, 0);
+    lsst::afw::image::Image<int> image(10, 10, 0);
+    spanSet->setImage(expected, 7);
+    compact.applyFunctor([](lsst::geom::Point2I const& point, int& out, int in) { out = in; }, image, 7);
+    for (int y = 0; y < 10; ++y) {
+        for (int x = 0; x < 10; ++x) {
+            BOOST_CHECK(image(x, y) == expected(x, y));
+        }
+    }
+
+    std::vector<lsst::geom::Point2I> points(compact.getArea());
+    compact.applyFunctor([](lsst::geom::Point2I const& point, lsst::geom::Point2I& out) { out = point; },
+                         points.begin());
+    auto pointIter = points.begin();
+    for (auto const& spn : *spanSet) {
+        for (auto const& pt : spn) {
+            BOOST_CHECK(pt == *pointIter);
+            ++pointIter;
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(CompactSpanSet_testIterators) {
+    // Two sets with the same number of Spans, but different Spans
+    afwGeom::CompactSpanSet first(afwGeom::SpanSet(lsst::geom::Box2I(lsst::geom::Point2I(0, 0),
+                                                                     lsst::geom::Extent2I(3, 2))));
+    afwGeom::CompactSpanSet second(afwGeom::SpanSet(lsst::geom::Box2I(lsst::geom::Point2I(5, 5),
+                                                                      lsst::geom::Extent2I(3, 2))));
+    BOOST_REQUIRE(first.size() == second.size());
+    BOOST_CHECK(first.begin() == first.begin());
+    BOOST_CHECK(first.begin() != second.begin());
+    BOOST_CHECK(first.begin() != first.shiftedBy(1, 0).begin());
+    auto iter = first.begin();
+    BOOST_CHECK(++iter != first.begin());
+    BOOST_CHECK(++iter == first.end());
+    BOOST_CHECK(std::distance(second.begin(), second.end()) == 2);
+}
@@ -671,6 +671,42 @@ class ExposureTestCase(lsst.utils.tests.TestCase):
             exposure3 = afwImage.ExposureF(tmpFile)
             self.assertIsNotNone(exposure3.getInfo().getCoaddInputs())
 
+    def testArchiveContentDeduplication(self):
+        """Equal but separately allocated components are saved once only when requested.
+        """
+        schema = afwTable.ExposureTable.makeMinimalSchema()
+        coaddInputs = afwImage.CoaddInputs(schema, schema)
+        for i in range(50):
+            record = coaddInputs.ccds.addNew()
+            record.setId(i)
+            record.setWcs(afwGeom.makeSkyWcs(self.md, False))
+        exposure = afwImage.ExposureF(100, 100, self.wcs)
+        exposure.getInfo().setCoaddInputs(coaddInputs)
+        self.assertFalse(exposure.getInfo().getArchiveContentDeduplication())
+        sizes = {}
+        for deduplicate in (False, True):
+            exposure.getInfo().setArchiveContentDeduplication(deduplicate)
+            self.assertEqual(afwImage.ExposureF(exposure).getInfo().getArchiveContentDeduplication(),
+                             deduplicate)
+            with lsst.utils.tests.getTempFilePath(".fits") as tmpFile:
+                exposure.writeFits(tmpFile)
+                sizes[deduplicate] = os.path.getsize(tmpFile)
+                ccds = afwImage.ExposureF(tmpFile).getInfo().getCoaddInputs().ccds
+                self.assertEqual(len(ccds), 50)
+                for record in ccds:
+                    self.assertEqual(record.getWcs(), self.wcs)
+        self.assertLess(sizes[True], sizes[False])
+
+        catalog = coaddInputs.ccds
+        sizes = {}
+        for flags in (0, afwTable.EXPOSURE_IO_DEDUPLICATE_ARCHIVE):
+            with lsst.utils.tests.getTempFilePath(".fits") as tmpFile:
+                catalog.writeFits(tmpFile, "w", flags)
+                sizes[flags] = os.path.getsize(tmpFile)
+                readBack = afwTable.ExposureCatalog.readFits(tmpFile)
+                self.assertEqual([r.getWcs() for r in readBack], [self.wcs]*50)
+        self.assertLess(sizes[afwTable.EXPOSURE_IO_DEDUPLICATE_ARCHIVE], sizes[0])
+
     def testGetCutout(self):
         wcs = self.smallExposure.getWcs()
 
@@ -20,6 +20,7 @@
 # see <http://www.lsstcorp.org/LegalNotices/>.
 #
 
+import math
 import os
 import unittest
 
@@ -114,6 +115,47 @@ class FitsTestCase(lsst.utils.tests.TestCase):
         for key in others:
             self.assertEqual(metadata.valueCount(key), 1, key)
 
+    def testValueTypes(self):
+        """Check the types that header values are read back as."""
+        header = PropertyList()
+        header.set("ABOOL", True)
+        header.set("ANINT", -7)
+        header.set("ALONG", 1 << 40)
+        header.set("ADOUBLE", -1.5e-30)
+        header.set("ANAN", float("nan"))
+        header.set("LONGSTR", "x"*100 + "y"*100)
+        header.add("HISTORY", "first")
+        header.add("HISTORY", "second")
+        metadata = self.writeAndRead(header)
+        self.assertIs(metadata.getScalar("ABOOL"), True)
+        self.assertEqual(metadata.getScalar("ANINT"), -7)
+        self.assertEqual(metadata.getScalar("ALONG"), 1 << 40)
+        self.assertEqual(metadata.getScalar("ADOUBLE"), -1.5e-30)
+        self.assertTrue(math.isnan(metadata.getScalar("ANAN")))
+        self.assertEqual(metadata.getScalar("LONGSTR"), "x"*100 + "y"*100)
+        self.assertEqual(metadata.getArray("HISTORY"), ["first", "second"])
+
+    def testReadKeys(self):
+        """Check that only the requested keys are read."""
+        header = PropertyList()
+        for i in range(500):
+            header.set("KEY%d" % i, i)
+        header.set("LONGSTR", "z"*150)
+        fitsFile = lsst.afw.fits.MemFileManager()
+        with lsst.afw.fits.Fits(fitsFile, "w") as fits:
+            fits.createEmpty()
+            fits.writeMetadata(header)
+        keys = ["KEY3", "KEY499", "LONGSTR", "NAXIS", "MISSING"]
+        metadata = fitsFile.readMetadata(keys=keys)
+        self.assertEqual(metadata.getOrderedNames(), ["NAXIS", "KEY3", "KEY499", "LONGSTR"])
+        self.assertEqual(metadata.getScalar("KEY499"), 499)
+        self.assertEqual(metadata.getScalar("LONGSTR"), "z"*150)
+        stripped = fitsFile.readMetadata(strip=True, keys=keys)
+        self.assertEqual(stripped.getOrderedNames(), ["KEY3", "KEY499", "LONGSTR"])
+        full = fitsFile.readMetadata()
+        for key in ["KEY3", "KEY499", "LONGSTR"]:
+            self.assertEqual(metadata.getScalar(key), full.getScalar(key))
+
 
 class TestMemory(lsst.utils.tests.MemoryTestCase):
     pass
@@ -0,0 +1,92 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE fits - async writer
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-variable"
+#include "boost/test/unit_test.hpp"
+#pragma clang diagnostic pop
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "lsst/afw/fits.h"
+#include "lsst/afw/fitsAsyncWriter.h"
+#include "lsst/afw/image/Image.h"
+
+namespace fits = lsst::afw::fits;
+namespace image = lsst::afw::image;
+
+BOOST_AUTO_TEST_CASE(testWriteImages) {
+    int const n = 6;
+    std::vector<std::string> filenames;
+    std::vector<std::future<void>> futures;
+    image::Image<float> original(lsst::geom::Extent2I(64, 32));
+    {
+        fits::AsyncWriter writer(2, 3);
+        for (int i = 0; i < n; ++i) {
+            original = static_cast<float>(i);
+            filenames.push_back("tests/asyncWriter" + std::to_string(i) + ".fits");
+            // A deep copy, so the original can be modified while the copy is written.
+            futures.push_back(writer.writeFits(std::make_unique<image::Image<float>>(original, true),
+                                               filenames.back()));
+            BOOST_CHECK(writer.getPending() <= writer.getMaxPending());
+        }
+        writer.wait();
+        BOOST_CHECK_EQUAL(writer.getPending(), 0u);
+    }
+    for (int i = 0; i < n; ++i) {
+        futures[i].get();
+        image::Image<float> read(filenames[i]);
+        BOOST_CHECK_EQUAL(read(10, 10), static_cast<float>(i));
+        std::remove(filenames[i].c_str());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testErrors) {
+    fits::AsyncWriter writer;
+    auto bad = writer.writeFits(std::make_unique<image::Image<float>>(lsst::geom::Extent2I(4, 4)),
+                                std::string("tests/no/such/directory/image.fits"));
+    auto thrown = writer.submit([]() { throw std::runtime_error("failed"); });
+    BOOST_CHECK_THROW(bad.get(), fits::FitsError);
+    BOOST_CHECK_THROW(thrown.get(), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(testBackPressure) {
+    int const maxPending = 2;
+    fits::AsyncWriter writer(4, maxPending);
+    if (writer.getThreadCount() == 0) return;  // cfitsio isn't reentrant; everything is synchronous
+    std::atomic<int> running(0);
+    std::atomic<int> maxRunning(0);
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < 10; ++i) {
+        futures.push_back(writer.submit([&running, &maxRunning]() {
+            int const now = ++running;
+            int seen = maxRunning;
+            while (now > seen && !maxRunning.compare_exchange_weak(seen, now)) {
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            --running;
+        }));
+        BOOST_CHECK(writer.getPending() <= static_cast<std::size_t>(maxPending));
+    }
+    for (auto& future : futures) {
+        future.get();
+    }
+    BOOST_CHECK(maxRunning <= maxPending);
+}
+
+BOOST_AUTO_TEST_CASE(testCompressionThreadLimit) {
+    fits::AsyncWriter writer(2);
+    if (writer.getThreadCount() == 0) return;  // cfitsio isn't reentrant; everything is synchronous
+    int limit = 0;
+    writer.submit([&limit]() { limit = fits::getCompressionThreadLimit(); }).get();
+    BOOST_CHECK(limit >= 1);
+    BOOST_CHECK(limit <= static_cast<int>(std::max(1u, std::thread::hardware_concurrency())));
+    BOOST_CHECK_EQUAL(fits::getCompressionThreadLimit(), 0);  // only the writer threads are limited
+}
@@ -0,0 +1,159 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE table - fits chunk reader
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-variable"
+#include "boost/test/unit_test.hpp"
+#pragma clang diagnostic pop
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "lsst/afw/fits.h"
+#include "lsst/afw/table/BaseRecord.h"
+#include "lsst/afw/table/BaseTable.h"
+#include "lsst/afw/table/Catalog.h"
+#include "lsst/afw/table/Source.h"
+#include "lsst/afw/table/io/FitsChunkReader.h"
+
+namespace table = lsst::afw::table;
+
+namespace {
+
+struct Fixture {
+    Fixture() : manager(0) {
+        kI = schema.addField<int>("a_i", "int");
+        kD = schema.addField<double>("a_d", "double");
+        kF = schema.addField<float>("b", "float");
+        kFlag1 = schema.addField<table::Flag>("a_flag", "first flag");
+        kFlag2 = schema.addField<table::Flag>("c_flag", "second flag");
+        table::BaseCatalog catalog(schema);
+        for (int i = 0; i < n; ++i) {
+            auto record = catalog.addNew();
+            record->set(kI, i);
+            record->set(kD, 0.5 * i);
+            record->set(kF, -1.0f * i);
+            record->set(kFlag1, i % 2 == 0);
+            record->set(kFlag2, i % 3 == 0);
+        }
+        catalog.writeFits(manager);
+    }
+
+    int const n = 1000;
+    lsst::afw::fits::MemFileManager manager;
+    table::Schema schema;
+    table::Key<int> kI;
+    table::Key<double> kD;
+    table::Key<float> kF;
+    table::Key<table::Flag> kFlag1;
+    table::Key<table::Flag> kFlag2;
+};
+
+}  // namespace
+
+BOOST_FIXTURE_TEST_CASE(testChunks, Fixture) {
+    table::io::FitsChunkReader<table::BaseCatalog> reader(manager, 1, 300);
+    BOOST_CHECK_EQUAL(reader.getRemainingCount(), static_cast<std::size_t>(n));
+    BOOST_CHECK(reader.getTable()->getBlockReuse());
+    auto schema = reader.getSchema();
+    auto kI = schema.find<int>("a_i").key;
+    auto kFlag2 = schema.find<table::Flag>("c_flag").key;
+    std::vector<std::size_t> sizes;
+    int row = 0;
+    while (!reader.isDone()) {
+        auto chunk = reader.next();
+        BOOST_CHECK(chunk.isContiguous());
+        sizes.push_back(chunk.size());
+        for (auto const& record : chunk) {
+            BOOST_CHECK_EQUAL(record.get(kI), row);
+            BOOST_CHECK_EQUAL(record.get(kFlag2), row % 3 == 0);
+            ++row;
+        }
+    }
+    BOOST_CHECK_EQUAL(row, n);
+    BOOST_CHECK((sizes == std::vector<std::size_t>{300, 300, 300, 100}));
+    BOOST_CHECK(reader.next().empty());
+}
+
+BOOST_FIXTURE_TEST_CASE(testProjectionAndRange, Fixture) {
+    table::io::FitsChunkReader<table::BaseCatalog> reader(manager, 1, 64, {"a"}, 100, 250);
+    auto schema = reader.getSchema();
+    BOOST_CHECK_EQUAL(schema.getFieldCount(), 3);
+    BOOST_CHECK_THROW(schema.find<float>("b"), lsst::pex::exceptions::NotFoundError);
+    BOOST_CHECK_THROW(schema.find<table::Flag>("c_flag"), lsst::pex::exceptions::NotFoundError);
+    auto kI = schema.find<int>("a_i").key;
+    auto kD = schema.find<double>("a_d").key;
+    auto kFlag1 = schema.find<table::Flag>("a_flag").key;
+    int row = 100;
+    while (!reader.isDone()) {
+        for (auto const& record : reader.next()) {
+            BOOST_CHECK_EQUAL(record.get(kI), row);
+            BOOST_CHECK_EQUAL(record.get(kD), 0.5 * row);
+            BOOST_CHECK_EQUAL(record.get(kFlag1), row % 2 == 0);
+            ++row;
+        }
+    }
+    BOOST_CHECK_EQUAL(row, 250);
+}
+
+BOOST_AUTO_TEST_CASE(testSourceColumns) {
+    table::Schema schema = table::SourceTable::makeMinimalSchema();
+    auto kFlux = schema.addField<double>("base_PsfFlux_instFlux", "flux");
+    schema.addField<double>("other", "a column that is not read");
+    table::SourceCatalog catalog(schema);
+    for (int i = 0; i < 50; ++i) {
+        auto record = catalog.addNew();
+        record->setParent(i < 5 ? 0 : catalog[i % 5].getId());
+        record->set(kFlux, 2.0 * i);
+    }
+    lsst::afw::fits::MemFileManager manager;
+    catalog.writeFits(manager);
+
+    // The columns in the class documentation example: a SourceCatalog needs all of its minimal schema.
+    table::io::FitsChunkReader<table::SourceCatalog> reader(manager, 1, 20,
+                                                            {"id", "coord", "parent", "base_PsfFlux"});
+    auto readSchema = reader.getSchema();
+    BOOST_CHECK_THROW(readSchema.find<double>("other"), lsst::pex::exceptions::NotFoundError);
+    auto kFlux2 = readSchema.find<double>("base_PsfFlux_instFlux").key;
+    std::size_t row = 0;
+    while (!reader.isDone()) {
+        for (auto const& record : reader.next()) {
+            BOOST_CHECK_EQUAL(record.getId(), catalog[row].getId());
+            BOOST_CHECK_EQUAL(record.getParent(), catalog[row].getParent());
+            BOOST_CHECK_EQUAL(record.get(kFlux2), 2.0 * row);
+            ++row;
+        }
+    }
+    BOOST_CHECK_EQUAL(row, catalog.size());
+
+    // Leaving out a minimal schema field can't make a SourceTable.
+    std::vector<std::string> const withoutParent = {"id", "coord", "base_PsfFlux"};
+    BOOST_CHECK_THROW(table::io::FitsChunkReader<table::SourceCatalog>(manager, 1, 20, withoutParent),
+                      lsst::pex::exceptions::InvalidParameterError);
+}
+
+BOOST_AUTO_TEST_CASE(testBlockReuse) {
+    table::Schema schema;
+    auto key = schema.addField<double>("d", "double");
+    auto tbl = table::BaseTable::make(schema);
+    tbl->setBlockReuse(true);
+    char const* first = nullptr;
+    for (int i = 0; i < 3; ++i) {
+        table::BaseCatalog catalog(tbl);
+        catalog.reserve(100);
+        for (int j = 0; j < 100; ++j) {
+            catalog.addNew()->set(key, j);
+        }
+        auto columns = catalog.getColumnView();
+        char const* data = reinterpret_cast<char const*>(columns[key].getData());
+        if (first) {
+            BOOST_CHECK(data == first);
+        } else {
+            first = data;
+        }
+        // Reused memory is zeroed and reinitialized like new memory.
+        BOOST_CHECK_EQUAL(catalog[1].get(key), 1.0);
+    }
+    auto kept = tbl->makeRecord();
+    BOOST_CHECK(std::isnan(kept->get(key)));
+}
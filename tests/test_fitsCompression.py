@@ -21,13 +21,16 @@
 #
 
 import os
+import re
 import unittest
 import itertools
+import contextlib
 
 import numpy as np
 import astropy.io.fits
 
 import lsst.utils
+import lsst.log
 import lsst.daf.base
 import lsst.daf.persistence
 import lsst.geom
@@ -311,6 +314,24 @@ class ImageScalingTestCase(lsst.utils.tests.TestCase):
                                         quantizeLevelList, quantizePadList):
             self.checkStdev(*values)
 
+    def testStdevSampled(self):
+        """Test that STDEV scaling estimated from a sample of pixels is
+        reproducible and close to that estimated from all pixels
+        """
+        image = lsst.afw.image.ImageF(lsst.geom.Extent2I(500, 400))
+        rng = np.random.RandomState(12345)
+        image.getArray()[:] = rng.normal(1000.0, self.stdev, image.getArray().shape)
+        maxSamples = 5000
+        for algorithm in (ImageScalingOptions.STDEV_POSITIVE, ImageScalingOptions.STDEV_BOTH):
+            full = ImageScalingOptions(algorithm, 32, quantizeLevel=10.0).determine(image)
+            sampled = [ImageScalingOptions(algorithm, 32, quantizeLevel=10.0, seed=seed,
+                                           maxSamples=maxSamples).determine(image) for seed in (1, 1, 2)]
+            self.assertEqual(sampled[0].bscale, sampled[1].bscale)
+            self.assertEqual(sampled[0].bzero, sampled[1].bzero)
+            # Relative error of the stdev is about 1.2/sqrt(maxSamples); allow for 5 sigma
+            for scale in sampled:
+                self.assertFloatsAlmostEqual(scale.bscale, full.bscale, rtol=5*1.2/maxSamples**0.5)
+
     def testRangeFailures(self):
         """Test that the RANGE scaling fails on integer inputs"""
         classList = (lsst.afw.image.ImageU, lsst.afw.image.ImageI, lsst.afw.image.ImageL)
@@ -554,6 +575,99 @@ class ImageCompressionTestCase(lsst.utils.tests.TestCase):
                 self.assertIn(mp, unpersisted.getMaskPlaneDict())
                 unpersisted.getPlaneBitMask(mp)
 
+    def readCompressedTiles(self, filename):
+        """Read the compressed bytes of each tile of the image in HDU 1"""
+        with astropy.io.fits.open(filename, disable_image_compression=True) as hduList:
+            return [np.asarray(tile).tobytes() for tile in hduList[1].data["COMPRESSED_DATA"]]
+
+    @contextlib.contextmanager
+    def assertRiceThreads(self, action, nThreads):
+        """Assert that the enclosed code had afw (rather than cfitsio) compress
+        or decompress RICE_1 tiles, on the given number of threads
+
+        Parameters
+        ----------
+        action : `str`
+            "Compressed" or "Decompressed".
+        nThreads : `int`
+            Expected number of threads.
+        """
+        log = lsst.log.Log.getLogger("afw.fits")
+        oldLevel = log.getLevel()
+        log.setLevel(lsst.log.Log.DEBUG)
+        try:
+            with lsst.log.UsePythonLogging(), self.assertLogs("afw.fits", level="DEBUG") as logs:
+                yield
+        finally:
+            log.setLevel(oldLevel)
+        pattern = re.compile(r"%s \d+ RICE_1 tiles on %d thread" % (action, nThreads))
+        self.assertTrue(any(pattern.search(message) for message in logs.output), logs.output)
+
+    def testCompressionThreads(self):
+        """Test that tiles compressed and decompressed on several threads
+        round-trip, including reads of subimages that cut across tiles
+
+        The tiles must also be identical to those compressed by astropy
+        (which uses cfitsio's own compression code), and each must be able to
+        read the other's files.  Debug log messages show that the tiles were
+        handled on afw's threads, and a corrupted tile must be reported.
+        """
+        bbox = lsst.geom.Box2I(lsst.geom.Point2I(12, 34), lsst.geom.Extent2I(250, 130))
+        subBBox = lsst.geom.Box2I(lsst.geom.Point2I(50, 40), lsst.geom.Extent2I(100, 77))
+        localSubBBox = lsst.geom.Box2I(subBBox.getMin() - lsst.geom.Extent2I(bbox.getMin()),
+                                       subBBox.getDimensions())
+        tiles = np.array((64, 16), dtype=np.int64)
+        compression = ImageCompressionOptions(ImageCompressionOptions.RICE, tiles, 0.0)
+        oldThreads = lsst.afw.fits.getCompressionThreads()
+        try:
+            for cls in (lsst.afw.image.ImageI, lsst.afw.image.ImageU):
+                image = cls(bbox)
+                rng = np.random.RandomState(12345)
+                image.getArray()[:] = rng.randint(0, 1000, image.getArray().shape)
+                expectedSub = image.Factory(image, subBBox).getArray()
+
+                # Tiles compressed by cfitsio (through astropy)
+                with lsst.utils.tests.getTempFilePath(self.extension) as filename:
+                    hdu = astropy.io.fits.CompImageHDU(image.getArray(), compression_type="RICE_1",
+                                                       tile_size=[int(tt) for tt in tiles])
+                    astropy.io.fits.HDUList([astropy.io.fits.PrimaryHDU(), hdu]).writeto(filename)
+                    reference = self.readCompressedTiles(filename)
+                    self.assertGreater(len(reference), 1)
+                    lsst.afw.fits.setCompressionThreads(4)
+                    with self.assertRiceThreads("Decompressed", 4):
+                        np.testing.assert_array_equal(cls(filename).getArray(), image.getArray())
+                    with self.assertRiceThreads("Decompressed", 4):
+                        np.testing.assert_array_equal(cls(filename, bbox=localSubBBox).getArray(),
+                                                      expectedSub)
+
+                contents = []
+                for nThreads in (1, 4):
+                    lsst.afw.fits.setCompressionThreads(nThreads)
+                    with lsst.utils.tests.getTempFilePath(self.extension) as filename:
+                        with self.assertRiceThreads("Compressed", nThreads):
+                            image.writeFits(filename, lsst.afw.fits.ImageWriteOptions(compression))
+                        with open(filename, "rb") as ff:
+                            contents.append(ff.read())
+                        self.assertEqual(self.readCompressedTiles(filename), reference)
+                        with astropy.io.fits.open(filename) as hduList:
+                            np.testing.assert_array_equal(hduList[1].data, image.getArray())
+                        with self.assertRiceThreads("Decompressed", nThreads):
+                            self.assertImagesEqual(cls(filename), image)
+                        self.assertImagesEqual(cls(filename, bbox=subBBox), image.Factory(image, subBBox))
+                self.assertEqual(contents[0], contents[1])
+
+                # A tile that cannot be decompressed is reported, though found on a worker thread
+                with lsst.utils.tests.getTempFilePath(self.extension) as filename:
+                    start = contents[1].index(reference[1])
+                    corrupted = (contents[1][:start] + b"\xff"*len(reference[1]) +
+                                 contents[1][start + len(reference[1]):])
+                    with open(filename, "wb") as ff:
+                        ff.write(corrupted)
+                    with self.assertRaisesRegex(lsst.afw.fits.FitsError, "Decompressing tile 1"):
+                        cls(filename)
+        finally:
+            lsst.afw.fits.setCompressionThreads(oldThreads)
+
     def testLossyFloatCfitsio(self):
         """Test lossy compresion of floating-point images with cfitsio
 
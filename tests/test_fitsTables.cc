@@ -194,3 +194,44 @@ BOOST_AUTO_TEST_CASE(ticket2164) {
     ConstBaseCatalog constCat(cat);
     BOOST_CHECK_THROW(constCat.getColumnView(), lsst::pex::exceptions::LogicError);
 }
+
+// Columns with scaling that afw never writes can't be copied from raw rows; check that they fall back
+// to being read cell by cell, with cfitsio applying the scaling, next to columns that are copied.
+BOOST_AUTO_TEST_CASE(testScaledColumnFallback) {
+    using namespace lsst::afw::table;
+    namespace fits = lsst::afw::fits;
+    Schema schema;
+    Key<int> i = schema.addField<int>("i", "test int field");
+    Key<double> d = schema.addField<double>("d", "test double field");
+    Key<float> f = schema.addField<float>("f", "test float field");
+    Key<Flag> flag = schema.addField<Flag>("flag", "test flag field");
+    BaseCatalog cat(schema);
+    for (int n = 0; n < 10; ++n) {
+        auto record = cat.addNew();
+        record->set(i, n);
+        record->set(d, 0.25 * n);
+        record->set(f, -0.5f * n);
+        record->set(flag, n % 2 == 0);
+    }
+    fits::MemFileManager manager;
+    cat.writeFits(manager);
+    {
+        // The flag column comes first, so "i" is column 1 and "d" column 2.
+        fits::Fits file(manager, "a", fits::Fits::AUTO_CLOSE | fits::Fits::AUTO_CHECK);
+        file.updateColumnKey("TZERO", 1, 10);
+        file.updateColumnKey("TSCAL", 2, 2.0);
+    }
+    BaseCatalog result = BaseCatalog::readFits(manager);
+    BOOST_REQUIRE_EQUAL(result.size(), cat.size());
+    Schema resultSchema = result.getSchema();
+    Key<int> i2 = resultSchema.find<int>("i").key;
+    Key<double> d2 = resultSchema.find<double>("d").key;
+    Key<float> f2 = resultSchema.find<float>("f").key;
+    Key<Flag> flag2 = resultSchema.find<Flag>("flag").key;
+    for (std::size_t n = 0; n < cat.size(); ++n) {
+        BOOST_CHECK_EQUAL(result[n].get(i2), cat[n].get(i) + 10);
+        BOOST_CHECK_EQUAL(result[n].get(d2), 2.0 * cat[n].get(d));
+        BOOST_CHECK_EQUAL(result[n].get(f2), cat[n].get(f));
+        BOOST_CHECK_EQUAL(result[n].get(flag2), cat[n].get(flag));
+    }
+}
@@ -28,6 +28,7 @@ or
    pytest test_footprint2.py
 """
 
+import math
 import unittest
 
 import lsst.utils.tests
@@ -551,6 +552,41 @@ class PeaksInFootprintsTestCase(unittest.TestCase):
 
         self.doTestPeaks(polarity=False, callback=callback)
 
+    def testPeaksMultithreaded(self):
+        """Test that the Peaks are the same whatever the number of threads used to find them"""
+        im = afwImage.ImageF(lsst.geom.Extent2I(200, 150))
+        for y in range(im.getHeight()):
+            for x in range(im.getWidth()):
+                im[x, y, afwImage.LOCAL] = ((x*7919 + y*104729) % 97) * (1 if (x//10 + y//10) % 3 else 0)
+        threshold = afwDetect.Threshold(20)
+        serial = afwDetect.FootprintSet(im, threshold)
+        self.assertGreater(len(serial.getFootprints()), 1)
+        for nThreads in (2, 4, 0):
+            threaded = afwDetect.FootprintSet(im, threshold, nThreads=nThreads)
+            self.assertEqual(len(threaded.getFootprints()), len(serial.getFootprints()))
+            for foot1, foot2 in zip(serial.getFootprints(), threaded.getFootprints()):
+                self.assertEqual([(p.getIx(), p.getIy(), p.getPeakValue()) for p in foot1.getPeaks()],
+                                 [(p.getIx(), p.getIy(), p.getPeakValue()) for p in foot2.getPeaks()])
+
+    def testMergePeaksWithNan(self):
+        """Test that merged Peaks are sorted by decreasing value, with NaN-valued Peaks last"""
+        mask = afwImage.Mask(lsst.geom.Extent2I(30, 20))
+        mask.array[5:10, 5:15] = 0x1
+        threshold = afwDetect.Threshold(0x1, afwDetect.Threshold.BITMASK)
+        fs1 = afwDetect.FootprintSet(mask, threshold)
+        fs2 = afwDetect.FootprintSet(mask, threshold)
+        for fs, peaks in [(fs1, [(6, 6, 30.0), (7, 6, 25.0), (8, 6, float("nan"))]),
+                          (fs2, [(6, 8, 28.0), (7, 8, float("nan"))])]:
+            self.assertEqual(len(fs.getFootprints()), 1)
+            for x, y, value in peaks:
+                fs.getFootprints()[0].addPeak(x, y, value)
+        fs1.merge(fs2)
+        self.assertEqual(len(fs1.getFootprints()), 1)
+        values = [p.getPeakValue() for p in fs1.getFootprints()[0].getPeaks()]
+        self.assertEqual(values[:3], [30.0, 28.0, 25.0])
+        self.assertEqual(len(values), 5)
+        self.assertTrue(all(math.isnan(v) for v in values[3:]))
+
     def testGrowFootprints(self):
         """Test that we can grow footprints, correctly merging those that now touch"""
         def callback():
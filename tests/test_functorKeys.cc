@@ -30,8 +30,11 @@
 #include "lsst/utils/tests.h"
 
 #include "lsst/geom/Angle.h"
+#include "lsst/pex/exceptions.h"
 #include "lsst/afw/table/aggregates.h"
 #include "lsst/afw/table/arrays.h"
+#include "lsst/afw/table/BaseRecord.h"
+#include "lsst/afw/table/BaseTable.h"
 #include "lsst/afw/table/Schema.h"
 
 /*
@@ -142,6 +145,37 @@ BOOST_AUTO_TEST_CASE(CovarianceMatrixKeyHash) {
                              CovarianceMatrixKey<double, 3>(schema["a"], names));
 }
 
+BOOST_AUTO_TEST_CASE(ArrayKeyColumnarReference) {
+    Schema schema;
+    ArrayKey<double> scalars = ArrayKey<double>::addFields(schema, "s", "scalar elements", "", 3);
+    ArrayKey<double> array(schema.addField<Array<double>>("a", "array field", "", 3));
+    auto table = BaseTable::make(schema);
+    table->setColumnar(true);
+    table->preallocate(4);
+    auto record = table->makeRecord();
+    table->makeRecord();
+    ndarray::Array<double, 1, 1> values = ndarray::allocate(3);
+    values[0] = 1.0;
+    values[1] = 2.0;
+    values[2] = 3.0;
+    record->set(scalars, values);
+    record->set(array, values);
+
+    // Separate scalar fields are not contiguous in a columnar record, so there is nothing to refer to
+    BOOST_CHECK_THROW(scalars.getReference(*record), pex::exceptions::LogicError);
+    BOOST_CHECK_THROW((*record)[scalars], pex::exceptions::LogicError);
+    // ...but read-only access returns their values, like get()
+    BaseRecord const& constRecord = *record;
+    ndarray::Array<double const, 1, 1> constRef = constRecord[scalars];
+    BOOST_CHECK(std::equal(constRef.begin(), constRef.end(), values.begin()));
+
+    // A true array field is contiguous, and its reference writes through to the record
+    ndarray::ArrayRef<double, 1, 1> ref = (*record)[array];
+    ref[1] = 5.0;
+    BOOST_CHECK_EQUAL(record->get(array)[1], 5.0);
+    BOOST_CHECK_EQUAL(constRecord[array][1], 5.0);
+}
+
 }  // namespace table
 }  // namespace afw
 }  // namespace lsst
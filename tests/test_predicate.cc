@@ -0,0 +1,98 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE table - predicate
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-variable"
+#include "boost/test/unit_test.hpp"
+#pragma clang diagnostic pop
+
+#include <cmath>
+#include <limits>
+
+#include "lsst/afw/table/BaseRecord.h"
+#include "lsst/afw/table/BaseTable.h"
+#include "lsst/afw/table/Catalog.h"
+#include "lsst/afw/table/Predicate.h"
+
+namespace table = lsst::afw::table;
+
+namespace {
+
+struct Fixture {
+    Fixture() {
+        kI = schema.addField<int>("i", "int");
+        kD = schema.addField<double>("d", "double");
+        kFlag = schema.addField<table::Flag>("flag", "flag");
+    }
+
+    table::BaseCatalog makeCatalog(bool columnar, int n) const {
+        table::BaseCatalog catalog(schema);
+        catalog.getTable()->setColumnar(columnar);
+        catalog.reserve(n);
+        for (int i = 0; i < n; ++i) {
+            auto record = catalog.addNew();
+            record->set(kI, i);
+            record->set(kD, i % 11 == 0 ? std::numeric_limits<double>::quiet_NaN() : 0.5 * i);
+            record->set(kFlag, i % 3 == 0);
+        }
+        return catalog;
+    }
+
+    bool expected(table::BaseRecord const& record) const {
+        return (record.get(kI) >= 100 && record.get(kD) < 2000.0 && !record.get(kFlag)) ||
+               record.get(kI) == 7;
+    }
+
+    table::Schema schema;
+    table::Key<int> kI;
+    table::Key<double> kD;
+    table::Key<table::Flag> kFlag;
+};
+
+}  // namespace
+
+BOOST_FIXTURE_TEST_CASE(testPredicateEvaluation, Fixture) {
+    table::Predicate const predicate =
+            (table::Predicate(kI, table::Predicate::GREATER_EQUAL, 100) &&
+             table::Predicate(kD, table::Predicate::LESS, 2000.0) && !table::Predicate(kFlag)) ||
+            table::Predicate(kI, table::Predicate::EQUAL, 7);
+    int const n = 10000;  // several blocks
+    for (bool columnar : {false, true}) {
+        auto catalog = makeCatalog(columnar, n);
+        BOOST_REQUIRE(catalog.isContiguous());
+        auto mask = predicate.evaluate(catalog);
+        BOOST_REQUIRE_EQUAL(mask.getSize<0>(), n);
+        for (int i = 0; i < n; ++i) {
+            BOOST_CHECK_EQUAL(mask[i], expected(catalog[i]));
+            BOOST_CHECK_EQUAL(predicate(catalog[i]), expected(catalog[i]));
+        }
+
+        // Non-contiguous catalogs are evaluated record by record.
+        auto strided = catalog.subset(0, n, 2);
+        BOOST_REQUIRE(!strided.isContiguous());
+        auto indices = predicate.select(strided);
+        std::size_t j = 0;
+        for (std::size_t i = 0; i < strided.size(); ++i) {
+            if (expected(strided[i])) {
+                BOOST_REQUIRE(j < indices.size());
+                BOOST_CHECK_EQUAL(indices[j++], i);
+            }
+        }
+        BOOST_CHECK_EQUAL(j, indices.size());
+
+        // Deep subsets are contiguous copies; shallow ones share records.
+        auto deep = predicate.subset(catalog, true);
+        auto shallow = predicate.subset(catalog);
+        BOOST_REQUIRE_EQUAL(deep.size(), shallow.size());
+        BOOST_CHECK(deep.isContiguous());
+        for (std::size_t i = 0; i < deep.size(); ++i) {
+            BOOST_CHECK(&deep[i] != &shallow[i]);
+            BOOST_CHECK_EQUAL(deep[i].get(kI), shallow[i].get(kI));
+            BOOST_CHECK(expected(shallow[i]));
+        }
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(testPredicateInvalidKey, Fixture) {
+    BOOST_CHECK_THROW(table::Predicate(table::Key<int>(), table::Predicate::LESS, 0),
+                      lsst::pex::exceptions::LogicError);
+}
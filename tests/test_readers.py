@@ -19,17 +19,21 @@
 # You should have received a copy of the GNU General Public License
 # along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
+import os
 import unittest
 
 import numpy as np
 
 import lsst.utils.tests
+import lsst.afw.fits
+import lsst.pex.exceptions
 from lsst.daf.base import PropertyList
 from lsst.geom import Box2I, Point2I, Extent2I, Point2D, Box2D, SpherePoint, degrees
 from lsst.afw.geom import makeSkyWcs, Polygon
 from lsst.afw.table import ExposureTable
 from lsst.afw.image import (Image, Mask, Exposure, LOCAL, PARENT, MaskPixel, VariancePixel,
                             ImageFitsReader, MaskFitsReader, MaskedImageFitsReader, ExposureFitsReader,
+                            ExposureCutoutReader, ScratchFileReader, ScratchWriteOptions,
                             Filter, PhotoCalib, ApCorrMap, VisitInfo, TransmissionCurve, CoaddInputs)
 from lsst.afw.image.utils import defineFilter
 from lsst.afw.detection import GaussianPsf
@@ -80,6 +84,30 @@ class FitsReaderTestCase(lsst.utils.tests.TestCase):
                                 self.assertEqual(subIn.getBBox(), image2.getBBox())
                                 self.assertTrue(np.all(image2.array == array2))
 
+    def testMappedReads(self):
+        for dtypeIn in self.dtypes:
+            with self.subTest(dtypeIn=dtypeIn):
+                imageIn = Image(self.bbox, dtype=dtypeIn)
+                imageIn.array[:, :] = np.random.randint(low=1, high=5000, size=imageIn.array.shape)
+                with lsst.utils.tests.getTempFilePath(".fits") as fileName:
+                    imageIn.writeFits(fileName)
+                    reader = ImageFitsReader(fileName)
+                    self.assertFalse(reader.mapping)
+                    reader.mapping = True
+                    for args in self.args:
+                        with self.subTest(args=args):
+                            subIn = imageIn.subset(*args) if args else imageIn
+                            image1 = reader.read(*args)
+                            self.assertImagesEqual(subIn, image1)
+                            # Rows are strided as in the file
+                            self.assertEqual(image1.array.strides[0], self.bbox.getWidth()*dtypeIn.itemsize)
+                            # Conversions can't be mapped, but still work
+                            image2 = reader.read(*args, dtype=np.float64)
+                            self.assertTrue(np.all(image2.array == subIn.array))
+                            # The mapping is private
+                            image1.array[:, :] = 0
+                            self.assertImagesEqual(subIn, reader.read(*args))
+
     def testMaskFitsReader(self):
         maskIn = Mask(self.bbox, dtype=MaskPixel)
         maskIn.array[:, :] = np.random.randint(low=1, high=5, size=maskIn.array.shape)
@@ -253,6 +281,163 @@ class FitsReaderTestCase(lsst.utils.tests.TestCase):
                     self.checkMaskedImageFitsReader(exposureIn, fileName, self.dtypes[n:])
                     self.checkExposureFitsReader(exposureIn, fileName, self.dtypes[n:])
 
+    def testReadCache(self):
+        """Test that readers share headers and components through the read cache."""
+        cache = lsst.afw.fits.ReadCache.getInstance()
+        self.assertEqual(cache.getCapacity(), 0)
+        metadata = PropertyList()
+        metadata.add("FIVE", 5)
+        wcs = makeSkyWcs(Point2D(2.5, 3.75), SpherePoint(40.0*degrees, 50.0*degrees),
+                         np.array([[1E-5, 0.0], [0.0, -1E-5]]))
+        psf = GaussianPsf(21, 21, 8.0)
+        coaddInputs = CoaddInputs(ExposureTable.makeMinimalSchema(), ExposureTable.makeMinimalSchema())
+        coaddInputs.ccds.addNew().setPsf(psf)
+        exposureIn = Exposure(self.bbox, dtype=np.float32)
+        exposureIn.setMetadata(metadata)
+        exposureIn.setWcs(wcs)
+        exposureIn.setPsf(psf)
+        exposureIn.getInfo().setApCorrMap(ApCorrMap())
+        exposureIn.getInfo().setCoaddInputs(coaddInputs)
+        cache.setCapacity(1 << 24)
+        try:
+            with lsst.utils.tests.getTempFilePath(".fits") as fileName:
+                exposureIn.writeFits(fileName)
+                reader1 = ExposureFitsReader(fileName)
+                self.assertEqual(reader1.readMetadata().getScalar("FIVE"), 5)
+                psf1 = reader1.readPsf()
+                self.assertEqual(cache.getHitCount(), 0)
+                self.assertGreater(cache.getCount(), 0)
+                reader2 = ExposureFitsReader(fileName)
+                metadata2 = reader2.readMetadata()
+                self.assertEqual(metadata2.getScalar("FIVE"), 5)
+                self.assertEqual(reader2.readBBox(), self.bbox)
+                self.assertEqual(reader2.readWcs(), wcs)
+                hits = cache.getHitCount()
+                # Decoded archive components are shared between readers...
+                self.assertIs(reader2.readPsf(), psf1)
+                self.assertGreater(cache.getHitCount(), hits)
+                # ...except those callers may modify, which are copied...
+                self.assertIsNot(reader2.readApCorrMap(), reader1.readApCorrMap())
+                # ...and CoaddInputs, which each reader decodes from the cached archive HDUs.
+                self.assertEqual(len(reader2.readCoaddInputs().ccds), 1)
+                self.assertIsNot(reader2.readCoaddInputs(), reader1.readCoaddInputs())
+                # Readers get their own copies of headers.
+                metadata2.set("FIVE", 6)
+                self.assertEqual(ExposureFitsReader(fileName).readMetadata().getScalar("FIVE"), 5)
+                # Rewriting the file changes its key.
+                metadata.set("FIVE", 7)
+                for i in range(40):  # more than a FITS block, so the size changes too
+                    metadata.set("EXTRA%d" % i, i)
+                exposureIn.setMetadata(metadata)
+                exposureIn.writeFits(fileName)
+                self.assertEqual(ExposureFitsReader(fileName).readMetadata().getScalar("FIVE"), 7)
+        finally:
+            cache.setCapacity(0)
+            cache.clear()
+        self.assertEqual(cache.getCount(), 0)
+
+    def testExposureCutoutReader(self):
+        """Test reading batches of cutouts from several files."""
+        psf = GaussianPsf(21, 21, 8.0)
+        boxes = [Box2I(Point2I(3, 4), Extent2I(2, 1)), Box2I(Point2I(2, 1), Extent2I(3, 3)),
+                 Box2I(Point2I(4, 6), Extent2I(1, 2))]
+        with lsst.utils.tests.getTempFilePath("_a.fits") as fileA, \
+                lsst.utils.tests.getTempFilePath("_b.fits") as fileB:
+            exposures = {}
+            for fileName in (fileA, fileB):
+                exposure = Exposure(self.bbox, dtype=np.float32)
+                shape = exposure.image.array.shape
+                exposure.image.array[:, :] = np.random.randint(low=1, high=5, size=shape)
+                exposure.variance.array[:, :] = np.random.randint(low=1, high=5, size=shape)
+                exposure.setPsf(psf)
+                exposure.writeFits(fileName)
+                exposures[fileName] = exposure
+            # Another name for fileA, which should be read through the same reader.
+            aliasA = os.path.join(os.path.dirname(fileA), ".", os.path.basename(fileA))
+            exposures[aliasA] = exposures[fileA]
+            requests = [ExposureCutoutReader.Request(fileName, bbox)
+                        for bbox in boxes for fileName in (fileA, fileB, aliasA)]
+            for nThreads in (1, 2):
+                with self.subTest(nThreads=nThreads):
+                    reader = ExposureCutoutReader(nThreads=nThreads, maxOpenFiles=1)
+                    maskedImages = reader.readMaskedImages(requests)
+                    cutouts = reader.readExposures(requests)
+                    self.assertEqual(len(maskedImages), len(requests))
+                    self.assertEqual(len(cutouts), len(requests))
+                    for request, maskedImage, cutout in zip(requests, maskedImages, cutouts):
+                        expected = exposures[request.fileName].subset(request.bbox)
+                        self.assertMaskedImagesEqual(maskedImage, expected.maskedImage)
+                        self.assertMaskedImagesEqual(cutout.maskedImage, expected.maskedImage)
+                        self.assertIsNotNone(cutout.getPsf())
+                    reader.closeFiles()
+            outside = [ExposureCutoutReader.Request(fileA, Box2I(Point2I(0, 0), Extent2I(100, 100)))]
+            with self.assertRaises(lsst.pex.exceptions.LengthError):
+                ExposureCutoutReader().readMaskedImages(outside)
+
+    def testScratchFiles(self):
+        """Test round-tripping images, masks, masked images and exposures through scratch files."""
+        metadata = PropertyList()
+        metadata.add("FIVE", 5)
+        wcs = makeSkyWcs(Point2D(2.5, 3.75), SpherePoint(40.0*degrees, 50.0*degrees),
+                         np.array([[1E-5, 0.0], [0.0, -1E-5]]))
+        psf = GaussianPsf(21, 21, 8.0)
+        optionsList = [ScratchWriteOptions(),
+                       ScratchWriteOptions(ScratchWriteOptions.GZIP),
+                       ScratchWriteOptions(ScratchWriteOptions.GZIP, tileRows=2)]
+        for dtype in self.dtypes:
+            exposureIn = Exposure(self.bbox, dtype=dtype)
+            shape = exposureIn.image.array.shape
+            exposureIn.image.array[:, :] = np.random.randint(low=1, high=5000, size=shape)
+            exposureIn.mask.array[:, :] = np.random.randint(low=1, high=5, size=shape)
+            exposureIn.variance.array[:, :] = np.random.uniform(low=1, high=5, size=shape)
+            exposureIn.setMetadata(metadata)
+            exposureIn.setWcs(wcs)
+            exposureIn.setPsf(psf)
+            for options in optionsList:
+                with self.subTest(dtype=dtype, compression=options.compression, tileRows=options.tileRows):
+                    with lsst.utils.tests.getTempFilePath(".scratch") as fileName:
+                        exposureIn.image.writeScratch(fileName, options)
+                        self.assertImagesEqual(type(exposureIn.image).readScratch(fileName), exposureIn.image)
+                        exposureIn.mask.writeScratch(fileName, options)
+                        self.assertImagesEqual(type(exposureIn.mask).readScratch(fileName), exposureIn.mask)
+                        exposureIn.maskedImage.writeScratch(fileName, options)
+                        self.assertMaskedImagesEqual(type(exposureIn.maskedImage).readScratch(fileName),
+                                                     exposureIn.maskedImage)
+                        exposureIn.writeScratch(fileName, options)
+                        exposureOut = type(exposureIn).readScratch(fileName)
+                        self.assertMaskedImagesEqual(exposureOut.maskedImage, exposureIn.maskedImage)
+                        self.assertEqual(exposureOut.getMetadata().getScalar("FIVE"), 5)
+                        self.assertEqual(exposureOut.getWcs(), wcs)
+                        self.assertImagesEqual(exposureOut.getPsf().computeImage(), psf.computeImage())
+                        reader = ScratchFileReader(fileName)
+                        self.assertEqual(reader.readBBox(), self.bbox)
+                        self.assertEqual(reader.readImageDType(), dtype)
+                        self.assertTrue(reader.hasExposureInfo())
+                        for mapping in (False, True):
+                            reader.mapping = mapping
+                            for args in self.args:
+                                subIn = exposureIn.subset(*args) if args else exposureIn
+                                self.assertImagesEqual(reader.readImage(*args), subIn.image)
+                                subOut = reader.readExposure(*args)
+                                self.assertMaskedImagesEqual(subOut.maskedImage, subIn.maskedImage)
+                                self.assertEqual(subOut.getWcs(), wcs)
+                        with self.assertRaises(lsst.pex.exceptions.TypeError):
+                            reader.readImage(dtype=np.uint64)
+                        with self.assertRaises(lsst.pex.exceptions.LengthError):
+                            reader.readImage(Box2I(Point2I(0, 0), Extent2I(100, 100)))
+        with lsst.utils.tests.getTempFilePath(".scratch") as fileName:
+            exposureIn.image.writeScratch(fileName, ScratchWriteOptions())
+            reader = ScratchFileReader(fileName)
+            self.assertFalse(reader.hasMask())
+            with self.assertRaisesRegex(lsst.pex.exceptions.NotFoundError, "no mask plane"):
+                reader.readMask()
+            with self.assertRaisesRegex(lsst.pex.exceptions.NotFoundError, "no variance plane"):
+                reader.readVariance()
+        with lsst.utils.tests.getTempFilePath(".fits") as fileName:
+            exposureIn.writeFits(fileName)
+            with self.assertRaises(lsst.pex.exceptions.IoError):
+                ScratchFileReader(fileName)
+
 
 class TestMemory(lsst.utils.tests.MemoryTestCase):
     pass
@@ -149,6 +149,26 @@ class SchemaTestCase(unittest.TestCase):
         arrayElementKey = arrayKey[1]
         self.assertEqual(lsst.afw.table.Key["F"], type(arrayElementKey))
 
+    def testFindAfterChanges(self):
+        """Test that name lookups follow added, copied, and renamed fields."""
+        schema = lsst.afw.table.Schema()
+        keys = [schema.addField("f%d" % i, type=np.float64, doc="field") for i in range(100)]
+        copy = lsst.afw.table.Schema(schema)
+        kExtra = copy.addField("extra", type=np.int32, doc="only in the copy")
+        for i, key in enumerate(keys):
+            self.assertEqual(schema.find("f%d" % i).key, key)
+            self.assertEqual(copy.find("f%d" % i).key, key)
+        self.assertEqual(copy.find("extra").key, kExtra)
+        with self.assertRaises(lsst.pex.exceptions.NotFoundError):
+            schema.find("extra")
+        mapper = lsst.afw.table.SchemaMapper(schema)
+        kOut = mapper.addMapping(keys[3], "b")
+        mapper.addMapping(keys[3], "c")
+        output = mapper.getOutputSchema()
+        self.assertEqual(output.find("c").key, kOut)
+        with self.assertRaises(lsst.pex.exceptions.NotFoundError):
+            output.find("b")
+
     def testComparison(self):
         schema1 = lsst.afw.table.Schema()
         schema1.addField("a", type=np.float32, doc="doc for a", units="m")
@@ -299,6 +319,52 @@ class SchemaMapperTestCase(unittest.TestCase):
         mapper3.addMapping(ka, "c", True)
         self.assertEqual(mapper3.getMapping(ka), kc)
 
+    def testCopyRecords(self):
+        """Test copying records with a mapper whose fields are only partly contiguous, including
+        fields mapped out of order, flags, and variable-length fields.
+        """
+        schema = lsst.afw.table.Schema()
+        kI = schema.addField("i", type=np.int32, doc="int")
+        kD = schema.addField("d", type=np.float64, doc="double")
+        kA = schema.addField("a", type="ArrayF", size=3, doc="array")
+        kFlag1 = schema.addField("flag1", type="Flag", doc="flag")
+        kL = schema.addField("l", type=np.int64, doc="long")
+        kFlag2 = schema.addField("flag2", type="Flag", doc="flag")
+        kS = schema.addField("s", type=str, size=0, doc="variable-length string")
+        mapper = lsst.afw.table.SchemaMapper(schema)
+        mapper.addMinimalSchema(lsst.afw.table.Schema())
+        kExtra = mapper.addOutputField(lsst.afw.table.Field[np.int16]("extra", "unmapped"))
+        outKeys = {}
+        for key in (kD, kI, kA, kFlag2, kS, kFlag1):
+            outKeys[key] = mapper.addMapping(key)
+        input = lsst.afw.table.BaseCatalog(schema)
+        for i in range(10):
+            record = input.addNew()
+            record.set(kI, i)
+            record.set(kD, 0.5*i)
+            record.set(kA, np.array([i, i + 1, i + 2], dtype=np.float32))
+            record.set(kFlag1, i % 2 == 0)
+            record.set(kL, 3*i)
+            record.set(kFlag2, i % 3 == 0)
+            record.set(kS, "s" * i)
+        output = lsst.afw.table.BaseCatalog(mapper.getOutputSchema())
+        output.extend(input, mapper=mapper)
+        for inRecord, outRecord in zip(input, output):
+            for key, outKey in outKeys.items():
+                if key == kA:
+                    np.testing.assert_array_equal(outRecord.get(outKey), inRecord.get(key))
+                else:
+                    self.assertEqual(outRecord.get(outKey), inRecord.get(key))
+            self.assertEqual(outRecord.get(kExtra), 0)
+
+        # Adding a mapping after records have been copied must be reflected in later copies.
+        outKeys[kL] = mapper.addMapping(kL)
+        output = lsst.afw.table.BaseCatalog(mapper.getOutputSchema())
+        output.extend(input, mapper=mapper)
+        for inRecord, outRecord in zip(input, output):
+            self.assertEqual(outRecord.get(outKeys[kL]), inRecord.get(kL))
+            self.assertEqual(outRecord.get(outKeys[kS]), inRecord.get(kS))
+
     def testJoin2(self):
         s1 = lsst.afw.table.Schema()
         self.assertEqual(s1.join("a", "b"), "a_b")
@@ -189,6 +189,68 @@ class SimpleTableTestCase(lsst.utils.tests.TestCase):
         mem = lsst.afw.fits.MemFileManager()
         self._testBaseFits(mem)
 
+    def testBulkFitsPersistence(self):
+        """Test FITS round-trip of a catalog large enough to be written in several blocks of rows,
+        with every kind of fixed-size field, flags, and (in a second catalog) fixed and
+        variable-length strings and a variable-length array, which are written cell by cell after
+        each block of rows.
+        """
+        n = 20000
+        schema = lsst.afw.table.Schema()
+        keys = [schema.addField("i", type=np.int32, doc="scalar int32"),
+                schema.addField("l", type=np.int64, doc="scalar int64"),
+                schema.addField("u", type=np.uint16, doc="scalar uint16"),
+                schema.addField("b", type=np.uint8, doc="scalar uint8"),
+                schema.addField("f", type=np.float32, doc="scalar float"),
+                schema.addField("d", type=np.float64, doc="scalar double"),
+                schema.addField("a", type="Angle", doc="scalar Angle")]
+        kArray = schema.addField("ad", type="ArrayD", doc="array double", size=3)
+        flagKeys = [schema.addField("flag%d" % i, type="Flag", doc="flag") for i in range(11)]
+        cat1 = lsst.afw.table.BaseCatalog(schema)
+        cat1.reserve(n)
+        for i in range(n):
+            record = cat1.addNew()
+            for j, k in enumerate(flagKeys):
+                record.set(k, (i + j) % 3 == 0)
+            record.set(kArray, np.random.randn(3))
+        cat1["i"] = np.random.randint(-2**31, 2**31 - 1, size=n, dtype=np.int32)
+        cat1["l"] = np.random.randint(-2**62, 2**62, size=n, dtype=np.int64)
+        cat1["u"] = np.random.randint(0, 2**16, size=n).astype(np.uint16)
+        cat1["b"] = np.random.randint(0, 2**8, size=n).astype(np.uint8)
+        cat1["f"] = np.random.randn(n).astype(np.float32)
+        cat1["d"] = np.random.randn(n)
+        cat1["a"] = np.random.randn(n)
+        with lsst.utils.tests.getTempFilePath(".fits") as filename:
+            cat1.writeFits(filename)
+            cat2 = lsst.afw.table.BaseCatalog.readFits(filename)
+        self.assertEqual(len(cat1), len(cat2))
+        for k in keys + flagKeys:
+            np.testing.assert_array_equal(cat1[k], cat2[k])
+        for r1, r2 in zip(cat1[:100], cat2[:100]):
+            self.assertFloatsEqual(r1.get(kArray), r2.get(kArray))
+
+        mapper = lsst.afw.table.SchemaMapper(schema)
+        mapper.addMinimalSchema(schema)
+        kString = mapper.editOutputSchema().addField("s", type=str, size=8, doc="string")
+        kVarString = mapper.editOutputSchema().addField("vs", type=str, size=0, doc="variable string")
+        kVarArray = mapper.editOutputSchema().addField("va", type="ArrayI", size=0, doc="variable array")
+        cat3 = lsst.afw.table.BaseCatalog(mapper.getOutputSchema())
+        cat3.extend(cat1, mapper=mapper)
+        for i, record in enumerate(cat3):
+            record.set(kString, "s%d" % i)
+            record.set(kVarString, "v" * (i % 7))
+            record.set(kVarArray, np.arange(i % 5, dtype=np.int32))
+        with lsst.utils.tests.getTempFilePath(".fits") as filename:
+            cat3.writeFits(filename)
+            cat4 = lsst.afw.table.BaseCatalog.readFits(filename)
+        self.assertEqual(len(cat3), len(cat4))
+        for k in keys + flagKeys:
+            np.testing.assert_array_equal(cat3[k], cat4[k])
+        for r3, r4 in zip(cat3, cat4):
+            self.assertEqual(r3.get(kString), r4.get(kString))
+            self.assertEqual(r3.get(kVarString), r4.get(kVarString))
+            np.testing.assert_array_equal(r3.get(kVarArray), r4.get(kVarArray))
+
     def testColumnView(self):
         schema = lsst.afw.table.Schema()
         kB = schema.addField("fB", type="B")
@@ -272,6 +334,118 @@ class SimpleTableTestCase(lsst.utils.tests.TestCase):
             with self.assertRaises(lsst.pex.exceptions.LogicError):
                 catalog.get(invalidKey)
 
+    def testColumnarStorage(self):
+        """Test that records in a columnar table behave like row-major records, with unit-stride
+        column views.
+        """
+        n = 50
+        schema = lsst.afw.table.Schema()
+        kI = schema.addField("i", type=np.int32, doc="scalar int32")
+        kD = schema.addField("d", type=np.float64, doc="scalar double")
+        kFlag = schema.addField("flag", type="Flag", doc="flag")
+        kArray = schema.addField("a", type="ArrayF", doc="array float", size=3)
+        kString = schema.addField("s", type=str, size=8, doc="string")
+        kVar = schema.addField("v", type="ArrayD", doc="variable-length array", size=0)
+        table = lsst.afw.table.BaseTable.make(schema)
+        self.assertFalse(table.isColumnar())
+        table.setColumnar(True)
+        self.assertTrue(table.isColumnar())
+        self.assertTrue(table.clone().isColumnar())
+        catalog = lsst.afw.table.BaseCatalog(table)
+        catalog.reserve(n)
+        for i in range(n):
+            record = catalog.addNew()
+            self.assertTrue(np.isnan(record.get(kD)))
+            record.set(kI, i)
+            record.set(kD, 0.5*i)
+            record.set(kFlag, i % 3 == 0)
+            record.set(kArray, np.array([i, -i, 2*i], dtype=np.float32))
+            record.set(kString, "s%d" % i)
+            record.set(kVar, np.arange(i % 4, dtype=np.float64))
+        self.assertTrue(catalog.isContiguous())
+        columns = catalog.getColumnView()
+        self.assertEqual(columns[kI].strides, (4,))
+        self.assertEqual(columns[kD].strides, (8,))
+        self.assertEqual(columns[kArray].strides, (12, 4))
+        np.testing.assert_array_equal(columns[kI], np.arange(n))
+        np.testing.assert_array_equal(columns[kFlag], np.arange(n) % 3 == 0)
+        np.testing.assert_array_equal(columns[kArray][:, 2], 2*np.arange(n))
+        catalog[kD] *= 2
+        for i, record in enumerate(catalog):
+            self.assertEqual(record.get(kI), i)
+            self.assertEqual(record.get(kD), i)
+            self.assertEqual(record.get(kFlag), i % 3 == 0)
+            self.assertFloatsEqual(record.get(kArray), np.array([i, -i, 2*i], dtype=np.float32))
+            self.assertEqual(record.get(kString), "s%d" % i)
+            self.assertFloatsEqual(record.get(kVar), np.arange(i % 4, dtype=np.float64))
+
+        # Subsets and copies
+        self.assertTrue(catalog[10:20].isContiguous())
+        np.testing.assert_array_equal(catalog[10:20][kI], np.arange(10, 20))
+        self.assertFalse(catalog[::2].isContiguous())
+        copy = catalog.copy(deep=True)
+        self.assertTrue(copy.table.isColumnar())
+        np.testing.assert_array_equal(copy[kD], catalog[kD])
+
+        # Switching back to row-major only affects new records
+        table.setColumnar(False)
+        record = catalog.addNew()
+        record.set(kI, n)
+        self.assertFalse(catalog.isContiguous())
+        self.assertEqual(catalog[n - 1].get(kI), n - 1)
+        self.assertEqual(catalog[n].get(kI), n)
+
+        # FITS round-trip of a catalog with both layouts
+        with lsst.utils.tests.getTempFilePath(".fits") as filename:
+            catalog.writeFits(filename)
+            cat2 = lsst.afw.table.BaseCatalog.readFits(filename)
+        self.assertEqual(len(cat2), len(catalog))
+        for original, record in zip(catalog, cat2):
+            for key in (kI, kD, kFlag, kString):
+                self.assertEqual(record.get(key), original.get(key))
+            self.assertFloatsEqual(record.get(kArray), original.get(kArray))
+            self.assertFloatsEqual(record.get(kVar), original.get(kVar))
+
+    def testColumnarArrayKey(self):
+        """Test that ArrayKeys made of separate scalar fields, which are not contiguous in columnar
+        records, read and write only their own record's values.
+        """
+        n = 5
+        schema = lsst.afw.table.Schema()
+        kBefore = schema.addField("before", type=np.float64, doc="scalar before the array")
+        kScalars = lsst.afw.table.ArrayDKey.addFields(schema, "s", "scalar elements", "", 3)
+        kAfter = schema.addField("after", type=np.float64, doc="scalar after the array")
+        kArray = lsst.afw.table.ArrayDKey(schema.addField("a", type="ArrayD", doc="array field", size=3))
+        table = lsst.afw.table.BaseTable.make(schema)
+        table.setColumnar(True)
+        catalog = lsst.afw.table.BaseCatalog(table)
+        catalog.reserve(n)
+        for i in range(n):
+            record = catalog.addNew()
+            record.set(kBefore, -1.0*i)
+            record.set(kAfter, -2.0*i)
+        for i, record in enumerate(catalog):
+            record.set(kScalars, np.array([i, 10*i, 100*i], dtype=np.float64))
+            record.set(kArray, np.array([-i, -10*i, -100*i], dtype=np.float64))
+        for i, record in enumerate(catalog):
+            self.assertFloatsEqual(record.get(kScalars), np.array([i, 10*i, 100*i], dtype=np.float64))
+            self.assertFloatsEqual(record.get(kArray), np.array([-i, -10*i, -100*i], dtype=np.float64))
+            self.assertEqual([record.get(kScalars[j]) for j in range(3)], [i, 10*i, 100*i])
+            self.assertEqual(record.get(kBefore), -1.0*i)
+            self.assertEqual(record.get(kAfter), -2.0*i)
+        np.testing.assert_array_equal(catalog[kScalars[1]], 10*np.arange(n))
+
+        # Round-trip through a row-major copy and FITS
+        rowMajor = lsst.afw.table.BaseCatalog(schema)
+        rowMajor.extend(catalog, deep=True)
+        with lsst.utils.tests.getTempFilePath(".fits") as filename:
+            catalog.writeFits(filename)
+            cat2 = lsst.afw.table.BaseCatalog.readFits(filename)
+        for original, record1, record2 in zip(catalog, rowMajor, cat2):
+            self.assertFloatsEqual(record1.get(kScalars), original.get(kScalars))
+            self.assertFloatsEqual(record2.get(kScalars), original.get(kScalars))
+            self.assertFloatsEqual(record2.get(kArray), original.get(kArray))
+
     def testUnsignedFitsPersistence(self):
         """Test FITS round-trip of unsigned short ints, since FITS handles unsigned columns differently
         from signed columns.
@@ -546,6 +720,32 @@ class SimpleTableTestCase(lsst.utils.tests.TestCase):
         self.assertEqual(s.start, cat.lower_bound(3, ki))
         self.assertEqual(s.stop, cat.upper_bound(3, ki))
 
+    def testThreadedSort(self):
+        """Test that multithreaded sorts are stable and match single-threaded ones.
+        """
+        schema = lsst.afw.table.SimpleTable.makeMinimalSchema()
+        ki = schema.addField("i", type=np.int32, doc="doc for i")
+        kf = schema.addField("f", type=np.float64, doc="doc for f")
+        n = 100000  # enough for several chunks
+        rng = np.random.RandomState(5)
+        cat = lsst.afw.table.SimpleCatalog(schema)
+        cat.reserve(n)
+        for j in range(n):
+            cat.addNew()
+        cat["id"][:] = rng.permutation(n)
+        cat[ki][:] = rng.randint(-100, 100, size=n)
+        cat[kf][:] = rng.randn(n)
+        for key in (ki, kf):
+            expected = np.argsort(cat[key], kind="mergesort")
+            ids = cat["id"][expected]
+            copy = cat.copy(deep=False)
+            copy.sort(key, nThreads=4)
+            self.assertTrue(copy.isSorted(key))
+            np.testing.assert_array_equal(copy["id"], ids)
+        cat.sort(nThreads=0)
+        self.assertTrue(cat.isSorted())
+        np.testing.assert_array_equal(cat["id"], np.arange(n))
+
     def testRename(self):
         """Test field-renaming functionality in Field, SchemaMapper.
         """
@@ -799,6 +999,44 @@ class SimpleTableTestCase(lsst.utils.tests.TestCase):
         with self.assertRaises(IndexError):
             del catalog[50]
 
+    def testCompactCatalog(self):
+        """Test the CompactCatalog bindings: records are views of the catalog's field data, and
+        field values can be read and written by index.
+        """
+        schema = lsst.afw.table.SimpleTable.makeMinimalSchema()
+        key = schema.addField("a", type=np.float64, doc="doc for 'a'")
+        catalog = lsst.afw.table.SimpleCatalog(schema)
+        for i in range(10):
+            record = catalog.addNew()
+            record.setId(i + 1)
+            record.set(key, 0.5*i)
+        compact = lsst.afw.table.SimpleCompactCatalog(catalog.table)
+        compact.extend(catalog)
+        self.assertEqual(len(compact), 10)
+        self.assertTrue(compact.isContiguous())
+        records = list(compact)
+        self.assertEqual([r.getId() for r in records], list(range(1, 11)))
+        self.assertEqual(compact[-1].get(key), 4.5)
+        compact.set(2, key, -1.0)
+        self.assertEqual(compact.get(2, key), -1.0)
+        self.assertEqual(records[2].get(key), -1.0)
+        np.testing.assert_array_equal(compact.getColumnView()[key], [r.get(key) for r in records])
+        with self.assertRaises(IndexError):
+            compact[10]
+
+        record = compact.addNew()
+        record.setId(100)
+        copy = compact.toCatalog()
+        self.assertIsInstance(copy[0], lsst.afw.table.SimpleRecord)
+        self.assertEqual([r.getId() for r in copy], list(range(1, 11)) + [100])
+
+        base = lsst.afw.table.BaseCompactCatalog(schema)
+        base.addNew().set(key, 2.0)
+        compact.clear()
+        self.assertEqual(len(compact), 0)
+        self.assertEqual(records[0].getId(), 1)
+        self.assertEqual(base[0].get(key), 2.0)
+
 
 class MemoryTester(lsst.utils.tests.MemoryTestCase):
     pass
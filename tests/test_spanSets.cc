@@ -20,7 +20,10 @@
  * see <https://www.lsstcorp.org/LegalNotices/>.
  */
 
+#include <algorithm>
 #include <iostream>
+#include <list>
+#include <stdexcept>
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MODULE SpanSet
 
@@ -633,6 +636,30 @@ BOOST_AUTO_TEST_CASE(SpanSet_testUnion) {
     BOOST_CHECK(*spanSetAsOther == *firstSS);
 }
 
+BOOST_AUTO_TEST_CASE(SpanSet_testSetOperationsUnnormalized) {
+    // Set operations must give the same answer when a SpanSet was built without normalization
+    // and so holds unsorted, overlapping and touching Spans
+    std::vector<afwGeom::Span> spans = {afwGeom::Span(2, 0, 3), afwGeom::Span(0, 5, 8),
+                                        afwGeom::Span(0, 0, 6), afwGeom::Span(2, 4, 6),
+                                        afwGeom::Span(1, 2, 2)};
+    afwGeom::SpanSet raw(spans, false);
+    afwGeom::SpanSet normalized(spans);
+    afwGeom::SpanSet other({afwGeom::Span(0, 3, 10), afwGeom::Span(1, 0, 1), afwGeom::Span(2, 5, 5)});
+
+    BOOST_CHECK(*raw.union_(other) == *normalized.union_(other));
+    BOOST_CHECK(*other.union_(raw) == *normalized.union_(other));
+    BOOST_CHECK(*raw.intersect(other) == *normalized.intersect(other));
+    BOOST_CHECK(*other.intersect(raw) == *normalized.intersect(other));
+    BOOST_CHECK(*raw.intersectNot(other) == *normalized.intersectNot(other));
+    BOOST_CHECK(*other.intersectNot(raw) == *other.intersectNot(normalized));
+
+    // The union of two unnormalized SpanSets is itself normalized
+    auto merged = raw.union_(afwGeom::SpanSet({afwGeom::Span(1, 3, 4), afwGeom::Span(1, 1, 3)}, false));
+    std::vector<afwGeom::Span> expected = {afwGeom::Span(0, 0, 8), afwGeom::Span(1, 1, 4),
+                                           afwGeom::Span(2, 0, 6)};
+    BOOST_CHECK(std::vector<afwGeom::Span>(merged->begin(), merged->end()) == expected);
+}
+
 BOOST_AUTO_TEST_CASE(SpanSet_MaskToSpanSet) {
     // This is to test the free function that turns Masks to SpanSets
     auto maskAndSet = makeMaskAndSpanSetForOperationTests();
@@ -649,6 +676,31 @@ BOOST_AUTO_TEST_CASE(SpanSet_MaskToSpanSet) {
     BOOST_CHECK(yCoord == 11);
 }
 
+BOOST_AUTO_TEST_CASE(SpanSet_MaskPlanesToSpanSets) {
+    // Rows are wider than one 64 pixel block so that runs cross block boundaries
+    using MaskPixel = lsst::afw::image::MaskPixel;
+    lsst::afw::image::Mask<MaskPixel> mask(lsst::geom::Box2I(lsst::geom::Point2I(-7, 3),
+                                                             lsst::geom::Extent2I(150, 20)));
+    auto circle = afwGeom::SpanSet::fromShape(9, afwGeom::Stencil::CIRCLE)->shiftedBy(60, 12);
+    auto box = std::make_shared<afwGeom::SpanSet>(
+            lsst::geom::Box2I(lsst::geom::Point2I(-7, 5), lsst::geom::Point2I(142, 8)));
+    circle->setMask(mask, static_cast<MaskPixel>(1));
+    box->setMask(mask, static_cast<MaskPixel>(4));
+    // A run which ends on the last pixel of a block
+    afwGeom::SpanSet({afwGeom::Span(20, 40, 56)}).setMask(mask, static_cast<MaskPixel>(4));
+
+    auto planes = afwGeom::SpanSet::fromMaskPlanes(mask, std::vector<MaskPixel>({1, 4, 5, 2}));
+    BOOST_REQUIRE(planes.size() == 4u);
+    BOOST_CHECK(*planes[0] == *circle);
+    BOOST_CHECK(*planes[1] == *box->union_(afwGeom::SpanSet({afwGeom::Span(20, 40, 56)})));
+    BOOST_CHECK(*planes[2] == *circle->union_(*planes[1]));
+    BOOST_CHECK(planes[3]->empty());
+
+    // The single plane version must agree with the generic comparator version
+    auto generic = afwGeom::SpanSet::fromMask(mask, [](MaskPixel pixel) { return (pixel & 4) != 0; });
+    BOOST_CHECK(*afwGeom::SpanSet::fromMask(mask, static_cast<MaskPixel>(4)) == *generic);
+}
+
 BOOST_AUTO_TEST_CASE(SpanSet_testEquality) {
     auto ret = makeOverlapSpanSets();
     auto firstSS = ret.first;
@@ -753,6 +805,76 @@ BOOST_AUTO_TEST_CASE(SpanSet_testFunctor) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(SpanSet_testApplyFunctorParallel) {
+    // Use a SpanSet large enough that the work is actually split between threads
+    int const radius = 150;
+    auto spnSt = afwGeom::SpanSet::fromShape(radius, afwGeom::Stencil::CIRCLE)->shiftedBy(radius, radius);
+    BOOST_REQUIRE(spnSt->getArea() > 4 * afwGeom::SpanSet::parallelMinArea);
+
+    ndarray::Array<int, 2, 2> input = ndarray::allocate(ndarray::makeVector(2 * radius + 1, 2 * radius + 1));
+    int counter = 0;
+    for (int i = 0; i < 2 * radius + 1; ++i) {
+        for (int j = 0; j < 2 * radius + 1; ++j) {
+            input[i][j] = counter++;
+        }
+    }
+
+    // Flatten with several threads must give the same array as the serial version
+    auto serialFlat = spnSt->flatten(input);
+    auto parallelFlat = spnSt->flatten(input, lsst::geom::Point2I(), 4);
+    BOOST_REQUIRE(parallelFlat.size() == serialFlat.size());
+    for (std::size_t i = 0; i < serialFlat.size(); ++i) {
+        BOOST_CHECK(parallelFlat[i] == serialFlat[i]);
+    }
+
+    // Unflattening the flattened array must restore the input inside the SpanSet
+    auto parallelUnflat = spnSt->unflatten(parallelFlat, 4);
+    for (auto const& spn : *spnSt) {
+        for (auto const& pt : spn) {
+            BOOST_CHECK(parallelUnflat[pt.getY()][pt.getX()] == input[pt.getY()][pt.getX()]);
+        }
+    }
+
+    // Iterators and Images are advanced to the correct position in each thread
+    std::vector<lsst::geom::Point2I> capturedPoints(spnSt->getArea());
+    lsst::afw::image::Image<int> image(2 * radius + 1, 2 * radius + 1, 0);
+    spnSt->applyFunctorParallel(0,
+                                [](lsst::geom::Point2I const& point, lsst::geom::Point2I& out, int& pix) {
+                                    out = point;
+                                    pix += 1;
+                                },
+                                capturedPoints.begin(), image);
+    auto capturedPointsIter = capturedPoints.begin();
+    for (auto const& spn : *spnSt) {
+        for (auto const& pnt : spn) {
+            BOOST_CHECK(pnt == *capturedPointsIter);
+            BOOST_CHECK(image(pnt.getX(), pnt.getY()) == 1);
+            ++capturedPointsIter;
+        }
+    }
+
+    // Iterators that are not random access are driven on a single thread
+    std::list<lsst::geom::Point2I> listPoints(spnSt->getArea());
+    spnSt->applyFunctorParallel(
+            4, [](lsst::geom::Point2I const& point, lsst::geom::Point2I& out) { out = point; },
+            listPoints.begin());
+    BOOST_CHECK(std::equal(listPoints.begin(), listPoints.end(), capturedPoints.begin()));
+    static_assert(!afwGeom::details::IterGetter<std::list<int>::iterator>::isThreadSafe,
+                  "list iterators must not be advanced concurrently");
+    static_assert(afwGeom::details::IterGetter<std::vector<int>::iterator>::isThreadSafe,
+                  "vector iterators may be advanced concurrently");
+
+    // Exceptions thrown by the functor propagate out of the call
+    BOOST_CHECK_THROW(spnSt->applyFunctorParallel(4,
+                                                  [radius](lsst::geom::Point2I const& point, int& pix) {
+                                                      if (point.getY() == 2 * radius) {
+                                                          throw std::runtime_error("failed");
+                                                      }
+                                                  },
+                                                  image),
+                      std::runtime_error);
+}
+
 BOOST_AUTO_TEST_CASE(SpanSet_testPersistence) {
     namespace tableIo = lsst::afw::table::io;
     // Create a SpanSet to persist
@@ -68,6 +68,19 @@ class SpanSetTestCase(lsst.utils.tests.TestCase):
         self.assertEqual(spanSetFromArray.getBBox().getMaxX(), 4)
         self.assertEqual(spanSetFromArray.getBBox().getMinY(), 0)
 
+    def testCompactSpanSet(self):
+        spanSet = afwGeom.SpanSet.fromShape(4, afwGeom.Stencil.CIRCLE).shiftedBy(10, 20)
+        compact = afwGeom.CompactSpanSet(spanSet)
+        self.assertEqual(len(compact), len(spanSet))
+        self.assertEqual(compact.getArea(), spanSet.getArea())
+        self.assertEqual(compact.getBBox(), spanSet.getBBox())
+        self.assertEqual(list(compact), list(spanSet))
+        self.assertEqual(compact.toSpanSet(), spanSet)
+        shifted = compact.shiftedBy(-1, 2)
+        self.assertTrue(shifted.sharesStorageWith(compact))
+        self.assertEqual(shifted.toSpanSet(), spanSet.shiftedBy(-1, 2))
+        self.assertLess(compact.getEncodedSize(), 12*len(spanSet))
+
     def testIsContiguous(self):
         spanSetConList = [afwGeom.Span(0, 2, 5), afwGeom.Span(1, 5, 8)]
         spanSetCon = afwGeom.SpanSet(spanSetConList)
@@ -339,6 +352,41 @@ class SpanSetTestCase(lsst.utils.tests.TestCase):
         for yVal, span in enumerate(spanSetUnion):
             self.assertEqual(span.getY(), yVal)
 
+    def testBatchedSetOperations(self):
+        # Compare against sets of pixels, for SpanSets with several Spans per row
+        np.random.seed(29)
+
+        def makeRandomSpanSet():
+            spans = [afwGeom.Span(int(y), int(x0), int(x0 + width))
+                     for y, x0, width in zip(np.random.randint(0, 8, 15),
+                                             np.random.randint(0, 30, 15),
+                                             np.random.randint(0, 6, 15))]
+            return afwGeom.SpanSet(spans)
+
+        def toPixels(spanSet):
+            return set((point.getX(), point.getY()) for span in spanSet for point in span)
+
+        spanSet = makeRandomSpanSet()
+        others = [makeRandomSpanSet() for _ in range(10)]
+        others.append(afwGeom.SpanSet())
+        others.append(spanSet)
+        intersections = spanSet.intersect(others)
+        differences = spanSet.intersectNot(others)
+        unions = spanSet.union(others)
+        self.assertEqual(len(intersections), len(others))
+        self.assertEqual(len(differences), len(others))
+        self.assertEqual(len(unions), len(others))
+        for other, intersection, difference, union in zip(others, intersections, differences, unions):
+            self.assertEqual(intersection, spanSet.intersect(other))
+            self.assertEqual(difference, spanSet.intersectNot(other))
+            self.assertEqual(union, spanSet.union(other))
+            self.assertEqual(toPixels(intersection), toPixels(spanSet) & toPixels(other))
+            self.assertEqual(toPixels(difference), toPixels(spanSet) - toPixels(other))
+            self.assertEqual(toPixels(union), toPixels(spanSet) | toPixels(other))
+            # Results are normalized
+            for result in (intersection, difference, union):
+                self.assertEqual(result, afwGeom.SpanSet(list(result)))
+
     def testMaskToSpanSet(self):
         mask, _ = self.makeMaskAndSpanSetForOperationTest()
         spanSetFromMask = afwGeom.SpanSet.fromMask(mask)
@@ -347,6 +347,22 @@ std::vector<ndarray::Vector<std::shared_ptr<Comparable>, M>> roundtripAndCompare
         outputs.back()[i] = outObj;
     }
 
+    // Round-trip and compare once more, reading the archive's data catalogs only as they're needed
+    // (in reverse order, so they are not read in the order they were written).
+    outputs.push_back(ndarray::Vector<std::shared_ptr<Comparable>, M>());
+    fits::Fits inFits3(manager, "r", fits::Fits::AUTO_CHECK);
+    inFits3.setHdu(fits::DEFAULT_HDU);
+    int const indexHdu = inFits3.getHdu();
+    InputArchive inArchive3 = InputArchive::readFits(inFits3, true);
+    for (int i = M - 1; i >= 0; --i) {
+        std::shared_ptr<Comparable> outObj =
+                std::dynamic_pointer_cast<Comparable>(inArchive3.get(inputIds[i]));
+        BOOST_CHECK_EQUAL(*outObj, *inputs[i]);
+        BOOST_CHECK_EQUAL(inFits3.getHdu(), indexHdu);
+        outputs.back()[i] = outObj;
+    }
+    inFits3.closeFile();
+
     return outputs;
 }
 
@@ -466,6 +482,49 @@ BOOST_AUTO_TEST_CASE(Nested) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(ContentDeduplication) {
+    using namespace lsst::afw::table::io;
+
+    auto makeA = [](double v) {
+        ndarray::Array<float, 1, 1> array = ndarray::allocate(2);
+        array[0] = 1.1;
+        array[1] = 1.2;
+        return std::make_shared<ExampleA>(3, v, array);
+    };
+    std::shared_ptr<Comparable> a1 = makeA(2.5), a2 = makeA(2.5), a3 = makeA(3.5), a4 = makeA(2.5);
+
+    OutputArchive archive;
+    archive.setContentDeduplication(true);
+    int const id1 = archive.put(a1);
+    BOOST_CHECK_EQUAL(archive.put(a2), id1);
+    int const id3 = archive.put(a3);
+    BOOST_CHECK_EQUAL(id3, id1 + 1);  // IDs of removed duplicates are reused
+    BOOST_CHECK_EQUAL(archive.countCatalogs(), 2);
+    BOOST_CHECK_EQUAL(archive.getCatalog(1).size(), 2u);
+
+    // Nested objects: c2's new nested object is a duplicate, so c2 is too; c3's nested objects differ.
+    std::shared_ptr<Comparable> c1(new ExampleC(1, a1, a2));
+    std::shared_ptr<Comparable> c2(new ExampleC(1, a4, a1));
+    std::shared_ptr<Comparable> c3(new ExampleC(1, a1, a3));
+    int const idC1 = archive.put(c1);
+    BOOST_CHECK_EQUAL(archive.put(c2), idC1);
+    BOOST_CHECK(archive.put(c3) != idC1);
+    BOOST_CHECK_EQUAL(archive.put(a4), id1);  // identity lookups find deduplicated nested objects
+
+    CatalogVector catalogs;
+    for (int j = 1; j < archive.countCatalogs(); ++j) {
+        catalogs.push_back(archive.getCatalog(j));
+    }
+    InputArchive inArchive(archive.getIndexCatalog(), catalogs);
+    std::shared_ptr<Comparable> d1 = std::dynamic_pointer_cast<Comparable>(inArchive.get(idC1));
+    BOOST_REQUIRE(d1);
+    BOOST_CHECK_EQUAL(*d1, *c2);
+
+    // Without deduplication, equal objects are saved separately.
+    OutputArchive plain;
+    BOOST_CHECK(plain.put(a1) != plain.put(a2));
+}
+
 namespace {
 
 std::vector<double> makeRandomVector(int size) {